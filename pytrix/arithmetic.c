@@ -0,0 +1,662 @@
+/*
+ *  Copyright (C) 2016 Warren Spencer warrenspencer27@gmail.com
+
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+PyObject *addFunction(PyObject *, FASTCALL_KEYWORDS_PARAMETERS);
+PyObject *subFunction(PyObject *, FASTCALL_KEYWORDS_PARAMETERS);
+PyObject *scaleFunction(PyObject *, FASTCALL_KEYWORDS_PARAMETERS);
+PyObject *matmulFunction(PyObject *, FASTCALL_KEYWORDS_PARAMETERS);
+PyObject *multiDotFunction(PyObject *, FASTCALL_PARAMETERS);
+PyObject *linearCombinationFunction(PyObject *, FASTCALL_KEYWORDS_PARAMETERS);
+PyObject *axpyFunction(PyObject *, FASTCALL_KEYWORDS_PARAMETERS);
+static unsigned char _assertOutMatrix(const char *, PyObject *, unsigned int, unsigned int);
+static unsigned char _assertOutVector(const char *, PyObject *, unsigned int);
+static PyObject *_addOrSub(const char *, PyObject *, PyObject *, PyObject *, unsigned char);
+static Matrix *_multiDotChain(Matrix **, Py_ssize_t *, Py_ssize_t, Py_ssize_t, Py_ssize_t, unsigned char *);
+static PyObject *_linearCombination(const char *, VECTOR_TYPE *, PyObject *const *, Py_ssize_t, PyObject *);
+
+
+static unsigned char _assertOutMatrix(const char *name, PyObject *out, unsigned int rows, unsigned int columns) {
+/*  Asserts that an out argument is a mutable matrix of the given dimensions.
+
+    Inputs: name    - The name of the function being called, for error messages.
+            out     - The out argument passed to the function.
+            rows    - The number of rows the result will have.
+            columns - The number of columns the result will have.
+
+    Outputs: 1 if out can hold the result, else 0 with a PyError set.
+*/
+
+    if (!Matrix_Check(out) || !((Matrix *)out)->isMutable) {
+        PyErr_Format(PyExc_TypeError, "%s() out argument must be a mutable Matrix, not: \"%.400s\"", name,
+                     Matrix_Check(out) ? "immutable Matrix" : Py_TYPE(out)->tp_name);
+        return 0;
+    }
+
+    if (((Matrix *)out)->rows != rows || ((Matrix *)out)->columns != columns) {
+        PyErr_Format(PyExc_ValueError, "%s() out argument must be a %ux%u Matrix, not %ux%u", name, rows, columns,
+                     ((Matrix *)out)->rows, ((Matrix *)out)->columns);
+        return 0;
+    }
+
+    return 1;
+}
+
+
+static unsigned char _assertOutVector(const char *name, PyObject *out, unsigned int dimensions) {
+/*  Asserts that an out argument is a mutable vector of the given number of dimensions.
+
+    Inputs: name       - The name of the function being called, for error messages.
+            out        - The out argument passed to the function.
+            dimensions - The number of dimensions the result will have.
+
+    Outputs: 1 if out can hold the result, else 0 with a PyError set.
+*/
+
+    if (!Vector_Check(out) || !((Vector *)out)->isMutable) {
+        PyErr_Format(PyExc_TypeError, "%s() out argument must be a mutable Vector, not: \"%.400s\"", name,
+                     Vector_Check(out) ? "immutable Vector" : Py_TYPE(out)->tp_name);
+        return 0;
+    }
+
+    if (((Vector *)out)->dimensions != dimensions) {
+        PyErr_Format(PyExc_ValueError, "%s() out argument must be a Vector of %u dimensions, not %u", name, dimensions,
+                     ((Vector *)out)->dimensions);
+        return 0;
+    }
+
+    return 1;
+}
+
+
+static PyObject *_addOrSub(const char *name, PyObject *a, PyObject *b, PyObject *out, unsigned char subtract) {
+/*  Adds or subtracts two matrices or two vectors, optionally writing the result into out.
+
+    Inputs: name     - The name of the function being called, for error messages.
+            a        - The first operand.
+            b        - The second operand.
+            out      - Either Py_None, or a mutable Matrix / Vector to write the result into.
+            subtract - Whether to compute a - b, rather than a + b.
+
+    Outputs: The result of the operation; a new reference to out if one was given.  NULL if an error occurred.
+*/
+
+    if (Matrix_Check(a) && Matrix_Check(b)) {
+        if (!_assertMatrixDimensionsEqual((Matrix *)a, (Matrix *)b))
+            return NULL;
+
+        if (out == Py_None)
+            return (PyObject *)(subtract ? _matrixSub((Matrix *)a, (Matrix *)b) : _matrixAdd((Matrix *)a, (Matrix *)b));
+
+        if (!_assertOutMatrix(name, out, ((Matrix *)a)->rows, ((Matrix *)a)->columns))
+            return NULL;
+
+        if (subtract)
+            _inplaceMatrixSub((Matrix *)a, (Matrix *)b, (Matrix *)out);
+        else
+            _inplaceMatrixAdd((Matrix *)a, (Matrix *)b, (Matrix *)out);
+
+    } else if (Vector_Check(a) && Vector_Check(b)) {
+        if (!_assertVectorDimensionsEqual((Vector *)a, (Vector *)b))
+            return NULL;
+
+        if (out == Py_None)
+            return (PyObject *)(subtract ? _vectorSub((Vector *)a, (Vector *)b) : _vectorAdd((Vector *)a, (Vector *)b));
+
+        if (!_assertOutVector(name, out, ((Vector *)a)->dimensions))
+            return NULL;
+
+        if (subtract)
+            _inplaceVectorSub((Vector *)a, (Vector *)b, (Vector *)out);
+        else
+            _inplaceVectorAdd((Vector *)a, (Vector *)b, (Vector *)out);
+
+    } else {
+        PyErr_Format(PyExc_TypeError, "%s() requires either two Matrices or two Vectors, not: \"%.400s\" & \"%.400s\"",
+                     name, Py_TYPE(a)->tp_name, Py_TYPE(b)->tp_name);
+        return NULL;
+    }
+
+    Py_INCREF(out);
+    return out;
+}
+
+
+PyObject *addFunction(PyObject *self, FASTCALL_KEYWORDS_PARAMETERS) {
+/*  Adds two matrices or two vectors.
+
+    Inputs: self    - A pointer to the pytrix module.
+            args    - The two operands, optionally followed by out.
+            nargs   - The number of positional arguments in args.
+            kwnames - The names of any keyword arguments passed.
+
+    Outputs: A new Matrix / Vector constructed by performing a + b, or out if it was given.  NULL if an error occurred.
+*/
+
+    FASTCALL_KEYWORDS_UNPACK_ARGS
+    PyObject *out = Py_None;
+
+    if (!_parseOptionalArg("add", "out", 2, args, nargs, kwnames, &out))
+        return NULL;
+
+    return _addOrSub("add", args[0], args[1], out, 0);
+}
+
+
+PyObject *subFunction(PyObject *self, FASTCALL_KEYWORDS_PARAMETERS) {
+/*  Subtracts one matrix or vector from another.
+
+    Inputs: self    - A pointer to the pytrix module.
+            args    - The two operands, optionally followed by out.
+            nargs   - The number of positional arguments in args.
+            kwnames - The names of any keyword arguments passed.
+
+    Outputs: A new Matrix / Vector constructed by performing a - b, or out if it was given.  NULL if an error occurred.
+*/
+
+    FASTCALL_KEYWORDS_UNPACK_ARGS
+    PyObject *out = Py_None;
+
+    if (!_parseOptionalArg("sub", "out", 2, args, nargs, kwnames, &out))
+        return NULL;
+
+    return _addOrSub("sub", args[0], args[1], out, 1);
+}
+
+
+PyObject *scaleFunction(PyObject *self, FASTCALL_KEYWORDS_PARAMETERS) {
+/*  Multiplies the components of a matrix or vector by a scalar.
+
+    Inputs: self    - A pointer to the pytrix module.
+            args    - The matrix or vector, and the scalar to multiply it by, optionally followed by out.
+            nargs   - The number of positional arguments in args.
+            kwnames - The names of any keyword arguments passed.
+
+    Outputs: A new Matrix / Vector constructed by performing a * scalar, or out if it was given.  NULL if an error
+             occurred.
+*/
+
+    FASTCALL_KEYWORDS_UNPACK_ARGS
+    PyObject *a,
+             *out = Py_None;
+    VECTOR_TYPE scalar;
+
+    if (!_parseOptionalArg("scale", "out", 2, args, nargs, kwnames, &out) || !_parseVectorTypeArg(args[1], &scalar))
+        return NULL;
+    a = args[0];
+
+    if (Matrix_Check(a)) {
+        if (out == Py_None)
+            return (PyObject *)_scalarMatrixMul((Matrix *)a, scalar);
+
+        if (!_assertOutMatrix("scale", out, ((Matrix *)a)->rows, ((Matrix *)a)->columns))
+            return NULL;
+
+        _inplaceScalarMatrixMul((Matrix *)a, scalar, (Matrix *)out);
+
+    } else if (Vector_Check(a)) {
+        if (out == Py_None)
+            return (PyObject *)_vectorMul((Vector *)a, scalar);
+
+        if (!_assertOutVector("scale", out, ((Vector *)a)->dimensions))
+            return NULL;
+
+        _inplaceVectorMul((Vector *)a, scalar, (Vector *)out);
+
+    } else {
+        PyErr_Format(PyExc_TypeError, "scale() requires a Matrix or Vector, not: \"%.400s\"", Py_TYPE(a)->tp_name);
+        return NULL;
+    }
+
+    Py_INCREF(out);
+    return out;
+}
+
+
+PyObject *matmulFunction(PyObject *self, FASTCALL_KEYWORDS_PARAMETERS) {
+/*  Multiplies a matrix by another matrix or a vector.
+
+    Inputs: self    - A pointer to the pytrix module.
+            args    - The matrix, and the matrix or vector to multiply it by, optionally followed by out.
+            nargs   - The number of positional arguments in args.
+            kwnames - The names of any keyword arguments passed.
+
+    Outputs: A new Matrix / Vector constructed by performing a * b, or out if it was given.  NULL if an error occurred.
+*/
+
+    FASTCALL_KEYWORDS_UNPACK_ARGS
+    PyObject *a,
+             *b,
+             *out = Py_None;
+
+    if (!_parseOptionalArg("matmul", "out", 2, args, nargs, kwnames, &out))
+        return NULL;
+    a = args[0];
+    b = args[1];
+
+    if (!Matrix_Check(a)) {
+        PyErr_Format(PyExc_TypeError, "matmul() requires a Matrix as its first argument, not: \"%.400s\"",
+                     Py_TYPE(a)->tp_name);
+        return NULL;
+    }
+
+    if (Matrix_Check(b)) {
+        if (out == Py_None)
+            return (PyObject *)_matrixMatrixMul((Matrix *)a, (Matrix *)b, 1);
+
+        if (((Matrix *)a)->columns != ((Matrix *)b)->rows) {
+            PyErr_SetString(PyExc_ValueError, "A * B Matrix multiplication requires A.columns = B.rows");
+            return NULL;
+        }
+
+        if (!_assertOutMatrix("matmul", out, ((Matrix *)a)->rows, ((Matrix *)b)->columns) ||
+            !_inplaceMatrixMatrixMul((Matrix *)a, (Matrix *)b, (Matrix *)out))
+            return NULL;
+
+    } else if (Vector_Check(b)) {
+        if (out == Py_None)
+            return (PyObject *)_vectorMatrixMul((Matrix *)a, (Vector *)b);
+
+        if (((Matrix *)a)->columns != ((Vector *)b)->dimensions) {
+            PyErr_SetString(PyExc_ValueError, "Matrix * Vector multiplication must have M.cols = V.dimensions");
+            return NULL;
+        }
+
+        if (!_assertOutVector("matmul", out, ((Matrix *)a)->rows) ||
+            !_inplaceVectorMatrixMul((Matrix *)a, (Vector *)b, (Vector *)out))
+            return NULL;
+
+    } else {
+        PyErr_Format(PyExc_TypeError, "matmul() requires a Matrix or Vector as its second argument, not: \"%.400s\"",
+                     Py_TYPE(b)->tp_name);
+        return NULL;
+    }
+
+    Py_INCREF(out);
+    return out;
+}
+
+
+static Matrix *_multiDotChain(Matrix **chain, Py_ssize_t *splits, Py_ssize_t n, Py_ssize_t i, Py_ssize_t j,
+                             unsigned char *isTemporary) {
+/*  Multiplies a subchain of matrices in the order given by a table of optimal splits.  Intermediate products are
+    reused as the destination of the next product where its shape allows, rather than allocating a new matrix.
+
+    Inputs: chain       - The matrices to multiply.
+            splits      - An n x n table; splits[i * n + j] is the index after which chain[i..j] should be split.
+            n           - The number of matrices in chain.
+            i           - The index of the first matrix of the subchain.
+            j           - The index of the last matrix of the subchain.
+            isTemporary - Set to whether the result is an intermediate product, which may be written to.
+
+    Outputs: A new reference to the product of chain[i..j], or NULL if an error occurred.
+*/
+
+    Matrix *left,
+           *right,
+           *product;
+    unsigned char leftTemporary,
+                  rightTemporary;
+
+    if (i == j) {
+        *isTemporary = 0;
+        Py_INCREF(chain[i]);
+        return chain[i];
+    }
+
+    if ((left = _multiDotChain(chain, splits, n, i, splits[i * n + j], &leftTemporary)) == NULL)
+        return NULL;
+    if ((right = _multiDotChain(chain, splits, n, splits[i * n + j] + 1, j, &rightTemporary)) == NULL) {
+        Py_DECREF(left);
+        return NULL;
+    }
+
+    *isTemporary = 1;
+
+    // Products with a small square matrix keep the shape of the other operand, which can then hold the result
+    if (leftTemporary && right->rows == right->columns && right->rows < MIN_STRASSEN_SIZE) {
+        product = _inplaceMatrixMatrixMul(left, right, left) ? left : NULL;
+        Py_DECREF(right);
+        if (product == NULL)
+            Py_DECREF(left);
+        return product;
+    }
+
+    if (rightTemporary && left->rows == left->columns && left->rows < MIN_STRASSEN_SIZE) {
+        product = _inplaceMatrixMatrixMul(left, right, right) ? right : NULL;
+        Py_DECREF(left);
+        if (product == NULL)
+            Py_DECREF(right);
+        return product;
+    }
+
+    product = _matrixMatrixMul(left, right, 1);
+    Py_DECREF(left);
+    Py_DECREF(right);
+    return product;
+}
+
+
+PyObject *multiDotFunction(PyObject *self, FASTCALL_PARAMETERS) {
+/*  Multiplies a chain of matrices, choosing the order of multiplication which requires the fewest scalar
+    multiplications.  The first and last items may be Vectors, which are treated as a row and a column respectively.
+
+    Inputs: self  - A pointer to the pytrix module.
+            args  - A sequence of at least 2 Matrices or Vectors.
+            nargs - The number of arguments in args.
+
+    Outputs: A Matrix, or a Vector if either end of the chain is a Vector, or a float if both are.  NULL if an error
+             occurred.
+*/
+
+    FASTCALL_UNPACK_ARGS
+    PyObject *sequence,
+             *item,
+             *result = NULL;
+    Matrix **chain = NULL,
+           *product = NULL;
+    Py_ssize_t *splits = NULL,
+               n = 0,
+               built = 0,
+               length,
+               i,
+               j,
+               k;
+    unsigned int *dims = NULL,
+                 row;
+    double *costs = NULL,
+           cost;
+    unsigned char firstVector,
+                  lastVector,
+                  isTemporary;
+
+    if (!_assertArgCount("multi_dot", nargs, 1))
+        return NULL;
+    if ((sequence = PySequence_Fast(args[0], "multi_dot() requires a sequence of Matrices")) == NULL)
+        return NULL;
+
+    if ((n = PySequence_Fast_GET_SIZE(sequence)) < 2) {
+        PyErr_SetString(PyExc_ValueError, "multi_dot() requires at least 2 operands");
+        goto cleanup;
+    }
+
+    firstVector = Vector_Check(PySequence_Fast_GET_ITEM(sequence, 0));
+    lastVector = Vector_Check(PySequence_Fast_GET_ITEM(sequence, n - 1));
+
+    chain = PyMem_Malloc(sizeof(Matrix *) * n);
+    dims = PyMem_Malloc(sizeof(unsigned int) * (n + 1));
+    costs = PyMem_Malloc(sizeof(double) * n * n);
+    splits = PyMem_Malloc(sizeof(Py_ssize_t) * n * n);
+    if (chain == NULL || dims == NULL || costs == NULL || splits == NULL) {
+        PyErr_NoMemory();
+        goto cleanup;
+    }
+
+    // Vectors at either end are multiplied as 1 x n and n x 1 matrices sharing the vector's data
+    for (built = 0; built < n; built++) {
+        item = PySequence_Fast_GET_ITEM(sequence, built);
+
+        if (Vector_Check(item) && (built == 0 || built == n - 1)) {
+            if (built == 0)
+                chain[built] = _matrixNewView(1, ((Vector *)item)->dimensions, ((Vector *)item)->data, item);
+            else
+                chain[built] = _matrixNewView(((Vector *)item)->dimensions, 1, ((Vector *)item)->data, item);
+            if (chain[built] == NULL)
+                goto cleanup;
+
+        } else if (Matrix_Check(item)) {
+            Py_INCREF(item);
+            chain[built] = (Matrix *)item;
+
+        } else {
+            PyErr_Format(PyExc_TypeError,
+                         "multi_dot() requires Matrices, optionally with a Vector at either end, not: \"%.400s\"",
+                         Py_TYPE(item)->tp_name);
+            goto cleanup;
+        }
+
+        if (built == 0) {
+            dims[0] = chain[0]->rows;
+        } else if (chain[built]->rows != dims[built]) {
+            PyErr_Format(PyExc_ValueError, "multi_dot() operand %zd has %u rows, but the previous operand has %u columns",
+                         built, chain[built]->rows, dims[built]);
+            built++;
+            goto cleanup;
+        }
+        dims[built + 1] = chain[built]->columns;
+    }
+
+    // Find the cheapest parenthesization of the chain; costs[i * n + j] is the fewest multiplications needed to compute
+    // chain[i..j]
+    for (i = 0; i < n; i++)
+        costs[i * n + i] = 0;
+
+    for (length = 1; length < n; length++) {
+        for (i = 0; i + length < n; i++) {
+            j = i + length;
+            costs[i * n + j] = -1;
+            for (k = i; k < j; k++) {
+                cost = costs[i * n + k] + costs[(k + 1) * n + j] + (double)dims[i] * dims[k + 1] * dims[j + 1];
+                if (costs[i * n + j] < 0 || cost < costs[i * n + j]) {
+                    costs[i * n + j] = cost;
+                    splits[i * n + j] = k;
+                }
+            }
+        }
+    }
+
+    if ((product = _multiDotChain(chain, splits, n, 0, n - 1, &isTemporary)) == NULL)
+        goto cleanup;
+
+    if (firstVector && lastVector) {
+        result = PyFloat_FromDouble(Matrix_GetValue(product, 0, 0));
+    } else if (firstVector) {
+        result = (PyObject *)_vectorCopy(Matrix_GetVector(product, 0));
+    } else if (lastVector) {
+        if ((result = (PyObject *)_vectorNew(product->rows)) != NULL)
+            for (row = 0; row < product->rows; row++)
+                Vector_SetValue(((Vector *)result), row, Matrix_GetValue(product, row, 0));
+    } else {
+        Py_INCREF(product);
+        result = (PyObject *)product;
+    }
+
+cleanup:
+    for (i = 0; i < built; i++)
+        Py_DECREF(chain[i]);
+    Py_XDECREF(product);
+    PyMem_Free(chain);
+    PyMem_Free(dims);
+    PyMem_Free(costs);
+    PyMem_Free(splits);
+    Py_DECREF(sequence);
+
+    return result;
+}
+
+
+static PyObject *_linearCombination(const char *name, VECTOR_TYPE *coefficients, PyObject *const *operands,
+                                    Py_ssize_t count, PyObject *out) {
+/*  Computes the sum of coefficients[i] * operands[i], where the operands are either all matrices or all vectors of the
+    same dimensions, optionally writing the result into out.
+
+    Inputs: name         - The name of the function being called, for error messages.
+            coefficients - The factor to multiply each operand by.
+            operands     - The matrices or vectors to combine.
+            count        - The number of operands; at least 1.
+            out          - Either Py_None, or a mutable Matrix / Vector to write the result into.  It may be one of
+                           the operands.
+
+    Outputs: The result of the operation; a new reference to out if one was given.  NULL if an error occurred.
+*/
+
+    VECTOR_TYPE **sources;
+    PyObject *result;
+    Py_ssize_t i;
+    unsigned int row,
+                 rows,
+                 columns;
+
+    if (Matrix_Check(operands[0])) {
+        rows = ((Matrix *)operands[0])->rows;
+        columns = ((Matrix *)operands[0])->columns;
+    } else if (Vector_Check(operands[0])) {
+        rows = 1;
+        columns = ((Vector *)operands[0])->dimensions;
+    } else {
+        PyErr_Format(PyExc_TypeError, "%s() requires Matrices or Vectors, not: \"%.400s\"", name,
+                     Py_TYPE(operands[0])->tp_name);
+        return NULL;
+    }
+
+    for (i = 1; i < count; i++) {
+        if (Py_TYPE(operands[i]) != Py_TYPE(operands[0])) {
+            PyErr_Format(PyExc_TypeError, "%s() requires either all Matrices or all Vectors, not: \"%.400s\" & "
+                         "\"%.400s\"", name, Py_TYPE(operands[0])->tp_name, Py_TYPE(operands[i])->tp_name);
+            return NULL;
+        }
+        if ((Matrix_Check(operands[i]) && !_assertMatrixDimensionsEqual((Matrix *)operands[0], (Matrix *)operands[i])) ||
+            (Vector_Check(operands[i]) && !_assertVectorDimensionsEqual((Vector *)operands[0], (Vector *)operands[i])))
+            return NULL;
+    }
+
+    if (out == Py_None) {
+        if (Matrix_Check(operands[0]))
+            result = (PyObject *)_matrixNew(rows, columns);
+        else
+            result = (PyObject *)_vectorNew(columns);
+        if (result == NULL)
+            return NULL;
+
+    } else {
+        if ((Matrix_Check(operands[0]) && !_assertOutMatrix(name, out, rows, columns)) ||
+            (Vector_Check(operands[0]) && !_assertOutVector(name, out, columns)))
+            return NULL;
+        Py_INCREF(out);
+        result = out;
+    }
+
+    if ((sources = PyMem_Malloc(sizeof(VECTOR_TYPE *) * count)) == NULL) {
+        Py_DECREF(result);
+        return PyErr_NoMemory();
+    }
+
+    if (Vector_Check(result)) {
+        for (i = 0; i < count; i++)
+            sources[i] = ((Vector *)operands[i])->data;
+        _vectorTypeArrayLinearCombination(((Vector *)result)->data, coefficients, sources, count, columns);
+
+    } else {
+        for (row = 0; row < rows; row++) {
+            for (i = 0; i < count; i++)
+                sources[i] = Matrix_GetVector(((Matrix *)operands[i]), row)->data;
+            _vectorTypeArrayLinearCombination(Matrix_GetVector(((Matrix *)result), row)->data, coefficients, sources,
+                                              count, columns);
+        }
+    }
+
+    PyMem_Free(sources);
+    return result;
+}
+
+
+PyObject *linearCombinationFunction(PyObject *self, FASTCALL_KEYWORDS_PARAMETERS) {
+/*  Computes a linear combination of matrices or vectors in a single pass, without creating intermediate objects.
+
+    Inputs: self    - A pointer to the pytrix module.
+            args    - A sequence of coefficients, and a sequence of as many matrices or vectors, optionally followed by
+                      out.
+            nargs   - The number of positional arguments in args.
+            kwnames - The names of any keyword arguments passed.
+
+    Outputs: A new Matrix / Vector holding the sum of each coefficient multiplied by its operand, or out if it was
+             given.  NULL if an error occurred.
+*/
+
+    FASTCALL_KEYWORDS_UNPACK_ARGS
+    PyObject *coefficientSequence,
+             *operandSequence,
+             *out = Py_None,
+             *result = NULL;
+    VECTOR_TYPE *coefficients = NULL;
+    Py_ssize_t count,
+               failed;
+
+    if (!_parseOptionalArg("linear_combination", "out", 2, args, nargs, kwnames, &out))
+        return NULL;
+
+    if ((coefficientSequence = PySequence_Fast(args[0], "linear_combination() requires a sequence of coefficients")) == NULL)
+        return NULL;
+    if ((operandSequence = PySequence_Fast(args[1], "linear_combination() requires a sequence of operands")) == NULL) {
+        Py_DECREF(coefficientSequence);
+        return NULL;
+    }
+
+    if ((count = PySequence_Fast_GET_SIZE(operandSequence)) != PySequence_Fast_GET_SIZE(coefficientSequence)) {
+        PyErr_Format(PyExc_ValueError, "linear_combination() given %zd coefficients for %zd operands",
+                     PySequence_Fast_GET_SIZE(coefficientSequence), count);
+        goto cleanup;
+    }
+
+    if (count == 0) {
+        PyErr_SetString(PyExc_ValueError, "linear_combination() requires at least 1 operand");
+        goto cleanup;
+    }
+
+    if ((coefficients = PyMem_Malloc(sizeof(VECTOR_TYPE) * count)) == NULL) {
+        PyErr_NoMemory();
+        goto cleanup;
+    }
+
+    if ((failed = _vectorTypeArrayFromObjects(coefficients, PySequence_Fast_ITEMS(coefficientSequence), count)) != -1) {
+        if (!PyErr_Occurred())
+            PyErr_Format(PyExc_TypeError, "linear_combination() coefficient %zd is not a number: \"%.400s\"", failed,
+                         Py_TYPE(PySequence_Fast_GET_ITEM(coefficientSequence, failed))->tp_name);
+        goto cleanup;
+    }
+
+    result = _linearCombination("linear_combination", coefficients, PySequence_Fast_ITEMS(operandSequence), count, out);
+
+cleanup:
+    PyMem_Free(coefficients);
+    Py_DECREF(coefficientSequence);
+    Py_DECREF(operandSequence);
+
+    return result;
+}
+
+
+PyObject *axpyFunction(PyObject *self, FASTCALL_KEYWORDS_PARAMETERS) {
+/*  Computes alpha * x + y in a single pass.
+
+    Inputs: self    - A pointer to the pytrix module.
+            args    - The scalar alpha, and two matrices or two vectors x & y, optionally followed by out.
+            nargs   - The number of positional arguments in args.
+            kwnames - The names of any keyword arguments passed.
+
+    Outputs: A new Matrix / Vector holding alpha * x + y, or out if it was given.  NULL if an error occurred.
+*/
+
+    FASTCALL_KEYWORDS_UNPACK_ARGS
+    PyObject *out = Py_None;
+    VECTOR_TYPE coefficients[2] = {0, 1};
+
+    if (!_parseOptionalArg("axpy", "out", 3, args, nargs, kwnames, &out) ||
+        !_parseVectorTypeArg(args[0], &coefficients[0]))
+        return NULL;
+
+    return _linearCombination("axpy", coefficients, args + 1, 2, out);
+}
@@ -0,0 +1,103 @@
+/*
+ *  Copyright (C) 2016 Warren Spencer warrenspencer27@gmail.com
+
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+static PyMemberDef KDTreeMembers[] = {
+    {"dimensions", T_UINT, offsetof(KDTree, dimensions), READONLY, "Number of dimensions of the points in the tree."},
+    {NULL} // Sentinel
+};
+
+static PySequenceMethods KDTreeSequenceMethods = {
+    (lenfunc)kdTreeLength,                      /* sq_length */
+    0,                                          /* sq_concat */
+    0,                                          /* sq_repeat */
+    0,                                          /* sq_item */
+    0,                                          /* sq_slice */
+    0,                                          /* sq_ass_item */
+    0,                                          /* sq_ass_slice */
+    0,                                          /* sq_contains */
+};
+
+static PyMethodDef KDTreeMethods[] = {
+    {"query", (PyCFunction)(void(*)(void))kdTreeQuery, METH_FASTCALL_KEYWORDS_COMPAT,
+        PyDoc_STR("query(point, k=1) -> list\n\nReturns the k points nearest to point as a list of (distance, index) "
+                  "tuples, from nearest to farthest; equally distant points are ordered by index.")},
+    {"query_batch", (PyCFunction)(void(*)(void))kdTreeQueryBatch, METH_FASTCALL_KEYWORDS_COMPAT,
+        PyDoc_STR("query_batch(points, k=1) -> list\n\nRuns query(point, k) for each of a PointCloud or sequence of "
+                  "Points, in parallel.")},
+    {"query_radius", (PyCFunction)(void(*)(void))kdTreeQueryRadius, METH_FASTCALL_COMPAT,
+        PyDoc_STR("query_radius(point, radius) -> list\n\nReturns the indices of the points within radius of point, "
+                  "in ascending order.")},
+    {"query_box", (PyCFunction)(void(*)(void))kdTreeQueryBox, METH_FASTCALL_COMPAT,
+        PyDoc_STR("query_box(lower, upper) -> list\n\nReturns the indices of the points within the axis aligned box "
+                  "with corners lower & upper, in ascending order.")},
+    {NULL}  // Sentinel
+};
+
+
+/* NOTES:
+    * KDTrees are immutable, and hold their own copy of the coordinates of the points they were built over.
+    * Points are identified by their index in the points the tree was built from.
+*/
+static PyTypeObject KDTreeType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    "pytrix.KDTree",
+    sizeof(KDTree),
+    0,                         /*tp_itemsize*/
+    (destructor)kdTreeDeInit,                         /*tp_dealloc*/
+    0,                         /*tp_print*/
+    0,                         /*tp_getattr*/
+    0,                         /*tp_setattr*/
+    0,                         /*tp_compare*/
+    0,                         /*tp_repr*/
+    0,                         /*tp_as_number*/
+    &KDTreeSequenceMethods,                         /*tp_as_sequence*/
+    0,                         /*tp_as_mapping*/
+    0,                         /*tp_hash */
+    0,                         /*tp_call*/
+    0,                         /*tp_str*/
+    0,                         /*tp_getattro*/
+    0,                         /*tp_setattro*/
+    0,                         /*tp_as_buffer*/
+    Py_TPFLAGS_DEFAULT,        /*tp_flags*/
+    "A spatial index over a set of Points, for nearest neighbour, radius & box queries.",
+    0,                     /* tp_traverse */
+    0,                     /* tp_clear */
+    0,                     /* tp_richcompare */
+    0,                     /* tp_weaklistoffset */
+    0,                     /* tp_iter */
+    0,                     /* tp_iternext */
+    KDTreeMethods,             /* tp_methods */
+    KDTreeMembers,             /* tp_members */
+    0,                         /* tp_getset */
+    0,                         /* tp_base */
+    0,                         /* tp_dict */
+    0,                         /* tp_descr_get */
+    0,                         /* tp_descr_set */
+    0,                         /* tp_dictoffset */
+    0,                         /* tp_init */
+    0,                         /* tp_alloc */
+    kdTreeNew,                 /* tp_new */
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0
+};
@@ -0,0 +1,49 @@
+/*
+ *  Copyright (C) 2016 Warren Spencer warrenspencer27@gmail.com
+
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// init.c
+static void _kdTreeSwap(KDTree *, Py_ssize_t, Py_ssize_t);
+static void _kdTreeSelect(KDTree *, Py_ssize_t, Py_ssize_t, Py_ssize_t, unsigned int);
+static unsigned int _kdTreeSpreadDimension(KDTree *, Py_ssize_t, Py_ssize_t);
+static Py_ssize_t _kdTreeSplit(KDTree *, Py_ssize_t, Py_ssize_t);
+static void _kdTreeBuild(KDTree *, Py_ssize_t, Py_ssize_t);
+static Py_ssize_t _kdTreeBuildTop(KDTree *, Py_ssize_t, Py_ssize_t, unsigned int, Py_ssize_t *, Py_ssize_t);
+static void _kdTreeBuildTask(void *, Py_ssize_t, Py_ssize_t, unsigned int);
+PyObject *kdTreeNew(PyTypeObject *, PyObject *, PyObject *);
+void kdTreeDeInit(KDTree *);
+Py_ssize_t kdTreeLength(KDTree *);
+
+// query.c
+static void _kdTreeNeighboursSiftDown(KDTreeNeighbours *, Py_ssize_t, Py_ssize_t);
+static void _kdTreeNeighboursPush(KDTreeNeighbours *, VECTOR_TYPE, Py_ssize_t);
+static void _kdTreeNeighboursSort(KDTreeNeighbours *);
+static VECTOR_TYPE _kdTreeDistance(KDTree *, Py_ssize_t, VECTOR_TYPE *);
+static void _kdTreeNearest(KDTree *, Py_ssize_t, Py_ssize_t, KDTreeNeighbours *);
+static unsigned char _kdTreeMatch(KDTreeMatches *, Py_ssize_t);
+static unsigned char _kdTreeWithin(KDTree *, Py_ssize_t, Py_ssize_t, VECTOR_TYPE *, VECTOR_TYPE, KDTreeMatches *);
+static unsigned char _kdTreeContains(KDTree *, Py_ssize_t, VECTOR_TYPE *, VECTOR_TYPE *);
+static unsigned char _kdTreeInBox(KDTree *, Py_ssize_t, Py_ssize_t, VECTOR_TYPE *, VECTOR_TYPE *, KDTreeMatches *);
+static void _kdTreeBatchTask(void *, Py_ssize_t, Py_ssize_t, unsigned int);
+static VECTOR_TYPE *_kdTreeQueryPoint(KDTree *, const char *, PyObject *);
+static unsigned char _kdTreeParseK(PyObject *, Py_ssize_t, Py_ssize_t *);
+static PyObject *_kdTreeNeighboursToList(VECTOR_TYPE *, Py_ssize_t *, Py_ssize_t);
+static int _kdTreeCompareIndices(const void *, const void *);
+static PyObject *_kdTreeMatchesToList(KDTreeMatches *);
+PyObject *kdTreeQuery(KDTree *, FASTCALL_KEYWORDS_PARAMETERS);
+PyObject *kdTreeQueryBatch(KDTree *, FASTCALL_KEYWORDS_PARAMETERS);
+PyObject *kdTreeQueryRadius(KDTree *, FASTCALL_PARAMETERS);
+PyObject *kdTreeQueryBox(KDTree *, FASTCALL_PARAMETERS);
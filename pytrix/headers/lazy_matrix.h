@@ -0,0 +1,107 @@
+/*
+ *  Copyright (C) 2016 Warren Spencer warrenspencer27@gmail.com
+
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+static PyGetSetDef LazyMatrixGetSet[] = {
+    {"rows", (getter)lazyMatrixRows, NULL, "Number of rows in the matrix the expression evaluates to.", NULL},
+    {"columns", (getter)lazyMatrixColumns, NULL, "Number of columns in the matrix the expression evaluates to.", NULL},
+    {NULL} // Sentinel
+};
+
+#if PY_MAJOR_VERSION >= 3
+static PyNumberMethods LazyMatrixNumberMethods = {
+    (binaryfunc)lazyMatrixAdd,                  /* nb_add */
+    (binaryfunc)lazyMatrixSub,                  /* nb_subtract */
+    (binaryfunc)lazyMatrixMul,                  /* nb_multiply */
+    0,                                          /* nb_remainder */
+    0,                                          /* nb_divmod */
+    0,                                          /* nb_power */
+    (unaryfunc)lazyMatrixNeg,                   /* nb_negative */
+};
+#else
+static PyNumberMethods LazyMatrixNumberMethods = {
+    (binaryfunc)lazyMatrixAdd,                  /* nb_add */
+    (binaryfunc)lazyMatrixSub,                  /* nb_subtract */
+    (binaryfunc)lazyMatrixMul,                  /* nb_multiply */
+    0,                                          /* nb_divide */
+    0,                                          /* nb_remainder */
+    0,                                          /* nb_divmod */
+    0,                                          /* nb_power */
+    (unaryfunc)lazyMatrixNeg,                   /* nb_negative */
+};
+#endif
+
+static PyMethodDef LazyMatrixMethods[] = {
+    {"evaluate", (PyCFunction)lazyMatrixEvaluate, METH_NOARGS,
+        PyDoc_STR("Evaluates the expression, returning a new Matrix.")},
+    {NULL}  /* Sentinel */
+};
+
+
+/* NOTES:
+    * LazyMatrices are nodes of an expression tree built by the arithmetic operators, and are created by pytrix.lazy.
+      Nothing is computed until evaluate() is called; sums, differences and scalings are then fused into a single pass
+      over the result, and each product, along with any scalar factors applied to it, into a single GEMM.
+*/
+static PyTypeObject LazyMatrixType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    "pytrix.LazyMatrix",
+    sizeof(LazyMatrix),
+    0,                         /*tp_itemsize*/
+    (destructor)lazyMatrixDeInit,                         /*tp_dealloc*/
+    0,                         /*tp_print*/
+    0,                         /*tp_getattr*/
+    0,                         /*tp_setattr*/
+    0,                         /*tp_compare*/
+    0,                         /*tp_repr*/
+    &LazyMatrixNumberMethods,                         /*tp_as_number*/
+    0,                         /*tp_as_sequence*/
+    0,                         /*tp_as_mapping*/
+    0,                         /*tp_hash */
+    0,                         /*tp_call*/
+    0,                         /*tp_str*/
+    0,                         /*tp_getattro*/
+    0,                         /*tp_setattro*/
+    0,                         /*tp_as_buffer*/
+    Py_TPFLAGS_DEFAULT | Py_TPFLAGS_CHECKTYPES,        /*tp_flags*/
+    "An unevaluated Matrix expression.",
+    0,                     /* tp_traverse */
+    0,                     /* tp_clear */
+    0,                     /* tp_richcompare */
+    0,                     /* tp_weaklistoffset */
+    0,                     /* tp_iter */
+    0,                     /* tp_iternext */
+    LazyMatrixMethods,             /* tp_methods */
+    0,                         /* tp_members */
+    LazyMatrixGetSet,              /* tp_getset */
+    0,                         /* tp_base */
+    0,                         /* tp_dict */
+    0,                         /* tp_descr_get */
+    0,                         /* tp_descr_set */
+    0,                         /* tp_dictoffset */
+    0,                         /* tp_init */
+    0,                         /* tp_alloc */
+    0,                         /* tp_new */
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0
+};
@@ -0,0 +1,34 @@
+/*
+ *  Copyright (C) 2016 Warren Spencer warrenspencer27@gmail.com
+
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// lazy.c
+static LazyMatrix *_lazyMatrixNode(unsigned char, unsigned int, unsigned int, PyObject *, PyObject *, VECTOR_TYPE);
+void lazyMatrixDeInit(LazyMatrix *);
+static LazyMatrix *_lazyMatrixOperand(PyObject *);
+PyObject *lazyFunction(PyObject *, FASTCALL_PARAMETERS);
+static PyObject *_lazyMatrixAddOrSub(PyObject *, PyObject *, unsigned char);
+PyObject *lazyMatrixAdd(PyObject *, PyObject *);
+PyObject *lazyMatrixSub(PyObject *, PyObject *);
+PyObject *lazyMatrixMul(PyObject *, PyObject *);
+PyObject *lazyMatrixNeg(LazyMatrix *);
+static LazyMatrix *_lazyMatrixUnscaled(LazyMatrix *, VECTOR_TYPE *);
+static unsigned char _lazyMatrixAppendTerm(LazyTerm **, Py_ssize_t *, Py_ssize_t *, VECTOR_TYPE, Matrix *, Matrix *);
+static unsigned char _lazyMatrixLower(LazyMatrix *, VECTOR_TYPE, LazyTerm **, Py_ssize_t *, Py_ssize_t *);
+static Matrix *_lazyMatrixEvaluate(LazyMatrix *);
+PyObject *lazyMatrixEvaluate(LazyMatrix *);
+PyObject *lazyMatrixRows(LazyMatrix *, void *);
+PyObject *lazyMatrixColumns(LazyMatrix *, void *);
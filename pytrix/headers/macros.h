@@ -19,6 +19,9 @@
 #define Point_Check(op) (Py_TYPE(op) == &PointType)
 #define Point_GetValue(point, idx) (*((point->data) + idx))
 #define Point_SetValue(point, idx, val) Point_GetValue(point, idx) = val
+#define DISTANCE_EUCLIDEAN 0
+#define DISTANCE_SQEUCLIDEAN 1
+#define DISTANCE_MANHATTAN 2
 
 
 // Vector Macros
@@ -34,5 +37,48 @@
 #define Matrix_GetValue(matrix, row, col) (Vector_GetValue(Matrix_GetVector(matrix, row), col))
 #define Matrix_SetValue(matrix, row, col, val) (Vector_SetValue(Matrix_GetVector(matrix, row), col, val))
 
+
+// Builder Macros
+#define VectorBuilder_Check(op) (Py_TYPE(op) == &VectorBuilderType)
+#define MatrixBuilder_Check(op) (Py_TYPE(op) == &MatrixBuilderType)
+
+
+// VectorArray Macros
+#define VectorArray_Check(op) (Py_TYPE(op) == &VectorArrayType)
+#define PointCloud_Check(op) (Py_TYPE(op) == &PointCloudType)
+#define VectorArray_Component(array, d) ((array)->data + (size_t)(d) * (array)->count)
+
+
+// KDTree Macros
+#define KDTree_Check(op) (Py_TYPE(op) == &KDTreeType)
+#define KDTree_GetPoint(tree, i) ((tree)->points + (size_t)(i) * (tree)->dimensions)
+#define SpatialGrid_GetPoint(grid, id) ((grid)->points + (size_t)(id) * (grid)->dimensions)
+// Whether a point at squared distance d1 with index i1 is nearer than one at d2 with index i2; ties go to the lower
+// index
+#define KDTree_Nearer(d1, i1, d2, i2) ((d1) < (d2) || ((d1) == (d2) && (i1) < (i2)))
+
+
+// Quaternion Macros
+#define Quaternion_Check(op) (Py_TYPE(op) == &QuaternionType)
+
+
+// MatrixBatch Macros
+#define MatrixBatch_Check(op) (Py_TYPE(op) == &MatrixBatchType)
+#define MatrixBatch_Values(batch, k) ((batch)->data + (size_t)(k) * (batch)->count)
+
+
+// LazyMatrix Macros
+#define LazyMatrix_Check(op) (Py_TYPE(op) == &LazyMatrixType)
+#define LAZY_LEAF 0
+#define LAZY_ADD 1
+#define LAZY_SUB 2
+#define LAZY_SCALE 3
+#define LAZY_MATMUL 4
+
+
+// SharedBuffer Macros
+#define SharedBuffer_GetRow(buffer, row) \
+    ((VECTOR_TYPE *)(buffer->data + SHARED_BUFFER_HEADER_SIZE) + (size_t)(row) * buffer->columns)
+
 // Other Macros
 #define Compatible_Input_Sequence_Check(op) (PyList_CheckExact(op) || PyTuple_CheckExact(op))
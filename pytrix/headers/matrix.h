@@ -18,6 +18,13 @@
 static PyMemberDef MatrixMembers[] = {
     {"rows", T_UINT, offsetof(Matrix, rows), READONLY, "Number of rows in the matrix."},
     {"columns", T_UINT, offsetof(Matrix, columns), READONLY, "Number of columns in the matrix."},
+    {"mutable", T_BOOL, offsetof(Matrix, isMutable), READONLY, "Whether the matrix may be used as an out argument."},
+    {NULL} // Sentinel
+};
+
+static PyGetSetDef MatrixGetSet[] = {
+    {"shared_name", (getter)matrixSharedName, NULL,
+        "Name of the shared memory segment holding this matrix, or None if it is not held in shared memory.", NULL},
     {NULL} // Sentinel
 };
 
@@ -65,14 +72,17 @@ static PySequenceMethods MatrixSequenceMethods = {
 static PyMethodDef MatrixMethods[] = {
     {"copy", (PyCFunction)matrixCopy, METH_NOARGS,
         PyDoc_STR("Returns a new copy of this Matrix.")},
-    {"row", (PyCFunction)matrixRow, METH_VARARGS,
+    {"row", (PyCFunction)(void(*)(void))matrixRow, METH_FASTCALL_COMPAT,
         PyDoc_STR("Returns the ith row of this Matrix as a Vector.")},
-    {"column", (PyCFunction)matrixColumn, METH_VARARGS,
+    {"column", (PyCFunction)(void(*)(void))matrixColumn, METH_FASTCALL_COMPAT,
         PyDoc_STR("Returns the ith column of this Matrix as a Vector.")},
     {"transpose", (PyCFunction)matrixTranspose, METH_NOARGS,
         PyDoc_STR("Constructs a new Matrix object, from the transpose of this Matrix.")},
-    {"permute", (PyCFunction)matrixPermute, METH_VARARGS,
+    {"permute", (PyCFunction)(void(*)(void))matrixPermute, METH_FASTCALL_COMPAT,
         PyDoc_STR("Constructs a new Matrix from the permutation of two rows of this Matrix.")},
+    {"apply", (PyCFunction)(void(*)(void))matrixApply, METH_FASTCALL_KEYWORDS_COMPAT,
+        PyDoc_STR("apply(vectors, out=None)\n\nMultiplies this Matrix by each of a sequence of Vectors, or a buffer of "
+                  "packed vectors, returning a Matrix whose rows are the results, or writing them into the buffer out.")},
     {"isSymmetrical", (PyCFunction)matrixIsSymmetrical, METH_NOARGS,
         PyDoc_STR("Determines whether or not this Matrix is symmetrical.")},
     {"isIdentity", (PyCFunction)matrixIsIdentity, METH_NOARGS,
@@ -87,7 +97,11 @@ static PyMethodDef MatrixMethods[] = {
         PyDoc_STR("Determines the trace of this matrix.")},
     {"determinant", (PyCFunction)matrixDeterminant, METH_NOARGS,
         PyDoc_STR("Determines the determinant of this matrix.")},
-    {"_strassenMul", (PyCFunction)matrixStrassenMul, METH_VARARGS,
+    {"det_exact", (PyCFunction)matrixDetExact, METH_NOARGS,
+        PyDoc_STR("Determines the exact determinant of this matrix of integers, as an int.")},
+    {"rank_exact", (PyCFunction)matrixRankExact, METH_NOARGS,
+        PyDoc_STR("Determines the exact rank of this matrix of integers.")},
+    {"_strassenMul", (PyCFunction)(void(*)(void))matrixStrassenMul, METH_FASTCALL_COMPAT,
         PyDoc_STR("Multiplies this matrix with another matrix using the Strassen-Winograd algorithm. Requires that the "
                   "second argument be an integer, which will be used to stop the recursive Strassen algorithm, and use "
                   "the naive O(n^3) algorithm to process the final recursive matrices")},
@@ -109,6 +123,41 @@ static PyMethodDef MatrixMethods[] = {
         PyDoc_STR("Factor this matrix into four new matrices P, L, D & U such that self = P * L * D * U with P being "
                   "a permutation matrix, L being lower triangular, D being a diagonal matrix, and U being upper "
                   "triangular.")},
+    {"zeros", (PyCFunction)(void(*)(void))matrixZeros, METH_FASTCALL_KEYWORDS_COMPAT | METH_CLASS,
+        PyDoc_STR("zeros(rows, columns, mutable=False) -> Matrix\n\nCreates a matrix filled with 0s.  Mutable matrices "
+                  "may be written to as the out argument of pytrix's arithmetic functions, and are unhashable.")},
+    {"save", (PyCFunction)matrixSave, METH_O,
+        PyDoc_STR("Writes this matrix to a file in numpy's .npy format.")},
+    {"load", (PyCFunction)matrixLoad, METH_VARARGS | METH_KEYWORDS | METH_CLASS,
+        PyDoc_STR("load(path, mmap=False) -> Matrix\n\nLoads a matrix from a 2 dimensional float64 .npy file.  If mmap "
+                  "is True the matrix references the file's pages directly rather than reading them into memory; pages "
+                  "are faulted in lazily as they are accessed.")},
+    {"frombytes", (PyCFunction)(void(*)(void))matrixFromBytes, METH_FASTCALL_COMPAT | METH_CLASS,
+        PyDoc_STR("frombytes(data, rows, columns) -> Matrix\n\nCreates a matrix from a buffer of native doubles laid out "
+                  "row by row.")},
+    {"to_shared", (PyCFunction)matrixToShared, METH_NOARGS,
+        PyDoc_STR("Creates a copy of this matrix held in a new shared memory segment, which other processes can attach "
+                  "to by name using Matrix.from_shared.  The segment is unlinked once the returned matrix and all of "
+                  "its rows have been freed.")},
+    {"from_shared", (PyCFunction)matrixFromShared, METH_O | METH_CLASS,
+        PyDoc_STR("from_shared(name) -> Matrix\n\nCreates a matrix referencing a shared memory segment created by "
+                  "Matrix.to_shared, without copying it.")},
+    {"from_text", (PyCFunction)matrixFromText, METH_VARARGS | METH_KEYWORDS | METH_CLASS,
+        PyDoc_STR("from_text(source, delimiter=None) -> Matrix\n\nParses a matrix from text containing one row per "
+                  "line.  source is either the path of a file, which is streamed, or a bytes-like object containing "
+                  "the text.  Values are separated by delimiter, or by whitespace if delimiter is None.")},
+    {"from_csv", (PyCFunction)matrixFromCsv, METH_VARARGS | METH_KEYWORDS | METH_CLASS,
+        PyDoc_STR("from_csv(source, delimiter=',') -> Matrix\n\nParses a matrix from comma separated values.  See "
+                  "Matrix.from_text.")},
+    {"to_text", (PyCFunction)matrixToText, METH_VARARGS | METH_KEYWORDS,
+        PyDoc_STR("to_text(path=None, delimiter=' ') -> str\n\nFormats this matrix as text, one row per line.  If "
+                  "path is given the text is written to that file instead of being returned.")},
+    {"tobytes", (PyCFunction)matrixToBytes, METH_NOARGS,
+        PyDoc_STR("Returns the contents of this matrix as a bytes object of native doubles, laid out row by row.")},
+    {"tolist", (PyCFunction)matrixToList, METH_NOARGS,
+        PyDoc_STR("Returns the contents of this matrix as a list of rows, each a list of floats.")},
+    {"__reduce_ex__", (PyCFunction)(void(*)(void))matrixReduceEx, METH_FASTCALL_COMPAT,
+        PyDoc_STR("Helper for pickle.")},
     {NULL}  /* Sentinel */
 };
 
@@ -130,7 +179,7 @@ static PyTypeObject MatrixType = {
     &MatrixNumberMethods,                         /*tp_as_number*/
     &MatrixSequenceMethods,                         /*tp_as_sequence*/
     0,                         /*tp_as_mapping*/
-    0,                         /*tp_hash */
+    (hashfunc)matrixHash,                         /*tp_hash */
     0,                         /*tp_call*/
     (reprfunc)matrixStr,                         /*tp_str*/
     0,                         /*tp_getattro*/
@@ -146,7 +195,7 @@ static PyTypeObject MatrixType = {
     0,                     /* tp_iternext */
     MatrixMethods,             /* tp_methods */
     MatrixMembers,             /* tp_members */
-    0,                         /* tp_getset */
+    MatrixGetSet,              /* tp_getset */
     0,                         /* tp_base */
     0,                         /* tp_dict */
     0,                         /* tp_descr_get */
@@ -0,0 +1,113 @@
+/*
+ *  Copyright (C) 2016 Warren Spencer warrenspencer27@gmail.com
+
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+static PyMemberDef MatrixBatchMembers[] = {
+    {"rows", T_UINT, offsetof(MatrixBatch, rows), READONLY, "Number of rows of each matrix."},
+    {"columns", T_UINT, offsetof(MatrixBatch, columns), READONLY, "Number of columns of each matrix."},
+    {NULL} // Sentinel
+};
+
+static PyNumberMethods MatrixBatchNumberMethods = {
+    0,
+    0,
+    (binaryfunc)matrixBatchMul,
+};
+
+static PySequenceMethods MatrixBatchSequenceMethods = {
+    (lenfunc)matrixBatchLength,                 /* sq_length */
+    0,                                          /* sq_concat */
+    0,                                          /* sq_repeat */
+    (ssizeargfunc)matrixBatchItem,              /* sq_item */
+    0,                                          /* sq_slice */
+    0,                                          /* sq_ass_item */
+    0,                                          /* sq_ass_slice */
+    0,                                          /* sq_contains */
+};
+
+static PyMethodDef MatrixBatchMethods[] = {
+    {"frombytes", (PyCFunction)(void(*)(void))matrixBatchFromBytes, METH_FASTCALL_COMPAT | METH_CLASS,
+        PyDoc_STR("frombytes(data, rows, columns) -> MatrixBatch\n\n"
+                  "Creates a batch from a buffer of native doubles holding each matrix in turn, laid out row by row.")},
+    {"tobytes", (PyCFunction)matrixBatchToBytes, METH_NOARGS,
+        PyDoc_STR("Returns each matrix in turn, laid out row by row, as a bytes object of native doubles.")},
+    {"determinant", (PyCFunction)matrixBatchDeterminant, METH_NOARGS,
+        PyDoc_STR("Returns a Vector of the determinant of each matrix.")},
+    {"inverse", (PyCFunction)matrixBatchInverse, METH_NOARGS,
+        PyDoc_STR("Returns a MatrixBatch of the inverse of each matrix.")},
+    {"solve", (PyCFunction)matrixBatchSolve, METH_O,
+        PyDoc_STR("solve(b) -> VectorArray\n\n"
+                  "Solves Ax = b for each matrix A, given a VectorArray of one Vector b for each matrix, or a single "
+                  "Vector b for every matrix.")},
+    {NULL}  // Sentinel
+};
+
+
+/* NOTES:
+    * MatrixBatches are immutable; when operations are performed on them new MatrixBatches are created.
+    * Values are stored batch-major (value 0 of every matrix, then value 1 of every matrix, and so on) so that the
+      kernels run over contiguous memory across the batch.  Indexing gathers a matrix into a new Matrix.
+*/
+static PyTypeObject MatrixBatchType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    "pytrix.MatrixBatch",
+    sizeof(MatrixBatch),
+    0,                         /*tp_itemsize*/
+    (destructor)matrixBatchDeInit,                         /*tp_dealloc*/
+    0,                         /*tp_print*/
+    0,                         /*tp_getattr*/
+    0,                         /*tp_setattr*/
+    0,                         /*tp_compare*/
+    0,                         /*tp_repr*/
+    &MatrixBatchNumberMethods,                         /*tp_as_number*/
+    &MatrixBatchSequenceMethods,                         /*tp_as_sequence*/
+    0,                         /*tp_as_mapping*/
+    PyObject_HashNotImplemented,                         /*tp_hash */
+    0,                         /*tp_call*/
+    0,                         /*tp_str*/
+    0,                         /*tp_getattro*/
+    0,                         /*tp_setattro*/
+    0,                         /*tp_as_buffer*/
+    Py_TPFLAGS_DEFAULT | Py_TPFLAGS_CHECKTYPES,        /*tp_flags*/
+    "Object representing a batch of matrices of the same shape.",
+    0,                     /* tp_traverse */
+    0,                     /* tp_clear */
+    0,                     /* tp_richcompare */
+    0,                     /* tp_weaklistoffset */
+    0,                     /* tp_iter */
+    0,                     /* tp_iternext */
+    MatrixBatchMethods,             /* tp_methods */
+    MatrixBatchMembers,             /* tp_members */
+    0,                         /* tp_getset */
+    0,                         /* tp_base */
+    0,                         /* tp_dict */
+    0,                         /* tp_descr_get */
+    0,                         /* tp_descr_set */
+    0,                         /* tp_dictoffset */
+    0,                         /* tp_init */
+    0,                         /* tp_alloc */
+    matrixBatchNew,                 /* tp_new */
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0
+};
@@ -0,0 +1,42 @@
+/*
+ *  Copyright (C) 2016 Warren Spencer warrenspencer27@gmail.com
+
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+// init.c
+MatrixBatch *_matrixBatchNew(Py_ssize_t, unsigned int, unsigned int);
+PyObject *matrixBatchNew(PyTypeObject *, PyObject *, PyObject *);
+void matrixBatchDeInit(MatrixBatch *);
+PyObject *matrixBatchFromBytes(PyObject *, FASTCALL_PARAMETERS);
+PyObject *matrixBatchToBytes(MatrixBatch *);
+
+// operations.c
+Py_ssize_t matrixBatchLength(MatrixBatch *);
+PyObject *matrixBatchItem(MatrixBatch *, Py_ssize_t);
+static void _matrixBatchProductTask(void *, Py_ssize_t, Py_ssize_t, unsigned int);
+PyObject *matrixBatchMul(PyObject *, PyObject *);
+static VECTOR_TYPE _matrixBatchFactorLU(VECTOR_TYPE *, unsigned int, unsigned int *);
+static void _matrixBatchSolveLU(VECTOR_TYPE *, unsigned int, unsigned int *, VECTOR_TYPE *);
+static VECTOR_TYPE *_matrixBatchGather(MatrixBatchFactor *, Py_ssize_t, unsigned int);
+static VECTOR_TYPE _matrixBatchDeterminantLU(MatrixBatchFactor *, Py_ssize_t, unsigned int);
+static unsigned char _matrixBatchInverseLU(MatrixBatchFactor *, Py_ssize_t, unsigned int);
+static void _matrixBatchDeterminantTask(void *, Py_ssize_t, Py_ssize_t, unsigned int);
+static void _matrixBatchInverseTask(void *, Py_ssize_t, Py_ssize_t, unsigned int);
+static void _matrixBatchSolveTask(void *, Py_ssize_t, Py_ssize_t, unsigned int);
+static unsigned char _matrixBatchFactor(MatrixBatch *, const char *, ParallelTask, MatrixBatchFactor *);
+PyObject *matrixBatchDeterminant(MatrixBatch *);
+PyObject *matrixBatchInverse(MatrixBatch *);
+PyObject *matrixBatchSolve(MatrixBatch *, PyObject *);
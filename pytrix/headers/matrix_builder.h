@@ -0,0 +1,152 @@
+/*
+ *  Copyright (C) 2016 Warren Spencer warrenspencer27@gmail.com
+
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+static PyGetSetDef MatrixBuilderGetSet[] = {
+    {"rows", (getter)matrixBuilderRows, NULL, "Number of rows in the matrix being built.", NULL},
+    {"columns", (getter)matrixBuilderColumns, NULL, "Number of columns in the matrix being built.", NULL},
+    {NULL} // Sentinel
+};
+
+// Only the in-place operators are implemented; a builder is never the result of an operation
+#if PY_MAJOR_VERSION >= 3
+static PyNumberMethods MatrixBuilderNumberMethods = {
+    0,                                          /* nb_add */
+    0,                                          /* nb_subtract */
+    0,                                          /* nb_multiply */
+    0,                                          /* nb_remainder */
+    0,                                          /* nb_divmod */
+    0,                                          /* nb_power */
+    0,                                          /* nb_negative */
+    0,                                          /* nb_positive */
+    0,                                          /* nb_absolute */
+    0,                                          /* nb_bool */
+    0,                                          /* nb_invert */
+    0,                                          /* nb_lshift */
+    0,                                          /* nb_rshift */
+    0,                                          /* nb_and */
+    0,                                          /* nb_xor */
+    0,                                          /* nb_or */
+    0,                                          /* nb_int */
+    0,                                          /* nb_reserved */
+    0,                                          /* nb_float */
+    (binaryfunc)matrixBuilderInplaceAdd,        /* nb_inplace_add */
+    (binaryfunc)matrixBuilderInplaceSub,        /* nb_inplace_subtract */
+    (binaryfunc)matrixBuilderInplaceMul,        /* nb_inplace_multiply */
+};
+#else
+static PyNumberMethods MatrixBuilderNumberMethods = {
+    0,                                          /* nb_add */
+    0,                                          /* nb_subtract */
+    0,                                          /* nb_multiply */
+    0,                                          /* nb_divide */
+    0,                                          /* nb_remainder */
+    0,                                          /* nb_divmod */
+    0,                                          /* nb_power */
+    0,                                          /* nb_negative */
+    0,                                          /* nb_positive */
+    0,                                          /* nb_absolute */
+    0,                                          /* nb_nonzero */
+    0,                                          /* nb_invert */
+    0,                                          /* nb_lshift */
+    0,                                          /* nb_rshift */
+    0,                                          /* nb_and */
+    0,                                          /* nb_xor */
+    0,                                          /* nb_or */
+    0,                                          /* nb_coerce */
+    0,                                          /* nb_int */
+    0,                                          /* nb_long */
+    0,                                          /* nb_float */
+    0,                                          /* nb_oct */
+    0,                                          /* nb_hex */
+    (binaryfunc)matrixBuilderInplaceAdd,        /* nb_inplace_add */
+    (binaryfunc)matrixBuilderInplaceSub,        /* nb_inplace_subtract */
+    (binaryfunc)matrixBuilderInplaceMul,        /* nb_inplace_multiply */
+};
+#endif
+
+static PyMappingMethods MatrixBuilderMappingMethods = {
+    0,                                          /* mp_length */
+    (binaryfunc)matrixBuilderSubscript,         /* mp_subscript */
+    (objobjargproc)matrixBuilderAssSubscript,   /* mp_ass_subscript */
+};
+
+static PyMethodDef MatrixBuilderMethods[] = {
+    {"swap_rows", (PyCFunction)(void(*)(void))matrixBuilderSwapRows, METH_FASTCALL_COMPAT,
+        PyDoc_STR("swap_rows(a, b)\n\nSwaps rows a & b of the matrix being built.")},
+    {"scale_row", (PyCFunction)(void(*)(void))matrixBuilderScaleRow, METH_FASTCALL_COMPAT,
+        PyDoc_STR("scale_row(row, factor)\n\nMultiplies a row of the matrix being built by factor.")},
+    {"add_row", (PyCFunction)(void(*)(void))matrixBuilderAddRow, METH_FASTCALL_COMPAT,
+        PyDoc_STR("add_row(dst, src, factor)\n\nAdds row src multiplied by factor to row dst of the matrix being built.")},
+    {"freeze", (PyCFunction)matrixBuilderFreeze, METH_NOARGS,
+        PyDoc_STR("Returns the built Matrix without copying it.  The builder cannot be used afterwards.")},
+    {NULL}  /* Sentinel */
+};
+
+
+/* NOTES:
+    * MatrixBuilders own a mutable matrix which they modify in place, until freeze() hands it over as an ordinary
+      immutable Matrix.
+*/
+static PyTypeObject MatrixBuilderType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    "pytrix.MatrixBuilder",
+    sizeof(MatrixBuilder),
+    0,                         /*tp_itemsize*/
+    (destructor)matrixBuilderDeInit,                         /*tp_dealloc*/
+    0,                         /*tp_print*/
+    0,                         /*tp_getattr*/
+    0,                         /*tp_setattr*/
+    0,                         /*tp_compare*/
+    0,                         /*tp_repr*/
+    &MatrixBuilderNumberMethods,                         /*tp_as_number*/
+    0,                         /*tp_as_sequence*/
+    &MatrixBuilderMappingMethods,                         /*tp_as_mapping*/
+    PyObject_HashNotImplemented,                         /*tp_hash */
+    0,                         /*tp_call*/
+    (reprfunc)matrixBuilderStr,                         /*tp_str*/
+    0,                         /*tp_getattro*/
+    0,                         /*tp_setattro*/
+    0,                         /*tp_as_buffer*/
+    Py_TPFLAGS_DEFAULT | Py_TPFLAGS_CHECKTYPES,        /*tp_flags*/
+    "A mutable Matrix, modified in place and then frozen into an immutable Matrix.",
+    0,                     /* tp_traverse */
+    0,                     /* tp_clear */
+    0,                     /* tp_richcompare */
+    0,                     /* tp_weaklistoffset */
+    0,                     /* tp_iter */
+    0,                     /* tp_iternext */
+    MatrixBuilderMethods,             /* tp_methods */
+    0,                         /* tp_members */
+    MatrixBuilderGetSet,              /* tp_getset */
+    0,                         /* tp_base */
+    0,                         /* tp_dict */
+    0,                         /* tp_descr_get */
+    0,                         /* tp_descr_set */
+    0,                         /* tp_dictoffset */
+    0,                         /* tp_init */
+    0,                         /* tp_alloc */
+    matrixBuilderNew,                 /* tp_new */
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0
+};
@@ -0,0 +1,36 @@
+/*
+ *  Copyright (C) 2016 Warren Spencer warrenspencer27@gmail.com
+
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// builder.c
+PyObject *matrixBuilderNew(PyTypeObject *, PyObject *, PyObject *);
+void matrixBuilderDeInit(MatrixBuilder *);
+static Matrix *_matrixBuilderMatrix(MatrixBuilder *);
+static Matrix *_matrixBuilderOperand(PyObject *);
+static unsigned char _matrixBuilderRowArg(Matrix *, PyObject *, unsigned int *);
+static unsigned char _matrixBuilderKey(Matrix *, PyObject *, unsigned int *, unsigned int *);
+PyObject *matrixBuilderSubscript(MatrixBuilder *, PyObject *);
+int matrixBuilderAssSubscript(MatrixBuilder *, PyObject *, PyObject *);
+PyObject *matrixBuilderInplaceAdd(MatrixBuilder *, PyObject *);
+PyObject *matrixBuilderInplaceSub(MatrixBuilder *, PyObject *);
+PyObject *matrixBuilderInplaceMul(MatrixBuilder *, PyObject *);
+PyObject *matrixBuilderSwapRows(MatrixBuilder *, FASTCALL_PARAMETERS);
+PyObject *matrixBuilderScaleRow(MatrixBuilder *, FASTCALL_PARAMETERS);
+PyObject *matrixBuilderAddRow(MatrixBuilder *, FASTCALL_PARAMETERS);
+PyObject *matrixBuilderFreeze(MatrixBuilder *);
+PyObject *matrixBuilderRows(MatrixBuilder *, void *);
+PyObject *matrixBuilderColumns(MatrixBuilder *, void *);
+PyObject *matrixBuilderStr(MatrixBuilder *);
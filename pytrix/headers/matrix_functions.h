@@ -17,28 +17,34 @@
 
 // init.c
 static void _freeMatrixData(Matrix *);
-int matrixInit(Matrix *, PyObject *);
+static int _matrixInitFromArray(Matrix *, PyObject *const *, Py_ssize_t);
+int matrixInit(Matrix *, PyObject *, PyObject *);
+#ifdef HAVE_TYPE_VECTORCALL
+PyObject *matrixVectorcall(PyObject *, PyObject *const *, size_t, PyObject *);
+#endif
+PyObject *matrixZeros(PyObject *, FASTCALL_KEYWORDS_PARAMETERS);
 void matrixDeInit(Matrix *);
 
 // iter.c
 PyObject *matrixIter(Matrix *);
 
 // operations.c
-PyObject *matrixStr(Matrix *);
 PyObject *matrixCopy(PyObject *);
 PyObject *matrixItem(PyObject *, Py_ssize_t);
 PyObject *matrixAdd(PyObject *, PyObject *);
 PyObject *matrixSub(PyObject *, PyObject *);
 PyObject *matrixMul(PyObject *, PyObject *);
-PyObject *matrixStrassenMul(PyObject *, PyObject *);
+PyObject *matrixStrassenMul(PyObject *, FASTCALL_PARAMETERS);
 PyObject *matrixNaiveMul(PyObject *, PyObject *);
 PyObject *matrixNeg(PyObject *);
 int matrixTrue(Matrix *);
 PyObject *matrixRichCmp(PyObject *, PyObject *, int);
+Py_hash_t matrixHash(Matrix *);
 PyObject *matrixTranspose(PyObject *);
-PyObject *matrixRow(PyObject *, PyObject *);
-PyObject *matrixColumn(PyObject *, PyObject *);
-PyObject *matrixPermute(PyObject *, PyObject *);
+PyObject *matrixRow(PyObject *, FASTCALL_PARAMETERS);
+PyObject *matrixColumn(PyObject *, FASTCALL_PARAMETERS);
+PyObject *matrixPermute(PyObject *, FASTCALL_PARAMETERS);
+PyObject *matrixApply(Matrix *, FASTCALL_KEYWORDS_PARAMETERS);
 PyObject *matrixGaussianElim(PyObject *);
 PyObject *matrixFactorLU(PyObject *);
 PyObject *matrixFactorLDU(PyObject *);
@@ -55,6 +61,11 @@ PyObject *matrixIsInvertible(PyObject *);
 // utils.c
 Matrix *_matrixNewBlank(unsigned int, unsigned int);
 Matrix *_matrixNew(unsigned int, unsigned int);
+Matrix *_matrixNewView(unsigned int, unsigned int, VECTOR_TYPE *, PyObject *);
+Matrix *_matrixNewContiguous(unsigned int, unsigned int);
+void _matrixApplyTransposed(VECTOR_TYPE *, unsigned int, unsigned int, VECTOR_TYPE **, Py_ssize_t, VECTOR_TYPE *,
+                            VECTOR_TYPE *);
+Matrix *_matrixFromBuffer(Py_buffer *, unsigned int, unsigned int);
 void _matrixCopyData(Matrix *, Matrix *);
 Matrix *_matrixCopy(Matrix *);
 void _matrixInitBlank(Matrix *);
@@ -62,11 +73,16 @@ unsigned char _matrixInitIdentity(Matrix *, unsigned char);
 unsigned char _assertMatrix(PyObject *);
 unsigned char _assertMatrixDimensionsEqual(Matrix *, Matrix *);
 unsigned char _matricesEqual(Matrix *, Matrix *);
+void _inplaceMatrixAdd(Matrix *, Matrix *, Matrix *);
+void _inplaceMatrixSub(Matrix *, Matrix *, Matrix *);
+void _inplaceScalarMatrixMul(Matrix *, VECTOR_TYPE, Matrix *);
 Matrix *_matrixAdd(Matrix *, Matrix *);
 Matrix *_matrixSub(Matrix *, Matrix *);
 Matrix *_scalarMatrixMul(Matrix *, VECTOR_TYPE);
+unsigned char _inplaceVectorMatrixMul(Matrix *, Vector *, Vector *);
 Vector *_vectorMatrixMul(Matrix *, Vector *);
 unsigned char _inplaceMatrixMatrixMul(Matrix *, Matrix *, Matrix *);
+void _inplaceMatrixGemm(VECTOR_TYPE, Matrix *, Matrix *, Matrix *);
 Matrix *_matrixMatrixMul(Matrix *, Matrix *, unsigned char);
 Matrix *_matrixNeg(Matrix *);
 Matrix *_matrixTranspose(Matrix *);
@@ -80,3 +96,46 @@ Matrix *_matrixInverse(Matrix *);
 
 // strassen.c
 Matrix *strassenWinogradMatrixMatrixMul(Matrix *, Matrix *, unsigned int);
+
+// small.c
+void _smallMatrixPack(Matrix *, VECTOR_TYPE *);
+static void _smallDeterminant2(const VECTOR_TYPE *, Py_ssize_t, Py_ssize_t, VECTOR_TYPE *);
+static void _smallInverse2(const VECTOR_TYPE *, VECTOR_TYPE *, Py_ssize_t, Py_ssize_t, VECTOR_TYPE *);
+static void _smallDeterminant3(const VECTOR_TYPE *, Py_ssize_t, Py_ssize_t, VECTOR_TYPE *);
+static void _smallInverse3(const VECTOR_TYPE *, VECTOR_TYPE *, Py_ssize_t, Py_ssize_t, VECTOR_TYPE *);
+static void _smallDeterminant4(const VECTOR_TYPE *, Py_ssize_t, Py_ssize_t, VECTOR_TYPE *);
+static void _smallInverse4(const VECTOR_TYPE *, VECTOR_TYPE *, Py_ssize_t, Py_ssize_t, VECTOR_TYPE *);
+static void _smallValuesInRange(const VECTOR_TYPE *, Py_ssize_t, Py_ssize_t, unsigned int, unsigned char *);
+static unsigned char _smallDeterminantUsable(const VECTOR_TYPE *, Py_ssize_t, unsigned int, VECTOR_TYPE);
+static void _smallInverseUsable(const VECTOR_TYPE *, const VECTOR_TYPE *, Py_ssize_t, Py_ssize_t, unsigned int,
+                                const VECTOR_TYPE *, unsigned char *);
+unsigned char _smallMatrixInverse(Matrix *, VECTOR_TYPE *);
+PyObject *batchInverseFunction(PyObject *, FASTCALL_PARAMETERS);
+
+// exact.c
+static unsigned char _bareissInt64(int64_t *, unsigned int, unsigned int, BareissState *);
+static unsigned char _bareissObjects(PyObject **, unsigned int, unsigned int, BareissState *);
+static PyObject *_matrixBareiss(Matrix *, const char *, unsigned int *);
+PyObject *matrixDetExact(Matrix *);
+PyObject *matrixRankExact(Matrix *);
+
+// io.c
+PyObject *matrixSave(Matrix *, PyObject *);
+PyObject *matrixLoad(PyObject *, PyObject *, PyObject *);
+PyObject *matrixFromBytes(PyObject *, FASTCALL_PARAMETERS);
+PyObject *_matrixToBytes(Matrix *);
+PyObject *matrixToBytes(Matrix *);
+PyObject *matrixToList(Matrix *);
+PyObject *matrixReduceEx(Matrix *, FASTCALL_PARAMETERS);
+
+// shared.c
+SharedBuffer *_matrixSharedBuffer(Matrix *);
+PyObject *matrixToShared(Matrix *);
+PyObject *matrixFromShared(PyObject *, PyObject *);
+PyObject *matrixSharedName(Matrix *, void *);
+
+// text.c
+PyObject *matrixFromText(PyObject *, PyObject *, PyObject *);
+PyObject *matrixFromCsv(PyObject *, PyObject *, PyObject *);
+PyObject *matrixStr(Matrix *);
+PyObject *matrixToText(Matrix *, PyObject *, PyObject *);
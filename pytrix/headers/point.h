@@ -64,6 +64,14 @@ static PySequenceMethods PointSequenceMethods = {
 static PyMethodDef PointMethods[] = {
     {"copy", (PyCFunction)pointCopy, METH_NOARGS,
         PyDoc_STR("Creates a copy of this point.")},
+    {"frombytes", (PyCFunction)pointFromBytes, METH_O | METH_CLASS,
+        PyDoc_STR("frombytes(data) -> Point\n\nCreates a point from a buffer of native doubles.")},
+    {"tobytes", (PyCFunction)pointToBytes, METH_NOARGS,
+        PyDoc_STR("Returns the coordinates of this point as a bytes object of native doubles.")},
+    {"totuple", (PyCFunction)pointToTuple, METH_NOARGS,
+        PyDoc_STR("Returns the coordinates of this point as a tuple of floats.")},
+    {"__reduce_ex__", (PyCFunction)(void(*)(void))pointReduceEx, METH_FASTCALL_COMPAT,
+        PyDoc_STR("Helper for pickle.")},
     {NULL}  // Sentinel
 };
 
@@ -85,7 +93,7 @@ static PyTypeObject PointType = {
     &PointNumberMethods,                         /*tp_as_number*/
     &PointSequenceMethods,                         /*tp_as_sequence*/
     0,                         /*tp_as_mapping*/
-    0,                         /*tp_hash */
+    (hashfunc)pointHash,                         /*tp_hash */
     0,                         /*tp_call*/
     (reprfunc)pointStr,                         /*tp_str*/
     0,                         /*tp_getattro*/
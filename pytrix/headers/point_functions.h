@@ -16,7 +16,11 @@
  */
 
 // init.c
-static int pointInit(Point *, PyObject *);
+static int _pointInitFromArray(Point *, PyObject *const *, Py_ssize_t);
+static int pointInit(Point *, PyObject *, PyObject *);
+#ifdef HAVE_TYPE_VECTORCALL
+PyObject *pointVectorcall(PyObject *, PyObject *const *, size_t, PyObject *);
+#endif
 static void pointDeInit(Point *);
 
 //operations.c
@@ -26,6 +30,7 @@ PyObject *pointAdd(PyObject *, PyObject *);
 PyObject *pointSub(PyObject *, PyObject *);
 PyObject *pointNeg(Point *);
 PyObject *pointRichCmp(PyObject *, PyObject *, int);
+Py_hash_t pointHash(Point *);
 int pointTrue(Point *);
 PyObject *pointItem(PyObject *, Py_ssize_t);
 
@@ -37,6 +42,12 @@ unsigned char _assertPointDimensionsEqual(Point *, Point *);
 unsigned char _assertPointVectorDimensionsEqual(Point *, Vector *);
 unsigned char _assertPoint(PyObject *);
 
+// io.c
+PyObject *pointFromBytes(PyObject *, PyObject *);
+PyObject *pointToBytes(Point *);
+PyObject *pointToTuple(Point *);
+PyObject *pointReduceEx(Point *, FASTCALL_PARAMETERS);
+
 PyObject *_pointToTuple(Point *);
 Point *_pointAdd(Point *, Vector *);
 Point *_pointVectorSub(Point *, Vector *);
@@ -44,5 +55,64 @@ Vector *_pointPointSub(Point *, Point *);
 Point *_pointNeg(Point *);
 unsigned char _pointsEqual(Point *, Point *);
 
+// transform.c
+static void _transformPointsTask(void *, Py_ssize_t, Py_ssize_t, unsigned int);
+PyObject *transformPointsFunction(PyObject *, FASTCALL_KEYWORDS_PARAMETERS);
+
+// distance.c
+unsigned char _pointSetComponents(const char *, PyObject *, VECTOR_TYPE **, Py_ssize_t *, unsigned int *,
+                                  unsigned char *);
+static void _pairwiseDistancesTask(void *, Py_ssize_t, Py_ssize_t, unsigned int);
+static void _pointSetNorms(VECTOR_TYPE *, Py_ssize_t, unsigned int, VECTOR_TYPE *);
+PyObject *pairwiseDistancesFunction(PyObject *, FASTCALL_KEYWORDS_PARAMETERS);
+
+// intersect.c
+static unsigned char _lineIntersection(VECTOR_TYPE *, VECTOR_TYPE *, VECTOR_TYPE *, VECTOR_TYPE *, unsigned char,
+                                       VECTOR_TYPE *);
+static PyObject *_intersectFunction(const char *, unsigned char, PyObject *const *, Py_ssize_t);
+PyObject *intersectLinesFunction(PyObject *, FASTCALL_PARAMETERS);
+PyObject *intersectSegmentsFunction(PyObject *, FASTCALL_PARAMETERS);
+static unsigned char _segmentsFromObject(PyObject *, VECTOR_TYPE **, Py_ssize_t *);
+static Py_ssize_t _segmentGridCell(SegmentGrid *, VECTOR_TYPE, VECTOR_TYPE, Py_ssize_t);
+static Py_ssize_t _segmentGridBucket(SegmentGrid *, Py_ssize_t, Py_ssize_t);
+static void _segmentGridPart(SegmentGrid *, Py_ssize_t, Py_ssize_t, VECTOR_TYPE *, VECTOR_TYPE *, Py_ssize_t *,
+                             Py_ssize_t *);
+static void _segmentGridEntry(SegmentGrid *, Py_ssize_t, Py_ssize_t, Py_ssize_t, const VECTOR_TYPE *,
+                              const VECTOR_TYPE *, SegmentGridEntry *);
+static Py_ssize_t _segmentGridPlace(SegmentGrid *, SegmentGridEntry *, Py_ssize_t);
+static unsigned char _segmentGridOverlap(SegmentGridEntry *, SegmentGridEntry *);
+static unsigned char _segmentGridMetBefore(SegmentGrid *, Py_ssize_t, Py_ssize_t, Py_ssize_t, Py_ssize_t);
+static VECTOR_TYPE _segmentExtentSelect(VECTOR_TYPE *, Py_ssize_t, Py_ssize_t);
+static unsigned char _segmentGridInit(SegmentGrid *);
+static int _segmentGridEntryCompare(const void *, const void *);
+static int _segmentGridEntryCompareX(const void *, const void *);
+static int _segmentGridEntryCompareY(const void *, const void *);
+static int _segmentIntersectionCompare(const void *, const void *);
+static unsigned char _segmentIntersectionAdd(SegmentIntersection **, Py_ssize_t *, Py_ssize_t *, Py_ssize_t,
+                                             Py_ssize_t, VECTOR_TYPE *);
+PyObject *segmentIntersectionsFunction(PyObject *, FASTCALL_PARAMETERS);
+
+// predicates.c
+static void _twoSum(VECTOR_TYPE, VECTOR_TYPE, VECTOR_TYPE *, VECTOR_TYPE *);
+static void _twoProduct(VECTOR_TYPE, VECTOR_TYPE, VECTOR_TYPE *, VECTOR_TYPE *);
+static unsigned int _expansionGrow(VECTOR_TYPE *, unsigned int, VECTOR_TYPE);
+static unsigned int _expansionAddProduct(VECTOR_TYPE *, unsigned int, VECTOR_TYPE, VECTOR_TYPE, VECTOR_TYPE);
+VECTOR_TYPE _orient2d(VECTOR_TYPE *, VECTOR_TYPE *, VECTOR_TYPE *);
+static unsigned int _expansionAddDeterminant(VECTOR_TYPE *, unsigned int, VECTOR_TYPE *, VECTOR_TYPE *, VECTOR_TYPE *,
+                                             VECTOR_TYPE);
+VECTOR_TYPE _orient3d(VECTOR_TYPE *, VECTOR_TYPE *, VECTOR_TYPE *, VECTOR_TYPE *);
+
+// hull.c
+static int _hullPointCompare(const void *, const void *);
+static PyObject *_convexHull2D(VECTOR_TYPE *, Py_ssize_t);
+static unsigned char _hullFaceNew(HullFace **, Py_ssize_t *, Py_ssize_t *, Py_ssize_t, Py_ssize_t, Py_ssize_t);
+static void _hullAssign(HullFace *, Py_ssize_t, Py_ssize_t, VECTOR_TYPE *, Py_ssize_t *, Py_ssize_t);
+static int _hullPointOrder(VECTOR_TYPE *, VECTOR_TYPE *);
+static int _hullEdgeCompare(const void *, const void *);
+static int _hullTriangleCompare(const void *, const void *);
+static PyObject *_convexHull3D(VECTOR_TYPE *, Py_ssize_t);
+PyObject *convexHullFunction(PyObject *, FASTCALL_PARAMETERS);
+PyObject *aabbFunction(PyObject *, FASTCALL_PARAMETERS);
+
 //iter.c
 PyObject *pointIter(Point *);
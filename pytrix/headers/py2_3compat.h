@@ -1,3 +1,42 @@
 #ifndef Py_TPFLAGS_CHECKTYPES
     #define Py_TPFLAGS_CHECKTYPES 0
 #endif
+
+#if PY_MAJOR_VERSION < 3
+    typedef long Py_hash_t;
+    typedef unsigned long Py_uhash_t;
+#endif
+
+// METH_FASTCALL was made public in Python 3.7.  Methods taking positional arguments are written against its calling
+// convention using the macros below; on older versions they are passed a tuple instead, whose items are used in place.
+#if PY_VERSION_HEX >= 0x03070000
+    #define METH_FASTCALL_COMPAT METH_FASTCALL
+    #define FASTCALL_PARAMETERS PyObject *const *args, Py_ssize_t nargs
+    #define FASTCALL_UNPACK_ARGS
+#else
+    #define METH_FASTCALL_COMPAT METH_VARARGS
+    #define FASTCALL_PARAMETERS PyObject *argsTuple
+    #define FASTCALL_UNPACK_ARGS \
+        PyObject **args = &PyTuple_GET_ITEM(argsTuple, 0); \
+        Py_ssize_t nargs = PyTuple_GET_SIZE(argsTuple);
+#endif
+
+// Methods which also take keyword arguments are passed the names of their keyword arguments as a tuple, whose values
+// follow the positional arguments in args.  On older versions kwnames is instead the keyword argument dictionary;
+// _parseOptionalArg handles both.
+#if PY_VERSION_HEX >= 0x03070000
+    #define METH_FASTCALL_KEYWORDS_COMPAT (METH_FASTCALL | METH_KEYWORDS)
+    #define FASTCALL_KEYWORDS_PARAMETERS PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames
+    #define FASTCALL_KEYWORDS_UNPACK_ARGS
+#else
+    #define METH_FASTCALL_KEYWORDS_COMPAT (METH_VARARGS | METH_KEYWORDS)
+    #define FASTCALL_KEYWORDS_PARAMETERS PyObject *argsTuple, PyObject *kwnames
+    #define FASTCALL_KEYWORDS_UNPACK_ARGS \
+        PyObject **args = &PyTuple_GET_ITEM(argsTuple, 0); \
+        Py_ssize_t nargs = PyTuple_GET_SIZE(argsTuple);
+#endif
+
+// Types can be constructed through vectorcall, bypassing tp_new / tp_init, from Python 3.9
+#if PY_VERSION_HEX >= 0x03090000
+    #define HAVE_TYPE_VECTORCALL 1
+#endif
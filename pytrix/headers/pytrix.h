@@ -21,19 +21,62 @@
     #define VECTOR_TYPE double
     #define STRASSEN_CUTOFF 32
     #define MIN_STRASSEN_SIZE 32
+    #define LINEAR_COMBINATION_BLOCK 256
+    #define PARALLEL_MAX_THREADS 16
+    #define PARALLEL_MIN_CHUNK 16384
+    #define VECTOR_ARRAY_BLOCK 256
+    #define MATRIX_BATCH_BLOCK 256
+    // Matrices of up to 4x4 are only inverted in closed form if the magnitudes of their non-zero values lie within this
+    // range, so that the products forming their determinants & adjugates can neither overflow nor underflow
+    #define SMALL_MATRIX_MIN_VALUE 1e-75
+    #define SMALL_MATRIX_MAX_VALUE 1e75
+    // The inverses of such matrices are checked for overflow only if the magnitudes of their determinants are below this
+    #define SMALL_MATRIX_MIN_DETERMINANT 1e-80
+    // The largest magnitude of the products formed by 64 bit fraction-free elimination
+    #define BAREISS_INT64_LIMIT 4611686018427387904.0
+    #define PAIRWISE_DISTANCE_BLOCK 512
+    #define KDTREE_LEAF_SIZE 16
+    #define KDTREE_PARALLEL_DEPTH 6
+    #define SPATIAL_GRID_MIN_TABLE 64
+    // The cells of the grid used to find segment intersections are this many times the extent of the median segment
+    #define SEGMENT_GRID_CELL 2
+    // Segments crossing more cells than this are compared against every other segment instead of being placed in cells
+    #define SEGMENT_GRID_MAX_CELLS 64
+    // The most columns or rows the grid may have
+    #define SEGMENT_GRID_MAX_SPAN 1073741824.0
+    // Bounds on the rounding error of the orientation predicates' floating point estimates, relative to the magnitude
+    // of their terms; from Shewchuk's "Adaptive Precision Floating-Point Arithmetic and Fast Robust Geometric
+    // Predicates"
+    #define PREDICATE_EPSILON (DBL_EPSILON / 2)
+    #define ORIENT2D_ERROR_BOUND ((3 + 16 * PREDICATE_EPSILON) * PREDICATE_EPSILON)
+    #define ORIENT3D_ERROR_BOUND ((7 + 56 * PREDICATE_EPSILON) * PREDICATE_EPSILON)
+    // 2^27 + 1; used to split a double into two halves whose products are exact
+    #define PREDICATE_SPLITTER 134217729.0
 
     // Standard Library Includes
     #include <Python.h>
     #include "structmember.h"
     #include <math.h>
+    #include <float.h>
     #include <string.h>
     #include <stdlib.h>
+    #include <stdint.h>
+    #ifdef _WIN32
+        #include <windows.h>
+    #else
+        #include <pthread.h>
+        #include <unistd.h>
+    #endif
+
+    // Compatibility Includes
+    #include "headers/py2_3compat.h"
 
     // Struct Definitions
     typedef struct {
         PyObject_HEAD
         unsigned int dimensions;
         VECTOR_TYPE *data;
+        Py_hash_t hash;
 
     } Point;
 
@@ -48,6 +91,11 @@
         PyObject_HEAD
         unsigned int dimensions;
         VECTOR_TYPE *data;
+        Py_hash_t hash;
+        // If not NULL, data is borrowed from (and kept alive by) this object rather than owned by the vector
+        PyObject *base;
+        // Mutable vectors may be written to as the out argument of arithmetic functions, and so cannot be hashed
+        char isMutable;
 
     } Vector;
 
@@ -63,6 +111,9 @@
         unsigned int rows;
         unsigned int columns;
         Vector **data;
+        Py_hash_t hash;
+        // Mutable matrices may be written to as the out argument of arithmetic functions, and so cannot be hashed
+        char isMutable;
 
     } Matrix;
 
@@ -73,13 +124,397 @@
 
     } MatrixIter;
 
+    typedef struct {
+        PyObject_HEAD
+        // The mutable vector being built, or NULL once it has been frozen
+        Vector *vector;
 
-    // Macro & Compatibility Includes
-    #include "headers/py2_3compat.h"
+    } VectorBuilder;
+
+    typedef struct {
+        PyObject_HEAD
+        // The mutable matrix being built, or NULL once it has been frozen
+        Matrix *matrix;
+
+    } MatrixBuilder;
+
+    typedef struct {
+        PyObject_HEAD
+        unsigned int rows;
+        unsigned int columns;
+        // The operation this node of the expression tree performs; one of the LAZY_* constants
+        unsigned char op;
+        // The Matrix wrapped by a LAZY_LEAF node, or the first operand of any other node
+        PyObject *left;
+        // The second operand of a LAZY_ADD, LAZY_SUB or LAZY_MATMUL node, otherwise NULL
+        PyObject *right;
+        // The factor applied by a LAZY_SCALE node
+        VECTOR_TYPE scalar;
+
+    } LazyMatrix;
+
+    typedef struct {
+        VECTOR_TYPE coefficient;
+        // A term is either coefficient * a, or, if b is not NULL, coefficient * a * b
+        Matrix *a;
+        Matrix *b;
+
+    } LazyTerm;
+
+    typedef struct {
+        // A node of an expression still to be lowered, and the factor to multiply each of its terms by
+        LazyMatrix *node;
+        VECTOR_TYPE coefficient;
+
+    } LazyPending;
+
+    // The struct of both VectorArrays and PointClouds
+    typedef struct {
+        PyObject_HEAD
+        Py_ssize_t count;
+        unsigned int dimensions;
+        // Structure-of-arrays storage; component d of element i is data[d * count + i]
+        VECTOR_TYPE *data;
+
+    } VectorArray;
+
+    // An operand of an arithmetic operation on VectorArrays / PointClouds; either an array, or a single Vector / Point
+    // which is applied to every element
+    typedef struct {
+        VECTOR_TYPE *data;
+        // The number of elements in the operand, or -1 for a single element
+        Py_ssize_t count;
+        unsigned int dimensions;
+        unsigned char isPoint;
+
+    } VectorArrayOperand;
+
+    typedef struct {
+        // The transform, laid out row by row with inDimensions + homogeneous columns
+        VECTOR_TYPE *matrix;
+        unsigned int inDimensions;
+        unsigned int outDimensions;
+        // Whether the transform is (n+1)x(n+1) homogeneous, and whether it requires a perspective divide
+        unsigned char homogeneous;
+        unsigned char projective;
+        VECTOR_TYPE *in;
+        VECTOR_TYPE *out;
+        Py_ssize_t count;
+        // Whether out holds the components of each element one after another, rather than component by component
+        unsigned char interleaved;
+
+    } VectorArrayTransform;
+
+    // The elements given to a batched operation, as either a sequence of Points or Vectors, a buffer of packed values,
+    // or a PointCloud or VectorArray; along with where the results of the operation are written
+    typedef struct {
+        Py_ssize_t count;
+        // The values of each element, unless the elements are held by an array
+        VECTOR_TYPE **inputs;
+        // The PointCloud or VectorArray holding the elements, which is read in place; otherwise NULL
+        VectorArray *array;
+        // The tuple of the sequence of elements, or the buffer they were given in, held until the batch is released
+        PyObject *sequence;
+        Py_buffer view;
+        unsigned char haveView;
+        // Either a new Matrix or array holding the results, or the out buffer they are written into
+        PyObject *result;
+        // The results, each element's components one after another; NULL when they are written to a new array
+        VECTOR_TYPE *out;
+        Py_buffer outView;
+        unsigned char haveOutView;
+
+    } BatchElements;
+
+    // A function processing items [start, end) of a task split between threads by _parallelFor; worker is the index
+    // of the thread running it.  Must not touch any Python objects, as it is run without the GIL
+    typedef void (*ParallelTask)(void *context, Py_ssize_t start, Py_ssize_t end, unsigned int worker);
+
+    typedef struct {
+        ParallelTask task;
+        void *context;
+        Py_ssize_t start;
+        Py_ssize_t end;
+        unsigned int worker;
+
+    } ParallelChunk;
+
+    typedef struct {
+        // The (n+1)x(n+1) transform, laid out row by row
+        VECTOR_TYPE *matrix;
+        unsigned int dimensions;
+        // Whether the last row of the matrix is other than (0, ..., 0, 1), requiring a perspective divide
+        unsigned char projective;
+        VECTOR_TYPE **inputs;
+        VECTOR_TYPE *out;
+        // dimensions values of scratch space for each worker
+        VECTOR_TYPE *scratch;
+
+    } PointTransform;
+
+    typedef struct {
+        // The coordinates of each set of points, stored component by component
+        VECTOR_TYPE *a;
+        VECTOR_TYPE *b;
+        Py_ssize_t countA;
+        Py_ssize_t countB;
+        unsigned int dimensions;
+        // The squared length of each point, for the euclidean metrics
+        VECTOR_TYPE *normsA;
+        VECTOR_TYPE *normsB;
+        unsigned char metric;
+        // countA x countB distances, laid out row by row
+        VECTOR_TYPE *out;
+
+    } PairwiseDistances;
+
+    // A segment crossing a cell of a SegmentGrid, with the bounds of the part of the segment within the cell
+    typedef struct {
+        Py_ssize_t column;
+        Py_ssize_t row;
+        Py_ssize_t segment;
+        VECTOR_TYPE low[2];
+        VECTOR_TYPE high[2];
+
+    } SegmentGridEntry;
+
+    typedef struct {
+        // The endpoints of each segment, laid out as x1, y1, x2, y2
+        VECTOR_TYPE *segments;
+        Py_ssize_t count;
+        // The lowest corner of the grid, and the width & height of its cells
+        VECTOR_TYPE x;
+        VECTOR_TYPE y;
+        VECTOR_TYPE cell;
+        // The margin around the bounds of each part of a segment, covering the rounding of the positions along it
+        VECTOR_TYPE epsilon;
+        Py_ssize_t columns;
+        Py_ssize_t rows;
+        // Each segment in each cell it crosses, grouped into buckets by a hash of the cell; only cells holding a
+        // segment are stored
+        SegmentGridEntry *entries;
+        Py_ssize_t entryCount;
+        // The first entry of each bucket, followed by the number of entries; the number of buckets is a power of two
+        Py_ssize_t *starts;
+        Py_ssize_t buckets;
+        // Whether each segment crosses too many cells to be placed in them
+        unsigned char *spanning;
+
+    } SegmentGrid;
+
+    typedef struct {
+        Py_ssize_t first;
+        Py_ssize_t second;
+        VECTOR_TYPE x;
+        VECTOR_TYPE y;
+
+    } SegmentIntersection;
+
+    typedef struct {
+        VECTOR_TYPE coordinates[2];
+        Py_ssize_t index;
+
+    } HullPoint;
+
+    // A triangular face of a 3 dimensional convex hull, whose vertices are counterclockwise when seen from outside
+    typedef struct {
+        Py_ssize_t vertices[3];
+        // The face across the edge from vertices[i] to vertices[(i + 1) % 3]
+        Py_ssize_t neighbours[3];
+        // The first of the points outside the hull which are visible from this face, or -1
+        Py_ssize_t conflicts;
+        // The last time this face was tested for visibility, and whether it was visible then
+        Py_ssize_t stamp;
+        unsigned char visible;
+        unsigned char alive;
+
+    } HullFace;
+
+    // An edge of the horizon seen from a point being added to a hull, between the faces it can & cannot see
+    typedef struct {
+        Py_ssize_t start;
+        Py_ssize_t end;
+        // The face which cannot be seen, and the position of the edge within it
+        Py_ssize_t face;
+        unsigned int edge;
+        // The face created over the edge
+        Py_ssize_t created;
+
+    } HullEdge;
+
+    typedef struct {
+        PyObject_HEAD
+        Py_ssize_t count;
+        unsigned int dimensions;
+        // The coordinates of the points, reordered so that each node's points are contiguous, one point after another
+        VECTOR_TYPE *points;
+        // The index of each point in the points the tree was built from
+        Py_ssize_t *indices;
+        // The dimension each node splits its points along, indexed by the position of the node's median point
+        unsigned int *splits;
+
+    } KDTree;
+
+    // The k nearest points found so far by a query, kept as a max-heap ordered by squared distance then index
+    typedef struct {
+        VECTOR_TYPE *query;
+        Py_ssize_t k;
+        Py_ssize_t size;
+        VECTOR_TYPE *distances;
+        Py_ssize_t *indices;
+
+    } KDTreeNeighbours;
+
+    // The indices of the points matched by a radius or box query
+    typedef struct {
+        Py_ssize_t *indices;
+        Py_ssize_t count;
+        Py_ssize_t capacity;
+
+    } KDTreeMatches;
+
+    typedef struct {
+        KDTree *tree;
+        // Pairs of the first & last + 1 positions of subtrees to build
+        Py_ssize_t *ranges;
+
+    } KDTreeBuild;
+
+    typedef struct {
+        KDTree *tree;
+        // The coordinates of the query points, stored component by component
+        VECTOR_TYPE *queries;
+        Py_ssize_t count;
+        Py_ssize_t k;
+        // k squared distances & indices for each query
+        VECTOR_TYPE *distances;
+        Py_ssize_t *indices;
+        // dimensions values of scratch space for each worker
+        VECTOR_TYPE *scratch;
+
+    } KDTreeBatch;
+
+    // The ids of the points within one cell of a SpatialGrid
+    typedef struct {
+        Py_ssize_t *members;
+        Py_ssize_t count;
+        Py_ssize_t capacity;
+        // Whether this slot of the grid's table holds a cell, which may have since been emptied
+        unsigned char used;
+
+    } SpatialGridCell;
+
+    typedef struct {
+        PyObject_HEAD
+        VECTOR_TYPE cellSize;
+        unsigned int dimensions;
+        Py_ssize_t count;
+        // Indexed by id: the coordinates of each point, the slot of the cell holding it (or -1 if the id is absent),
+        // and its position among that cell's members
+        VECTOR_TYPE *points;
+        Py_ssize_t *cells;
+        Py_ssize_t *positions;
+        Py_ssize_t capacity;
+        // An open addressing hash table of the occupied cells, keyed by their integer coordinates
+        SpatialGridCell *table;
+        int64_t *keys;
+        Py_ssize_t tableSize;
+        Py_ssize_t tableUsed;
+        // Room for 3 sets of cell coordinates, used while placing & querying points
+        int64_t *scratch;
+
+    } SpatialGrid;
+
+    typedef struct {
+        PyObject_HEAD
+        // The scalar part w, followed by the vector part x, y & z
+        VECTOR_TYPE data[4];
+
+    } Quaternion;
+
+    typedef struct {
+        PyObject_HEAD
+        Py_ssize_t count;
+        unsigned int rows;
+        unsigned int columns;
+        // Batch-major storage; value k (row * columns + column) of matrix i is data[k * count + i]
+        VECTOR_TYPE *data;
+
+    } MatrixBatch;
+
+    typedef struct {
+        // The values of each operand, in the layout of a MatrixBatch; or, if single, of one matrix laid out row by row
+        // which is applied to every matrix of the other operand
+        VECTOR_TYPE *a;
+        VECTOR_TYPE *b;
+        unsigned char singleA;
+        unsigned char singleB;
+        unsigned int rows;
+        unsigned int inner;
+        unsigned int columns;
+        VECTOR_TYPE *out;
+        Py_ssize_t count;
+
+    } MatrixBatchProduct;
+
+    typedef struct {
+        // The square matrices to factor, in the layout of a MatrixBatch
+        VECTOR_TYPE *in;
+        unsigned int n;
+        Py_ssize_t count;
+        // Where to write the determinant of each matrix, or the inverse of each matrix in the layout of a MatrixBatch
+        VECTOR_TYPE *determinants;
+        VECTOR_TYPE *inverses;
+        // The right hand side of each system to solve, stored component by component, or a single right hand side for
+        // every system; and where to write each solution, stored component by component
+        VECTOR_TYPE *rhs;
+        unsigned char singleRhs;
+        VECTOR_TYPE *solutions;
+        // n * (n + 1) values & n pivots of scratch space for each worker
+        VECTOR_TYPE *scratch;
+        unsigned int *pivots;
+        // The index of the first singular matrix found by each worker, or -1
+        Py_ssize_t singular[PARALLEL_MAX_THREADS];
+
+    } MatrixBatchFactor;
+
+    // The progress of fraction-free elimination, so that it can be continued with Python ints once 64 bit integers
+    // would overflow
+    typedef struct {
+        // The position of the current pivot; the rows above it hold the pivots already eliminated with
+        unsigned int row;
+        unsigned int column;
+        // The column of the previous pivot, whose value divides each value eliminated with the current one; or -1
+        long previous;
+        // The next row to eliminate below the current pivot, or 0 if the pivot has not yet been found
+        unsigned int next;
+        // The sign of the permutation applied to the rows
+        int sign;
+
+    } BareissState;
+
+    typedef struct {
+        PyObject_HEAD
+        // The multiprocessing.shared_memory.SharedMemory instance this buffer owns
+        PyObject *shm;
+        char *data;
+        Py_ssize_t size;
+        unsigned int rows;
+        unsigned int columns;
+        // Whether or not this process created the segment, and so is responsible for unlinking it
+        unsigned char creator;
+
+    } SharedBuffer;
+
+
+    // Macro Includes
     #include "headers/macros.h"
 
     // Utilities
     #include "utils.c"
+    #include "npy.c"
+    #include "text.c"
+    #include "parallel.c"
 
     // Function Definition Includes
     #include "headers/point_functions.h"
@@ -88,26 +523,52 @@
     #include "headers/vector_iter_functions.h"
     #include "headers/matrix_functions.h"
     #include "headers/matrix_iter_functions.h"
+    #include "headers/shared_buffer_functions.h"
+    #include "headers/vector_builder_functions.h"
+    #include "headers/matrix_builder_functions.h"
+    #include "headers/lazy_matrix_functions.h"
+    #include "headers/vector_array_functions.h"
+    #include "headers/kdtree_functions.h"
+    #include "headers/spatial_grid_functions.h"
+    #include "headers/quaternion_functions.h"
+    #include "headers/matrix_batch_functions.h"
 
     // Type Includes
     #include "headers/point_iter.h"
     #include "headers/vector_iter.h"
     #include "headers/matrix_iter.h"
+    #include "headers/shared_buffer.h"
     #include "headers/point.h"
     #include "headers/vector.h"
     #include "headers/matrix.h"
+    #include "headers/vector_builder.h"
+    #include "headers/matrix_builder.h"
+    #include "headers/lazy_matrix.h"
+    #include "headers/vector_array.h"
+    #include "headers/kdtree.h"
+    #include "headers/spatial_grid.h"
+    #include "headers/quaternion.h"
+    #include "headers/matrix_batch.h"
 
     // Point Function Includes
     #include "point/init.c"
     #include "point/iter.c"
     #include "point/utils.c"
     #include "point/operations.c"
+    #include "point/io.c"
+    #include "point/transform.c"
+    #include "point/distance.c"
+    #include "point/intersect.c"
+    #include "point/predicates.c"
+    #include "point/hull.c"
 
     // Vector Function Includes
     #include "vector/init.c"
     #include "vector/iter.c"
     #include "vector/utils.c"
     #include "vector/operations.c"
+    #include "vector/io.c"
+    #include "vector/builder.c"
 
     // Matrix Function Includes
     #include "matrix/init.c"
@@ -115,9 +576,38 @@
     #include "matrix/utils.c"
     #include "matrix/operations.c"
     #include "matrix/strassen.c"
+    #include "matrix/small.c"
+    #include "matrix/exact.c"
+    #include "matrix/io.c"
+    #include "matrix/shared.c"
+    #include "matrix/text.c"
+    #include "matrix/builder.c"
+    #include "matrix/lazy.c"
+
+    // VectorArray Function Includes
+    #include "vector_array/init.c"
+    #include "vector_array/utils.c"
+    #include "vector_array/operations.c"
+
+    // KDTree Function Includes
+    #include "kdtree/init.c"
+    #include "kdtree/query.c"
+
+    // SpatialGrid Function Includes
+    #include "spatial_grid/init.c"
+    #include "spatial_grid/operations.c"
+
+    // Quaternion Function Includes
+    #include "quaternion/init.c"
+    #include "quaternion/operations.c"
+
+    // MatrixBatch Function Includes
+    #include "matrix_batch/init.c"
+    #include "matrix_batch/operations.c"
 
     // Other includes
     #include "matrixConstructors.c"
+    #include "arithmetic.c"
 
     // Declarations for DLL import/export
     #ifndef PyMODINIT_FUNC
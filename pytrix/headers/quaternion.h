@@ -0,0 +1,133 @@
+/*
+ *  Copyright (C) 2016 Warren Spencer warrenspencer27@gmail.com
+
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+static PyMemberDef QuaternionMembers[] = {
+    {"w", T_DOUBLE, offsetof(Quaternion, data), READONLY, "The scalar part of the quaternion."},
+    {"x", T_DOUBLE, offsetof(Quaternion, data) + sizeof(VECTOR_TYPE), READONLY, "The x part of the quaternion."},
+    {"y", T_DOUBLE, offsetof(Quaternion, data) + sizeof(VECTOR_TYPE) * 2, READONLY, "The y part of the quaternion."},
+    {"z", T_DOUBLE, offsetof(Quaternion, data) + sizeof(VECTOR_TYPE) * 3, READONLY, "The z part of the quaternion."},
+    {NULL} // Sentinel
+};
+
+#if PY_MAJOR_VERSION >= 3
+static PyNumberMethods QuaternionNumberMethods = {
+    0,
+    0,
+    (binaryfunc)quaternionMul,
+    0,
+    0,
+    0,
+    (unaryfunc)quaternionNeg,
+};
+#else
+static PyNumberMethods QuaternionNumberMethods = {
+    0,
+    0,
+    (binaryfunc)quaternionMul,
+    0,
+    0,
+    0,
+    0,
+    (unaryfunc)quaternionNeg,
+};
+#endif
+
+static PyMethodDef QuaternionMethods[] = {
+    {"from_axis_angle", (PyCFunction)(void(*)(void))quaternionFromAxisAngle, METH_FASTCALL_COMPAT | METH_CLASS,
+        PyDoc_STR("from_axis_angle(axis, radians) -> Quaternion\n\nCreates a rotation of radians about a 3 "
+                  "dimensional Vector axis.")},
+    {"from_euler", (PyCFunction)(void(*)(void))quaternionFromEuler, METH_FASTCALL_COMPAT | METH_CLASS,
+        PyDoc_STR("from_euler(x, y, z) -> Quaternion\n\nCreates the same rotation as rotation3DMatrix(x, y, z).")},
+    {"from_matrix", (PyCFunction)quaternionFromMatrix, METH_O | METH_CLASS,
+        PyDoc_STR("from_matrix(matrix) -> Quaternion\n\nCreates the rotation performed by a 3x3 rotation Matrix.")},
+    {"to_matrix", (PyCFunction)quaternionToMatrix, METH_NOARGS,
+        PyDoc_STR("Returns the 3x3 rotation Matrix performing this rotation.")},
+    {"rotate", (PyCFunction)quaternionRotate, METH_O,
+        PyDoc_STR("rotate(items)\n\nRotates a 3 dimensional Vector, Point, VectorArray or PointCloud, or a sequence "
+                  "of Vectors & Points.")},
+    {"slerp", (PyCFunction)(void(*)(void))quaternionSlerp, METH_FASTCALL_COMPAT,
+        PyDoc_STR("slerp(other, t) -> Quaternion\n\nSpherically interpolates from this rotation (t = 0) to other "
+                  "(t = 1) along the shorter arc.")},
+    {"conjugate", (PyCFunction)quaternionConjugate, METH_NOARGS,
+        PyDoc_STR("Returns the conjugate of this quaternion; the inverse rotation of a unit quaternion.")},
+    {"inverse", (PyCFunction)quaternionInverse, METH_NOARGS,
+        PyDoc_STR("Returns the inverse of this quaternion.")},
+    {"normalize", (PyCFunction)quaternionNormalize, METH_NOARGS,
+        PyDoc_STR("Returns this quaternion scaled to unit length.")},
+    {"length", (PyCFunction)quaternionLength, METH_NOARGS,
+        PyDoc_STR("Returns the length of this quaternion.")},
+    {"totuple", (PyCFunction)quaternionToTuple, METH_NOARGS,
+        PyDoc_STR("Returns the (w, x, y, z) components of this quaternion as a tuple of floats.")},
+    {"__reduce__", (PyCFunction)quaternionReduce, METH_NOARGS,
+        PyDoc_STR("Helper for pickle.")},
+    {NULL}  // Sentinel
+};
+
+
+/* NOTES:
+    * Quaternions are immutable; when operations are performed on them new quaternions are created.
+    * a * b is the rotation b followed by the rotation a, matching the order of the rotation matrices they represent.
+*/
+static PyTypeObject QuaternionType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    "pytrix.Quaternion",
+    sizeof(Quaternion),
+    0,                         /*tp_itemsize*/
+    (destructor)quaternionDeInit,                     /*tp_dealloc*/
+    0,                         /*tp_print*/
+    0,                         /*tp_getattr*/
+    0,                         /*tp_setattr*/
+    0,                         /*tp_compare*/
+    0,                         /*tp_repr*/
+    &QuaternionNumberMethods,                         /*tp_as_number*/
+    0,                         /*tp_as_sequence*/
+    0,                         /*tp_as_mapping*/
+    (hashfunc)quaternionHash,                         /*tp_hash */
+    0,                         /*tp_call*/
+    (reprfunc)quaternionStr,                          /*tp_str*/
+    0,                         /*tp_getattro*/
+    0,                         /*tp_setattro*/
+    0,                         /*tp_as_buffer*/
+    Py_TPFLAGS_DEFAULT | Py_TPFLAGS_CHECKTYPES,        /*tp_flags*/
+    "Object representing a Quaternion; a rotation in 3 dimensions.",
+    0,                     /* tp_traverse */
+    0,                     /* tp_clear */
+    quaternionRichCmp,                     /* tp_richcompare */
+    0,                     /* tp_weaklistoffset */
+    0,                     /* tp_iter */
+    0,                     /* tp_iternext */
+    QuaternionMethods,         /* tp_methods */
+    QuaternionMembers,         /* tp_members */
+    0,                         /* tp_getset */
+    0,                         /* tp_base */
+    0,                         /* tp_dict */
+    0,                         /* tp_descr_get */
+    0,                         /* tp_descr_set */
+    0,                         /* tp_dictoffset */
+    0,                         /* tp_init */
+    0,                         /* tp_alloc */
+    quaternionNew,             /* tp_new */
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0
+};
@@ -0,0 +1,43 @@
+/*
+ *  Copyright (C) 2016 Warren Spencer warrenspencer27@gmail.com
+
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// init.c
+Quaternion *_quaternionNew(VECTOR_TYPE, VECTOR_TYPE, VECTOR_TYPE, VECTOR_TYPE);
+PyObject *quaternionNew(PyTypeObject *, PyObject *, PyObject *);
+void quaternionDeInit(Quaternion *);
+PyObject *quaternionFromAxisAngle(PyObject *, FASTCALL_PARAMETERS);
+PyObject *quaternionFromEuler(PyObject *, FASTCALL_PARAMETERS);
+PyObject *quaternionFromMatrix(PyObject *, PyObject *);
+
+// operations.c
+static void _quaternionMultiply(VECTOR_TYPE *, VECTOR_TYPE *, VECTOR_TYPE *);
+static unsigned char _quaternionRotation(Quaternion *, VECTOR_TYPE *);
+static PyObject *_quaternionRotateOne(PyObject *, VECTOR_TYPE *);
+PyObject *quaternionStr(Quaternion *);
+PyObject *quaternionToTuple(Quaternion *);
+PyObject *quaternionReduce(Quaternion *);
+PyObject *quaternionRichCmp(PyObject *, PyObject *, int);
+Py_hash_t quaternionHash(Quaternion *);
+PyObject *quaternionMul(PyObject *, PyObject *);
+PyObject *quaternionNeg(Quaternion *);
+PyObject *quaternionLength(Quaternion *);
+PyObject *quaternionNormalize(Quaternion *);
+PyObject *quaternionConjugate(Quaternion *);
+PyObject *quaternionInverse(Quaternion *);
+PyObject *quaternionSlerp(Quaternion *, FASTCALL_PARAMETERS);
+PyObject *quaternionToMatrix(Quaternion *);
+PyObject *quaternionRotate(Quaternion *, PyObject *);
@@ -0,0 +1,105 @@
+/*
+ *  Copyright (C) 2016 Warren Spencer warrenspencer27@gmail.com
+
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+static PyMemberDef SpatialGridMembers[] = {
+    {"cell_size", T_DOUBLE, offsetof(SpatialGrid, cellSize), READONLY, "Width of each cell of the grid."},
+    {"dimensions", T_UINT, offsetof(SpatialGrid, dimensions), READONLY, "Number of dimensions of the grid's points."},
+    {NULL} // Sentinel
+};
+
+static PySequenceMethods SpatialGridSequenceMethods = {
+    (lenfunc)spatialGridLength,                 /* sq_length */
+    0,                                          /* sq_concat */
+    0,                                          /* sq_repeat */
+    0,                                          /* sq_item */
+    0,                                          /* sq_slice */
+    0,                                          /* sq_ass_item */
+    0,                                          /* sq_ass_slice */
+    (objobjproc)spatialGridContains,            /* sq_contains */
+};
+
+static PyMethodDef SpatialGridMethods[] = {
+    {"insert", (PyCFunction)(void(*)(void))spatialGridInsert, METH_FASTCALL_COMPAT,
+        PyDoc_STR("insert(id, point)\n\nAdds a Point to the grid under id, a non-negative int not already in use.")},
+    {"move", (PyCFunction)(void(*)(void))spatialGridMove, METH_FASTCALL_COMPAT,
+        PyDoc_STR("move(id, point)\n\nMoves the point with the given id to a new position.")},
+    {"remove", (PyCFunction)(void(*)(void))spatialGridRemove, METH_FASTCALL_COMPAT,
+        PyDoc_STR("remove(id)\n\nRemoves the point with the given id from the grid.")},
+    {"update", (PyCFunction)(void(*)(void))spatialGridUpdate, METH_FASTCALL_KEYWORDS_COMPAT,
+        PyDoc_STR("update(points, ids=None)\n\nInserts or moves a batch of points, given as a buffer of packed "
+                  "doubles, a PointCloud or a sequence of Points.  ids defaults to 0, 1, 2...")},
+    {"query_radius", (PyCFunction)(void(*)(void))spatialGridQueryRadius, METH_FASTCALL_COMPAT,
+        PyDoc_STR("query_radius(point, radius) -> list\n\nReturns the ids of the points within radius of point, in "
+                  "ascending order.")},
+    {NULL}  // Sentinel
+};
+
+
+/* NOTES:
+    * SpatialGrids are mutable; points are stored under caller chosen ids, which index an array within the grid and so
+      should be small, such as the positions of the points in the caller's own arrays.
+    * Each point is kept in the cell of a uniform grid containing it, and only occupied cells are stored.
+*/
+static PyTypeObject SpatialGridType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    "pytrix.SpatialGrid",
+    sizeof(SpatialGrid),
+    0,                         /*tp_itemsize*/
+    (destructor)spatialGridDeInit,                    /*tp_dealloc*/
+    0,                         /*tp_print*/
+    0,                         /*tp_getattr*/
+    0,                         /*tp_setattr*/
+    0,                         /*tp_compare*/
+    0,                         /*tp_repr*/
+    0,                         /*tp_as_number*/
+    &SpatialGridSequenceMethods,                    /*tp_as_sequence*/
+    0,                         /*tp_as_mapping*/
+    0,                         /*tp_hash */
+    0,                         /*tp_call*/
+    0,                         /*tp_str*/
+    0,                         /*tp_getattro*/
+    0,                         /*tp_setattro*/
+    0,                         /*tp_as_buffer*/
+    Py_TPFLAGS_DEFAULT,        /*tp_flags*/
+    "A uniform grid of points which can be inserted, moved & removed by id, for radius queries over moving points.",
+    0,                     /* tp_traverse */
+    0,                     /* tp_clear */
+    0,                     /* tp_richcompare */
+    0,                     /* tp_weaklistoffset */
+    0,                     /* tp_iter */
+    0,                     /* tp_iternext */
+    SpatialGridMethods,        /* tp_methods */
+    SpatialGridMembers,        /* tp_members */
+    0,                         /* tp_getset */
+    0,                         /* tp_base */
+    0,                         /* tp_dict */
+    0,                         /* tp_descr_get */
+    0,                         /* tp_descr_set */
+    0,                         /* tp_dictoffset */
+    0,                         /* tp_init */
+    0,                         /* tp_alloc */
+    spatialGridNew,            /* tp_new */
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0
+};
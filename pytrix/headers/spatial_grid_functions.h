@@ -0,0 +1,39 @@
+/*
+ *  Copyright (C) 2016 Warren Spencer warrenspencer27@gmail.com
+
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// init.c
+static int64_t _spatialGridCoordinate(SpatialGrid *, VECTOR_TYPE);
+static Py_ssize_t _spatialGridSlot(SpatialGrid *, int64_t *);
+static unsigned char _spatialGridRehash(SpatialGrid *, Py_ssize_t);
+static Py_ssize_t _spatialGridCell(SpatialGrid *, int64_t *);
+static unsigned char _spatialGridReserve(SpatialGrid *, Py_ssize_t);
+PyObject *spatialGridNew(PyTypeObject *, PyObject *, PyObject *);
+void spatialGridDeInit(SpatialGrid *);
+Py_ssize_t spatialGridLength(SpatialGrid *);
+int spatialGridContains(SpatialGrid *, PyObject *);
+
+// operations.c
+static unsigned char _spatialGridParseId(const char *, PyObject *, Py_ssize_t *);
+static VECTOR_TYPE *_spatialGridPoint(SpatialGrid *, const char *, PyObject *);
+static void _spatialGridDetach(SpatialGrid *, Py_ssize_t);
+static unsigned char _spatialGridPlace(SpatialGrid *, Py_ssize_t, VECTOR_TYPE *, Py_ssize_t);
+static unsigned char _spatialGridVisit(SpatialGrid *, Py_ssize_t, VECTOR_TYPE *, VECTOR_TYPE, KDTreeMatches *);
+PyObject *spatialGridInsert(SpatialGrid *, FASTCALL_PARAMETERS);
+PyObject *spatialGridMove(SpatialGrid *, FASTCALL_PARAMETERS);
+PyObject *spatialGridRemove(SpatialGrid *, FASTCALL_PARAMETERS);
+PyObject *spatialGridUpdate(SpatialGrid *, FASTCALL_KEYWORDS_PARAMETERS);
+PyObject *spatialGridQueryRadius(SpatialGrid *, FASTCALL_PARAMETERS);
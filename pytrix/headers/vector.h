@@ -18,6 +18,7 @@
 
 static PyMemberDef VectorMembers[] = {
     {"dimensions", T_UINT, offsetof(Vector, dimensions), READONLY, "Number of dimensions of the vector."},
+    {"mutable", T_BOOL, offsetof(Vector, isMutable), READONLY, "Whether the vector may be used as an out argument."},
     {NULL} // Sentinel
 };
 
@@ -99,6 +100,22 @@ static PyMethodDef VectorMethods[] = {
         PyDoc_STR("Calculate the angle between this vector and another vector.")},
     {"isOrthogonal", (PyCFunction)vectorOrthogonal, METH_O,
         PyDoc_STR("Determines whether or not another vector is orthogonal to this vector.")},
+    {"zeros", (PyCFunction)(void(*)(void))vectorZeros, METH_FASTCALL_KEYWORDS_COMPAT | METH_CLASS,
+        PyDoc_STR("zeros(dimensions, mutable=False) -> Vector\n\nCreates a vector whose components are all 0.  Mutable "
+                  "vectors may be written to as the out argument of pytrix's arithmetic functions, and are unhashable.")},
+    {"save", (PyCFunction)vectorSave, METH_O,
+        PyDoc_STR("Writes this vector to a file in numpy's .npy format.")},
+    {"load", (PyCFunction)vectorLoad, METH_VARARGS | METH_KEYWORDS | METH_CLASS,
+        PyDoc_STR("load(path, mmap=False) -> Vector\n\nLoads a vector from a 1 dimensional float64 .npy file.  If mmap "
+                  "is True the vector references the file's pages directly rather than reading them into memory.")},
+    {"frombytes", (PyCFunction)vectorFromBytes, METH_O | METH_CLASS,
+        PyDoc_STR("frombytes(data) -> Vector\n\nCreates a vector from a buffer of native doubles.")},
+    {"tobytes", (PyCFunction)vectorToBytes, METH_NOARGS,
+        PyDoc_STR("Returns the components of this vector as a bytes object of native doubles.")},
+    {"tolist", (PyCFunction)vectorToList, METH_NOARGS,
+        PyDoc_STR("Returns the components of this vector as a list of floats.")},
+    {"__reduce_ex__", (PyCFunction)(void(*)(void))vectorReduceEx, METH_FASTCALL_COMPAT,
+        PyDoc_STR("Helper for pickle.")},
     {NULL}  // Sentinel
 };
 
@@ -120,7 +137,7 @@ static PyTypeObject VectorType = {
     &VectorNumberMethods,                         /*tp_as_number*/
     &VectorSequenceMethods,                         /*tp_as_sequence*/
     0,                         /*tp_as_mapping*/
-    0,                         /*tp_hash */
+    (hashfunc)vectorHash,                         /*tp_hash */
     0,                         /*tp_call*/
     (reprfunc)vectorStr,                         /*tp_str*/
     0,                         /*tp_getattro*/
@@ -0,0 +1,183 @@
+/*
+ *  Copyright (C) 2016 Warren Spencer warrenspencer27@gmail.com
+
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+static PyMemberDef VectorArrayMembers[] = {
+    {"dimensions", T_UINT, offsetof(VectorArray, dimensions), READONLY, "Number of dimensions of each element."},
+    {NULL} // Sentinel
+};
+
+#if PY_MAJOR_VERSION >= 3
+static PyNumberMethods VectorArrayNumberMethods = {
+    (binaryfunc)vectorArrayAdd,
+    (binaryfunc)vectorArraySub,
+    (binaryfunc)vectorArrayMul,
+    0,
+    0,
+    0,
+    (unaryfunc)vectorArrayNeg,
+};
+#else
+static PyNumberMethods VectorArrayNumberMethods = {
+    (binaryfunc)vectorArrayAdd,
+    (binaryfunc)vectorArraySub,
+    (binaryfunc)vectorArrayMul,
+    0,
+    0,
+    0,
+    0,
+    (unaryfunc)vectorArrayNeg,
+};
+#endif
+
+static PySequenceMethods VectorArraySequenceMethods = {
+    (lenfunc)vectorArrayLength,                 /* sq_length */
+    0,                                          /* sq_concat */
+    0,                                          /* sq_repeat */
+    (ssizeargfunc)vectorArrayItem,              /* sq_item */
+    0,                                          /* sq_slice */
+    0,                                          /* sq_ass_item */
+    0,                                          /* sq_ass_slice */
+    0,                                          /* sq_contains */
+};
+
+static PyMethodDef VectorArrayMethods[] = {
+    {"frombytes", (PyCFunction)(void(*)(void))vectorArrayFromBytes, METH_FASTCALL_COMPAT | METH_CLASS,
+        PyDoc_STR("frombytes(data, dimensions) -> array\n\n"
+                  "Creates an array from a buffer of native doubles holding the coordinates of each element in turn.")},
+    {"tobytes", (PyCFunction)vectorArrayToBytes, METH_NOARGS,
+        PyDoc_STR("Returns the coordinates of each element in turn as a bytes object of native doubles.")},
+    {"centroid", (PyCFunction)vectorArrayCentroid, METH_NOARGS,
+        PyDoc_STR("Returns the mean of the elements of this array.")},
+    {"bounds", (PyCFunction)vectorArrayBounds, METH_NOARGS,
+        PyDoc_STR("Returns a tuple of the minimum & maximum of each coordinate over the elements of this array.")},
+    {"transform", (PyCFunction)vectorArrayTransformMethod, METH_O,
+        PyDoc_STR("transform(matrix) -> array\n\n"
+                  "Multiplies each vector by matrix, or applies the (n+1)x(n+1) homogeneous transform matrix to each "
+                  "point.")},
+    {NULL}  // Sentinel
+};
+
+
+/* NOTES:
+    * VectorArrays are immutable; when operations are performed on them new VectorArrays are created.
+    * Coordinates are stored component by component (every x coordinate, then every y coordinate, and so on) so that
+      bulk operations run over contiguous memory.  Indexing gathers an element into a new Vector.
+*/
+static PyTypeObject VectorArrayType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    "pytrix.VectorArray",
+    sizeof(VectorArray),
+    0,                         /*tp_itemsize*/
+    (destructor)vectorArrayDeInit,                         /*tp_dealloc*/
+    0,                         /*tp_print*/
+    0,                         /*tp_getattr*/
+    0,                         /*tp_setattr*/
+    0,                         /*tp_compare*/
+    0,                         /*tp_repr*/
+    &VectorArrayNumberMethods,                         /*tp_as_number*/
+    &VectorArraySequenceMethods,                         /*tp_as_sequence*/
+    0,                         /*tp_as_mapping*/
+    PyObject_HashNotImplemented,                         /*tp_hash */
+    0,                         /*tp_call*/
+    0,                         /*tp_str*/
+    0,                         /*tp_getattro*/
+    0,                         /*tp_setattro*/
+    0,                         /*tp_as_buffer*/
+    Py_TPFLAGS_DEFAULT | Py_TPFLAGS_CHECKTYPES,        /*tp_flags*/
+    "Object representing a packed array of Vectors.",
+    0,                     /* tp_traverse */
+    0,                     /* tp_clear */
+    vectorArrayRichCmp,                     /* tp_richcompare */
+    0,                     /* tp_weaklistoffset */
+    0,                     /* tp_iter */
+    0,                     /* tp_iternext */
+    VectorArrayMethods,             /* tp_methods */
+    VectorArrayMembers,             /* tp_members */
+    0,                         /* tp_getset */
+    0,                         /* tp_base */
+    0,                         /* tp_dict */
+    0,                         /* tp_descr_get */
+    0,                         /* tp_descr_set */
+    0,                         /* tp_dictoffset */
+    0,                         /* tp_init */
+    0,                         /* tp_alloc */
+    vectorArrayNew,                 /* tp_new */
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0
+};
+
+/* NOTES:
+    * PointClouds are immutable; when operations are performed on them new PointClouds are created.
+    * Coordinates are stored component by component (every x coordinate, then every y coordinate, and so on) so that
+      bulk operations run over contiguous memory.  Indexing gathers an element into a new Point.
+*/
+static PyTypeObject PointCloudType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    "pytrix.PointCloud",
+    sizeof(VectorArray),
+    0,                         /*tp_itemsize*/
+    (destructor)vectorArrayDeInit,                         /*tp_dealloc*/
+    0,                         /*tp_print*/
+    0,                         /*tp_getattr*/
+    0,                         /*tp_setattr*/
+    0,                         /*tp_compare*/
+    0,                         /*tp_repr*/
+    &VectorArrayNumberMethods,                         /*tp_as_number*/
+    &VectorArraySequenceMethods,                         /*tp_as_sequence*/
+    0,                         /*tp_as_mapping*/
+    PyObject_HashNotImplemented,                         /*tp_hash */
+    0,                         /*tp_call*/
+    0,                         /*tp_str*/
+    0,                         /*tp_getattro*/
+    0,                         /*tp_setattro*/
+    0,                         /*tp_as_buffer*/
+    Py_TPFLAGS_DEFAULT | Py_TPFLAGS_CHECKTYPES,        /*tp_flags*/
+    "Object representing a packed array of Points.",
+    0,                     /* tp_traverse */
+    0,                     /* tp_clear */
+    vectorArrayRichCmp,                     /* tp_richcompare */
+    0,                     /* tp_weaklistoffset */
+    0,                     /* tp_iter */
+    0,                     /* tp_iternext */
+    VectorArrayMethods,             /* tp_methods */
+    VectorArrayMembers,             /* tp_members */
+    0,                         /* tp_getset */
+    0,                         /* tp_base */
+    0,                         /* tp_dict */
+    0,                         /* tp_descr_get */
+    0,                         /* tp_descr_set */
+    0,                         /* tp_dictoffset */
+    0,                         /* tp_init */
+    0,                         /* tp_alloc */
+    vectorArrayNew,                 /* tp_new */
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0
+};
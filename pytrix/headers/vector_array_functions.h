@@ -0,0 +1,48 @@
+/*
+ *  Copyright (C) 2016 Warren Spencer warrenspencer27@gmail.com
+
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// init.c
+PyObject *vectorArrayNew(PyTypeObject *, PyObject *, PyObject *);
+void vectorArrayDeInit(VectorArray *);
+PyObject *vectorArrayFromBytes(PyObject *, FASTCALL_PARAMETERS);
+PyObject *vectorArrayToBytes(VectorArray *);
+
+// utils.c
+VectorArray *_vectorArrayNew(PyTypeObject *, Py_ssize_t, unsigned int);
+const char *_vectorArrayElementName(PyTypeObject *);
+PyObject *_vectorArrayElement(VectorArray *, Py_ssize_t);
+unsigned char _vectorArrayOperand(PyObject *, VectorArrayOperand *);
+void _vectorArrayCombine(VectorArrayOperand *, VectorArrayOperand *, VECTOR_TYPE, VECTOR_TYPE *, Py_ssize_t);
+static void _vectorArrayTransformTask(void *, Py_ssize_t, Py_ssize_t, unsigned int);
+unsigned char _vectorArrayTransformInto(VectorArray *, Matrix *, VECTOR_TYPE *, unsigned char);
+VectorArray *_vectorArrayTransform(VectorArray *, Matrix *);
+unsigned char _vectorArrayParseBatch(BatchElements *, const char *, PyObject *, PyObject *, PyTypeObject *,
+                                     unsigned int, unsigned int);
+void _vectorArrayReleaseBatch(BatchElements *);
+
+// operations.c
+Py_ssize_t vectorArrayLength(VectorArray *);
+PyObject *vectorArrayItem(VectorArray *, Py_ssize_t);
+static PyObject *_vectorArrayAddOrSub(PyObject *, PyObject *, VECTOR_TYPE);
+PyObject *vectorArrayAdd(PyObject *, PyObject *);
+PyObject *vectorArraySub(PyObject *, PyObject *);
+PyObject *vectorArrayMul(PyObject *, PyObject *);
+PyObject *vectorArrayNeg(VectorArray *);
+PyObject *vectorArrayRichCmp(PyObject *, PyObject *, int);
+PyObject *vectorArrayCentroid(VectorArray *);
+PyObject *vectorArrayBounds(VectorArray *);
+PyObject *vectorArrayTransformMethod(VectorArray *, PyObject *);
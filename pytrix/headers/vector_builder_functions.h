@@ -0,0 +1,31 @@
+/*
+ *  Copyright (C) 2016 Warren Spencer warrenspencer27@gmail.com
+
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// builder.c
+PyObject *vectorBuilderNew(PyTypeObject *, PyObject *, PyObject *);
+void vectorBuilderDeInit(VectorBuilder *);
+static Vector *_vectorBuilderVector(VectorBuilder *);
+static Vector *_vectorBuilderOperand(PyObject *);
+Py_ssize_t vectorBuilderLength(VectorBuilder *);
+PyObject *vectorBuilderItem(VectorBuilder *, Py_ssize_t);
+int vectorBuilderAssItem(VectorBuilder *, Py_ssize_t, PyObject *);
+PyObject *vectorBuilderInplaceAdd(VectorBuilder *, PyObject *);
+PyObject *vectorBuilderInplaceSub(VectorBuilder *, PyObject *);
+PyObject *vectorBuilderInplaceMul(VectorBuilder *, PyObject *);
+PyObject *vectorBuilderFreeze(VectorBuilder *);
+PyObject *vectorBuilderDimensions(VectorBuilder *, void *);
+PyObject *vectorBuilderStr(VectorBuilder *);
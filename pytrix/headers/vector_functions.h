@@ -16,7 +16,12 @@
  */
 
 // init.c
-static int vectorInit(Vector *, PyObject *);
+static int _vectorInitFromArray(Vector *, PyObject *const *, Py_ssize_t);
+static int vectorInit(Vector *, PyObject *, PyObject *);
+#ifdef HAVE_TYPE_VECTORCALL
+PyObject *vectorVectorcall(PyObject *, PyObject *const *, size_t, PyObject *);
+#endif
+PyObject *vectorZeros(PyObject *, FASTCALL_KEYWORDS_PARAMETERS);
 static void vectorDeInit(Vector *);
 
 //operations.c
@@ -35,11 +40,22 @@ PyObject *vectorDiv(PyObject *, PyObject *);
 PyObject *vectorNeg(Vector *);
 PyObject *vectorOrthogonal(Vector *, PyObject *);
 PyObject *vectorRichCmp(PyObject *, PyObject *, int);
+Py_hash_t vectorHash(Vector *);
 int vectorTrue(Vector *);
 PyObject *vectorItem(PyObject *, Py_ssize_t);
 
+// io.c
+PyObject *vectorSave(Vector *, PyObject *);
+PyObject *vectorLoad(PyObject *, PyObject *, PyObject *);
+PyObject *vectorFromBytes(PyObject *, PyObject *);
+PyObject *vectorToBytes(Vector *);
+PyObject *vectorToList(Vector *);
+PyObject *vectorReduceEx(Vector *, FASTCALL_PARAMETERS);
+
 // utils.c
 Vector *_vectorNew(unsigned int);
+Vector *_vectorNewView(unsigned int, VECTOR_TYPE *, PyObject *);
+void _vectorFreeData(Vector *);
 void _vectorCopyData(Vector *, Vector *);
 Vector *_vectorCopy(Vector *);
 unsigned char _assertVectorDimensionsEqual(Vector *, Vector *);
@@ -48,6 +64,9 @@ unsigned char _assertVector(PyObject *);
 PyObject *_vectorToTuple(Vector *);
 VECTOR_TYPE _vectorDot(Vector *, Vector *);
 VECTOR_TYPE _vectorLength(Vector *);
+void _inplaceVectorAdd(Vector *, Vector *, Vector *);
+void _inplaceVectorSub(Vector *, Vector *, Vector *);
+void _inplaceVectorMul(Vector *, VECTOR_TYPE, Vector *);
 Vector *_vectorAdd(Vector *, Vector *);
 Vector *_vectorSub(Vector *, Vector *);
 Vector *_vectorMul(Vector *, VECTOR_TYPE);
@@ -0,0 +1,316 @@
+/*
+ *  Copyright (C) 2016 Warren Spencer warrenspencer27@gmail.com
+
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+static void _kdTreeSwap(KDTree *tree, Py_ssize_t i, Py_ssize_t j) {
+/*  Swaps two points of a KDTree, along with their indices.
+
+    Inputs: tree - The tree.
+            i    - The position of the first point.
+            j    - The position of the second point.
+*/
+
+    VECTOR_TYPE *a = KDTree_GetPoint(tree, i),
+                *b = KDTree_GetPoint(tree, j),
+                value;
+    Py_ssize_t index;
+    unsigned int d;
+
+    for (d = 0; d < tree->dimensions; d++) {
+        value = a[d];
+        a[d] = b[d];
+        b[d] = value;
+    }
+
+    index = tree->indices[i];
+    tree->indices[i] = tree->indices[j];
+    tree->indices[j] = index;
+}
+
+
+static void _kdTreeSelect(KDTree *tree, Py_ssize_t lo, Py_ssize_t hi, Py_ssize_t nth, unsigned int d) {
+/*  Partially sorts the points of a range of a KDTree along a dimension, so that the nth point is the one which would be
+    there were the range fully sorted, every point before it is no greater along d and every point after it no less.
+
+    Inputs: tree - The tree.
+            lo   - The position of the first point of the range.
+            hi   - The position after the last point of the range.
+            nth  - The position to select the point of.
+            d    - The dimension to sort the points along.
+*/
+
+    Py_ssize_t left = lo,
+               right = hi - 1,
+               middle,
+               i,
+               j;
+    VECTOR_TYPE pivot;
+
+    #define KDTREE_VALUE(position) KDTree_GetPoint(tree, position)[d]
+
+    while (right > left) {
+        // Order the first, middle & last points, and partition around the median of the three
+        middle = left + (right - left) / 2;
+        if (KDTREE_VALUE(middle) < KDTREE_VALUE(left))
+            _kdTreeSwap(tree, middle, left);
+        if (KDTREE_VALUE(right) < KDTREE_VALUE(left))
+            _kdTreeSwap(tree, right, left);
+        if (KDTREE_VALUE(right) < KDTREE_VALUE(middle))
+            _kdTreeSwap(tree, right, middle);
+        pivot = KDTREE_VALUE(middle);
+
+        i = left;
+        j = right;
+        while (i <= j) {
+            while (KDTREE_VALUE(i) < pivot)
+                i++;
+            while (KDTREE_VALUE(j) > pivot)
+                j--;
+            if (i <= j)
+                _kdTreeSwap(tree, i++, j--);
+        }
+
+        // Points [left, j] are no greater than the pivot, and points [i, right] no less
+        if (nth <= j)
+            right = j;
+        else if (nth >= i)
+            left = i;
+        else
+            break;
+    }
+
+    #undef KDTREE_VALUE
+}
+
+
+static unsigned int _kdTreeSpreadDimension(KDTree *tree, Py_ssize_t lo, Py_ssize_t hi) {
+/*  Finds the dimension along which the points of a range of a KDTree are most spread out.
+
+    Inputs: tree - The tree.
+            lo   - The position of the first point of the range.
+            hi   - The position after the last point of the range.
+
+    Outputs: The dimension with the greatest difference between its largest and smallest values.
+*/
+
+    VECTOR_TYPE *point,
+                low,
+                high,
+                spread = -1;
+    Py_ssize_t i;
+    unsigned int d,
+                 widest = 0;
+
+    for (d = 0; d < tree->dimensions; d++) {
+        low = high = KDTree_GetPoint(tree, lo)[d];
+        for (i = lo + 1; i < hi; i++) {
+            point = KDTree_GetPoint(tree, i);
+            low = point[d] < low ? point[d] : low;
+            high = point[d] > high ? point[d] : high;
+        }
+
+        if (high - low > spread) {
+            spread = high - low;
+            widest = d;
+        }
+    }
+
+    return widest;
+}
+
+
+static Py_ssize_t _kdTreeSplit(KDTree *tree, Py_ssize_t lo, Py_ssize_t hi) {
+/*  Splits the points of a range of a KDTree around their median along the dimension they are most spread out in.
+
+    Inputs: tree - The tree.
+            lo   - The position of the first point of the range.
+            hi   - The position after the last point of the range.
+
+    Outputs: The position of the median point.
+*/
+
+    Py_ssize_t middle = lo + (hi - lo) / 2;
+    unsigned int d = _kdTreeSpreadDimension(tree, lo, hi);
+
+    _kdTreeSelect(tree, lo, hi, middle, d);
+    tree->splits[middle] = d;
+
+    return middle;
+}
+
+
+static void _kdTreeBuild(KDTree *tree, Py_ssize_t lo, Py_ssize_t hi) {
+/*  Builds the subtree of a KDTree holding a range of its points.
+
+    Inputs: tree - The tree.
+            lo   - The position of the first point of the range.
+            hi   - The position after the last point of the range.
+*/
+
+    Py_ssize_t middle;
+
+    while (hi - lo > KDTREE_LEAF_SIZE) {
+        middle = _kdTreeSplit(tree, lo, hi);
+        _kdTreeBuild(tree, lo, middle);
+        lo = middle + 1;
+    }
+}
+
+
+static Py_ssize_t _kdTreeBuildTop(KDTree *tree, Py_ssize_t lo, Py_ssize_t hi, unsigned int depth, Py_ssize_t *ranges,
+                                  Py_ssize_t count) {
+/*  Builds the top levels of the subtree of a KDTree holding a range of its points, recording the ranges of the
+    subtrees below them so that they can be built independently.
+
+    Inputs: tree   - The tree.
+            lo     - The position of the first point of the range.
+            hi     - The position after the last point of the range.
+            depth  - The number of levels to build.
+            ranges - The array to record the first & last + 1 positions of each remaining subtree in.
+            count  - The number of subtrees already recorded in ranges.
+
+    Outputs: The number of subtrees recorded in ranges.
+*/
+
+    Py_ssize_t middle;
+
+    if (depth == 0 || hi - lo <= KDTREE_LEAF_SIZE) {
+        ranges[2 * count] = lo;
+        ranges[2 * count + 1] = hi;
+        return count + 1;
+    }
+
+    middle = _kdTreeSplit(tree, lo, hi);
+    count = _kdTreeBuildTop(tree, lo, middle, depth - 1, ranges, count);
+    return _kdTreeBuildTop(tree, middle + 1, hi, depth - 1, ranges, count);
+}
+
+
+static void _kdTreeBuildTask(void *context, Py_ssize_t start, Py_ssize_t end, unsigned int worker) {
+/*  Builds a number of independent subtrees of a KDTree.
+
+    Inputs: context - The KDTreeBuild holding the ranges of the subtrees.
+            start   - The index of the first subtree to build.
+            end     - The index after the last subtree to build.
+            worker  - The index of the thread running the task; unused.
+*/
+
+    KDTreeBuild *build = (KDTreeBuild *)context;
+    Py_ssize_t i;
+
+    for (i = start; i < end; i++)
+        _kdTreeBuild(build->tree, build->ranges[2 * i], build->ranges[2 * i + 1]);
+}
+
+
+PyObject *kdTreeNew(PyTypeObject *type, PyObject *args, PyObject *kwds) {
+/*  Builds a KDTree over a copy of the coordinates of a set of points.  The top levels of the tree are built first,
+    after which the subtrees below them are built in parallel, without holding the GIL.
+
+    Inputs: type - The KDTree type.
+            args - A tuple containing a PointCloud or a sequence of Points to build the tree over.
+            kwds - Optionally contains points instead.
+
+    Outputs: A new KDTree, or NULL if an error occurred.
+*/
+
+    static char *kwlist[] = {"points", NULL};
+    Py_ssize_t ranges[2 << KDTREE_PARALLEL_DEPTH],
+               i;
+    KDTreeBuild build;
+    PyObject *points;
+    KDTree *self;
+    VECTOR_TYPE *components;
+    unsigned char owned;
+    unsigned int d;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O:KDTree", kwlist, &points))
+        return NULL;
+
+    if ((self = PyObject_New(KDTree, type)) == NULL)
+        return NULL;
+    self->points = NULL;
+    self->indices = NULL;
+    self->splits = NULL;
+
+    if (!_pointSetComponents("KDTree", points, &components, &self->count, &self->dimensions, &owned)) {
+        Py_DECREF(self);
+        return NULL;
+    }
+
+    if (self->count && self->dimensions == 0) {
+        PyErr_SetString(PyExc_ValueError, "KDTree() requires Points of at least one dimension.");
+        goto error;
+    }
+
+    self->points = PyMem_New(VECTOR_TYPE, (size_t)self->count * self->dimensions + 1);
+    self->indices = PyMem_New(Py_ssize_t, self->count + 1);
+    self->splits = PyMem_New(unsigned int, self->count + 1);
+    if (self->points == NULL || self->indices == NULL || self->splits == NULL) {
+        PyErr_NoMemory();
+        goto error;
+    }
+
+    build.tree = self;
+    build.ranges = ranges;
+
+    Py_BEGIN_ALLOW_THREADS
+    for (i = 0; i < self->count; i++) {
+        self->indices[i] = i;
+        for (d = 0; d < self->dimensions; d++)
+            KDTree_GetPoint(self, i)[d] = components[(size_t)d * self->count + i];
+    }
+
+    // Smaller trees aren't worth starting threads for, and are built in one piece
+    i = _kdTreeBuildTop(self, 0, self->count, self->count >= PARALLEL_MIN_CHUNK ? KDTREE_PARALLEL_DEPTH : 0, ranges, 0);
+    _parallelFor(_kdTreeBuildTask, &build, i, 1);
+    Py_END_ALLOW_THREADS
+
+    if (owned)
+        PyMem_Free(components);
+    return (PyObject *)self;
+
+error:
+    if (owned)
+        PyMem_Free(components);
+    Py_DECREF(self);
+    return NULL;
+}
+
+
+void kdTreeDeInit(KDTree *self) {
+/*  Frees a KDTree.
+
+    Inputs: self - The tree to free.
+*/
+
+    PyMem_Free(self->points);
+    PyMem_Free(self->indices);
+    PyMem_Free(self->splits);
+    PyObject_Del(self);
+}
+
+
+Py_ssize_t kdTreeLength(KDTree *self) {
+/*  Returns the number of points in a KDTree.
+
+    Inputs: self - The tree.
+
+    Outputs: The number of points self was built over.
+*/
+
+    return self->count;
+}
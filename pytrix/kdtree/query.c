@@ -0,0 +1,653 @@
+/*
+ *  Copyright (C) 2016 Warren Spencer warrenspencer27@gmail.com
+
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+static void _kdTreeNeighboursSiftDown(KDTreeNeighbours *neighbours, Py_ssize_t i, Py_ssize_t size) {
+/*  Restores the heap order of the first size neighbours found by a query, after the neighbour at position i has been
+    replaced with a nearer one.
+
+    Inputs: neighbours - The neighbours.
+            i          - The position of the replaced neighbour.
+            size       - The number of neighbours in the heap.
+*/
+
+    VECTOR_TYPE *distances = neighbours->distances,
+                distance = distances[i];
+    Py_ssize_t *indices = neighbours->indices,
+               index = indices[i],
+               child;
+
+    while ((child = 2 * i + 1) < size) {
+        if (child + 1 < size && KDTree_Nearer(distances[child], indices[child], distances[child + 1],
+                                              indices[child + 1]))
+            child++;
+        if (!KDTree_Nearer(distance, index, distances[child], indices[child]))
+            break;
+
+        distances[i] = distances[child];
+        indices[i] = indices[child];
+        i = child;
+    }
+
+    distances[i] = distance;
+    indices[i] = index;
+}
+
+
+static void _kdTreeNeighboursPush(KDTreeNeighbours *neighbours, VECTOR_TYPE distance, Py_ssize_t index) {
+/*  Offers a point to the neighbours found by a query, keeping it if it is among the k nearest found so far.
+
+    Inputs: neighbours - The neighbours.
+            distance   - The squared distance of the point from the query.
+            index      - The index of the point.
+*/
+
+    VECTOR_TYPE *distances = neighbours->distances;
+    Py_ssize_t *indices = neighbours->indices,
+               i,
+               parent;
+
+    if (neighbours->size == neighbours->k) {
+        if (KDTree_Nearer(distance, index, distances[0], indices[0])) {
+            distances[0] = distance;
+            indices[0] = index;
+            _kdTreeNeighboursSiftDown(neighbours, 0, neighbours->size);
+        }
+        return;
+    }
+
+    for (i = neighbours->size++; i > 0; i = parent) {
+        parent = (i - 1) / 2;
+        if (!KDTree_Nearer(distances[parent], indices[parent], distance, index))
+            break;
+
+        distances[i] = distances[parent];
+        indices[i] = indices[parent];
+    }
+
+    distances[i] = distance;
+    indices[i] = index;
+}
+
+
+static void _kdTreeNeighboursSort(KDTreeNeighbours *neighbours) {
+/*  Sorts the neighbours found by a query from nearest to farthest, in place.
+
+    Inputs: neighbours - The neighbours.
+*/
+
+    VECTOR_TYPE distance;
+    Py_ssize_t index,
+               size;
+
+    for (size = neighbours->size - 1; size > 0; size--) {
+        distance = neighbours->distances[size];
+        index = neighbours->indices[size];
+        neighbours->distances[size] = neighbours->distances[0];
+        neighbours->indices[size] = neighbours->indices[0];
+        neighbours->distances[0] = distance;
+        neighbours->indices[0] = index;
+        _kdTreeNeighboursSiftDown(neighbours, 0, size);
+    }
+}
+
+
+static VECTOR_TYPE _kdTreeDistance(KDTree *tree, Py_ssize_t i, VECTOR_TYPE *query) {
+/*  Computes the squared distance from a point of a KDTree to a query point.
+
+    Inputs: tree  - The tree.
+            i     - The position of the point in the tree.
+            query - The coordinates of the query point.
+
+    Outputs: The squared distance between the points.
+*/
+
+    VECTOR_TYPE *point = KDTree_GetPoint(tree, i),
+                distance = 0,
+                difference;
+    unsigned int d;
+
+    for (d = 0; d < tree->dimensions; d++) {
+        difference = point[d] - query[d];
+        distance += difference * difference;
+    }
+
+    return distance;
+}
+
+
+static void _kdTreeNearest(KDTree *tree, Py_ssize_t lo, Py_ssize_t hi, KDTreeNeighbours *neighbours) {
+/*  Finds the nearest points to a query in the subtree of a KDTree holding a range of its points.  The side of each
+    split the query lies on is searched first, and the other side only if it could hold a nearer point.
+
+    Inputs: tree       - The tree.
+            lo         - The position of the first point of the range.
+            hi         - The position after the last point of the range.
+            neighbours - The neighbours found so far, which are updated with any nearer points.
+*/
+
+    Py_ssize_t middle,
+               i;
+    VECTOR_TYPE difference;
+
+    if (hi - lo <= KDTREE_LEAF_SIZE) {
+        for (i = lo; i < hi; i++)
+            _kdTreeNeighboursPush(neighbours, _kdTreeDistance(tree, i, neighbours->query), tree->indices[i]);
+        return;
+    }
+
+    middle = lo + (hi - lo) / 2;
+    difference = neighbours->query[tree->splits[middle]] - KDTree_GetPoint(tree, middle)[tree->splits[middle]];
+
+    if (difference <= 0)
+        _kdTreeNearest(tree, lo, middle, neighbours);
+    else
+        _kdTreeNearest(tree, middle + 1, hi, neighbours);
+
+    _kdTreeNeighboursPush(neighbours, _kdTreeDistance(tree, middle, neighbours->query), tree->indices[middle]);
+
+    // Points on the other side of the split are at least as far away as the split itself; equally distant points are
+    // still searched for, so that ties are always resolved to the lowest indices
+    if (neighbours->size < neighbours->k || difference * difference <= neighbours->distances[0]) {
+        if (difference <= 0)
+            _kdTreeNearest(tree, middle + 1, hi, neighbours);
+        else
+            _kdTreeNearest(tree, lo, middle, neighbours);
+    }
+}
+
+
+static unsigned char _kdTreeMatch(KDTreeMatches *matches, Py_ssize_t index) {
+/*  Records a point matched by a radius or box query.
+
+    Inputs: matches - The matches found so far.
+            index   - The index of the matched point.
+
+    Outputs: 1 if successful, otherwise 0 with a MemoryError set.
+*/
+
+    Py_ssize_t *indices;
+
+    if (matches->count == matches->capacity) {
+        if ((indices = PyMem_Realloc(matches->indices, sizeof(Py_ssize_t) * (matches->capacity * 2 + 16))) == NULL) {
+            PyErr_NoMemory();
+            return 0;
+        }
+        matches->indices = indices;
+        matches->capacity = matches->capacity * 2 + 16;
+    }
+
+    matches->indices[matches->count++] = index;
+    return 1;
+}
+
+
+static unsigned char _kdTreeWithin(KDTree *tree, Py_ssize_t lo, Py_ssize_t hi, VECTOR_TYPE *query, VECTOR_TYPE radius,
+                                   KDTreeMatches *matches) {
+/*  Finds the points within a distance of a query in the subtree of a KDTree holding a range of its points.
+
+    Inputs: tree    - The tree.
+            lo      - The position of the first point of the range.
+            hi      - The position after the last point of the range.
+            query   - The coordinates of the query point.
+            radius  - The square of the distance to search within.
+            matches - The matches found so far, which are appended to.
+
+    Outputs: 1 if successful, otherwise 0 with an error set.
+*/
+
+    Py_ssize_t middle,
+               i;
+    VECTOR_TYPE difference;
+
+    if (hi - lo <= KDTREE_LEAF_SIZE) {
+        for (i = lo; i < hi; i++)
+            if (_kdTreeDistance(tree, i, query) <= radius && !_kdTreeMatch(matches, tree->indices[i]))
+                return 0;
+        return 1;
+    }
+
+    middle = lo + (hi - lo) / 2;
+    difference = query[tree->splits[middle]] - KDTree_GetPoint(tree, middle)[tree->splits[middle]];
+
+    if ((difference <= 0 || difference * difference <= radius) && !_kdTreeWithin(tree, lo, middle, query, radius,
+                                                                                 matches))
+        return 0;
+    if (_kdTreeDistance(tree, middle, query) <= radius && !_kdTreeMatch(matches, tree->indices[middle]))
+        return 0;
+    if (difference >= 0 || difference * difference <= radius)
+        return _kdTreeWithin(tree, middle + 1, hi, query, radius, matches);
+
+    return 1;
+}
+
+
+static unsigned char _kdTreeContains(KDTree *tree, Py_ssize_t i, VECTOR_TYPE *lower, VECTOR_TYPE *upper) {
+/*  Determines whether a point of a KDTree lies within an axis aligned box.
+
+    Inputs: tree  - The tree.
+            i     - The position of the point in the tree.
+            lower - The lowest corner of the box.
+            upper - The highest corner of the box.
+
+    Outputs: 1 if the point lies within the box, including on its boundary, otherwise 0.
+*/
+
+    VECTOR_TYPE *point = KDTree_GetPoint(tree, i);
+    unsigned int d;
+
+    for (d = 0; d < tree->dimensions; d++)
+        if (point[d] < lower[d] || point[d] > upper[d])
+            return 0;
+
+    return 1;
+}
+
+
+static unsigned char _kdTreeInBox(KDTree *tree, Py_ssize_t lo, Py_ssize_t hi, VECTOR_TYPE *lower, VECTOR_TYPE *upper,
+                                  KDTreeMatches *matches) {
+/*  Finds the points within an axis aligned box in the subtree of a KDTree holding a range of its points.
+
+    Inputs: tree    - The tree.
+            lo      - The position of the first point of the range.
+            hi      - The position after the last point of the range.
+            lower   - The lowest corner of the box.
+            upper   - The highest corner of the box.
+            matches - The matches found so far, which are appended to.
+
+    Outputs: 1 if successful, otherwise 0 with an error set.
+*/
+
+    Py_ssize_t middle,
+               i;
+    unsigned int d;
+
+    if (hi - lo <= KDTREE_LEAF_SIZE) {
+        for (i = lo; i < hi; i++)
+            if (_kdTreeContains(tree, i, lower, upper) && !_kdTreeMatch(matches, tree->indices[i]))
+                return 0;
+        return 1;
+    }
+
+    middle = lo + (hi - lo) / 2;
+    d = tree->splits[middle];
+
+    if (lower[d] <= KDTree_GetPoint(tree, middle)[d] && !_kdTreeInBox(tree, lo, middle, lower, upper, matches))
+        return 0;
+    if (_kdTreeContains(tree, middle, lower, upper) && !_kdTreeMatch(matches, tree->indices[middle]))
+        return 0;
+    if (upper[d] >= KDTree_GetPoint(tree, middle)[d])
+        return _kdTreeInBox(tree, middle + 1, hi, lower, upper, matches);
+
+    return 1;
+}
+
+
+static void _kdTreeBatchTask(void *context, Py_ssize_t start, Py_ssize_t end, unsigned int worker) {
+/*  Finds the nearest points of a KDTree to a range of query points.
+
+    Inputs: context - The KDTreeBatch to run.
+            start   - The index of the first query point.
+            end     - The index after the last query point.
+            worker  - The index of the thread running the task.
+*/
+
+    KDTreeBatch *batch = (KDTreeBatch *)context;
+    KDTreeNeighbours neighbours;
+    Py_ssize_t i;
+    unsigned int d;
+
+    neighbours.query = batch->scratch + (size_t)worker * batch->tree->dimensions;
+    neighbours.k = batch->k;
+
+    for (i = start; i < end; i++) {
+        for (d = 0; d < batch->tree->dimensions; d++)
+            neighbours.query[d] = batch->queries[(size_t)d * batch->count + i];
+
+        neighbours.size = 0;
+        neighbours.distances = batch->distances + (size_t)i * batch->k;
+        neighbours.indices = batch->indices + (size_t)i * batch->k;
+        _kdTreeNearest(batch->tree, 0, batch->tree->count, &neighbours);
+        _kdTreeNeighboursSort(&neighbours);
+    }
+}
+
+
+static VECTOR_TYPE *_kdTreeQueryPoint(KDTree *self, const char *name, PyObject *point) {
+/*  Validates a query point passed to a KDTree.
+
+    Inputs: self  - The tree being queried.
+            name  - The name of the query method, for error messages.
+            point - The object passed as the query point.
+
+    Outputs: The coordinates of the point, or NULL with an error set if it is not a Point of the tree's dimensions.
+*/
+
+    if (!Point_Check(point)) {
+        PyErr_Format(PyExc_TypeError, "%.200s() requires a Point, not: \"%.400s\"", name, Py_TYPE(point)->tp_name);
+        return NULL;
+    }
+
+    if (self->count && ((Point *)point)->dimensions != self->dimensions) {
+        PyErr_Format(PyExc_ValueError, "%.200s() requires a Point of %u dimensions, not %u", name, self->dimensions,
+                     ((Point *)point)->dimensions);
+        return NULL;
+    }
+
+    return ((Point *)point)->data;
+}
+
+
+static unsigned char _kdTreeParseK(PyObject *arg, Py_ssize_t count, Py_ssize_t *k) {
+/*  Parses the number of neighbours to find passed to a KDTree query.
+
+    Inputs: arg   - The object passed as k.
+            count - The number of points in the tree.
+            k     - Set to the number of neighbours to find; no more than count.
+
+    Outputs: 1 if successful, otherwise 0 with an error set.
+*/
+
+    long value;
+
+    if (!_parseLongArg(arg, &value))
+        return 0;
+
+    if (value < 1) {
+        PyErr_Format(PyExc_ValueError, "k must be at least 1, not %ld", value);
+        return 0;
+    }
+
+    *k = value < count ? (Py_ssize_t)value : count;
+    return 1;
+}
+
+
+static PyObject *_kdTreeNeighboursToList(VECTOR_TYPE *distances, Py_ssize_t *indices, Py_ssize_t count) {
+/*  Converts the sorted neighbours found by a query to a list.
+
+    Inputs: distances - The squared distance of each neighbour.
+            indices   - The index of each neighbour.
+            count     - The number of neighbours.
+
+    Outputs: A list of (distance, index) tuples, or NULL if an error occurred.
+*/
+
+    PyObject *list,
+             *item;
+    Py_ssize_t i;
+
+    if ((list = PyList_New(count)) == NULL)
+        return NULL;
+
+    for (i = 0; i < count; i++) {
+        if ((item = Py_BuildValue("(dn)", sqrt(distances[i]), indices[i])) == NULL) {
+            Py_DECREF(list);
+            return NULL;
+        }
+        PyList_SET_ITEM(list, i, item);
+    }
+
+    return list;
+}
+
+
+static int _kdTreeCompareIndices(const void *a, const void *b) {
+/*  Orders two point indices, for qsort.
+
+    Inputs: a - A pointer to the first index.
+            b - A pointer to the second index.
+
+    Outputs: A negative number, zero or a positive number if a is less than, equal to or greater than b.
+*/
+
+    Py_ssize_t first = *(const Py_ssize_t *)a,
+               second = *(const Py_ssize_t *)b;
+
+    return (first > second) - (first < second);
+}
+
+
+static PyObject *_kdTreeMatchesToList(KDTreeMatches *matches) {
+/*  Converts the points matched by a radius or box query to a sorted list of their indices, and frees the matches.
+
+    Inputs: matches - The matches.
+
+    Outputs: A list of ints, or NULL if an error occurred.
+*/
+
+    PyObject *list,
+             *item;
+    Py_ssize_t i;
+
+    // qsort may not be given a NULL array, even an empty one
+    if (matches->count > 1)
+        qsort(matches->indices, matches->count, sizeof(Py_ssize_t), _kdTreeCompareIndices);
+
+    if ((list = PyList_New(matches->count)) != NULL) {
+        for (i = 0; i < matches->count; i++) {
+            if ((item = PyLong_FromSsize_t(matches->indices[i])) == NULL) {
+                Py_CLEAR(list);
+                break;
+            }
+            PyList_SET_ITEM(list, i, item);
+        }
+    }
+
+    PyMem_Free(matches->indices);
+    return list;
+}
+
+
+PyObject *kdTreeQuery(KDTree *self, FASTCALL_KEYWORDS_PARAMETERS) {
+/*  Finds the k points of a KDTree nearest to a query point.
+
+    Inputs: self    - The tree to query.
+            args    - The query Point, optionally followed by k; the number of neighbours to find.  Defaults to 1.
+            nargs   - The number of positional arguments in args.
+            kwnames - The names of any keyword arguments passed.
+
+    Outputs: A list of up to k (distance, index) tuples, from nearest to farthest, where index is the position of the
+             point in the points the tree was built from.  Equally distant points are ordered by index.  NULL if an
+             error occurred.
+*/
+
+    FASTCALL_KEYWORDS_UNPACK_ARGS
+    PyObject *kArg = NULL,
+             *result;
+    KDTreeNeighbours neighbours;
+    Py_ssize_t k = 1;
+
+    if (!_parseOptionalArg("query", "k", 1, args, nargs, kwnames, &kArg))
+        return NULL;
+
+    if ((neighbours.query = _kdTreeQueryPoint(self, "query", args[0])) == NULL)
+        return NULL;
+    if (kArg != NULL && !_kdTreeParseK(kArg, self->count, &k))
+        return NULL;
+    k = k < self->count ? k : self->count;
+
+    neighbours.k = k;
+    neighbours.size = 0;
+    neighbours.distances = PyMem_New(VECTOR_TYPE, k + 1);
+    neighbours.indices = PyMem_New(Py_ssize_t, k + 1);
+    if (neighbours.distances == NULL || neighbours.indices == NULL) {
+        PyMem_Free(neighbours.distances);
+        PyMem_Free(neighbours.indices);
+        return PyErr_NoMemory();
+    }
+
+    if (k) {
+        _kdTreeNearest(self, 0, self->count, &neighbours);
+        _kdTreeNeighboursSort(&neighbours);
+    }
+    result = _kdTreeNeighboursToList(neighbours.distances, neighbours.indices, neighbours.size);
+
+    PyMem_Free(neighbours.distances);
+    PyMem_Free(neighbours.indices);
+    return result;
+}
+
+
+PyObject *kdTreeQueryBatch(KDTree *self, FASTCALL_KEYWORDS_PARAMETERS) {
+/*  Finds the k points of a KDTree nearest to each of a number of query points.  The queries are split between threads,
+    without holding the GIL.
+
+    Inputs: self    - The tree to query.
+            args    - A PointCloud or a sequence of Points to query, optionally followed by k; the number of neighbours
+                      to find for each.  Defaults to 1.
+            nargs   - The number of positional arguments in args.
+            kwnames - The names of any keyword arguments passed.
+
+    Outputs: A list holding, for each query point, a list of its neighbours as returned by KDTree.query.  NULL if an
+             error occurred.
+*/
+
+    FASTCALL_KEYWORDS_UNPACK_ARGS
+    PyObject *kArg = NULL,
+             *result = NULL,
+             *item;
+    KDTreeBatch batch;
+    unsigned char owned = 0;
+    unsigned int dimensions;
+    Py_ssize_t k = 1,
+               i;
+
+    batch.distances = NULL;
+    batch.indices = NULL;
+    batch.scratch = NULL;
+
+    if (!_parseOptionalArg("query_batch", "k", 1, args, nargs, kwnames, &kArg))
+        return NULL;
+    if (kArg != NULL && !_kdTreeParseK(kArg, self->count, &k))
+        return NULL;
+
+    if (!_pointSetComponents("query_batch", args[0], &batch.queries, &batch.count, &dimensions, &owned))
+        return NULL;
+
+    if (self->count && batch.count && dimensions != self->dimensions) {
+        PyErr_Format(PyExc_ValueError, "query_batch() requires Points of %u dimensions, not %u", self->dimensions,
+                     dimensions);
+        goto cleanup;
+    }
+
+    batch.tree = self;
+    batch.k = k < self->count ? k : self->count;
+    batch.distances = PyMem_New(VECTOR_TYPE, (size_t)batch.count * batch.k + 1);
+    batch.indices = PyMem_New(Py_ssize_t, (size_t)batch.count * batch.k + 1);
+    batch.scratch = PyMem_New(VECTOR_TYPE, (size_t)PARALLEL_MAX_THREADS * self->dimensions + 1);
+    if (batch.distances == NULL || batch.indices == NULL || batch.scratch == NULL) {
+        PyErr_NoMemory();
+        goto cleanup;
+    }
+
+    if (batch.k) {
+        Py_BEGIN_ALLOW_THREADS
+        _parallelFor(_kdTreeBatchTask, &batch, batch.count, PARALLEL_MIN_CHUNK / KDTREE_LEAF_SIZE);
+        Py_END_ALLOW_THREADS
+    }
+
+    if ((result = PyList_New(batch.count)) == NULL)
+        goto cleanup;
+
+    for (i = 0; i < batch.count; i++) {
+        item = _kdTreeNeighboursToList(batch.distances + (size_t)i * batch.k, batch.indices + (size_t)i * batch.k,
+                                       batch.k);
+        if (item == NULL) {
+            Py_CLEAR(result);
+            goto cleanup;
+        }
+        PyList_SET_ITEM(result, i, item);
+    }
+
+cleanup:
+    if (owned)
+        PyMem_Free(batch.queries);
+    PyMem_Free(batch.distances);
+    PyMem_Free(batch.indices);
+    PyMem_Free(batch.scratch);
+
+    return result;
+}
+
+
+PyObject *kdTreeQueryRadius(KDTree *self, FASTCALL_PARAMETERS) {
+/*  Finds the points of a KDTree within a distance of a query point.
+
+    Inputs: self  - The tree to query.
+            args  - The query Point, followed by the distance to search within.
+            nargs - The number of arguments in args.
+
+    Outputs: A list of the indices of the points no farther than the distance from the query point, in ascending
+             order, or NULL if an error occurred.
+*/
+
+    FASTCALL_UNPACK_ARGS
+    KDTreeMatches matches;
+    VECTOR_TYPE *query,
+                radius;
+
+    if (!_assertArgCount("query_radius", nargs, 2))
+        return NULL;
+
+    if ((query = _kdTreeQueryPoint(self, "query_radius", args[0])) == NULL)
+        return NULL;
+    if (!_parseVectorTypeArg(args[1], &radius))
+        return NULL;
+
+    matches.indices = NULL;
+    matches.count = matches.capacity = 0;
+    if (radius >= 0 && self->count && !_kdTreeWithin(self, 0, self->count, query, radius * radius, &matches)) {
+        PyMem_Free(matches.indices);
+        return NULL;
+    }
+
+    return _kdTreeMatchesToList(&matches);
+}
+
+
+PyObject *kdTreeQueryBox(KDTree *self, FASTCALL_PARAMETERS) {
+/*  Finds the points of a KDTree within an axis aligned box.
+
+    Inputs: self  - The tree to query.
+            args  - The lowest & highest corners of the box, as Points.
+            nargs - The number of arguments in args.
+
+    Outputs: A list of the indices of the points within the box, including on its boundary, in ascending order, or NULL
+             if an error occurred.
+*/
+
+    FASTCALL_UNPACK_ARGS
+    KDTreeMatches matches;
+    VECTOR_TYPE *lower,
+                *upper;
+
+    if (!_assertArgCount("query_box", nargs, 2))
+        return NULL;
+
+    if ((lower = _kdTreeQueryPoint(self, "query_box", args[0])) == NULL ||
+        (upper = _kdTreeQueryPoint(self, "query_box", args[1])) == NULL)
+        return NULL;
+
+    matches.indices = NULL;
+    matches.count = matches.capacity = 0;
+    if (self->count && !_kdTreeInBox(self, 0, self->count, lower, upper, &matches)) {
+        PyMem_Free(matches.indices);
+        return NULL;
+    }
+
+    return _kdTreeMatchesToList(&matches);
+}
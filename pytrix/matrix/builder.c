@@ -0,0 +1,487 @@
+/*
+ *  Copyright (C) 2016 Warren Spencer warrenspencer27@gmail.com
+
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+PyObject *matrixBuilderNew(PyTypeObject *type, PyObject *args, PyObject *kwds) {
+/*  Creates a new matrix builder, either filled with 0s or from a copy of an existing matrix.
+
+    Inputs: type - The MatrixBuilder type.
+            args - A tuple containing either the number of rows & columns of the matrix to build, or a Matrix to copy.
+            kwds - A dictionary of keyword arguments, which must be empty.
+
+    Outputs: A new MatrixBuilder, or NULL if an error occurred.
+*/
+
+    MatrixBuilder *self;
+    Matrix *m;
+    long rows,
+         columns;
+
+    if (kwds != NULL && PyDict_Size(kwds) != 0) {
+        PyErr_SetString(PyExc_TypeError, "MatrixBuilder() takes no keyword arguments");
+        return NULL;
+    }
+
+    if (PyTuple_GET_SIZE(args) == 1 && Matrix_Check(PyTuple_GET_ITEM(args, 0))) {
+        if ((m = _matrixCopy((Matrix *)PyTuple_GET_ITEM(args, 0))) == NULL)
+            return NULL;
+
+    } else if (PyTuple_GET_SIZE(args) == 2) {
+        if (!_parseLongArg(PyTuple_GET_ITEM(args, 0), &rows) || !_parseLongArg(PyTuple_GET_ITEM(args, 1), &columns))
+            return NULL;
+
+        if (rows < 0 || columns < 0 || rows > UINT_MAX || columns > UINT_MAX) {
+            PyErr_Format(PyExc_ValueError, "Invalid Matrix dimensions: %ldx%ld", rows, columns);
+            return NULL;
+        }
+
+        if ((m = _matrixNew((unsigned int)rows, (unsigned int)columns)) == NULL)
+            return NULL;
+        _matrixInitBlank(m);
+
+    } else {
+        PyErr_SetString(PyExc_TypeError, "MatrixBuilder takes either a Matrix to copy, or a number of rows & columns.");
+        return NULL;
+    }
+
+    if ((self = (MatrixBuilder *)type->tp_alloc(type, 0)) == NULL) {
+        Py_DECREF(m);
+        return NULL;
+    }
+
+    m->isMutable = 1;
+    self->matrix = m;
+
+    return (PyObject *)self;
+}
+
+
+void matrixBuilderDeInit(MatrixBuilder *self) {
+    /* De-allocates a matrix builder. */
+
+    Py_XDECREF(self->matrix);
+    Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+
+static Matrix *_matrixBuilderMatrix(MatrixBuilder *self) {
+/*  Returns the matrix being built by a builder.
+
+    Inputs: self - The builder.
+
+    Outputs: A borrowed reference to the builder's matrix, or NULL with a ValueError set if it has been frozen.
+*/
+
+    if (self->matrix == NULL)
+        PyErr_SetString(PyExc_ValueError, "MatrixBuilder has already been frozen.");
+
+    return self->matrix;
+}
+
+
+static Matrix *_matrixBuilderOperand(PyObject *operand) {
+/*  Returns the matrix held by the operand of an in-place operation.
+
+    Inputs: operand - Either a Matrix or a MatrixBuilder.
+
+    Outputs: A borrowed reference to the operand's matrix.  NULL if operand is neither, or if an error occurred (in
+             which case a PyError is set).
+*/
+
+    if (Matrix_Check(operand))
+        return (Matrix *)operand;
+    if (MatrixBuilder_Check(operand))
+        return _matrixBuilderMatrix((MatrixBuilder *)operand);
+
+    return NULL;
+}
+
+
+static unsigned char _matrixBuilderRowArg(Matrix *m, PyObject *arg, unsigned int *row) {
+/*  Converts an argument to the index of a row of the matrix being built.
+
+    Inputs: m   - The matrix being built.
+            arg - The argument to convert.
+            row - Set to the index of the row.
+
+    Outputs: 1 if arg is the index of a row in m, else 0 with a PyError set.
+*/
+
+    long i;
+
+    if (!_parseLongArg(arg, &i))
+        return 0;
+
+    if (i < 0 || i >= m->rows) {
+        PyErr_Format(PyExc_IndexError, "Row %ld is out of range for a MatrixBuilder with %u rows.", i, m->rows);
+        return 0;
+    }
+
+    *row = (unsigned int)i;
+    return 1;
+}
+
+
+static unsigned char _matrixBuilderKey(Matrix *m, PyObject *key, unsigned int *row, unsigned int *col) {
+/*  Converts a (row, column) subscript to the indices of a value of the matrix being built.
+
+    Inputs: m   - The matrix being built.
+            key - The subscript.
+            row - Set to the index of the row.
+            col - Set to the index of the column.
+
+    Outputs: 1 if key refers to a value in m, else 0 with a PyError set.
+*/
+
+    long j;
+
+    if (!PyTuple_Check(key) || PyTuple_GET_SIZE(key) != 2) {
+        PyErr_SetString(PyExc_TypeError, "MatrixBuilder indices must be a (row, column) tuple.");
+        return 0;
+    }
+
+    if (!_matrixBuilderRowArg(m, PyTuple_GET_ITEM(key, 0), row) || !_parseLongArg(PyTuple_GET_ITEM(key, 1), &j))
+        return 0;
+
+    if (j < 0 || j >= m->columns) {
+        PyErr_Format(PyExc_IndexError, "Column %ld is out of range for a MatrixBuilder with %u columns.", j,
+                     m->columns);
+        return 0;
+    }
+
+    *col = (unsigned int)j;
+    return 1;
+}
+
+
+PyObject *matrixBuilderSubscript(MatrixBuilder *self, PyObject *key) {
+/*  Returns a single value from the matrix being built.
+
+    Inputs: self - The builder.
+            key  - A (row, column) tuple.
+
+    Outputs: A PyFloat, or NULL if an error occurred.
+*/
+
+    Matrix *m;
+    unsigned int row,
+                 col;
+
+    if ((m = _matrixBuilderMatrix(self)) == NULL || !_matrixBuilderKey(m, key, &row, &col))
+        return NULL;
+
+    return PyNumber_FROM_VECTOR_TYPE(Matrix_GetValue(m, row, col));
+}
+
+
+int matrixBuilderAssSubscript(MatrixBuilder *self, PyObject *key, PyObject *value) {
+/*  Sets a single value of the matrix being built.
+
+    Inputs: self  - The builder.
+            key   - A (row, column) tuple.
+            value - The number to set, or NULL if the value is being deleted.
+
+    Outputs: 0 if successful, else -1.
+*/
+
+    Matrix *m;
+    unsigned int row,
+                 col;
+    VECTOR_TYPE v;
+
+    if (value == NULL) {
+        PyErr_SetString(PyExc_TypeError, "MatrixBuilder values cannot be deleted.");
+        return -1;
+    }
+
+    if ((m = _matrixBuilderMatrix(self)) == NULL || !_matrixBuilderKey(m, key, &row, &col) ||
+        !_parseVectorTypeArg(value, &v))
+        return -1;
+
+    Matrix_SetValue(m, row, col, v);
+    return 0;
+}
+
+
+PyObject *matrixBuilderInplaceAdd(MatrixBuilder *self, PyObject *other) {
+/*  Adds a matrix to the matrix being built, in place.
+
+    Inputs: self  - The builder.
+            other - A Matrix or MatrixBuilder to add.
+
+    Outputs: self, or NULL if an error occurred.
+*/
+
+    Matrix *m,
+           *o;
+
+    if ((m = _matrixBuilderMatrix(self)) == NULL)
+        return NULL;
+
+    if ((o = _matrixBuilderOperand(other)) == NULL) {
+        if (PyErr_Occurred())
+            return NULL;
+        Py_INCREF(Py_NotImplemented);
+        return Py_NotImplemented;
+    }
+
+    if (!_assertMatrixDimensionsEqual(m, o))
+        return NULL;
+
+    _inplaceMatrixAdd(m, o, m);
+
+    Py_INCREF(self);
+    return (PyObject *)self;
+}
+
+
+PyObject *matrixBuilderInplaceSub(MatrixBuilder *self, PyObject *other) {
+/*  Subtracts a matrix from the matrix being built, in place.
+
+    Inputs: self  - The builder.
+            other - A Matrix or MatrixBuilder to subtract.
+
+    Outputs: self, or NULL if an error occurred.
+*/
+
+    Matrix *m,
+           *o;
+
+    if ((m = _matrixBuilderMatrix(self)) == NULL)
+        return NULL;
+
+    if ((o = _matrixBuilderOperand(other)) == NULL) {
+        if (PyErr_Occurred())
+            return NULL;
+        Py_INCREF(Py_NotImplemented);
+        return Py_NotImplemented;
+    }
+
+    if (!_assertMatrixDimensionsEqual(m, o))
+        return NULL;
+
+    _inplaceMatrixSub(m, o, m);
+
+    Py_INCREF(self);
+    return (PyObject *)self;
+}
+
+
+PyObject *matrixBuilderInplaceMul(MatrixBuilder *self, PyObject *other) {
+/*  Multiplies the matrix being built by either a scalar, or on the right by a square matrix, in place.
+
+    Inputs: self  - The builder.
+            other - A scalar, or a Matrix or MatrixBuilder with as many rows & columns as the matrix being built has
+                    columns.
+
+    Outputs: self, or NULL if an error occurred.
+*/
+
+    Matrix *m,
+           *o;
+    VECTOR_TYPE scalar;
+
+    if ((m = _matrixBuilderMatrix(self)) == NULL)
+        return NULL;
+
+    if ((o = _matrixBuilderOperand(other)) != NULL) {
+        if (o->rows != m->columns || o->columns != m->columns) {
+            PyErr_SetString(PyExc_ValueError,
+                            "In-place A * B Matrix multiplication requires B.rows = B.columns = A.columns");
+            return NULL;
+        }
+        if (!_inplaceMatrixMatrixMul(m, o, m))
+            return NULL;
+
+    } else if (PyErr_Occurred()) {
+        return NULL;
+
+    } else if (PyNumber_Check(other)) {
+        if ((scalar = PyNumber_AS_VECTOR_TYPE(other)) == -1 && PyErr_Occurred())
+            return NULL;
+        _inplaceScalarMatrixMul(m, scalar, m);
+
+    } else {
+        Py_INCREF(Py_NotImplemented);
+        return Py_NotImplemented;
+    }
+
+    Py_INCREF(self);
+    return (PyObject *)self;
+}
+
+
+PyObject *matrixBuilderSwapRows(MatrixBuilder *self, FASTCALL_PARAMETERS) {
+/*  Swaps two rows of the matrix being built.
+
+    Inputs: self  - The builder.
+            args  - The indices of the two rows to swap.
+            nargs - The number of arguments in args.
+
+    Outputs: None, or NULL if an error occurred.
+*/
+
+    FASTCALL_UNPACK_ARGS
+    Matrix *m;
+    Vector *temp;
+    unsigned int a,
+                 b;
+
+    if (!_assertArgCount("swap_rows", nargs, 2) || (m = _matrixBuilderMatrix(self)) == NULL ||
+        !_matrixBuilderRowArg(m, args[0], &a) || !_matrixBuilderRowArg(m, args[1], &b))
+        return NULL;
+
+    temp = Matrix_GetVector(m, a);
+    Matrix_SetVector(m, a, Matrix_GetVector(m, b));
+    Matrix_SetVector(m, b, temp);
+
+    Py_RETURN_NONE;
+}
+
+
+PyObject *matrixBuilderScaleRow(MatrixBuilder *self, FASTCALL_PARAMETERS) {
+/*  Multiplies a row of the matrix being built by a scalar.
+
+    Inputs: self  - The builder.
+            args  - The index of the row, and the scalar to multiply it by.
+            nargs - The number of arguments in args.
+
+    Outputs: None, or NULL if an error occurred.
+*/
+
+    FASTCALL_UNPACK_ARGS
+    Matrix *m;
+    unsigned int row;
+    VECTOR_TYPE factor;
+
+    if (!_assertArgCount("scale_row", nargs, 2) || (m = _matrixBuilderMatrix(self)) == NULL ||
+        !_matrixBuilderRowArg(m, args[0], &row) || !_parseVectorTypeArg(args[1], &factor))
+        return NULL;
+
+    _inplaceVectorMul(Matrix_GetVector(m, row), factor, Matrix_GetVector(m, row));
+
+    Py_RETURN_NONE;
+}
+
+
+PyObject *matrixBuilderAddRow(MatrixBuilder *self, FASTCALL_PARAMETERS) {
+/*  Adds a multiple of one row of the matrix being built to another.
+
+    Inputs: self  - The builder.
+            args  - The index of the row to add to, the index of the row to add, and the factor to multiply the added
+                    row by.
+            nargs - The number of arguments in args.
+
+    Outputs: None, or NULL if an error occurred.
+*/
+
+    FASTCALL_UNPACK_ARGS
+    Matrix *m;
+    Vector *dst,
+           *src;
+    unsigned int dstRow,
+                 srcRow,
+                 i;
+    VECTOR_TYPE factor;
+
+    if (!_assertArgCount("add_row", nargs, 3) || (m = _matrixBuilderMatrix(self)) == NULL ||
+        !_matrixBuilderRowArg(m, args[0], &dstRow) || !_matrixBuilderRowArg(m, args[1], &srcRow) ||
+        !_parseVectorTypeArg(args[2], &factor))
+        return NULL;
+
+    dst = Matrix_GetVector(m, dstRow);
+    src = Matrix_GetVector(m, srcRow);
+    for (i = 0; i < m->columns; i++)
+        Vector_SetValue(dst, i, Vector_GetValue(dst, i) + Vector_GetValue(src, i) * factor);
+
+    Py_RETURN_NONE;
+}
+
+
+PyObject *matrixBuilderFreeze(MatrixBuilder *self) {
+/*  Ends the building of a matrix, handing its data to an immutable Matrix without copying it.  The builder cannot be
+    used afterwards.
+
+    Inputs: self - The builder.
+
+    Outputs: The built Matrix, or NULL if the builder has already been frozen.
+*/
+
+    Matrix *m;
+
+    if ((m = _matrixBuilderMatrix(self)) == NULL)
+        return NULL;
+
+    // Our reference to the matrix is passed to the caller
+    self->matrix = NULL;
+    m->isMutable = 0;
+    m->hash = -1;
+
+    return (PyObject *)m;
+}
+
+
+PyObject *matrixBuilderRows(MatrixBuilder *self, void *closure) {
+/*  Returns the number of rows of the matrix being built.
+
+    Inputs: self    - The builder.
+            closure - Unused.
+
+    Outputs: A PyLong, or NULL if the builder has been frozen.
+*/
+
+    Matrix *m;
+
+    if ((m = _matrixBuilderMatrix(self)) == NULL)
+        return NULL;
+
+    return PyLong_FromUnsignedLong(m->rows);
+}
+
+
+PyObject *matrixBuilderColumns(MatrixBuilder *self, void *closure) {
+/*  Returns the number of columns of the matrix being built.
+
+    Inputs: self    - The builder.
+            closure - Unused.
+
+    Outputs: A PyLong, or NULL if the builder has been frozen.
+*/
+
+    Matrix *m;
+
+    if ((m = _matrixBuilderMatrix(self)) == NULL)
+        return NULL;
+
+    return PyLong_FromUnsignedLong(m->columns);
+}
+
+
+PyObject *matrixBuilderStr(MatrixBuilder *self) {
+/*  Returns a string representation of the matrix being built.
+
+    Inputs: self - The builder.
+
+    Outputs: A PyString, or NULL if an error occurred.
+*/
+
+    Matrix *m;
+
+    if ((m = _matrixBuilderMatrix(self)) == NULL)
+        return NULL;
+
+    return matrixStr(m);
+}
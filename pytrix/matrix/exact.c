@@ -0,0 +1,330 @@
+/*
+ *  Copyright (C) 2016 Warren Spencer warrenspencer27@gmail.com
+
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+/*
+    Exact determinants & ranks of integer matrices by Bareiss' fraction-free gaussian elimination.
+
+    Each step of the elimination replaces every value below & to the right of the pivot with
+    (pivot * value - left * above) / previous pivot, where the division is always exact; every value is then a minor
+    of the original matrix, so the values grow no larger than the determinant.  Columns without a pivot are skipped,
+    leaving the number of pivots as the rank of the matrix, and the last pivot of a full rank square matrix as its
+    determinant, up to the sign of the row swaps.
+
+    Elimination is done with 64 bit integers for as long as every product fits, and continued with Python ints once one
+    would not.
+*/
+
+
+static unsigned char _bareissInt64(int64_t *a, unsigned int rows, unsigned int columns, BareissState *state) {
+/*  Continues fraction-free elimination of a matrix of 64 bit integers, stopping before any product would overflow.
+
+    Inputs: a       - The values of the matrix, laid out row by row.
+            rows    - The number of rows in the matrix.
+            columns - The number of columns in the matrix.
+            state   - The progress of the elimination, which is updated as it proceeds.
+
+    Outputs: 1 if the elimination completed, or 0 if it stopped before a row whose products would overflow; the
+             elimination can be continued from state by _bareissObjects.
+*/
+
+    int64_t *pivotRow,
+            *row,
+            pivot,
+            previous,
+            left,
+            temp;
+    unsigned int i,
+                 j;
+
+    for (; state->column < columns && state->row < rows; state->column++) {
+        pivotRow = a + (size_t)state->row * columns;
+
+        if (state->next == 0) {
+            for (i = state->row; i < rows && a[(size_t)i * columns + state->column] == 0; i++);
+            if (i == rows)
+                continue;
+
+            if (i != state->row) {
+                row = a + (size_t)i * columns;
+                for (j = state->column; j < columns; j++) {
+                    temp = row[j];
+                    row[j] = pivotRow[j];
+                    pivotRow[j] = temp;
+                }
+                state->sign = -state->sign;
+            }
+            state->next = state->row + 1;
+        }
+
+        pivot = pivotRow[state->column];
+        previous = state->previous < 0 ? 1 : a[(size_t)(state->row - 1) * columns + state->previous];
+
+        for (; state->next < rows; state->next++) {
+            row = a + (size_t)state->next * columns;
+            left = row[state->column];
+
+            // Check the whole row before eliminating any of it, so that it can be redone with Python ints
+            for (j = state->column + 1; j < columns; j++)
+                if (fabs((double)pivot * (double)row[j]) >= BAREISS_INT64_LIMIT ||
+                    fabs((double)left * (double)pivotRow[j]) >= BAREISS_INT64_LIMIT)
+                    return 0;
+
+            for (j = state->column + 1; j < columns; j++)
+                row[j] = (pivot * row[j] - left * pivotRow[j]) / previous;
+            row[state->column] = 0;
+        }
+
+        state->previous = state->column;
+        state->row++;
+        state->next = 0;
+    }
+
+    return 1;
+}
+
+
+static unsigned char _bareissObjects(PyObject **a, unsigned int rows, unsigned int columns, BareissState *state) {
+/*  Continues fraction-free elimination of a matrix of Python ints.
+
+    Inputs: a       - The values of the matrix, laid out row by row, which are replaced as the elimination proceeds.
+            rows    - The number of rows in the matrix.
+            columns - The number of columns in the matrix.
+            state   - The progress of the elimination, which is updated as it proceeds.
+
+    Outputs: 1 if the elimination completed, or 0 if an error occurred.
+*/
+
+    PyObject **pivotRow,
+             **row,
+             *pivot,
+             *previous,
+             *left,
+             *temp,
+             *product,
+             *difference;
+    unsigned int i,
+                 j;
+    int nonZero;
+
+    for (; state->column < columns && state->row < rows; state->column++) {
+        pivotRow = a + (size_t)state->row * columns;
+
+        if (state->next == 0) {
+            for (i = state->row; i < rows; i++) {
+                if ((nonZero = PyObject_IsTrue(a[(size_t)i * columns + state->column])) < 0)
+                    return 0;
+                if (nonZero)
+                    break;
+            }
+            if (i == rows)
+                continue;
+
+            if (i != state->row) {
+                row = a + (size_t)i * columns;
+                for (j = state->column; j < columns; j++) {
+                    temp = row[j];
+                    row[j] = pivotRow[j];
+                    pivotRow[j] = temp;
+                }
+                state->sign = -state->sign;
+            }
+            state->next = state->row + 1;
+        }
+
+        pivot = pivotRow[state->column];
+        previous = state->previous < 0 ? NULL : a[(size_t)(state->row - 1) * columns + state->previous];
+
+        for (; state->next < rows; state->next++) {
+            row = a + (size_t)state->next * columns;
+            left = row[state->column];
+
+            for (j = state->column + 1; j < columns; j++) {
+                if ((temp = PyNumber_Multiply(pivot, row[j])) == NULL)
+                    return 0;
+                if ((product = PyNumber_Multiply(left, pivotRow[j])) == NULL) {
+                    Py_DECREF(temp);
+                    return 0;
+                }
+                difference = PyNumber_Subtract(temp, product);
+                Py_DECREF(temp);
+                Py_DECREF(product);
+                if (difference == NULL)
+                    return 0;
+
+                if (previous != NULL) {
+                    temp = PyNumber_FloorDivide(difference, previous);
+                    Py_DECREF(difference);
+                    if (temp == NULL)
+                        return 0;
+                } else
+                    temp = difference;
+
+                Py_DECREF(row[j]);
+                row[j] = temp;
+            }
+
+            if ((temp = PyLong_FromLong(0)) == NULL)
+                return 0;
+            Py_DECREF(row[state->column]);
+            row[state->column] = temp;
+        }
+
+        state->previous = state->column;
+        state->row++;
+        state->next = 0;
+    }
+
+    return 1;
+}
+
+
+static PyObject *_matrixBareiss(Matrix *m, const char *name, unsigned int *rank) {
+/*  Eliminates an integer matrix by fraction-free gaussian elimination.
+
+    Inputs: m    - The matrix to eliminate, whose values must all be integers.
+            name - The name of the calling method, for error messages.
+            rank - Where to write the rank of the matrix.
+
+    Outputs: A Python int of the last pivot of the elimination, negated if an odd number of rows were swapped; or 1 if
+             the matrix has no pivots.  NULL if an error occurred.
+*/
+
+    size_t size = (size_t)m->rows * m->columns,
+           i;
+    int64_t *values;
+    PyObject **objects = NULL,
+             *result = NULL;
+    BareissState state;
+    VECTOR_TYPE value;
+    unsigned char large = 0;
+
+    if ((values = PyMem_New(int64_t, size + 1)) == NULL)
+        return PyErr_NoMemory();
+
+    for (i = 0; i < size; i++) {
+        value = Matrix_GetValue(m, i / m->columns, i % m->columns);
+        if (!Py_IS_FINITE(value) || floor(value) != value) {
+            PyErr_Format(PyExc_ValueError, "Matrix.%s requires a Matrix of integers.", name);
+            goto cleanup;
+        }
+        if (fabs(value) >= BAREISS_INT64_LIMIT)
+            large = 1;
+        else
+            values[i] = (int64_t)value;
+    }
+
+    state.row = 0;
+    state.column = 0;
+    state.previous = -1;
+    state.next = 0;
+    state.sign = 1;
+
+    if (large || !_bareissInt64(values, m->rows, m->columns, &state)) {
+        // Continue from where the 64 bit elimination stopped with Python ints
+        if ((objects = PyMem_New(PyObject *, size + 1)) == NULL) {
+            PyErr_NoMemory();
+            goto cleanup;
+        }
+        memset(objects, 0, sizeof(PyObject *) * size);
+
+        for (i = 0; i < size; i++) {
+            if (large)
+                objects[i] = PyLong_FromDouble(Matrix_GetValue(m, i / m->columns, i % m->columns));
+            else
+                objects[i] = PyLong_FromLongLong((long long)values[i]);
+            if (objects[i] == NULL)
+                goto cleanup;
+        }
+
+        if (!_bareissObjects(objects, m->rows, m->columns, &state))
+            goto cleanup;
+
+        if (state.previous < 0)
+            result = PyLong_FromLong(1);
+        else if (state.sign < 0)
+            result = PyNumber_Negative(objects[(size_t)(state.row - 1) * m->columns + state.previous]);
+        else {
+            result = objects[(size_t)(state.row - 1) * m->columns + state.previous];
+            Py_INCREF(result);
+        }
+
+    } else {
+        result = PyLong_FromLongLong(state.previous < 0 ? 1 :
+                                     state.sign * (long long)values[(size_t)(state.row - 1) * m->columns +
+                                                                     state.previous]);
+    }
+
+    *rank = state.row;
+
+cleanup:
+    if (objects != NULL) {
+        for (i = 0; i < size; i++)
+            Py_XDECREF(objects[i]);
+        PyMem_Free(objects);
+    }
+    PyMem_Free(values);
+    return result;
+}
+
+
+PyObject *matrixDetExact(Matrix *self) {
+/*  Calculates the exact determinant of a matrix of integers.
+
+    Inputs: self - The matrix to take the determinant of.
+
+    Outputs: A Python int of the determinant of self, or NULL if an error occurred.
+*/
+
+    PyObject *pivot;
+    unsigned int rank;
+
+    if (self->rows != self->columns) {
+        PyErr_SetString(PyExc_ValueError, "Matrix.det_exact must be run on a square matrix.");
+        return NULL;
+    }
+
+    if ((pivot = _matrixBareiss(self, "det_exact", &rank)) == NULL)
+        return NULL;
+
+    if (rank < self->rows) {
+        Py_DECREF(pivot);
+        return PyLong_FromLong(0);
+    }
+
+    return pivot;
+}
+
+
+PyObject *matrixRankExact(Matrix *self) {
+/*  Determines the exact rank of a matrix of integers.
+
+    Inputs: self - The matrix to determine the rank of.
+
+    Outputs: A Python int of the rank of self, or NULL if an error occurred.
+*/
+
+    PyObject *pivot;
+    unsigned int rank;
+
+    if ((pivot = _matrixBareiss(self, "rank_exact", &rank)) == NULL)
+        return NULL;
+
+    Py_DECREF(pivot);
+    return PyLong_FromUnsignedLong((unsigned long)rank);
+}
@@ -31,127 +31,223 @@ static void _freeMatrixData(Matrix *self) {
     }
 }
 
-int matrixInit(Matrix *self, PyObject *args) {
-/*  Initializes a matrix from a sequence of either vectors or sequences.
+static int _matrixInitFromArray(Matrix *self, PyObject *const *args, Py_ssize_t nargs) {
+/*  Initializes a matrix from either a single sequence of sequences, or a series of sequences.
 
-    Inputs: self - The Matrix being initialized.
-            args - A packed version of the arguments passed to the initializer.
+    Inputs: self  - The Matrix being initialized.
+            args  - The arguments passed to the initializer.
+            nargs - The number of arguments in args.
 
     Outputs: 0 If successful, else -1
 */
 
-    unsigned int i,
-                 j;
-    PyObject *iterable = NULL,
-             *rowSequence = NULL,
-             *item = NULL;
+    unsigned int i;
+    PyObject *const *rowObjects;
+    PyObject *first,
+             *rowSequence,
+             *item;
+    Py_ssize_t rowCount,
+               failed;
     Vector *rowVector;
 
 
     // We expect either args to contain either a single iterable of iterables, or a series of iterables.
     // Assert that args isn't empty
-    if (PySequence_Length(args) == 0) {
+    if (nargs == 0) {
         PyErr_SetString(PyExc_TypeError,
                         "No input rows passed to Matrix.__init__. See help(Matrix) for more information.");
         return -1;
     }
 
-    if ((iterable = PySequence_GetItem(args, 0)) == NULL)
-        return -1;
-    if (!Compatible_Input_Sequence_Check(iterable)) {
+    first = args[0];
+    if (!Compatible_Input_Sequence_Check(first)) {
         PyErr_SetString(PyExc_TypeError, "First argument to Matrix.__init__ is not an iterable.");
         return -1;
     }
 
+    // By default, treat our arguments as the rows of the matrix
+    rowObjects = args;
+    rowCount = nargs;
+
     // If iterable is empty
-    if (PySequence_Length(iterable) == 0) {
+    if (PySequence_Fast_GET_SIZE(first) == 0) {
         // Assert that we were only given a single argument.  One empty iterable argument implies empty matrix.
         // Multiple empty iterable arguments is undefined.
-        if (PySequence_Length(args) != 1) {
+        if (nargs != 1) {
             PyErr_SetString(PyExc_TypeError, "Passing more than one empty row to Matrix.__init__ is not allowed.");
             return -1;
         }
+        rowCount = 0;
 
     // Otherwise iterable isn't empty.  Check if it contains iterables.
     } else {
-        if ((item = PySequence_GetItem(iterable, 0)) == NULL)
-            return -1;
+        item = PySequence_Fast_GET_ITEM(first, 0);
 
         // Ensure that we were given an iterable
         if (Compatible_Input_Sequence_Check(item)) {
             // If iterable contains iterables, then we have a [[...], [...]] scenario.  Ensure that there were no other
             // arguments to Matrix.__init__
-            if (PySequence_Length(args) != 1) {
+            if (nargs != 1) {
                 PyErr_SetString(PyExc_TypeError, "2d iterable passed with other arguments. Behavior is undefined.");
                 return -1;
             }
 
             // If the length of the inner iterable is empty, ensure it is the only iterable in our iterable list
             // In other words, ([[], []]) is undefined for the same reasons that ([], []) is
-            if (PySequence_Length(item) == 0 && PySequence_Length(iterable) != 1) {
+            if (PySequence_Fast_GET_SIZE(item) == 0 && PySequence_Fast_GET_SIZE(first) != 1) {
                 PyErr_SetString(PyExc_TypeError, "Passing more than one empty row to Matrix.__init__ is not allowed.");
                 return -1;
             }
 
-        // Otherwise our iterable doesn't contain iterables.  So, to get the [[...], [...]] structure required below
-        // we will set iterable to args.  As args is an iterable containing iterables.
-        } else {
-            iterable = args;
+            rowObjects = PySequence_Fast_ITEMS(first);
+            rowCount = PySequence_Fast_GET_SIZE(first);
         }
     }
 
-
-    // Parse iterable, perform validation, and parse it into our matrix.
-    self->rows = PySequence_Fast_GET_SIZE(iterable);
-    self->columns = 0;
-
-    // If our iterable has any rows ensure they are all of the same length
-    if (self->rows != 0) {
-        for (i = 0; i < self->rows; i++) {
-            item = PySequence_Fast_GET_ITEM(iterable, i);
-            if (!Compatible_Input_Sequence_Check(item)) {
-                PyErr_Format(PyExc_TypeError, "Non-sequence in iterable slot %d", i);
-                return -1;
-            }
-            if (i == 0) {
-                self->columns = PySequence_Fast_GET_SIZE(item);
-            } else {
-                if (PySequence_Fast_GET_SIZE(item) != self->columns) {
-                    PyErr_Format(PyExc_TypeError, "Length of rows in slots 0 & %d differ (%d & %d).",
-                                 i, self->columns, (int)PySequence_Fast_GET_SIZE(item));
-                    return -1;
-                }
-            }
+    // Parse our rows, perform validation, and parse them into our matrix.
+    // If we have any rows ensure they are all of the same length
+    for (i = 0; i < rowCount; i++) {
+        item = rowObjects[i];
+        if (!Compatible_Input_Sequence_Check(item)) {
+            PyErr_Format(PyExc_TypeError, "Non-sequence in iterable slot %d", i);
+            return -1;
+        }
+        if (i != 0 && PySequence_Fast_GET_SIZE(item) != PySequence_Fast_GET_SIZE(rowObjects[0])) {
+            PyErr_Format(PyExc_TypeError, "Length of rows in slots 0 & %d differ (%d & %d).",
+                         i, (int)PySequence_Fast_GET_SIZE(rowObjects[0]), (int)PySequence_Fast_GET_SIZE(item));
+            return -1;
         }
     }
 
     // If we have already been initialized, free the memory reserved in our data variable before it is reinitialized
-    if (self->data != NULL)
+    if (self->data != NULL) {
         _freeMatrixData(self);
+        self->data = NULL;
+    }
 
-    if ((self->data = PyMem_Malloc(self->rows * sizeof(Vector *))) == NULL)
+    self->hash = -1;
+    self->rows = (unsigned int)rowCount;
+    self->columns = rowCount ? (unsigned int)PySequence_Fast_GET_SIZE(rowObjects[0]) : 0;
+
+    if ((self->data = PyMem_Malloc(self->rows * sizeof(Vector *))) == NULL) {
+        PyErr_NoMemory();
         return -1;
+    }
 
     memset(self->data, '\x00', sizeof(Vector *) * self->rows);
 
-    // Initialize self->data from the given iterable
+    // Initialize self->data from our rows.  Each row is attached to the matrix before being filled, so that it is
+    // freed along with the matrix should an error occur.
     for (i = 0; i < self->rows; i++) {
-        rowSequence = PySequence_Fast_GET_ITEM(iterable, i);
-        rowVector = _vectorNew(self->columns);
-        for (j = 0; j < self->columns; j++) {
-            item = PySequence_Fast_GET_ITEM(rowSequence, j);
-            if (!PyNumber_Check(item)) {
-                PyErr_Format(PyExc_TypeError, "Non-numeric object in row %d, column %d", i, j);
-                return -1;
-            }
-            Vector_SetValue(rowVector, j, PyNumber_AS_VECTOR_TYPE(item));
-        }
+        rowSequence = rowObjects[i];
+        if ((rowVector = _vectorNew(self->columns)) == NULL)
+            return -1;
         Matrix_SetVector(self, i, rowVector);
+
+        failed = _vectorTypeArrayFromObjects(rowVector->data, PySequence_Fast_ITEMS(rowSequence), self->columns);
+        if (failed != -1) {
+            if (!PyErr_Occurred())
+                PyErr_Format(PyExc_TypeError, "Non-numeric object in row %d, column %zd", i, failed);
+            return -1;
+        }
     }
 
     return 0;
 }
 
+
+int matrixInit(Matrix *self, PyObject *args, PyObject *kwds) {
+/*  Initializes a matrix from a sequence of either vectors or sequences.
+
+    Inputs: self - The Matrix being initialized.
+            args - A packed version of the arguments passed to the initializer.
+            kwds - A dictionary of keyword arguments passed to the initializer, which must be empty.
+
+    Outputs: 0 If successful, else -1
+*/
+
+    if (kwds != NULL && PyDict_Size(kwds) != 0) {
+        PyErr_SetString(PyExc_TypeError, "Matrix() takes no keyword arguments");
+        return -1;
+    }
+
+    return _matrixInitFromArray(self, &PyTuple_GET_ITEM(args, 0), PyTuple_GET_SIZE(args));
+}
+
+
+#ifdef HAVE_TYPE_VECTORCALL
+PyObject *matrixVectorcall(PyObject *type, PyObject *const *args, size_t nargsf, PyObject *kwnames) {
+/*  Constructs a matrix without packing its arguments into a tuple.
+
+    Inputs: type    - The Matrix type.
+            args    - The arguments passed to the constructor.
+            nargsf  - The number of arguments in args, possibly with PY_VECTORCALL_ARGUMENTS_OFFSET set.
+            kwnames - The names of any keyword arguments passed.
+
+    Outputs: A new Matrix, or NULL if an error occurred.
+*/
+
+    PyObject *self;
+
+    if (kwnames != NULL && PyTuple_GET_SIZE(kwnames) != 0) {
+        PyErr_SetString(PyExc_TypeError, "Matrix() takes no keyword arguments");
+        return NULL;
+    }
+
+    if ((self = PyType_GenericNew((PyTypeObject *)type, NULL, NULL)) == NULL)
+        return NULL;
+
+    if (_matrixInitFromArray((Matrix *)self, args, PyVectorcall_NARGS(nargsf)) == -1) {
+        Py_DECREF(self);
+        return NULL;
+    }
+
+    return self;
+}
+#endif
+
+
+PyObject *matrixZeros(PyObject *cls, FASTCALL_KEYWORDS_PARAMETERS) {
+/*  Creates a new matrix filled with 0s.
+
+    Inputs: cls     - The Matrix type.
+            args    - The number of rows & columns of the matrix, followed by the optional mutable flag.
+            nargs   - The number of positional arguments in args.
+            kwnames - The names of any keyword arguments passed.
+
+    Outputs: A new Matrix, or NULL if an error occurred.  If mutable is True, the matrix may be used as the out
+             argument of pytrix's arithmetic functions.
+*/
+
+    FASTCALL_KEYWORDS_UNPACK_ARGS
+    PyObject *mutableArg = Py_False;
+    long rows,
+         columns;
+    int isMutable;
+    Matrix *m;
+
+    if (!_parseOptionalArg("zeros", "mutable", 2, args, nargs, kwnames, &mutableArg) ||
+        !_parseLongArg(args[0], &rows) || !_parseLongArg(args[1], &columns))
+        return NULL;
+
+    if (rows < 0 || columns < 0 || rows > UINT_MAX || columns > UINT_MAX) {
+        PyErr_Format(PyExc_ValueError, "Invalid Matrix dimensions: %ldx%ld", rows, columns);
+        return NULL;
+    }
+
+    if ((isMutable = PyObject_IsTrue(mutableArg)) == -1)
+        return NULL;
+
+    if ((m = _matrixNew((unsigned int)rows, (unsigned int)columns)) == NULL)
+        return NULL;
+
+    _matrixInitBlank(m);
+    m->isMutable = (char)isMutable;
+
+    return (PyObject *)m;
+}
+
+
 void matrixDeInit(Matrix *self) {
     /* De-allocates a matrix. */
 
@@ -0,0 +1,321 @@
+/*
+ *  Copyright (C) 2016 Warren Spencer warrenspencer27@gmail.com
+
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+PyObject *matrixSave(Matrix *self, PyObject *path) {
+/*  Writes this matrix to a file in numpy's .npy format.
+
+    Inputs: self - The matrix to save.
+            path - The path of the file to write to.
+
+    Outputs: None, or NULL if an error occurred.
+*/
+
+    unsigned int i,
+                 shape[2] = {self->rows, self->columns};
+    FILE *f;
+
+    if ((f = _openPath(path, "wb")) == NULL)
+        return NULL;
+
+    if (!_npyWriteHeader(f, path, 2, shape)) {
+        fclose(f);
+        return NULL;
+    }
+
+    for (i = 0; i < self->rows; i++) {
+        if (!_npyWriteData(f, path, Matrix_GetVector(self, i)->data, self->columns)) {
+            fclose(f);
+            return NULL;
+        }
+    }
+
+    if (fclose(f) != 0)
+        return PyErr_SetFromErrno(PyExc_IOError);
+
+    Py_RETURN_NONE;
+}
+
+
+static Matrix *_matrixLoadMapped(PyObject *path, NpyHeader *header) {
+/*  Creates a matrix whose rows reference the data section of a memory mapped .npy file.
+
+    Inputs: path   - The path of the .npy file.
+            header - The parsed header of the file.
+
+    Outputs: A new Matrix, or NULL if an error occurred.
+*/
+
+    PyObject *map;
+    VECTOR_TYPE *data;
+    Matrix *m;
+
+    if (header->fortranOrder) {
+        PyErr_SetString(PyExc_ValueError, "Cannot memory map an .npy file stored in Fortran order.");
+        return NULL;
+    }
+
+    if ((map = _npyMap(path, header, (size_t)header->shape[0] * header->shape[1], &data)) == NULL)
+        return NULL;
+
+    // Each row holds a reference to the mapping, which is unmapped once the last of them has been freed
+    m = _matrixNewView(header->shape[0], header->shape[1], data, map);
+    Py_DECREF(map);
+    return m;
+}
+
+
+static Matrix *_matrixLoadCopy(FILE *f, PyObject *path, NpyHeader *header) {
+/*  Creates a matrix by reading the data section of an .npy file into memory.
+
+    Inputs: f      - The .npy file, positioned at the start of its data section.
+            path   - The path that f was opened from.
+            header - The parsed header of the file.
+
+    Outputs: A new Matrix, or NULL if an error occurred.
+*/
+
+    unsigned int i,
+                 j;
+    unsigned int rows = header->shape[0],
+                 columns = header->shape[1];
+    VECTOR_TYPE *buffer;
+    Matrix *m;
+
+    if ((m = _matrixNew(rows, columns)) == NULL)
+        return NULL;
+
+    if (!header->fortranOrder) {
+        for (i = 0; i < rows; i++) {
+            if (!_npyReadData(f, path, header, Matrix_GetVector(m, i)->data, columns)) {
+                matrixDeInit(m);
+                return NULL;
+            }
+        }
+
+        return m;
+    }
+
+    // Fortran ordered data is stored column by column; read it in whole then scatter it into our rows
+    if ((buffer = PyMem_New(VECTOR_TYPE, (size_t)rows * columns)) == NULL) {
+        matrixDeInit(m);
+        return (Matrix *)PyErr_NoMemory();
+    }
+
+    if (!_npyReadData(f, path, header, buffer, (size_t)rows * columns)) {
+        PyMem_Free(buffer);
+        matrixDeInit(m);
+        return NULL;
+    }
+
+    for (i = 0; i < rows; i++)
+        for (j = 0; j < columns; j++)
+            Matrix_SetValue(m, i, j, buffer[(size_t)j * rows + i]);
+
+    PyMem_Free(buffer);
+    return m;
+}
+
+
+PyObject *matrixLoad(PyObject *cls, PyObject *args, PyObject *kwargs) {
+/*  Creates a new matrix from a 2 dimensional float64 array stored in numpy's .npy format.
+
+    Inputs: cls    - The Matrix type.
+            args   - A tuple containing the path of the file to load.
+            kwargs - Optionally contains mmap; if True the matrix will reference the file's pages directly, rather than
+                     reading them into memory.
+
+    Outputs: A new Matrix, or NULL if an error occurred.
+*/
+
+    static char *kwlist[] = {"path", "mmap", NULL};
+    PyObject *path,
+             *mmap = Py_False;
+    NpyHeader header;
+    FILE *f;
+    Matrix *m;
+    int useMmap;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|O:load", kwlist, &path, &mmap))
+        return NULL;
+
+    if ((useMmap = PyObject_IsTrue(mmap)) == -1)
+        return NULL;
+
+    if ((f = _openPath(path, "rb")) == NULL)
+        return NULL;
+
+    if (!_npyReadHeader(f, path, &header)) {
+        fclose(f);
+        return NULL;
+    }
+
+    if (header.ndim != 2) {
+        fclose(f);
+        PyErr_Format(PyExc_ValueError, "Matrices can only be loaded from 2 dimensional arrays, not %u.", header.ndim);
+        return NULL;
+    }
+
+    if (useMmap) {
+        fclose(f);
+        m = _matrixLoadMapped(path, &header);
+    } else {
+        m = _matrixLoadCopy(f, path, &header);
+        fclose(f);
+    }
+
+    return (PyObject *)m;
+}
+
+
+PyObject *matrixFromBytes(PyObject *cls, FASTCALL_PARAMETERS) {
+/*  Creates a new matrix from a buffer of native doubles laid out row by row.
+
+    Inputs: cls   - The Matrix type.
+            args  - An object supporting the buffer protocol, and the number of rows & columns of the matrix to create.
+            nargs - The number of arguments in args.
+
+    Outputs: A new Matrix, or NULL if an error occurred.
+*/
+
+    FASTCALL_UNPACK_ARGS
+    PyObject *data;
+    Py_buffer view;
+    long rows,
+         columns;
+    Matrix *m;
+
+    if (!_assertArgCount("frombytes", nargs, 3) || !_parseLongArg(args[1], &rows) || !_parseLongArg(args[2], &columns))
+        return NULL;
+    data = args[0];
+
+    if (rows < 0 || columns < 0 || rows > UINT_MAX || columns > UINT_MAX) {
+        PyErr_Format(PyExc_ValueError, "Invalid Matrix dimensions: %ldx%ld", rows, columns);
+        return NULL;
+    }
+
+    if (!_getVectorTypeBuffer(data, (Py_ssize_t)rows * columns, &view))
+        return NULL;
+
+    m = _matrixFromBuffer(&view, (unsigned int)rows, (unsigned int)columns);
+    PyBuffer_Release(&view);
+    return (PyObject *)m;
+}
+
+
+PyObject *_matrixToBytes(Matrix *self) {
+/*  Copies the data of a matrix into a bytes object of native doubles, laid out row by row.
+
+    Inputs: self - The matrix to copy.
+
+    Outputs: A new bytes object, or NULL if an error occurred.
+*/
+
+    PyObject *bytes;
+    unsigned int i;
+    size_t rowSize = self->columns * sizeof(VECTOR_TYPE);
+    char *dst;
+
+    if ((bytes = PyBytes_FromStringAndSize(NULL, (Py_ssize_t)self->rows * rowSize)) == NULL)
+        return NULL;
+
+    dst = PyBytes_AS_STRING(bytes);
+    for (i = 0; i < self->rows; i++)
+        memcpy(dst + i * rowSize, Matrix_GetVector(self, i)->data, rowSize);
+
+    return bytes;
+}
+
+
+PyObject *matrixToBytes(Matrix *self) {
+/*  Returns the data of this matrix as a bytes object of native doubles, laid out row by row.
+
+    Inputs: self - The matrix to convert.
+
+    Outputs: A new bytes object, or NULL if an error occurred.
+*/
+
+    return _matrixToBytes(self);
+}
+
+
+PyObject *matrixToList(Matrix *self) {
+/*  Converts this matrix to a list of rows, each of which is a list of floats.
+
+    Inputs: self - The matrix to convert.
+
+    Outputs: A new PyList, or NULL if an error occurred.
+*/
+
+    PyObject *list,
+             *row;
+    unsigned int i;
+
+    if ((list = PyList_New(self->rows)) == NULL)
+        return NULL;
+
+    for (i = 0; i < self->rows; i++) {
+        if ((row = _vectorTypeArrayToList(Matrix_GetVector(self, i)->data, self->columns)) == NULL) {
+            Py_DECREF(list);
+            return NULL;
+        }
+        PyList_SET_ITEM(list, i, row);
+    }
+
+    return list;
+}
+
+
+PyObject *matrixReduceEx(Matrix *self, FASTCALL_PARAMETERS) {
+/*  Implements the pickle protocol for matrices.  The matrix data is emitted as a single bytes object, which is
+    transferred out-of-band when pickle protocol 5 or above is used.
+
+    Inputs: self  - The matrix being pickled.
+            args  - The pickle protocol being used.
+            nargs - The number of arguments in args.
+
+    Outputs: A tuple of (Matrix.frombytes, (data, rows, columns)), or (Matrix.from_shared, (name,)) for matrices held
+             in shared memory.  NULL if an error occurred.
+*/
+
+    FASTCALL_UNPACK_ARGS
+    PyObject *bytes,
+             *constructor;
+    SharedBuffer *buffer;
+    long protocol;
+
+    if (!_assertArgCount("__reduce_ex__", nargs, 1) || !_parseLongArg(args[0], &protocol))
+        return NULL;
+
+    // Matrices held in shared memory are pickled by the name of their segment, so that they can be attached to
+    // rather than copied
+    if ((buffer = _matrixSharedBuffer(self)) != NULL) {
+        if ((constructor = PyObject_GetAttrString((PyObject *)&MatrixType, "from_shared")) == NULL)
+            return NULL;
+
+        return Py_BuildValue("(N(N))", constructor, _sharedBufferName(buffer));
+    }
+
+    if ((bytes = _pickleBytes(_matrixToBytes(self), (int)protocol)) == NULL)
+        return NULL;
+
+    if ((constructor = PyObject_GetAttrString((PyObject *)&MatrixType, "frombytes")) == NULL) {
+        Py_DECREF(bytes);
+        return NULL;
+    }
+
+    return Py_BuildValue("(N(NII))", constructor, bytes, self->rows, self->columns);
+}
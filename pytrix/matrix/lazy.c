@@ -0,0 +1,546 @@
+/*
+ *  Copyright (C) 2016 Warren Spencer warrenspencer27@gmail.com
+
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+static LazyMatrix *_lazyMatrixNode(unsigned char op, unsigned int rows, unsigned int columns, PyObject *left,
+                                   PyObject *right, VECTOR_TYPE scalar) {
+/*  Creates a new node of a lazy expression tree.
+
+    Inputs: op      - The operation performed by the node; one of the LAZY_* constants.
+            rows    - The number of rows of the matrix the node evaluates to.
+            columns - The number of columns of the matrix the node evaluates to.
+            left    - The first operand of the node.  A new reference is taken.
+            right   - The second operand of the node, or NULL.  A new reference is taken.
+            scalar  - The factor applied by a LAZY_SCALE node.
+
+    Outputs: A new LazyMatrix, or NULL if an error occurred.
+*/
+
+    LazyMatrix *node;
+
+    if ((node = PyObject_New(LazyMatrix, &LazyMatrixType)) == NULL)
+        return NULL;
+
+    Py_INCREF(left);
+    Py_XINCREF(right);
+    node->op = op;
+    node->rows = rows;
+    node->columns = columns;
+    node->left = left;
+    node->right = right;
+    node->scalar = scalar;
+
+    return node;
+}
+
+
+void lazyMatrixDeInit(LazyMatrix *self) {
+    /* De-allocates a lazy matrix expression.  Nodes which would be de-allocated along with it are detached onto a
+       stack and released one at a time, so that arbitrarily deep expressions can be freed without recursing. */
+
+    PyObject **stack = NULL,
+             **grown,
+             *children[2];
+    Py_ssize_t count = 0,
+               capacity = 0;
+    LazyMatrix *node = self;
+    int i;
+
+    while (1) {
+        children[0] = node->left;
+        children[1] = node->right;
+        node->left = NULL;
+        node->right = NULL;
+
+        for (i = 0; i < 2; i++) {
+            if (children[i] == NULL)
+                continue;
+
+            // Only keep hold of nodes this is the last reference to; releasing any other object cannot recurse
+            if (LazyMatrix_Check(children[i]) && Py_REFCNT(children[i]) == 1) {
+                if (count == capacity) {
+                    if ((grown = PyMem_Realloc(stack, sizeof(PyObject *) * (capacity * 2 + 16))) == NULL) {
+                        Py_DECREF(children[i]);
+                        continue;
+                    }
+                    stack = grown;
+                    capacity = capacity * 2 + 16;
+                }
+                stack[count++] = children[i];
+
+            } else
+                Py_DECREF(children[i]);
+        }
+
+        // The children of every other node have been detached, so releasing it de-allocates only the node itself
+        if (node == self)
+            PyObject_Del(self);
+        else
+            Py_DECREF(node);
+
+        if (count == 0)
+            break;
+        node = (LazyMatrix *)stack[--count];
+    }
+
+    PyMem_Free(stack);
+}
+
+
+static LazyMatrix *_lazyMatrixOperand(PyObject *operand) {
+/*  Returns an operand of a lazy expression as a LazyMatrix, wrapping plain Matrices in a leaf node.
+
+    Inputs: operand - The object to convert.
+
+    Outputs: A new reference to a LazyMatrix, or NULL if operand is neither a LazyMatrix nor a Matrix, or if an error
+             occurred.  No exception is set in the former case.
+*/
+
+    if (LazyMatrix_Check(operand)) {
+        Py_INCREF(operand);
+        return (LazyMatrix *)operand;
+    }
+
+    if (Matrix_Check(operand))
+        return _lazyMatrixNode(LAZY_LEAF, ((Matrix *)operand)->rows, ((Matrix *)operand)->columns, operand, NULL, 0);
+
+    return NULL;
+}
+
+
+PyObject *lazyFunction(PyObject *self, FASTCALL_PARAMETERS) {
+/*  Begins a lazy expression from a matrix.
+
+    Inputs: self  - The pytrix module.
+            args  - A single Matrix to wrap.
+            nargs - The number of arguments in args.
+
+    Outputs: A LazyMatrix wrapping the given Matrix, or NULL if an error occurred.
+*/
+
+    FASTCALL_UNPACK_ARGS
+
+    if (!_assertArgCount("lazy", nargs, 1) || !_assertMatrix(args[0]))
+        return NULL;
+
+    return (PyObject *)_lazyMatrixOperand(args[0]);
+}
+
+
+static PyObject *_lazyMatrixAddOrSub(PyObject *a, PyObject *b, unsigned char op) {
+/*  Builds a node adding or subtracting two lazy expressions or matrices.
+
+    Inputs: a  - Supposedly the left operand.
+            b  - Supposedly the right operand.
+            op - Either LAZY_ADD or LAZY_SUB.
+
+    Outputs: A new LazyMatrix, NotImplemented if either operand is not a matrix expression, or NULL if an error
+             occurred.
+*/
+
+    LazyMatrix *left,
+               *right,
+               *node = NULL;
+
+    if ((left = _lazyMatrixOperand(a)) == NULL) {
+        if (PyErr_Occurred())
+            return NULL;
+        Py_INCREF(Py_NotImplemented);
+        return Py_NotImplemented;
+    }
+
+    if ((right = _lazyMatrixOperand(b)) == NULL) {
+        Py_DECREF(left);
+        if (PyErr_Occurred())
+            return NULL;
+        Py_INCREF(Py_NotImplemented);
+        return Py_NotImplemented;
+    }
+
+    if (left->rows != right->rows || left->columns != right->columns)
+        PyErr_SetString(PyExc_ValueError, "Matrices must be of the same dimensions.");
+    else
+        node = _lazyMatrixNode(op, left->rows, left->columns, (PyObject *)left, (PyObject *)right, 0);
+
+    Py_DECREF(left);
+    Py_DECREF(right);
+    return (PyObject *)node;
+}
+
+
+PyObject *lazyMatrixAdd(PyObject *a, PyObject *b) {
+/*  Builds a node adding two matrix expressions.
+
+    Inputs: a - Supposedly the first expression to add.
+            b - Supposedly the second expression to add.
+
+    Outputs: A new LazyMatrix representing a + b, or NULL if an error occurred.
+*/
+
+    return _lazyMatrixAddOrSub(a, b, LAZY_ADD);
+}
+
+
+PyObject *lazyMatrixSub(PyObject *a, PyObject *b) {
+/*  Builds a node subtracting one matrix expression from another.
+
+    Inputs: a - Supposedly the expression to subtract from.
+            b - Supposedly the expression to subtract.
+
+    Outputs: A new LazyMatrix representing a - b, or NULL if an error occurred.
+*/
+
+    return _lazyMatrixAddOrSub(a, b, LAZY_SUB);
+}
+
+
+PyObject *lazyMatrixMul(PyObject *a, PyObject *b) {
+/*  Builds a node multiplying a matrix expression by either a scalar or another matrix expression.
+
+    Inputs: a - Supposedly either a scalar or the left expression to multiply.
+            b - Supposedly either a scalar or the right expression to multiply.
+
+    Outputs: A new LazyMatrix representing a * b, NotImplemented if the operands are not supported, or NULL if an error
+             occurred.
+*/
+
+    LazyMatrix *left,
+               *right,
+               *node = NULL;
+    VECTOR_TYPE scalar;
+
+    // Scaling by a number
+    if (PyNumber_Check(a) || PyNumber_Check(b)) {
+        if (PyNumber_Check(b)) {
+            PyObject *temp = a;
+            a = b;
+            b = temp;
+        }
+
+        if ((scalar = PyNumber_AS_VECTOR_TYPE(a)) == -1 && PyErr_Occurred())
+            return NULL;
+        if ((right = _lazyMatrixOperand(b)) == NULL) {
+            if (PyErr_Occurred())
+                return NULL;
+            Py_INCREF(Py_NotImplemented);
+            return Py_NotImplemented;
+        }
+
+        node = _lazyMatrixNode(LAZY_SCALE, right->rows, right->columns, (PyObject *)right, NULL, scalar);
+        Py_DECREF(right);
+        return (PyObject *)node;
+    }
+
+    // Matrix multiplication
+    if ((left = _lazyMatrixOperand(a)) == NULL) {
+        if (PyErr_Occurred())
+            return NULL;
+        Py_INCREF(Py_NotImplemented);
+        return Py_NotImplemented;
+    }
+
+    if ((right = _lazyMatrixOperand(b)) == NULL) {
+        Py_DECREF(left);
+        if (PyErr_Occurred())
+            return NULL;
+        Py_INCREF(Py_NotImplemented);
+        return Py_NotImplemented;
+    }
+
+    if (left->columns != right->rows)
+        PyErr_SetString(PyExc_ValueError, "A * B Matrix multiplication requires A.columns = B.rows");
+    else
+        node = _lazyMatrixNode(LAZY_MATMUL, left->rows, right->columns, (PyObject *)left, (PyObject *)right, 0);
+
+    Py_DECREF(left);
+    Py_DECREF(right);
+    return (PyObject *)node;
+}
+
+
+PyObject *lazyMatrixNeg(LazyMatrix *self) {
+/*  Builds a node negating a matrix expression.
+
+    Inputs: self - The expression to negate.
+
+    Outputs: A new LazyMatrix representing -self, or NULL if an error occurred.
+*/
+
+    return (PyObject *)_lazyMatrixNode(LAZY_SCALE, self->rows, self->columns, (PyObject *)self, NULL, -1);
+}
+
+
+static LazyMatrix *_lazyMatrixUnscaled(LazyMatrix *node, VECTOR_TYPE *coefficient) {
+/*  Strips any scaling nodes from the top of an expression, folding their factors into a coefficient.
+
+    Inputs: node        - The expression to strip.
+            coefficient - The coefficient to multiply the factors of the stripped nodes into.
+
+    Outputs: A borrowed reference to the first node of the expression which is not a LAZY_SCALE node.
+*/
+
+    while (node->op == LAZY_SCALE) {
+        *coefficient *= node->scalar;
+        node = (LazyMatrix *)node->left;
+    }
+
+    return node;
+}
+
+
+static unsigned char _lazyMatrixAppendTerm(LazyTerm **terms, Py_ssize_t *count, Py_ssize_t *capacity,
+                                           VECTOR_TYPE coefficient, Matrix *a, Matrix *b) {
+/*  Appends a term to the list of terms an expression has been lowered to, taking over the references to a & b.
+
+    Inputs: terms       - The array of terms, which is grown as needed.
+            count       - The number of terms in the array.
+            capacity    - The number of terms the array has space for.
+            coefficient - The coefficient of the new term.
+            a           - The first matrix of the term.
+            b           - The second matrix of the term, or NULL.
+
+    Outputs: 1 if successful, 0 if an error occurred, in which case the references to a & b are released.
+*/
+
+    LazyTerm *grown;
+
+    if (*count == *capacity) {
+        if ((grown = PyMem_Realloc(*terms, sizeof(LazyTerm) * (*capacity * 2 + 4))) == NULL) {
+            Py_DECREF(a);
+            Py_XDECREF(b);
+            PyErr_NoMemory();
+            return 0;
+        }
+        *terms = grown;
+        *capacity = *capacity * 2 + 4;
+    }
+
+    (*terms)[*count].coefficient = coefficient;
+    (*terms)[*count].a = a;
+    (*terms)[*count].b = b;
+    (*count)++;
+    return 1;
+}
+
+
+static unsigned char _lazyMatrixLower(LazyMatrix *node, VECTOR_TYPE coefficient, LazyTerm **terms, Py_ssize_t *count,
+                                      Py_ssize_t *capacity) {
+/*  Lowers an expression to a sum of terms, each either a scaled matrix or a scaled product of two matrices.  Sums,
+    differences and scalings are folded into the coefficients of the terms; only the operands of products which are
+    themselves compound expressions are evaluated.  The nodes still to be lowered are kept on a stack rather than
+    recursed into, so that expressions built up by long chains of sums are not limited in depth.
+
+    Inputs: node        - The expression to lower.
+            coefficient - The factor to multiply each of the expression's terms by.
+            terms       - The array of terms to append to.
+            count       - The number of terms in the array.
+            capacity    - The number of terms the array has space for.
+
+    Outputs: 1 if successful, 0 if an error occurred.
+*/
+
+    LazyPending *pending,
+                *grown;
+    Py_ssize_t depth = 0,
+               size = 16;
+    VECTOR_TYPE factor;
+    Matrix *a,
+           *b;
+    unsigned char success = 0;
+
+    if ((pending = PyMem_New(LazyPending, size)) == NULL) {
+        PyErr_NoMemory();
+        return 0;
+    }
+
+    pending[depth].node = node;
+    pending[depth++].coefficient = coefficient;
+
+    while (depth > 0) {
+        depth--;
+        node = pending[depth].node;
+        coefficient = pending[depth].coefficient;
+
+        // Make room for both operands of a sum
+        if (depth + 2 > size) {
+            if ((grown = PyMem_Realloc(pending, sizeof(LazyPending) * size * 2)) == NULL) {
+                PyErr_NoMemory();
+                goto cleanup;
+            }
+            pending = grown;
+            size *= 2;
+        }
+
+        switch (node->op) {
+            case LAZY_LEAF:
+                Py_INCREF(node->left);
+                if (!_lazyMatrixAppendTerm(terms, count, capacity, coefficient, (Matrix *)node->left, NULL))
+                    goto cleanup;
+                break;
+
+            case LAZY_ADD:
+            case LAZY_SUB:
+                // The right operand is pushed first, so that terms are appended in the order they were written
+                pending[depth].node = (LazyMatrix *)node->right;
+                pending[depth++].coefficient = node->op == LAZY_ADD ? coefficient : -coefficient;
+                pending[depth].node = (LazyMatrix *)node->left;
+                pending[depth++].coefficient = coefficient;
+                break;
+
+            case LAZY_SCALE:
+                pending[depth].node = (LazyMatrix *)node->left;
+                pending[depth++].coefficient = coefficient * node->scalar;
+                break;
+
+            default:
+                // Operands of products are evaluated recursively, so guard against chains of products exhausting the
+                // C stack
+                if (Py_EnterRecursiveCall(" while evaluating a lazy matrix expression"))
+                    goto cleanup;
+
+                // Scalings of either side of a product are moved onto its coefficient, so alpha * A * B is a single
+                // GEMM
+                factor = 1;
+                a = _lazyMatrixEvaluate(_lazyMatrixUnscaled((LazyMatrix *)node->left, &factor));
+                b = a == NULL ? NULL : _lazyMatrixEvaluate(_lazyMatrixUnscaled((LazyMatrix *)node->right, &factor));
+                Py_LeaveRecursiveCall();
+
+                if (b == NULL) {
+                    Py_XDECREF(a);
+                    goto cleanup;
+                }
+                if (!_lazyMatrixAppendTerm(terms, count, capacity, coefficient * factor, a, b))
+                    goto cleanup;
+        }
+    }
+
+    success = 1;
+
+cleanup:
+    PyMem_Free(pending);
+    return success;
+}
+
+
+static Matrix *_lazyMatrixEvaluate(LazyMatrix *node) {
+/*  Evaluates an expression.  Its element-wise terms are summed in a single pass over each row of the result, after
+    which each of its products is accumulated into the result with one GEMM.
+
+    Inputs: node - The expression to evaluate.
+
+    Outputs: A new reference to the resulting Matrix, or NULL if an error occurred.
+*/
+
+    LazyTerm *terms = NULL;
+    Py_ssize_t count = 0,
+               capacity = 0,
+               first,
+               t;
+    unsigned int row,
+                 col;
+    Matrix *out = NULL;
+    VECTOR_TYPE coefficient,
+                *dst,
+                *src;
+
+    if (node->op == LAZY_LEAF) {
+        Py_INCREF(node->left);
+        return (Matrix *)node->left;
+    }
+
+    if (!_lazyMatrixLower(node, 1, &terms, &count, &capacity))
+        goto cleanup;
+
+    if ((out = _matrixNew(node->rows, node->columns)) == NULL)
+        goto cleanup;
+
+    // Find the first element-wise term, which initializes the result
+    for (first = 0; first < count && terms[first].b != NULL; first++);
+
+    for (row = 0; row < node->rows; row++) {
+        dst = Matrix_GetVector(out, row)->data;
+
+        if (first == count) {
+            memset(dst, 0, sizeof(VECTOR_TYPE) * node->columns);
+            continue;
+        }
+
+        coefficient = terms[first].coefficient;
+        src = Matrix_GetVector(terms[first].a, row)->data;
+        for (col = 0; col < node->columns; col++)
+            dst[col] = coefficient * src[col];
+
+        for (t = first + 1; t < count; t++) {
+            if (terms[t].b != NULL)
+                continue;
+            coefficient = terms[t].coefficient;
+            src = Matrix_GetVector(terms[t].a, row)->data;
+            for (col = 0; col < node->columns; col++)
+                dst[col] += coefficient * src[col];
+        }
+    }
+
+    for (t = 0; t < count; t++)
+        if (terms[t].b != NULL)
+            _inplaceMatrixGemm(terms[t].coefficient, terms[t].a, terms[t].b, out);
+
+cleanup:
+    for (t = 0; t < count; t++) {
+        Py_DECREF(terms[t].a);
+        Py_XDECREF(terms[t].b);
+    }
+    PyMem_Free(terms);
+
+    return out;
+}
+
+
+PyObject *lazyMatrixEvaluate(LazyMatrix *self) {
+/*  Evaluates a lazy expression.
+
+    Inputs: self - The expression to evaluate.
+
+    Outputs: A Matrix holding the value of the expression, or NULL if an error occurred.
+*/
+
+    return (PyObject *)_lazyMatrixEvaluate(self);
+}
+
+
+PyObject *lazyMatrixRows(LazyMatrix *self, void *closure) {
+/*  Returns the number of rows of the matrix an expression evaluates to.
+
+    Inputs: self    - The expression.
+            closure - Unused.
+
+    Outputs: A PyLong.
+*/
+
+    return PyLong_FromUnsignedLong(self->rows);
+}
+
+
+PyObject *lazyMatrixColumns(LazyMatrix *self, void *closure) {
+/*  Returns the number of columns of the matrix an expression evaluates to.
+
+    Inputs: self    - The expression.
+            closure - Unused.
+
+    Outputs: A PyLong.
+*/
+
+    return PyLong_FromUnsignedLong(self->columns);
+}
@@ -15,67 +15,6 @@
  *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
-PyObject *matrixStr(Matrix *self) {
-/*  Constructs a human-readable Python String representing a human readable version of this matrix.
-
-    Inputs: self - The matrix for which the human readable format will be produced.
-
-    Outputs: A PyString containing the human readable form of the matrix.
-*/
-
-    unsigned int i;
-    const char *cNewline = "\n\00";
-    PyObject *matrixRepr,
-             *newlineStr,
-             *vectorReprs,
-             *tuple,
-             *list,
-             *listRepr;
-
-    // Create a list of all the vector reprs
-    if ((vectorReprs = PyList_New(self->rows)) == NULL)
-        return NULL;
-
-    for (i = 0; i < self->rows; i++) {
-        if ((tuple = _vectorToTuple(Matrix_GetVector(self, i))) == NULL) {
-            Py_DECREF(vectorReprs);
-            return NULL;
-        }
-        if ((list = PySequence_List(tuple)) == NULL) {
-            Py_DECREF(vectorReprs);
-            Py_DECREF(tuple);
-            return NULL;
-        }
-
-        if ((listRepr = PyObject_Repr(list)) == NULL) {
-            Py_DECREF(vectorReprs);
-            Py_DECREF(tuple);
-            Py_DECREF(list);
-        }
-
-        PyList_SET_ITEM(vectorReprs, i, listRepr);
-        Py_DECREF(tuple);
-        Py_DECREF(list);
-    }
-
-    // Create a newline-delimited version of all the vector reprs joined
-    if ((newlineStr = PyUnicode_FromString(cNewline)) == NULL || PyErr_Occurred() != NULL) {
-        Py_DECREF(vectorReprs);
-        return NULL;
-    }
-
-    if ((matrixRepr = PyObject_CallMethod(newlineStr, "join", "O", vectorReprs)) == NULL) {
-        Py_DECREF(newlineStr);
-        Py_DECREF(vectorReprs);
-        return NULL;
-    }
-
-    Py_DECREF(newlineStr);
-    Py_DECREF(vectorReprs);
-    return matrixRepr;
-}
-
-
 PyObject *matrixCopy(PyObject *self) {
 /*  Creates a new copy of this matrix object.
 
@@ -168,11 +107,19 @@ PyObject *matrixMul(PyObject *a, PyObject *b) {
         * NULL if none of the above stand true, or if an exception was encountered.
 */
 
+    VECTOR_TYPE scalar;
+
     // If one of our operands are scalars, perform scalar multiplication
-    if (PyNumber_Check(a))
-        return (PyObject *)_scalarMatrixMul((Matrix *)b, PyNumber_AS_VECTOR_TYPE(a));
-    if (PyNumber_Check(b))
-        return (PyObject *)_scalarMatrixMul((Matrix *)a, PyNumber_AS_VECTOR_TYPE(b));
+    if (PyNumber_Check(a)) {
+        if ((scalar = PyNumber_AS_VECTOR_TYPE(a)) == -1 && PyErr_Occurred())
+            return NULL;
+        return (PyObject *)_scalarMatrixMul((Matrix *)b, scalar);
+    }
+    if (PyNumber_Check(b)) {
+        if ((scalar = PyNumber_AS_VECTOR_TYPE(b)) == -1 && PyErr_Occurred())
+            return NULL;
+        return (PyObject *)_scalarMatrixMul((Matrix *)a, scalar);
+    }
 
     // Otherwise, if one of our other operands is a Vector, perform vector multiplication
     if (Vector_Check(b))
@@ -182,6 +129,12 @@ PyObject *matrixMul(PyObject *a, PyObject *b) {
     if (Matrix_Check(a) && Matrix_Check(b))
         return (PyObject *)_matrixMatrixMul((Matrix *)a, (Matrix *)b, 1);
 
+    // Products with a lazy expression or a batch of matrices are built by the LazyMatrix & MatrixBatch types
+    if (LazyMatrix_Check(a) || LazyMatrix_Check(b) || MatrixBatch_Check(a) || MatrixBatch_Check(b)) {
+        Py_INCREF(Py_NotImplemented);
+        return Py_NotImplemented;
+    }
+
     // Otherwise, raise an exception. One of our operands will be a matrix, we are assured that by the fact that we
     // were called; figure out which one isn't for the error message.
     if (Matrix_Check(b)) {
@@ -194,21 +147,24 @@ PyObject *matrixMul(PyObject *a, PyObject *b) {
 }
 
 
-PyObject *matrixStrassenMul(PyObject *self, PyObject *args) {
+PyObject *matrixStrassenMul(PyObject *self, FASTCALL_PARAMETERS) {
 /*  Multiplies a matrix by another matrix using strassens multiplications regardless of the size (assuming their sizes
     are at least 2x2).
 
-    Inputs: self - The matrix the function was called on, the first to multiply with.
-            args - A PyTuple containing the second matrix to multiply with and the strassen cutoff point.
+    Inputs: self  - The matrix the function was called on, the first to multiply with.
+            args  - The second matrix to multiply with and the strassen cutoff point.
+            nargs - The number of arguments in args.
 
     Outputs: A new Matrix object calculated by performing a * b, or NULL if an error occurs.
 */
 
+    FASTCALL_UNPACK_ARGS
     PyObject *otherMatrix;
-    int minCutoff;
+    long minCutoff;
 
-    if (!PyArg_ParseTuple(args, "Oi", &otherMatrix, &minCutoff))
+    if (!_assertArgCount("_strassenMul", nargs, 2) || !_parseLongArg(args[1], &minCutoff))
         return NULL;
+    otherMatrix = args[0];
 
     if (!Matrix_Check(otherMatrix)) {
         PyErr_Format(PyExc_TypeError,
@@ -217,11 +173,12 @@ PyObject *matrixStrassenMul(PyObject *self, PyObject *args) {
     }
 
     if (minCutoff < 2) {
-        PyErr_Format(PyExc_ValueError, "minCutoff argument to Matrix.strassenMul cannot be less than 2: %i", minCutoff);
+        PyErr_Format(PyExc_ValueError, "minCutoff argument to Matrix.strassenMul cannot be less than 2: %ld", minCutoff);
         return NULL;
     }
 
-    return (PyObject *)strassenWinogradMatrixMatrixMul((Matrix *)self, (Matrix *)otherMatrix, (unsigned int)minCutoff);
+    return (PyObject *)strassenWinogradMatrixMatrixMul((Matrix *)self, (Matrix *)otherMatrix,
+                                                       minCutoff > UINT_MAX ? UINT_MAX : (unsigned int)minCutoff);
 }
 
 
@@ -292,6 +249,14 @@ PyObject *matrixRichCmp(PyObject *a, PyObject *b, int op) {
     if ((!_assertMatrix(a)) || (!_assertMatrix(b)))
         return NULL;
 
+    // If both hashes have already been computed and they differ, the matrices cannot be equal
+    if ((((Matrix *)a)->hash != -1 && ((Matrix *)b)->hash != -1) && ((Matrix *)a)->hash != ((Matrix *)b)->hash) {
+        if (op == Py_EQ)
+            Py_RETURN_FALSE;
+        if (op == Py_NE)
+            Py_RETURN_TRUE;
+    }
+
     switch (op) {
         case Py_EQ:
             if (_matricesEqual((Matrix *)a, (Matrix *)b))
@@ -310,6 +275,36 @@ PyObject *matrixRichCmp(PyObject *a, PyObject *b, int op) {
 }
 
 
+Py_hash_t matrixHash(Matrix *self) {
+/*  Hashes a matrix.  As matrices are immutable the hash is only computed once, and is cached on the matrix.
+
+    Inputs: self - The matrix to hash.
+
+    Outputs: A Py_hash_t of the components of self.
+*/
+
+    unsigned int row;
+    Py_uhash_t hash;
+
+    if (self->isMutable) {
+        PyErr_SetString(PyExc_TypeError, "unhashable type: mutable Matrix");
+        return -1;
+    }
+
+    if (self->hash == -1) {
+        // Seed the hash with the dimensions of the matrix so that matrices with the same components but different
+        // shapes hash differently, then chain the hash of each row into the next
+        hash = ((Py_uhash_t)self->rows * (Py_uhash_t)HASH_PRIME_1) ^ (Py_uhash_t)self->columns;
+        for (row = 0; row < self->rows; row++)
+            hash = _hashVectorTypeArray(Matrix_GetVector(self, row)->data, self->columns, hash);
+
+        self->hash = _finalizeHash(hash);
+    }
+
+    return self->hash;
+}
+
+
 PyObject *matrixTranspose(PyObject *self) {
 /*  Creates and returns a new matrix constructed by taking the transpose of this matrix.
 
@@ -322,20 +317,22 @@ PyObject *matrixTranspose(PyObject *self) {
 }
 
 
-PyObject *matrixRow(PyObject *self, PyObject *args) {
+PyObject *matrixRow(PyObject *self, FASTCALL_PARAMETERS) {
 /*  Returns the ith row from the Matrix self.
 
-    Inputs: self - The matrix to return the ith row from.
-            args - A PyTuple containing a PyNumber of the index of the row to return.
+    Inputs: self  - The matrix to return the ith row from.
+            args  - A PyNumber of the index of the row to return.
+            nargs - The number of arguments in args.
 
     Outputs: A Vector object of the ith row in self if successful, NULL if an error occurs.
 */
 
+    FASTCALL_UNPACK_ARGS
     long i;
     Matrix *m = (Matrix *)self;
     Vector *v;
 
-    if (!PyArg_ParseTuple(args, "l", &i))
+    if (!_assertArgCount("row", nargs, 1) || !_parseLongArg(args[0], &i))
         return NULL;
 
     if (i >= m->rows || i < 0) {
@@ -350,21 +347,23 @@ PyObject *matrixRow(PyObject *self, PyObject *args) {
 }
 
 
-PyObject *matrixColumn(PyObject *self, PyObject *args) {
+PyObject *matrixColumn(PyObject *self, FASTCALL_PARAMETERS) {
 /*  Returns the ith column from the Matrix self.
 
-    Inputs: self - The matrix to return the ith column from.
-            args - A PyTuple containing a PyNumber of the index of the column to return.
+    Inputs: self  - The matrix to return the ith column from.
+            args  - A PyNumber of the index of the column to return.
+            nargs - The number of arguments in args.
 
     Outputs: A Vector object of the ith column in self if successful, NULL if an error occurs.
 */
 
+    FASTCALL_UNPACK_ARGS
     long col,
          i;
     Matrix *m = (Matrix *)self;
     Vector *v;
 
-    if (!PyArg_ParseTuple(args, "l", &col))
+    if (!_assertArgCount("column", nargs, 1) || !_parseLongArg(args[0], &col))
         return NULL;
 
     if (col >= m->columns || col < 0) {
@@ -382,27 +381,34 @@ PyObject *matrixColumn(PyObject *self, PyObject *args) {
 }
 
 
-PyObject *matrixPermute(PyObject *self, PyObject *args) {
+PyObject *matrixPermute(PyObject *self, FASTCALL_PARAMETERS) {
 /*  Returns a new matrix with the given rows permuted.
 
-    Inputs: self - The matrix to permute.
-            args - A tuple containing the indices of the two rows to permute.
+    Inputs: self  - The matrix to permute.
+            args  - The indices of the two rows to permute.
+            nargs - The number of arguments in args.
 
     Outputs: A new copy of self with the given rows permuted.
 */
 
-    int a,
-        b;
+    FASTCALL_UNPACK_ARGS
+    long a,
+         b;
 
-    if (!PyArg_ParseTuple(args, "ii", &a, &b))
+    if (!_assertArgCount("permute", nargs, 2) || !_parseLongArg(args[0], &a) || !_parseLongArg(args[1], &b))
         return NULL;
 
     if (a < 0) {
-        PyErr_Format(PyExc_ValueError, "Matrix.permute indices cannot be less than 0: %d", a);
+        PyErr_Format(PyExc_ValueError, "Matrix.permute indices cannot be less than 0: %ld", a);
         return NULL;
     }
     if (b < 0) {
-        PyErr_Format(PyExc_ValueError, "Matrix.permute indices cannot be less than 0: %d", b);
+        PyErr_Format(PyExc_ValueError, "Matrix.permute indices cannot be less than 0: %ld", b);
+        return NULL;
+    }
+
+    if (a > UINT_MAX || b > UINT_MAX) {
+        PyErr_Format(PyExc_ValueError, "Given permute index is greater than Matrix.rows: %ld", a > b ? a : b);
         return NULL;
     }
 
@@ -410,6 +416,64 @@ PyObject *matrixPermute(PyObject *self, PyObject *args) {
 }
 
 
+PyObject *matrixApply(Matrix *self, FASTCALL_KEYWORDS_PARAMETERS) {
+/*  Multiplies this matrix by each of a number of vectors, as a single matrix-matrix product computed without holding
+    the GIL.
+
+    Inputs: self    - The matrix to multiply by.
+            args    - Either a sequence of Vectors, a VectorArray, or an object supporting the buffer protocol
+                      containing vectors of self.columns native doubles laid out one after another; optionally followed
+                      by out, a writable buffer to write the results into.
+            nargs   - The number of positional arguments in args.
+            kwnames - The names of any keyword arguments passed.
+
+    Outputs: A VectorArray of the products of self with each vector if given a VectorArray, otherwise a Matrix whose
+             rows are the products, stored contiguously; or out if it was given.  NULL if an error occurred.
+*/
+
+    FASTCALL_KEYWORDS_UNPACK_ARGS
+    PyObject *outArg = Py_None;
+    BatchElements batch;
+    VECTOR_TYPE *transposed;
+    unsigned int row,
+                 col;
+
+    if (!_parseOptionalArg("apply", "out", 1, args, nargs, kwnames, &outArg) ||
+        !_vectorArrayParseBatch(&batch, "Matrix.apply", args[0], outArg, &VectorType, self->columns, self->rows))
+        return NULL;
+
+    // VectorArrays are multiplied component by component, straight from their own storage
+    if (batch.array != NULL) {
+        if (!_vectorArrayTransformInto(batch.array, self, batch.out != NULL ? batch.out :
+                                       ((VectorArray *)batch.result)->data, batch.out != NULL))
+            Py_CLEAR(batch.result);
+
+        _vectorArrayReleaseBatch(&batch);
+        return batch.result;
+    }
+
+    // The transpose is followed by room for the scratch space of a single result
+    if ((transposed = PyMem_Malloc(sizeof(VECTOR_TYPE) * ((size_t)self->rows * (self->columns + 1) + 1))) == NULL) {
+        Py_CLEAR(batch.result);
+        _vectorArrayReleaseBatch(&batch);
+        return PyErr_NoMemory();
+    }
+    for (row = 0; row < self->rows; row++)
+        for (col = 0; col < self->columns; col++)
+            transposed[(size_t)col * self->rows + row] = Matrix_GetValue(self, row, col);
+
+    Py_BEGIN_ALLOW_THREADS
+    _matrixApplyTransposed(transposed, self->rows, self->columns, batch.inputs, batch.count, batch.out,
+                           transposed + (size_t)self->rows * self->columns);
+    Py_END_ALLOW_THREADS
+
+    _vectorArrayReleaseBatch(&batch);
+    PyMem_Free(transposed);
+
+    return batch.result;
+}
+
+
 PyObject *matrixGaussianElim(PyObject *self) {
 /*  Uses Gaussian elimination to convert the given matrix into an upper triangular matrix.
 
@@ -0,0 +1,110 @@
+/*
+ *  Copyright (C) 2016 Warren Spencer warrenspencer27@gmail.com
+
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+SharedBuffer *_matrixSharedBuffer(Matrix *self) {
+/*  Determines whether a matrix is laid out exactly as the contents of a shared memory segment.
+
+    Inputs: self - The matrix to inspect.
+
+    Outputs: A borrowed reference to the SharedBuffer holding the matrix, or NULL if it is not held by one.
+*/
+
+    unsigned int i;
+    SharedBuffer *buffer;
+    Vector *row;
+
+    if (self->rows == 0 || Matrix_GetVector(self, 0)->base == NULL ||
+        Py_TYPE(Matrix_GetVector(self, 0)->base) != &SharedBufferType)
+        return NULL;
+
+    buffer = (SharedBuffer *)Matrix_GetVector(self, 0)->base;
+    if (buffer->rows != self->rows || buffer->columns != self->columns)
+        return NULL;
+
+    // Rows may have been shared between matrices; ensure each is the expected row of the segment
+    for (i = 0; i < self->rows; i++) {
+        row = Matrix_GetVector(self, i);
+        if (row->base != (PyObject *)buffer || row->data != SharedBuffer_GetRow(buffer, i))
+            return NULL;
+    }
+
+    return buffer;
+}
+
+
+PyObject *matrixToShared(Matrix *self) {
+/*  Creates a copy of this matrix held in a new shared memory segment.
+
+    Inputs: self - The matrix to copy.
+
+    Outputs: A new Matrix, whose segment is unlinked once it and all of its rows have been freed.  NULL if an error
+             occurred.
+*/
+
+    unsigned int i;
+    SharedBuffer *buffer;
+    Matrix *m;
+
+    if ((buffer = _sharedBufferCreate(self->rows, self->columns)) == NULL)
+        return NULL;
+
+    for (i = 0; i < self->rows; i++)
+        memcpy(SharedBuffer_GetRow(buffer, i), Matrix_GetVector(self, i)->data, self->columns * sizeof(VECTOR_TYPE));
+
+    m = _matrixNewView(self->rows, self->columns, SharedBuffer_GetRow(buffer, 0), (PyObject *)buffer);
+    Py_DECREF(buffer);
+    return (PyObject *)m;
+}
+
+
+PyObject *matrixFromShared(PyObject *cls, PyObject *name) {
+/*  Creates a matrix referencing a shared memory segment created by Matrix.to_shared, without copying it.
+
+    Inputs: cls  - The Matrix type.
+            name - The name of the shared memory segment.
+
+    Outputs: A new Matrix, or NULL if an error occurred.
+*/
+
+    SharedBuffer *buffer;
+    Matrix *m;
+
+    if ((buffer = _sharedBufferAttach(name)) == NULL)
+        return NULL;
+
+    m = _matrixNewView(buffer->rows, buffer->columns, SharedBuffer_GetRow(buffer, 0), (PyObject *)buffer);
+    Py_DECREF(buffer);
+    return (PyObject *)m;
+}
+
+
+PyObject *matrixSharedName(Matrix *self, void *closure) {
+/*  Getter for the name of the shared memory segment holding this matrix.
+
+    Inputs: self    - The matrix.
+            closure - Unused.
+
+    Outputs: The name of the segment, None if the matrix is not held in shared memory, or NULL if an error occurred.
+*/
+
+    SharedBuffer *buffer;
+
+    if ((buffer = _matrixSharedBuffer(self)) == NULL)
+        Py_RETURN_NONE;
+
+    return _sharedBufferName(buffer);
+}
@@ -0,0 +1,452 @@
+/*
+ *  Copyright (C) 2016 Warren Spencer warrenspencer27@gmail.com
+
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+/*
+    Closed form determinant and inverse kernels for 2x2, 3x3 and 4x4 matrices, the sizes most common in transform code.
+
+    The kernels operate on runs of matrices whose values are interleaved, in the layout of a MatrixBatch: value k of
+    matrix i is at k * stride + i.  A single matrix packed row by row is a run of 1 matrix with a stride of 1.  The
+    kernels touch no Python objects and contain no branches, so that the compiler is free to keep every value in
+    registers and to vectorize across the matrices of a run.  The inverses are computed from the adjugate and so, unlike
+    gaussian elimination, do not pivot; they are as accurate as elimination for well conditioned matrices.  Results for
+    matrices which are singular, or whose values are too large or small for the products of the closed forms to be
+    represented, are rejected by _smallDeterminantUsable & _smallInverseUsable, and are instead computed by
+    elimination.
+*/
+
+
+void _smallMatrixPack(Matrix *m, VECTOR_TYPE *out) {
+/*  Copies the values of a matrix, row by row, into an array.
+
+    Inputs: m   - The matrix to copy the values of.
+            out - An array of at least m->rows * m->columns values to copy into.
+*/
+
+    unsigned int row;
+
+    for (row = 0; row < m->rows; row++)
+        memcpy(out + row * m->columns, Matrix_GetVector(m, row)->data, sizeof(VECTOR_TYPE) * m->columns);
+}
+
+
+static void _smallDeterminant2(const VECTOR_TYPE *a, Py_ssize_t stride, Py_ssize_t count, VECTOR_TYPE *determinants) {
+/*  Calculates the determinants of a run of 2x2 matrices.
+
+    Inputs: a            - The first value of the first matrix; the values of matrix i begin at a + i.
+            stride       - The distance between consecutive values of a matrix.
+            count        - The number of matrices.
+            determinants - An array of count values to write the determinants to.
+*/
+
+    Py_ssize_t i;
+
+    for (i = 0; i < count; i++)
+        determinants[i] = a[i] * a[3 * stride + i] - a[stride + i] * a[2 * stride + i];
+}
+
+
+static void _smallInverse2(const VECTOR_TYPE *a, VECTOR_TYPE *out, Py_ssize_t stride, Py_ssize_t count,
+                           VECTOR_TYPE *determinants) {
+/*  Calculates the inverses of a run of 2x2 matrices as their adjugates divided by their determinants.
+
+    Inputs: a            - The first value of the first matrix; the values of matrix i begin at a + i.
+            out          - Where to write the inverses, in the same layout as a; may not overlap a.
+            stride       - The distance between consecutive values of a matrix.
+            count        - The number of matrices.
+            determinants - An array of count values to write the determinants to.  Matrices with a determinant of 0
+                           are not invertible, and the values written for their inverses are not finite.
+*/
+
+    VECTOR_TYPE a0, a1, a2, a3,
+                multiplier;
+    Py_ssize_t i;
+
+    for (i = 0; i < count; i++) {
+        a0 = a[i]; a1 = a[stride + i]; a2 = a[2 * stride + i]; a3 = a[3 * stride + i];
+
+        determinants[i] = a0 * a3 - a1 * a2;
+        multiplier = 1 / determinants[i];
+
+        out[i] = a3 * multiplier;
+        out[stride + i] = -a1 * multiplier;
+        out[2 * stride + i] = -a2 * multiplier;
+        out[3 * stride + i] = a0 * multiplier;
+    }
+}
+
+
+static void _smallDeterminant3(const VECTOR_TYPE *a, Py_ssize_t stride, Py_ssize_t count, VECTOR_TYPE *determinants) {
+/*  Calculates the determinants of a run of 3x3 matrices by cofactor expansion along their first rows.
+
+    Inputs: a            - The first value of the first matrix; the values of matrix i begin at a + i.
+            stride       - The distance between consecutive values of a matrix.
+            count        - The number of matrices.
+            determinants - An array of count values to write the determinants to.
+*/
+
+    VECTOR_TYPE a0, a1, a2, a3, a4, a5, a6, a7, a8;
+    Py_ssize_t i;
+
+    for (i = 0; i < count; i++) {
+        a0 = a[i]; a1 = a[stride + i]; a2 = a[2 * stride + i];
+        a3 = a[3 * stride + i]; a4 = a[4 * stride + i]; a5 = a[5 * stride + i];
+        a6 = a[6 * stride + i]; a7 = a[7 * stride + i]; a8 = a[8 * stride + i];
+
+        determinants[i] = a0 * (a4 * a8 - a5 * a7) + a1 * (a5 * a6 - a3 * a8) + a2 * (a3 * a7 - a4 * a6);
+    }
+}
+
+
+static void _smallInverse3(const VECTOR_TYPE *a, VECTOR_TYPE *out, Py_ssize_t stride, Py_ssize_t count,
+                           VECTOR_TYPE *determinants) {
+/*  Calculates the inverses of a run of 3x3 matrices as their adjugates divided by their determinants.
+
+    Inputs: a            - The first value of the first matrix; the values of matrix i begin at a + i.
+            out          - Where to write the inverses, in the same layout as a; may not overlap a.
+            stride       - The distance between consecutive values of a matrix.
+            count        - The number of matrices.
+            determinants - An array of count values to write the determinants to.  Matrices with a determinant of 0
+                           are not invertible, and the values written for their inverses are not finite.
+*/
+
+    VECTOR_TYPE a0, a1, a2, a3, a4, a5, a6, a7, a8,
+                c0, c1, c2,
+                multiplier;
+    Py_ssize_t i;
+
+    for (i = 0; i < count; i++) {
+        a0 = a[i]; a1 = a[stride + i]; a2 = a[2 * stride + i];
+        a3 = a[3 * stride + i]; a4 = a[4 * stride + i]; a5 = a[5 * stride + i];
+        a6 = a[6 * stride + i]; a7 = a[7 * stride + i]; a8 = a[8 * stride + i];
+
+        c0 = a4 * a8 - a5 * a7;
+        c1 = a5 * a6 - a3 * a8;
+        c2 = a3 * a7 - a4 * a6;
+        determinants[i] = a0 * c0 + a1 * c1 + a2 * c2;
+        multiplier = 1 / determinants[i];
+
+        out[i] = c0 * multiplier;
+        out[stride + i] = (a2 * a7 - a1 * a8) * multiplier;
+        out[2 * stride + i] = (a1 * a5 - a2 * a4) * multiplier;
+        out[3 * stride + i] = c1 * multiplier;
+        out[4 * stride + i] = (a0 * a8 - a2 * a6) * multiplier;
+        out[5 * stride + i] = (a2 * a3 - a0 * a5) * multiplier;
+        out[6 * stride + i] = c2 * multiplier;
+        out[7 * stride + i] = (a1 * a6 - a0 * a7) * multiplier;
+        out[8 * stride + i] = (a0 * a4 - a1 * a3) * multiplier;
+    }
+}
+
+
+static void _smallDeterminant4(const VECTOR_TYPE *a, Py_ssize_t stride, Py_ssize_t count, VECTOR_TYPE *determinants) {
+/*  Calculates the determinants of a run of 4x4 matrices by Laplace expansion along their first two rows; the sum of
+    the products of each 2x2 minor of the top two rows with its complementary minor of the bottom two.
+
+    Inputs: a            - The first value of the first matrix; the values of matrix i begin at a + i.
+            stride       - The distance between consecutive values of a matrix.
+            count        - The number of matrices.
+            determinants - An array of count values to write the determinants to.
+*/
+
+    VECTOR_TYPE a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15;
+    Py_ssize_t i;
+
+    for (i = 0; i < count; i++) {
+        a0 = a[i]; a1 = a[stride + i]; a2 = a[2 * stride + i]; a3 = a[3 * stride + i];
+        a4 = a[4 * stride + i]; a5 = a[5 * stride + i]; a6 = a[6 * stride + i]; a7 = a[7 * stride + i];
+        a8 = a[8 * stride + i]; a9 = a[9 * stride + i]; a10 = a[10 * stride + i]; a11 = a[11 * stride + i];
+        a12 = a[12 * stride + i]; a13 = a[13 * stride + i]; a14 = a[14 * stride + i]; a15 = a[15 * stride + i];
+
+        determinants[i] = (a0 * a5 - a4 * a1) * (a10 * a15 - a14 * a11) -
+                          (a0 * a6 - a4 * a2) * (a9 * a15 - a13 * a11) +
+                          (a0 * a7 - a4 * a3) * (a9 * a14 - a13 * a10) +
+                          (a1 * a6 - a5 * a2) * (a8 * a15 - a12 * a11) -
+                          (a1 * a7 - a5 * a3) * (a8 * a14 - a12 * a10) +
+                          (a2 * a7 - a6 * a3) * (a8 * a13 - a12 * a9);
+    }
+}
+
+
+static void _smallInverse4(const VECTOR_TYPE *a, VECTOR_TYPE *out, Py_ssize_t stride, Py_ssize_t count,
+                           VECTOR_TYPE *determinants) {
+/*  Calculates the inverses of a run of 4x4 matrices as their adjugates divided by their determinants.  Each cofactor
+    is built from the 2x2 minors of the top and bottom pairs of rows, which are shared between them, for 12 minors in
+    all.
+
+    Inputs: a            - The first value of the first matrix; the values of matrix i begin at a + i.
+            out          - Where to write the inverses, in the same layout as a; may not overlap a.
+            stride       - The distance between consecutive values of a matrix.
+            count        - The number of matrices.
+            determinants - An array of count values to write the determinants to.  Matrices with a determinant of 0
+                           are not invertible, and the values written for their inverses are not finite.
+*/
+
+    VECTOR_TYPE a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15,
+                s0, s1, s2, s3, s4, s5,
+                c0, c1, c2, c3, c4, c5,
+                multiplier;
+    Py_ssize_t i;
+
+    for (i = 0; i < count; i++) {
+        a0 = a[i]; a1 = a[stride + i]; a2 = a[2 * stride + i]; a3 = a[3 * stride + i];
+        a4 = a[4 * stride + i]; a5 = a[5 * stride + i]; a6 = a[6 * stride + i]; a7 = a[7 * stride + i];
+        a8 = a[8 * stride + i]; a9 = a[9 * stride + i]; a10 = a[10 * stride + i]; a11 = a[11 * stride + i];
+        a12 = a[12 * stride + i]; a13 = a[13 * stride + i]; a14 = a[14 * stride + i]; a15 = a[15 * stride + i];
+
+        // Minors of the top two rows, s, and of the bottom two, c, indexed by the pair of columns they span
+        s0 = a0 * a5 - a4 * a1;
+        s1 = a0 * a6 - a4 * a2;
+        s2 = a0 * a7 - a4 * a3;
+        s3 = a1 * a6 - a5 * a2;
+        s4 = a1 * a7 - a5 * a3;
+        s5 = a2 * a7 - a6 * a3;
+        c0 = a8 * a13 - a12 * a9;
+        c1 = a8 * a14 - a12 * a10;
+        c2 = a8 * a15 - a12 * a11;
+        c3 = a9 * a14 - a13 * a10;
+        c4 = a9 * a15 - a13 * a11;
+        c5 = a10 * a15 - a14 * a11;
+        determinants[i] = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+        multiplier = 1 / determinants[i];
+
+        out[i] = (a5 * c5 - a6 * c4 + a7 * c3) * multiplier;
+        out[stride + i] = (-a1 * c5 + a2 * c4 - a3 * c3) * multiplier;
+        out[2 * stride + i] = (a13 * s5 - a14 * s4 + a15 * s3) * multiplier;
+        out[3 * stride + i] = (-a9 * s5 + a10 * s4 - a11 * s3) * multiplier;
+        out[4 * stride + i] = (-a4 * c5 + a6 * c2 - a7 * c1) * multiplier;
+        out[5 * stride + i] = (a0 * c5 - a2 * c2 + a3 * c1) * multiplier;
+        out[6 * stride + i] = (-a12 * s5 + a14 * s2 - a15 * s1) * multiplier;
+        out[7 * stride + i] = (a8 * s5 - a10 * s2 + a11 * s1) * multiplier;
+        out[8 * stride + i] = (a4 * c4 - a5 * c2 + a7 * c0) * multiplier;
+        out[9 * stride + i] = (-a0 * c4 + a1 * c2 - a3 * c0) * multiplier;
+        out[10 * stride + i] = (a12 * s4 - a13 * s2 + a15 * s0) * multiplier;
+        out[11 * stride + i] = (-a8 * s4 + a9 * s2 - a11 * s0) * multiplier;
+        out[12 * stride + i] = (-a4 * c3 + a5 * c1 - a6 * c0) * multiplier;
+        out[13 * stride + i] = (a0 * c3 - a1 * c1 + a2 * c0) * multiplier;
+        out[14 * stride + i] = (-a12 * s3 + a13 * s1 - a14 * s0) * multiplier;
+        out[15 * stride + i] = (a8 * s3 - a9 * s1 + a10 * s0) * multiplier;
+    }
+}
+
+
+static void _smallValuesInRange(const VECTOR_TYPE *a, Py_ssize_t stride, Py_ssize_t count, unsigned int n,
+                                unsigned char *inRange) {
+/*  Determines for a run of matrices whether the products of their closed forms can neither overflow nor underflow;
+    that is, whether every value of each matrix lies within SMALL_MATRIX_MIN_VALUE and SMALL_MATRIX_MAX_VALUE, or is 0.
+
+    Inputs: a       - The first value of the first matrix; the values of matrix i begin at a + i.
+            stride  - The distance between consecutive values of a matrix.
+            count   - The number of matrices; at most MATRIX_BATCH_BLOCK.
+            n       - The number of rows & columns of the matrices.
+            inRange - An array of count values to write 1 to for each matrix whose values are in range, otherwise 0.
+*/
+
+    // The extremes are kept in arrays of their own, as flags written during the scan could alias the matrices
+    VECTOR_TYPE smallest[MATRIX_BATCH_BLOCK],
+                largest[MATRIX_BATCH_BLOCK],
+                magnitude;
+    const VECTOR_TYPE *src;
+    Py_ssize_t i;
+    unsigned int k;
+
+    for (i = 0; i < count; i++) {
+        smallest[i] = DBL_MAX;
+        largest[i] = 0;
+    }
+
+    for (k = 0; k < n * n; k++) {
+        src = a + k * stride;
+        for (i = 0; i < count; i++) {
+            magnitude = fabs(src[i]);
+            largest[i] = magnitude > largest[i] ? magnitude : largest[i];
+            smallest[i] = magnitude != 0 && magnitude < smallest[i] ? magnitude : smallest[i];
+        }
+    }
+
+    for (i = 0; i < count; i++)
+        inRange[i] = smallest[i] >= SMALL_MATRIX_MIN_VALUE && largest[i] <= SMALL_MATRIX_MAX_VALUE;
+}
+
+
+static unsigned char _smallDeterminantUsable(const VECTOR_TYPE *a, Py_ssize_t stride, unsigned int n,
+                                             VECTOR_TYPE determinant) {
+/*  Determines whether the closed form determinant of a matrix can be used, or whether it must be calculated by
+    elimination instead.  A determinant which is 0 or not finite may be the result of the products of the closed form
+    underflowing or overflowing, and is only used if the values of the matrix are in range.
+
+    Inputs: a           - The first value of the matrix, in the layout of the kernels.
+            stride      - The distance between consecutive values of the matrix.
+            n           - The number of rows & columns of the matrix.
+            determinant - The closed form determinant of the matrix.
+
+    Outputs: 1 if the determinant can be used, otherwise 0.
+*/
+
+    unsigned char inRange;
+
+    if (determinant != 0 && fabs(determinant) <= DBL_MAX)
+        return 1;
+
+    _smallValuesInRange(a, stride, 1, n, &inRange);
+    return inRange;
+}
+
+
+static void _smallInverseUsable(const VECTOR_TYPE *a, const VECTOR_TYPE *inverses, Py_ssize_t stride,
+                                Py_ssize_t count, unsigned int n, const VECTOR_TYPE *determinants,
+                                unsigned char *usable) {
+/*  Determines for a run of matrices whether their closed form inverses can be used, or whether they must be inverted
+    by elimination instead.  Closed form inverses are only used if the values of the matrix are in range, its
+    determinant is a finite, normal, non-zero number, and every value of the inverse is finite.
+
+    Inputs: a            - The first value of the first matrix; the values of matrix i begin at a + i.
+            inverses     - The first value of the first closed form inverse, in the same layout.
+            stride       - The distance between consecutive values of a matrix.
+            count        - The number of matrices.
+            n            - The number of rows & columns of the matrices.
+            determinants - The determinants of the matrices, computed alongside their inverses.
+            usable       - An array of count values to write 1 to for each usable inverse, otherwise 0.
+*/
+
+    const VECTOR_TYPE *src;
+    Py_ssize_t i;
+    unsigned int k;
+
+    _smallValuesInRange(a, stride, count, n, usable);
+    for (i = 0; i < count; i++) {
+        usable[i] &= (fabs(determinants[i]) >= DBL_MIN) & (fabs(determinants[i]) <= DBL_MAX);
+
+        // The adjugates of matrices in range cannot overflow, so their inverses can only do so for tiny determinants
+        if (!usable[i] || fabs(determinants[i]) >= SMALL_MATRIX_MIN_DETERMINANT)
+            continue;
+
+        for (k = 0; k < n * n; k++) {
+            src = inverses + k * stride + i;
+            usable[i] &= fabs(*src) <= DBL_MAX;
+        }
+    }
+}
+
+
+unsigned char _smallMatrixInverse(Matrix *m, VECTOR_TYPE *values) {
+/*  Attempts to invert a 2x2, 3x3 or 4x4 matrix in closed form.
+
+    Inputs: m      - The matrix to invert.
+            values - An array of at least 16 values to write the inverse to, row by row.
+
+    Outputs: 1 if values holds the inverse of m, or 0 if m must instead be inverted by elimination; either because it
+             is singular, or because its values are too large or too small for the closed form.
+*/
+
+    VECTOR_TYPE packed[16],
+                determinant;
+    unsigned char usable;
+
+    _smallMatrixPack(m, packed);
+    switch (m->rows) {
+        case 2:
+            _smallInverse2(packed, values, 1, 1, &determinant);
+            break;
+        case 3:
+            _smallInverse3(packed, values, 1, 1, &determinant);
+            break;
+        default:
+            _smallInverse4(packed, values, 1, 1, &determinant);
+    }
+
+    _smallInverseUsable(packed, values, 1, 1, m->rows, &determinant, &usable);
+    return usable;
+}
+
+
+PyObject *batchInverseFunction(PyObject *self, FASTCALL_PARAMETERS) {
+/*  Inverts a number of square matrices of the same size in a single call.
+
+    Inputs: self  - A pointer to the pytrix module.
+            args  - A sequence of square Matrix objects, all of the same size.
+            nargs - The number of arguments in args.
+
+    Outputs: A list of the inverses of the matrices, in the same order, or NULL if an error occurred.
+*/
+
+    FASTCALL_UNPACK_ARGS
+    PyObject *sequence,
+             *result = NULL;
+    Matrix *m,
+           *inverse;
+    VECTOR_TYPE values[16];
+    Py_ssize_t count,
+               i;
+    unsigned int n = 0,
+                 row;
+
+    if (!_assertArgCount("batch_inverse", nargs, 1))
+        return NULL;
+
+    if ((sequence = PySequence_Fast(args[0], "batch_inverse() requires a sequence of Matrix objects.")) == NULL)
+        return NULL;
+    count = PySequence_Fast_GET_SIZE(sequence);
+
+    for (i = 0; i < count; i++) {
+        if (!_assertMatrix(PySequence_Fast_GET_ITEM(sequence, i)))
+            goto cleanup;
+        m = (Matrix *)PySequence_Fast_GET_ITEM(sequence, i);
+
+        if (i == 0)
+            n = m->rows;
+        if (m->rows != m->columns || m->rows != n) {
+            PyErr_Format(PyExc_ValueError, "batch_inverse() requires square matrices of the same size; matrix %zd is "
+                         "%ux%u.", i, m->rows, m->columns);
+            goto cleanup;
+        }
+    }
+
+    if ((result = PyList_New(count)) == NULL)
+        goto cleanup;
+
+    for (i = 0; i < count; i++) {
+        m = (Matrix *)PySequence_Fast_GET_ITEM(sequence, i);
+
+        if (n >= 2 && n <= 4 && _smallMatrixInverse(m, values)) {
+            if ((inverse = _matrixNewContiguous(n, n)) == NULL)
+                goto error;
+            for (row = 0; row < n; row++)
+                memcpy(Matrix_GetVector(inverse, row)->data, values + row * n, sizeof(VECTOR_TYPE) * n);
+
+        } else if ((inverse = _matrixInverse(m)) == NULL) {
+            // Name the matrix which could not be inverted
+            if (PyErr_ExceptionMatches(PyExc_ValueError)) {
+                PyErr_Clear();
+                PyErr_Format(PyExc_ValueError, "Cannot take inverse of non-invertible matrix %zd.", i);
+            }
+            goto error;
+        }
+
+        PyList_SET_ITEM(result, i, (PyObject *)inverse);
+    }
+
+    goto cleanup;
+
+error:
+    Py_CLEAR(result);
+
+cleanup:
+    Py_DECREF(sequence);
+    return result;
+}
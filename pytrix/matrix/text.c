@@ -0,0 +1,267 @@
+/*
+ *  Copyright (C) 2016 Warren Spencer warrenspencer27@gmail.com
+
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+static unsigned char _textSourceIsPath(PyObject *source) {
+/*  Determines whether a source passed to Matrix.from_text / Matrix.from_csv is a path, or the text itself.
+
+    Inputs: source - The source object.
+
+    Outputs: 1 if source should be treated as a path, 0 if it is an object supporting the buffer protocol containing
+             the text to parse.
+*/
+
+#if PY_MAJOR_VERSION < 3
+    if (PyString_Check(source))
+        return 1;
+#endif
+
+    return PyUnicode_Check(source) || !PyObject_CheckBuffer(source);
+}
+
+
+static Matrix *_matrixParseText(PyObject *source, const char *delimiter) {
+/*  Creates a new matrix by parsing delimited text, one row per line.
+
+    Inputs: source    - Either the path of a file to parse, or an object supporting the buffer protocol containing the
+                        text to parse.
+            delimiter - A single character string separating values on a line, or NULL to separate them by whitespace.
+
+    Outputs: A new Matrix, or NULL if an error occurred.
+*/
+
+    TextParser parser;
+    Py_buffer view;
+    Matrix *m = NULL;
+    unsigned char parsed;
+
+    // Delimiters may not be any of the characters which can appear in a number, or end a line
+    if (delimiter != NULL && (strlen(delimiter) != 1 || (unsigned char)delimiter[0] > 127 ||
+                              strchr("\r\n.+-eE0123456789", delimiter[0]) != NULL)) {
+        PyErr_SetString(PyExc_ValueError, "delimiter must be a single ASCII character, other than a digit, '\\r', "
+                                          "'\\n', '.', '+', '-', 'e' or 'E'.");
+        return NULL;
+    }
+
+    if (!_textParserInit(&parser, delimiter == NULL ? '\0' : delimiter[0]))
+        return NULL;
+
+    if (_textSourceIsPath(source)) {
+        parsed = _textParseFile(&parser, source);
+    } else {
+        if (PyObject_GetBuffer(source, &view, PyBUF_SIMPLE) == -1) {
+            _textParserFree(&parser);
+            return NULL;
+        }
+
+        parsed = _textParse(&parser, view.buf, view.len, 1) != -1;
+        PyBuffer_Release(&view);
+    }
+
+    // Trim the parsed values to size, and have the matrix reference them directly
+    if (parsed && _PyBytes_Resize(&parser.values, parser.count * sizeof(VECTOR_TYPE)) != -1 &&
+        _getVectorTypeBuffer(parser.values, (Py_ssize_t)parser.count, &view)) {
+        m = _matrixFromBuffer(&view, parser.rows, parser.columns);
+        PyBuffer_Release(&view);
+    }
+
+    _textParserFree(&parser);
+    return m;
+}
+
+
+PyObject *matrixFromText(PyObject *cls, PyObject *args, PyObject *kwargs) {
+/*  Creates a new matrix by parsing text containing one row per line, with values separated by whitespace or a
+    delimiter.
+
+    Inputs: cls    - The Matrix type.
+            args   - A tuple containing either the path of a file to parse, or a bytes-like object containing the text.
+            kwargs - Optionally contains delimiter; the character separating values on a line.  Defaults to None, which
+                     separates values by runs of whitespace.
+
+    Outputs: A new Matrix, or NULL if an error occurred.
+*/
+
+    static char *kwlist[] = {"source", "delimiter", NULL};
+    PyObject *source;
+    const char *delimiter = NULL;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|z:from_text", kwlist, &source, &delimiter))
+        return NULL;
+
+    return (PyObject *)_matrixParseText(source, delimiter);
+}
+
+
+PyObject *matrixFromCsv(PyObject *cls, PyObject *args, PyObject *kwargs) {
+/*  Creates a new matrix by parsing comma separated values, one row per line.
+
+    Inputs: cls    - The Matrix type.
+            args   - A tuple containing either the path of a file to parse, or a bytes-like object containing the text.
+            kwargs - Optionally contains delimiter; the character separating values on a line.  Defaults to ','.
+
+    Outputs: A new Matrix, or NULL if an error occurred.
+*/
+
+    static char *kwlist[] = {"source", "delimiter", NULL};
+    PyObject *source;
+    const char *delimiter = ",";
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|s:from_csv", kwlist, &source, &delimiter))
+        return NULL;
+
+    return (PyObject *)_matrixParseText(source, delimiter);
+}
+
+
+static char *_matrixFormatRows(Matrix *self, const char *prefix, const char *separator, const char *suffix,
+                               const char *lineSeparator, size_t *length) {
+/*  Formats the rows of a matrix as text into a single, preallocated buffer.
+
+    Inputs: self          - The matrix to format.
+            prefix        - A string to write before each row.
+            separator     - A string to write between each value of a row.
+            suffix        - A string to write after each row.
+            lineSeparator - A string to write between each row.
+            length        - Set to the number of bytes written to the returned buffer.
+
+    Outputs: A buffer allocated with PyMem_Malloc containing the formatted text, or NULL if an error occurred.
+*/
+
+    unsigned int i;
+    size_t prefixLength = strlen(prefix),
+           separatorLength = strlen(separator),
+           suffixLength = strlen(suffix),
+           lineSeparatorLength = strlen(lineSeparator);
+    char *buffer,
+         *dst;
+
+    buffer = PyMem_Malloc(1 + (size_t)self->rows * (prefixLength + suffixLength + lineSeparatorLength +
+                                                   (size_t)self->columns * (TEXT_MAX_DOUBLE_LENGTH + separatorLength)));
+    if (buffer == NULL) {
+        PyErr_NoMemory();
+        return NULL;
+    }
+
+    dst = buffer;
+    for (i = 0; i < self->rows; i++) {
+        if (i) {
+            memcpy(dst, lineSeparator, lineSeparatorLength);
+            dst += lineSeparatorLength;
+        }
+
+        memcpy(dst, prefix, prefixLength);
+        dst += prefixLength;
+
+        if ((dst = _formatVectorTypeArray(dst, Matrix_GetVector(self, i)->data, self->columns, separator,
+                                          separatorLength)) == NULL) {
+            PyMem_Free(buffer);
+            return NULL;
+        }
+
+        memcpy(dst, suffix, suffixLength);
+        dst += suffixLength;
+    }
+
+    *length = dst - buffer;
+    return buffer;
+}
+
+
+PyObject *matrixStr(Matrix *self) {
+/*  Constructs a human-readable Python String representing a human readable version of this matrix.
+
+    Inputs: self - The matrix for which the human readable format will be produced.
+
+    Outputs: A PyString containing the human readable form of the matrix.
+*/
+
+    PyObject *str;
+    char *buffer;
+    size_t length;
+
+    if ((buffer = _matrixFormatRows(self, "[", ", ", "]", "\n", &length)) == NULL)
+        return NULL;
+
+    str = PyUnicode_FromStringAndSize(buffer, length);
+    PyMem_Free(buffer);
+    return str;
+}
+
+
+PyObject *matrixToText(Matrix *self, PyObject *args, PyObject *kwargs) {
+/*  Formats this matrix as text, one row per line, with values formatted as Python's repr of a float.
+
+    Inputs: self   - The matrix to format.
+            args   - Optionally contains path; if given the text is written to the file at path rather than returned.
+            kwargs - Optionally contains path and delimiter; the string written between each value.  Defaults to ' '.
+
+    Outputs: A string containing the formatted matrix, or None if path was given.  NULL if an error occurred.
+*/
+
+    static char *kwlist[] = {"path", "delimiter", NULL};
+    PyObject *path = Py_None,
+             *str;
+    const char *delimiter = " ";
+    char *buffer;
+    size_t length;
+    unsigned int i;
+    FILE *f;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|Os:to_text", kwlist, &path, &delimiter))
+        return NULL;
+
+    if (path == Py_None) {
+        if ((buffer = _matrixFormatRows(self, "", delimiter, "\n", "", &length)) == NULL)
+            return NULL;
+
+        str = PyUnicode_FromStringAndSize(buffer, length);
+        PyMem_Free(buffer);
+        return str;
+    }
+
+    // When writing to a file, only one row is formatted at a time
+    if ((buffer = PyMem_Malloc(1 + (size_t)self->columns * (TEXT_MAX_DOUBLE_LENGTH + strlen(delimiter)))) == NULL)
+        return PyErr_NoMemory();
+
+    if ((f = _openPath(path, "wb")) == NULL) {
+        PyMem_Free(buffer);
+        return NULL;
+    }
+
+    for (i = 0; i < self->rows; i++) {
+        char *end;
+
+        if ((end = _formatVectorTypeArray(buffer, Matrix_GetVector(self, i)->data, self->columns, delimiter,
+                                          strlen(delimiter))) == NULL)
+            break;
+        *end++ = '\n';
+
+        if (fwrite(buffer, 1, end - buffer, f) != (size_t)(end - buffer)) {
+            PyErr_SetFromErrno(PyExc_IOError);
+            break;
+        }
+    }
+
+    PyMem_Free(buffer);
+    if (fclose(f) != 0 && !PyErr_Occurred())
+        PyErr_SetFromErrno(PyExc_IOError);
+
+    if (PyErr_Occurred())
+        return NULL;
+
+    Py_RETURN_NONE;
+}
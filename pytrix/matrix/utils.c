@@ -39,6 +39,8 @@ Matrix *_matrixNewBlank(unsigned int rows, unsigned int columns) {
     newMatrix->rows = rows;
     newMatrix->columns = columns;
     newMatrix->data = data;
+    newMatrix->hash = -1;
+    newMatrix->isMutable = 0;
 
     return newMatrix;
 }
@@ -73,6 +75,129 @@ Matrix *_matrixNew(unsigned int rows, unsigned int columns) {
 }
 
 
+Matrix *_matrixNewView(unsigned int rows, unsigned int columns, VECTOR_TYPE *data, PyObject *base) {
+/*  Creates a new matrix object whose rows reference a contiguous, row-major block of data owned by another object.
+
+    Inputs: rows    - The number of rows to create the new matrix with.
+            columns - The number of columns per row in the new matrix.
+            data    - A pointer to the first of rows * columns values the matrix should use as its data.
+            base    - The object which owns data.  Each row of the matrix holds a reference to it.
+
+    Outputs: A pointer to the new Matrix object, or NULL if an error occurred.
+*/
+
+    unsigned int i;
+    Matrix *newMatrix;
+    Vector *row;
+
+    if ((newMatrix = _matrixNewBlank(rows, columns)) == NULL)
+        return NULL;
+
+    for (i = 0; i < rows; i++) {
+        if ((row = _vectorNewView(columns, data + (size_t)i * columns, base)) == NULL) {
+            matrixDeInit(newMatrix);
+            return NULL;
+        }
+
+        Matrix_SetVector(newMatrix, i, row);
+    }
+
+    return newMatrix;
+}
+
+
+Matrix *_matrixNewContiguous(unsigned int rows, unsigned int columns) {
+/*  Creates a new matrix object whose rows are laid out one after another in a single block of memory, held by a bytes
+    object.  The contents of the matrix are uninitialized.
+
+    Inputs: rows    - The number of rows to create the new matrix with.
+            columns - The number of columns per row in the new matrix.
+
+    Outputs: A pointer to the new Matrix object, or NULL if an error occurred.
+*/
+
+    PyObject *block;
+    Matrix *newMatrix;
+    char *data;
+
+    // Allocate an extra value so that the data can be aligned regardless of where the bytes object stores it
+    if ((block = PyBytes_FromStringAndSize(NULL, ((Py_ssize_t)rows * columns + 1) * sizeof(VECTOR_TYPE))) == NULL)
+        return NULL;
+
+    data = PyBytes_AS_STRING(block);
+    data += (sizeof(VECTOR_TYPE) - (uintptr_t)data % sizeof(VECTOR_TYPE)) % sizeof(VECTOR_TYPE);
+
+    newMatrix = _matrixNewView(rows, columns, (VECTOR_TYPE *)data, block);
+    Py_DECREF(block);
+    return newMatrix;
+}
+
+
+void _matrixApplyTransposed(VECTOR_TYPE *transposed, unsigned int rows, unsigned int columns, VECTOR_TYPE **inputs,
+                            Py_ssize_t count, VECTOR_TYPE *out, VECTOR_TYPE *scratch) {
+/*  Multiplies a matrix by each of a number of vectors, writing the results one after another into out.  Equivalent
+    to the matrix-matrix product of the vectors, taken as rows, with the transpose of the matrix; does not touch any
+    Python objects so that it may be run without the GIL.
+
+    Inputs: transposed - The transpose of the matrix, as a columns x rows block of values.
+            rows       - The number of rows in the matrix, and so the dimensions of each result.
+            columns    - The number of columns in the matrix, and so the dimensions of each input.
+            inputs     - Pointers to the data of each vector to multiply.
+            count      - The number of vectors.
+            out        - A block of count * rows values to write the results into.  It may hold the inputs.
+            scratch    - Space for rows values, which each result is accumulated in before being written to out.
+*/
+
+    Py_ssize_t v;
+    unsigned int row,
+                 col;
+    VECTOR_TYPE factor,
+                *dst,
+                *src;
+
+    for (v = 0; v < count; v++) {
+        memset(scratch, 0, sizeof(VECTOR_TYPE) * rows);
+        for (col = 0; col < columns; col++) {
+            factor = inputs[v][col];
+            src = transposed + (size_t)col * rows;
+            for (row = 0; row < rows; row++)
+                scratch[row] += factor * src[row];
+        }
+        dst = out + (size_t)v * rows;
+        memcpy(dst, scratch, sizeof(VECTOR_TYPE) * rows);
+    }
+}
+
+
+Matrix *_matrixFromBuffer(Py_buffer *view, unsigned int rows, unsigned int columns) {
+/*  Creates a new matrix from a buffer of rows * columns VECTOR_TYPEs, laid out row by row.  Immutable buffers (such
+    as those produced when unpickling) are referenced directly rather than copied.
+
+    Inputs: view    - A buffer acquired by _getVectorTypeBuffer.
+            rows    - The number of rows to create the new matrix with.
+            columns - The number of columns per row in the new matrix.
+
+    Outputs: A pointer to the new Matrix object, or NULL if an error occurred.
+*/
+
+    unsigned int i;
+    PyObject *owner;
+    Matrix *newMatrix;
+
+    if ((owner = _vectorTypeBufferOwner(view)) != NULL)
+        return _matrixNewView(rows, columns, (VECTOR_TYPE *)view->buf, owner);
+
+    if ((newMatrix = _matrixNew(rows, columns)) == NULL)
+        return NULL;
+
+    for (i = 0; i < rows; i++)
+        memcpy(Matrix_GetVector(newMatrix, i)->data, (VECTOR_TYPE *)view->buf + (size_t)i * columns,
+               columns * sizeof(VECTOR_TYPE));
+
+    return newMatrix;
+}
+
+
 void _matrixCopyData(Matrix *in, Matrix *out) {
 /*  Copies the contents from one matrix to another.  Does no error checking.
 
@@ -199,6 +324,54 @@ unsigned char _matricesEqual(Matrix *a, Matrix *b) {
 }
 
 
+void _inplaceMatrixAdd(Matrix *a, Matrix *b, Matrix *out) {
+/*  Adds the components of two matrices together, writing the result into out.
+    Assumes that a, b & out have the same dimensions; out may safely be one of a, b.
+
+    Inputs: a   - The first matrix to add.
+            b   - The second matrix to add.
+            out - The matrix to write a + b into.
+*/
+
+    unsigned int i;
+
+    for (i = 0; i < out->rows; i++)
+        _inplaceVectorAdd(Matrix_GetVector(a, i), Matrix_GetVector(b, i), Matrix_GetVector(out, i));
+}
+
+
+void _inplaceMatrixSub(Matrix *a, Matrix *b, Matrix *out) {
+/*  Subtracts the components of one matrix from another, writing the result into out.
+    Assumes that a, b & out have the same dimensions; out may safely be one of a, b.
+
+    Inputs: a   - The matrix to subtract from.
+            b   - The matrix to be subtracted from a.
+            out - The matrix to write a - b into.
+*/
+
+    unsigned int i;
+
+    for (i = 0; i < out->rows; i++)
+        _inplaceVectorSub(Matrix_GetVector(a, i), Matrix_GetVector(b, i), Matrix_GetVector(out, i));
+}
+
+
+void _inplaceScalarMatrixMul(Matrix *self, VECTOR_TYPE multiplier, Matrix *out) {
+/*  Multiplies the components of a matrix by a scalar, writing the result into out.
+    Assumes that self & out have the same dimensions; out may safely be self.
+
+    Inputs: self       - The matrix to be multiplied by multiplier.
+            multiplier - The scalar to multiply self by.
+            out        - The matrix to write self * multiplier into.
+*/
+
+    unsigned int i;
+
+    for (i = 0; i < out->rows; i++)
+        _inplaceVectorMul(Matrix_GetVector(self, i), multiplier, Matrix_GetVector(out, i));
+}
+
+
 Matrix *_matrixAdd(Matrix *a, Matrix *b) {
 /*  Adds the components of two matrices together to construct a third matrix.
 
@@ -208,23 +381,15 @@ Matrix *_matrixAdd(Matrix *a, Matrix *b) {
     Outputs: A new third matrix constructed by performing a + b, or NULL if an error occurred.
 */
 
-    unsigned int i;
     Matrix *sum;
-    Vector *row;
 
     if (!_assertMatrixDimensionsEqual(a, b))
         return NULL;
 
-    if ((sum = _matrixNewBlank(a->rows, a->columns)) == NULL)
+    if ((sum = _matrixNew(a->rows, a->columns)) == NULL)
         return NULL;
 
-    for (i = 0; i < sum->rows; i++) {
-        if ((row = _vectorAdd(Matrix_GetVector(a, i), Matrix_GetVector(b, i))) == NULL) {
-            Py_DECREF(sum);
-            return NULL;
-        }
-        Matrix_SetVector(sum, i, row);
-    }
+    _inplaceMatrixAdd(a, b, sum);
 
     return sum;
 }
@@ -239,23 +404,15 @@ Matrix *_matrixSub(Matrix *a, Matrix *b) {
     Outputs: A new third matrix constructed by performing a - b, or NULL if an error occurred.
 */
 
-    unsigned int i;
     Matrix *difference;
-    Vector *row;
 
     if (!_assertMatrixDimensionsEqual(a, b))
         return NULL;
 
-    if ((difference = _matrixNewBlank(a->rows, a->columns)) == NULL)
+    if ((difference = _matrixNew(a->rows, a->columns)) == NULL)
         return NULL;
 
-    for (i = 0; i < difference->rows; i++) {
-        if ((row = _vectorSub(Matrix_GetVector(a, i), Matrix_GetVector(b, i))) == NULL) {
-            Py_DECREF(difference);
-            return NULL;
-        }
-        Matrix_SetVector(difference, i, row);
-    }
+    _inplaceMatrixSub(a, b, difference);
 
     return difference;
 }
@@ -270,45 +427,49 @@ Matrix *_scalarMatrixMul(Matrix *self, VECTOR_TYPE multiplier) {
     Outputs: A new matrix constructed by performing self * multiplier, or NULL if an error occurred.
 */
 
-    unsigned int i;
     Matrix *product;
-    Vector *row;
 
     if ((product = _matrixNew(self->rows, self->columns)) == NULL)
         return NULL;
 
-    for (i = 0; i < self->rows; i++) {
-        if ((row = _vectorMul(Matrix_GetVector(self, i), multiplier)) == NULL) {
-            Py_DECREF(product);
-            return NULL;
-        }
-        Matrix_SetVector(product, i, row);
-    }
+    _inplaceScalarMatrixMul(self, multiplier, product);
 
     return product;
 }
 
 
-Vector *_vectorMatrixMul(Matrix *m, Vector *v) {
-/*  Multiplies a Matrix by a Vector.
+unsigned char _inplaceVectorMatrixMul(Matrix *m, Vector *v, Vector *out) {
+/*  Multiplies a Matrix by a Vector, writing the result into out.
+    Note that out may safely be v.
 
-    Inputs: m - The matrix to multiply.
-            v - The vector to multiply.
+    Inputs: m   - The matrix to multiply.
+            v   - The vector to multiply.
+            out - The vector to write m * v into.
 
-    Outputs: A new Vector constructed by performing a * b, or NULL if an error occurred.
+    Outputs: 1 if successful, 0 if an error occurred.
 */
 
     unsigned int i,
                  j;
-    Vector *outVector;
+    Vector *temp = NULL;
     VECTOR_TYPE val;
 
     if (v->dimensions != m->columns) {
         PyErr_SetString(PyExc_ValueError, "Matrix * Vector multiplication must have M.cols = V.dimensions");
-        return NULL;
+        return 0;
     }
 
-    outVector = _vectorNew(m->rows);
+    if (out->dimensions != m->rows) {
+        PyErr_SetString(PyExc_ValueError, "Matrix * Vector multiplication must have Out.dimensions = M.rows");
+        return 0;
+    }
+
+    // If we're writing over our input vector, take a copy of it first as each of its components is read for every row
+    if (out == v) {
+        if ((temp = _vectorCopy(v)) == NULL)
+            return 0;
+        v = temp;
+    }
 
     for (i = 0; i < m->rows; i++) {
         val = 0;
@@ -316,7 +477,37 @@ Vector *_vectorMatrixMul(Matrix *m, Vector *v) {
             val += Matrix_GetValue(m, i, j) * Vector_GetValue(v, j);
         }
 
-        Vector_SetValue(outVector, i, val);
+        Vector_SetValue(out, i, val);
+    }
+
+    Py_XDECREF(temp);
+
+    return 1;
+}
+
+
+Vector *_vectorMatrixMul(Matrix *m, Vector *v) {
+/*  Multiplies a Matrix by a Vector.
+
+    Inputs: m - The matrix to multiply.
+            v - The vector to multiply.
+
+    Outputs: A new Vector constructed by performing a * b, or NULL if an error occurred.
+*/
+
+    Vector *outVector;
+
+    if (v->dimensions != m->columns) {
+        PyErr_SetString(PyExc_ValueError, "Matrix * Vector multiplication must have M.cols = V.dimensions");
+        return NULL;
+    }
+
+    if ((outVector = _vectorNew(m->rows)) == NULL)
+        return NULL;
+
+    if (!_inplaceVectorMatrixMul(m, v, outVector)) {
+        Py_DECREF(outVector);
+        return NULL;
     }
 
     return outVector;
@@ -337,7 +528,9 @@ unsigned char _inplaceMatrixMatrixMul(Matrix *left, Matrix *right, Matrix *out)
     unsigned int row,
                  col,
                  i;
+    unsigned char success;
     Vector *temp;
+    Matrix *rightCopy;
     VECTOR_TYPE val = 0;
 
     if (left->columns != right->rows) {
@@ -350,8 +543,16 @@ unsigned char _inplaceMatrixMatrixMul(Matrix *left, Matrix *right, Matrix *out)
         return 0;
     }
 
+    // If we're squaring out in place, take a copy of the right-hand side; it is read from after rows of out are written
+    if (left == out && right == out) {
+        if ((rightCopy = _matrixCopy(right)) == NULL)
+            return 0;
+        success = _inplaceMatrixMatrixMul(left, rightCopy, out);
+        Py_DECREF(rightCopy);
+        return success;
+
     // If we're doing an in-place left-hand side matrix multiplication
-    if (left == out) {
+    } else if (left == out) {
         if ((temp = _vectorNew(left->columns)) == NULL)
             return 0;
 
@@ -402,6 +603,36 @@ unsigned char _inplaceMatrixMatrixMul(Matrix *left, Matrix *right, Matrix *out)
 }
 
 
+void _inplaceMatrixGemm(VECTOR_TYPE alpha, Matrix *a, Matrix *b, Matrix *out) {
+/*  Accumulates alpha * a * b into out.  Rows of b are streamed in order for each element of a, so that the innermost
+    loop runs over contiguous memory.
+    Note that out must not be one of a, b, and that dimensions are not checked.
+
+    Inputs: alpha - The factor to multiply a * b by.
+            a     - The left matrix to multiply.
+            b     - The right matrix to multiply.
+            out   - The matrix to add the product to.
+*/
+
+    unsigned int row,
+                 col,
+                 i;
+    VECTOR_TYPE factor,
+                *dst,
+                *src;
+
+    for (row = 0; row < a->rows; row++) {
+        dst = Matrix_GetVector(out, row)->data;
+        for (i = 0; i < a->columns; i++) {
+            factor = alpha * Matrix_GetValue(a, row, i);
+            src = Matrix_GetVector(b, i)->data;
+            for (col = 0; col < b->columns; col++)
+                dst[col] += factor * src[col];
+        }
+    }
+}
+
+
 Matrix *_matrixMatrixMul(Matrix *a, Matrix *b, unsigned char checkStrassen) {
 /*  Multiplies a matrix by another matrix.
 
@@ -529,6 +760,7 @@ unsigned char _matrixInvertible(Matrix *m) {
              Calling functions should check whether or not an error was raised with PyErr_Occurred.
 */
 
+    VECTOR_TYPE values[16];
     unsigned int rank;
 
     if (m->rows != m->columns)
@@ -537,9 +769,9 @@ unsigned char _matrixInvertible(Matrix *m) {
     if (m->rows == 1)
         return Matrix_GetValue(m, 0, 0) != 0;
 
-    if (m->rows == 2) {
-        return _matrixDeterminant(m) != 0;
-    }
+    // Matrices of up to 4 x 4 which can't be inverted in closed form may still be invertible by elimination
+    if (m->rows >= 2 && m->rows <= 4 && _smallMatrixInverse(m, values))
+        return 1;
 
     rank = _matrixRank((Matrix *)m);
 
@@ -632,7 +864,8 @@ VECTOR_TYPE _matrixDeterminant(Matrix *m) {
     Matrix *tempM;
     Vector *tempRow;
     VECTOR_TYPE determinant = 1,
-                multiplier;
+                multiplier,
+                packed[16];
 
     PyErr_Clear();
 
@@ -648,6 +881,19 @@ VECTOR_TYPE _matrixDeterminant(Matrix *m) {
         return ((Matrix_GetValue(m, 1, 1) * Matrix_GetValue(m, 0, 0)) -
                       (Matrix_GetValue(m, 0, 1) * Matrix_GetValue(m, 1, 0)));
 
+    // 3 x 3 and 4 x 4 matrices have closed form determinants which don't require a copy, unless their values are too
+    // large or small for its products
+    if (m->rows == 3 || m->rows == 4) {
+        _smallMatrixPack(m, packed);
+        if (m->rows == 3)
+            _smallDeterminant3(packed, 1, 1, &determinant);
+        else
+            _smallDeterminant4(packed, 1, 1, &determinant);
+        if (_smallDeterminantUsable(packed, 1, m->rows, determinant))
+            return determinant;
+        determinant = 1;
+    }
+
     if ((tempM = _matrixCopy(m)) == NULL)
         return 0;
 
@@ -856,7 +1102,8 @@ Matrix *_matrixInverse(Matrix *m) {
     Matrix *inverse,
            *tempM;
     Vector *tempRow;
-    VECTOR_TYPE multiplier;
+    VECTOR_TYPE multiplier,
+                values[16];
     unsigned int row,
                  col,
                  tempIter;
@@ -880,26 +1127,10 @@ Matrix *_matrixInverse(Matrix *m) {
         return inverse;
     }
 
-    // If m is 2 x 2 we can do this faster without guassian elimination
-    if (m->rows == 2) {
-        multiplier = _matrixDeterminant(m);
-        if (PyErr_Occurred()) {
-            Py_DECREF(inverse);
-            return NULL;
-        }
-
-        // Assert that it's invertible
-        if (multiplier == 0) {
-            PyErr_SetString(PyExc_ValueError, "Cannot take inverse of non-invertible matrix.");
-            Py_DECREF(inverse);
-            return NULL;
-        }
-
-        multiplier = 1 / multiplier;
-        Matrix_SetValue(inverse, 0, 0, multiplier * Matrix_GetValue(m, 1, 1));
-        Matrix_SetValue(inverse, 0, 1, -(multiplier * Matrix_GetValue(m, 0, 1)));
-        Matrix_SetValue(inverse, 1, 0, -(multiplier * Matrix_GetValue(m, 1, 0)));
-        Matrix_SetValue(inverse, 1, 1, multiplier * Matrix_GetValue(m, 0, 0));
+    // Matrices of up to 4 x 4 can be inverted directly from their adjugates, unless they are singular or badly scaled
+    if (m->rows >= 2 && m->rows <= 4 && _smallMatrixInverse(m, values)) {
+        for (row = 0; row < m->rows; row++)
+            memcpy(Matrix_GetVector(inverse, row)->data, values + row * m->rows, sizeof(VECTOR_TYPE) * m->rows);
         return inverse;
     }
 
@@ -15,25 +15,27 @@
  *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
-PyObject *identityMatrix(PyObject *, PyObject *);
-PyObject *rotation2DMatrix(PyObject *, PyObject *);
-PyObject *rotation3DMatrix(PyObject *, PyObject *);
-PyObject *permutationMatrix(PyObject *, PyObject *);
+PyObject *identityMatrix(PyObject *, FASTCALL_PARAMETERS);
+PyObject *rotation2DMatrix(PyObject *, FASTCALL_PARAMETERS);
+PyObject *rotation3DMatrix(PyObject *, FASTCALL_PARAMETERS);
+PyObject *permutationMatrix(PyObject *, FASTCALL_PARAMETERS);
 
 
-PyObject *identityMatrix(PyObject *self, PyObject *args) {
+PyObject *identityMatrix(PyObject *self, FASTCALL_PARAMETERS) {
 /*  Convenience function for constructing identity matrices of particular dimensions.
 
-    Inputs: self - A pointer to the pytrix module.
-            args - A PyTuple containing a PyNumber of the number of dimensions to initialize the identity matrix with.
+    Inputs: self  - A pointer to the pytrix module.
+            args  - A PyNumber of the number of dimensions to initialize the identity matrix with.
+            nargs - The number of arguments in args.
 
     Outputs: An identity Matrix of the specified dimensions.
 */
 
+    FASTCALL_UNPACK_ARGS
     Matrix *identity;
     long dimensions;
 
-    if (!PyArg_ParseTuple(args, "l", &dimensions))
+    if (!_assertArgCount("identityMatrix", nargs, 1) || !_parseLongArg(args[0], &dimensions))
         return NULL;
 
     if (dimensions < 0) {
@@ -41,9 +43,6 @@ PyObject *identityMatrix(PyObject *self, PyObject *args) {
         return NULL;
     }
 
-    if (PyErr_Occurred())
-        return NULL;
-
     if ((identity = _matrixNew(dimensions, dimensions)) == NULL)
         return NULL;
 
@@ -56,19 +55,21 @@ PyObject *identityMatrix(PyObject *self, PyObject *args) {
 }
 
 
-PyObject *rotation2DMatrix(PyObject *self, PyObject *args) {
+PyObject *rotation2DMatrix(PyObject *self, FASTCALL_PARAMETERS) {
 /*  Convenience function for constructing a rotation matrix to rotate a vector by a specified number of radians.
 
-    Inputs: self - A pointer to the pytrix module.
-            args - A PyTuple containing a PyNumber containing the radians to rotate the matrix.
+    Inputs: self  - A pointer to the pytrix module.
+            args  - A PyNumber containing the radians to rotate the matrix.
+            nargs - The number of arguments in args.
 
     Outputs: A rotation Matrix with the specified rotation properties.
 */
 
+    FASTCALL_UNPACK_ARGS
     Matrix *rotation;
     VECTOR_TYPE radians;
 
-    if (!PyArg_ParseTuple(args, "d", &radians))
+    if (!_assertArgCount("rotation2DMatrix", nargs, 1) || !_parseVectorTypeArg(args[0], &radians))
         return NULL;
 
     if ((rotation = _matrixNew(2, 2)) == NULL)
@@ -83,120 +84,76 @@ PyObject *rotation2DMatrix(PyObject *self, PyObject *args) {
 }
 
 
-PyObject *rotation3DMatrix(PyObject *self, PyObject *args) {
+PyObject *rotation3DMatrix(PyObject *self, FASTCALL_PARAMETERS) {
 /*  Convenience function for constructing a rotation matrix to rotate a vector by a specified number of radians.
 
-    Inputs: self - A pointer to the pytrix module.
-            args - A PyTuple containing three PyNumbers for the x, y, and z rotation radians.
+    Inputs: self  - A pointer to the pytrix module.
+            args  - Three PyNumbers for the x, y, and z rotation radians.
+            nargs - The number of arguments in args.
 
     Outputs: A rotation Matrix with the specified rotation properties.
 */
 
-    Matrix *xRotation = NULL,
-           *yRotation = NULL,
-           *zRotation = NULL,
-           *rotation;
+    FASTCALL_UNPACK_ARGS
+    Matrix *rotation;
     VECTOR_TYPE xRadians,
                 yRadians,
-                zRadians;
-
-    if (!PyArg_ParseTuple(args, "ddd", &xRadians, &yRadians, &zRadians))
+                zRadians,
+                cx,
+                sx,
+                cy,
+                sy,
+                cz,
+                sz;
+
+    if (!_assertArgCount("rotation3DMatrix", nargs, 3) || !_parseVectorTypeArg(args[0], &xRadians) ||
+        !_parseVectorTypeArg(args[1], &yRadians) || !_parseVectorTypeArg(args[2], &zRadians))
         return NULL;
 
     if ((rotation = _matrixNew(3, 3)) == NULL)
         return NULL;
-    if (!_matrixInitIdentity(rotation, 1)) {
-        Py_DECREF(rotation);
-        return NULL;
-    }
 
-    if (xRadians != 0) {
-        if ((xRotation = _matrixNew(3, 3)) == NULL) {
-            Py_DECREF(rotation);
-            return NULL;
-        }
-        Matrix_SetValue(xRotation, 0, 0, 1);
-        Matrix_SetValue(xRotation, 0, 1, 0);
-        Matrix_SetValue(xRotation, 0, 2, 0);
-        Matrix_SetValue(xRotation, 1, 0, 0);
-        Matrix_SetValue(xRotation, 1, 1, cos(xRadians));
-        Matrix_SetValue(xRotation, 1, 2, -sin(xRadians));
-        Matrix_SetValue(xRotation, 2, 0, 0);
-        Matrix_SetValue(xRotation, 2, 1, sin(xRadians));
-        Matrix_SetValue(xRotation, 2, 2, cos(xRadians));
-        if (!_inplaceMatrixMatrixMul(xRotation, rotation, rotation)) {
-            Py_DECREF(rotation);
-            Py_DECREF(xRotation);
-            return NULL;
-        }
-        Py_DECREF(xRotation);
-    }
-    if (yRadians != 0) {
-        if ((yRotation = _matrixNew(3, 3)) == NULL) {
-            Py_DECREF(rotation);
-            Py_XDECREF(xRotation);
-            return NULL;
-        }
-        Matrix_SetValue(yRotation, 0, 0, cos(yRadians));
-        Matrix_SetValue(yRotation, 0, 1, 0);
-        Matrix_SetValue(yRotation, 0, 2, sin(yRadians));
-        Matrix_SetValue(yRotation, 1, 0, 0);
-        Matrix_SetValue(yRotation, 1, 1, 1);
-        Matrix_SetValue(yRotation, 1, 2, 0);
-        Matrix_SetValue(yRotation, 2, 0, -sin(yRadians));
-        Matrix_SetValue(yRotation, 2, 1, 0);
-        Matrix_SetValue(yRotation, 2, 2, cos(yRadians));
-        if (!_inplaceMatrixMatrixMul(yRotation, rotation, rotation)) {
-            Py_DECREF(rotation);
-            Py_DECREF(yRotation);
-            return NULL;
-        }
-        Py_DECREF(yRotation);
-    }
-    if (zRadians != 0) {
-        if ((zRotation = _matrixNew(3, 3)) == NULL) {
-            Py_DECREF(rotation);
-            Py_XDECREF(xRotation);
-            Py_XDECREF(yRotation);
-            return NULL;
-        }
-        Matrix_SetValue(zRotation, 0, 0, cos(zRadians));
-        Matrix_SetValue(zRotation, 0, 1, -sin(zRadians));
-        Matrix_SetValue(zRotation, 0, 2, 0);
-        Matrix_SetValue(zRotation, 1, 0, sin(zRadians));
-        Matrix_SetValue(zRotation, 1, 1, cos(zRadians));
-        Matrix_SetValue(zRotation, 1, 2, 0);
-        Matrix_SetValue(zRotation, 2, 0, 0);
-        Matrix_SetValue(zRotation, 2, 1, 0);
-        Matrix_SetValue(zRotation, 2, 2, 1);
-        if (!_inplaceMatrixMatrixMul(zRotation, rotation, rotation)) {
-            Py_DECREF(rotation);
-            Py_DECREF(zRotation);
-            return NULL;
-        }
-        Py_DECREF(zRotation);
-    }
+    cx = cos(xRadians);
+    sx = sin(xRadians);
+    cy = cos(yRadians);
+    sy = sin(yRadians);
+    cz = cos(zRadians);
+    sz = sin(zRadians);
+
+    // The product of the rotations about z, y & x (applying x first), expanded
+    Matrix_SetValue(rotation, 0, 0, cz * cy);
+    Matrix_SetValue(rotation, 0, 1, cz * sy * sx - sz * cx);
+    Matrix_SetValue(rotation, 0, 2, cz * sy * cx + sz * sx);
+    Matrix_SetValue(rotation, 1, 0, sz * cy);
+    Matrix_SetValue(rotation, 1, 1, sz * sy * sx + cz * cx);
+    Matrix_SetValue(rotation, 1, 2, sz * sy * cx - cz * sx);
+    Matrix_SetValue(rotation, 2, 0, -sy);
+    Matrix_SetValue(rotation, 2, 1, cy * sx);
+    Matrix_SetValue(rotation, 2, 2, cy * cx);
 
     return (PyObject *)rotation;
 }
 
 
-PyObject *permutationMatrix(PyObject *self, PyObject *args) {
+PyObject *permutationMatrix(PyObject *self, FASTCALL_PARAMETERS) {
 /*  Convenience function for constructing a permutation matrix of a given dimension for swapping particular rows.
 
-    Inputs: self - A pointer to the pytrix module.
-            args - A PyTuple containing (dimensions, row1, row2)
+    Inputs: self  - A pointer to the pytrix module.
+            args  - The dimensions, row1 & row2 of the permutation.
+            nargs - The number of arguments in args.
 
     Outputs: A permutation Matrix of the specified dimensions for swapping the specified rows.
 */
 
+    FASTCALL_UNPACK_ARGS
     long row1,
          row2,
          dimensions;
     Matrix *permutation;
     Vector *tempRow;
 
-    if (!PyArg_ParseTuple(args, "lll", &dimensions, &row1, &row2))
+    if (!_assertArgCount("permutationMatrix", nargs, 3) || !_parseLongArg(args[0], &dimensions) ||
+        !_parseLongArg(args[1], &row1) || !_parseLongArg(args[2], &row2))
         return NULL;
     if (row1 < 0 || row2 < 0) {
         PyErr_SetString(PyExc_ValueError, "pytrix.permutation row input cannot be less than 0.");
@@ -206,6 +163,10 @@ PyObject *permutationMatrix(PyObject *self, PyObject *args) {
         PyErr_SetString(PyExc_ValueError, "pytrix.permutation dimensions input cannot be less than 2.");
         return NULL;
     }
+    if (row1 >= dimensions || row2 >= dimensions) {
+        PyErr_SetString(PyExc_ValueError, "pytrix.permutation row input must be less than dimensions.");
+        return NULL;
+    }
 
     if ((permutation = _matrixNew(dimensions, dimensions)) == NULL)
         return NULL;
@@ -0,0 +1,205 @@
+/*
+ *  Copyright (C) 2016 Warren Spencer warrenspencer27@gmail.com
+
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+MatrixBatch *_matrixBatchNew(Py_ssize_t count, unsigned int rows, unsigned int columns) {
+/*  Creates a new, uninitialized MatrixBatch.
+
+    Inputs: count   - The number of matrices in the new batch.
+            rows    - The number of rows of each matrix.
+            columns - The number of columns of each matrix.
+
+    Outputs: A pointer to the new batch, or NULL if an error occurred.
+*/
+
+    MatrixBatch *newBatch;
+    VECTOR_TYPE *data;
+
+    if ((data = PyMem_New(VECTOR_TYPE, (size_t)count * rows * columns + 1)) == NULL)
+        return (MatrixBatch *)PyErr_NoMemory();
+
+    if ((newBatch = PyObject_New(MatrixBatch, &MatrixBatchType)) == NULL) {
+        PyMem_Free(data);
+        return NULL;
+    }
+
+    newBatch->count = count;
+    newBatch->rows = rows;
+    newBatch->columns = columns;
+    newBatch->data = data;
+
+    return newBatch;
+}
+
+
+PyObject *matrixBatchNew(PyTypeObject *type, PyObject *args, PyObject *kwds) {
+/*  Creates a new MatrixBatch from a sequence of Matrices.
+
+    Inputs: type - The MatrixBatch type.
+            args - A tuple containing a single sequence of Matrices, all of the same shape.
+            kwds - A dictionary of keyword arguments, which must be empty.
+
+    Outputs: A new MatrixBatch, or NULL if an error occurred.
+*/
+
+    PyObject *sequence,
+             *item;
+    MatrixBatch *self;
+    Matrix *m;
+    Py_ssize_t count,
+               i;
+    unsigned int rows = 0,
+                 columns = 0,
+                 row,
+                 col;
+
+    if (kwds != NULL && PyDict_Size(kwds) != 0) {
+        PyErr_SetString(PyExc_TypeError, "MatrixBatch() takes no keyword arguments");
+        return NULL;
+    }
+
+    if (PyTuple_GET_SIZE(args) != 1) {
+        PyErr_SetString(PyExc_TypeError, "MatrixBatch() takes a single sequence of Matrices");
+        return NULL;
+    }
+
+    if ((sequence = PySequence_Fast(PyTuple_GET_ITEM(args, 0), "Expected a sequence of Matrices")) == NULL)
+        return NULL;
+    count = PySequence_Fast_GET_SIZE(sequence);
+
+    for (i = 0; i < count; i++) {
+        item = PySequence_Fast_GET_ITEM(sequence, i);
+        if (!Matrix_Check(item)) {
+            PyErr_Format(PyExc_TypeError, "MatrixBatch() requires Matrices, not: \"%.400s\"", Py_TYPE(item)->tp_name);
+            Py_DECREF(sequence);
+            return NULL;
+        }
+
+        m = (Matrix *)item;
+        if (i == 0) {
+            rows = m->rows;
+            columns = m->columns;
+        } else if (m->rows != rows || m->columns != columns) {
+            PyErr_Format(PyExc_ValueError, "MatrixBatch() requires Matrices of the same shape; matrix %zd is %ux%u, "
+                         "not %ux%u", i, m->rows, m->columns, rows, columns);
+            Py_DECREF(sequence);
+            return NULL;
+        }
+    }
+
+    if ((self = _matrixBatchNew(count, rows, columns)) == NULL) {
+        Py_DECREF(sequence);
+        return NULL;
+    }
+
+    for (i = 0; i < count; i++) {
+        m = (Matrix *)PySequence_Fast_GET_ITEM(sequence, i);
+        for (row = 0; row < rows; row++)
+            for (col = 0; col < columns; col++)
+                MatrixBatch_Values(self, row * columns + col)[i] = Matrix_GetValue(m, row, col);
+    }
+
+    Py_DECREF(sequence);
+    return (PyObject *)self;
+}
+
+
+void matrixBatchDeInit(MatrixBatch *self) {
+    /* De-allocates a MatrixBatch. */
+
+    PyMem_Free(self->data);
+    PyObject_Del(self);
+}
+
+
+PyObject *matrixBatchFromBytes(PyObject *cls, FASTCALL_PARAMETERS) {
+/*  Creates a new MatrixBatch from a buffer of matrices of native doubles, each laid out row by row, one after another.
+
+    Inputs: cls   - The MatrixBatch type.
+            args  - An object supporting the buffer protocol, followed by the number of rows & columns of each matrix.
+            nargs - The number of arguments in args.
+
+    Outputs: A new MatrixBatch, or NULL if an error occurred.
+*/
+
+    FASTCALL_UNPACK_ARGS
+    Py_buffer view;
+    MatrixBatch *self = NULL;
+    VECTOR_TYPE *src;
+    Py_ssize_t count,
+               i;
+    long rows,
+         columns;
+    unsigned int k;
+
+    if (!_assertArgCount("frombytes", nargs, 3) || !_parseLongArg(args[1], &rows) || !_parseLongArg(args[2], &columns))
+        return NULL;
+
+    if (rows < 1 || columns < 1 || rows > UINT_MAX || columns > UINT_MAX || rows * columns > UINT_MAX) {
+        PyErr_Format(PyExc_ValueError, "Invalid matrix shape: %ldx%ld", rows, columns);
+        return NULL;
+    }
+
+    if (!_getVectorTypeBuffer(args[0], -1, &view))
+        return NULL;
+
+    count = view.len / sizeof(VECTOR_TYPE);
+    if (count % (rows * columns) != 0) {
+        PyErr_Format(PyExc_ValueError, "Buffer of %zd values does not hold a whole number of %ldx%ld matrices.", count,
+                     rows, columns);
+        PyBuffer_Release(&view);
+        return NULL;
+    }
+    count /= rows * columns;
+
+    if ((self = _matrixBatchNew(count, (unsigned int)rows, (unsigned int)columns)) != NULL) {
+        src = (VECTOR_TYPE *)view.buf;
+        for (i = 0; i < count; i++)
+            for (k = 0; k < self->rows * self->columns; k++)
+                memcpy(MatrixBatch_Values(self, k) + i, src++, sizeof(VECTOR_TYPE));
+    }
+
+    PyBuffer_Release(&view);
+    return (PyObject *)self;
+}
+
+
+PyObject *matrixBatchToBytes(MatrixBatch *self) {
+/*  Returns the matrices of a MatrixBatch as a bytes object of native doubles, each matrix laid out row by row, one
+    after another; the layout accepted by frombytes.
+
+    Inputs: self - The batch to convert.
+
+    Outputs: A new bytes object, or NULL if an error occurred.
+*/
+
+    PyObject *bytes;
+    VECTOR_TYPE *dst;
+    Py_ssize_t i;
+    unsigned int k;
+
+    if ((bytes = PyBytes_FromStringAndSize(NULL, (Py_ssize_t)(self->count * self->rows * self->columns *
+                                                              sizeof(VECTOR_TYPE)))) == NULL)
+        return NULL;
+
+    dst = (VECTOR_TYPE *)PyBytes_AS_STRING(bytes);
+    for (i = 0; i < self->count; i++)
+        for (k = 0; k < self->rows * self->columns; k++)
+            memcpy(dst++, MatrixBatch_Values(self, k) + i, sizeof(VECTOR_TYPE));
+
+    return bytes;
+}
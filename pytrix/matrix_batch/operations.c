@@ -0,0 +1,663 @@
+/*
+ *  Copyright (C) 2016 Warren Spencer warrenspencer27@gmail.com
+
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+Py_ssize_t matrixBatchLength(MatrixBatch *self) {
+/*  Returns the number of matrices in a MatrixBatch.
+
+    Inputs: self - The batch.
+
+    Outputs: The number of matrices in self.
+*/
+
+    return self->count;
+}
+
+
+PyObject *matrixBatchItem(MatrixBatch *self, Py_ssize_t i) {
+/*  Gathers the ith matrix of a MatrixBatch into a new Matrix.
+
+    Inputs: self - The batch.
+            i    - The index of the matrix to return.
+
+    Outputs: A new Matrix, or NULL if an error occurred.
+*/
+
+    Matrix *m;
+    unsigned int row,
+                 col;
+
+    if (i < 0 || i >= self->count) {
+        PyErr_Format(PyExc_IndexError, "Cannot return matrix %zd of a MatrixBatch with %zd matrices.", i, self->count);
+        return NULL;
+    }
+
+    if ((m = _matrixNew(self->rows, self->columns)) == NULL)
+        return NULL;
+
+    for (row = 0; row < self->rows; row++)
+        for (col = 0; col < self->columns; col++)
+            Matrix_SetValue(m, row, col, MatrixBatch_Values(self, row * self->columns + col)[i]);
+
+    return (PyObject *)m;
+}
+
+
+static void _matrixBatchProductTask(void *context, Py_ssize_t start, Py_ssize_t end, unsigned int worker) {
+/*  Multiplies a range of the matrices of a batch, MATRIX_BATCH_BLOCK matrices at a time.  For each block, every value
+    of the products is accumulated from contiguous runs of the values of the operands, across the matrices of the
+    block.
+
+    Inputs: context - The MatrixBatchProduct to compute.
+            start   - The index of the first matrix to multiply.
+            end     - The index after the last matrix to multiply.
+            worker  - The index of the thread running the task; unused.
+*/
+
+    MatrixBatchProduct *product = (MatrixBatchProduct *)context;
+    unsigned int row,
+                 col,
+                 k;
+    Py_ssize_t block,
+               size,
+               i;
+    VECTOR_TYPE *dst,
+                *a,
+                *b;
+
+    for (block = start; block < end; block += size) {
+        size = end - block < MATRIX_BATCH_BLOCK ? end - block : MATRIX_BATCH_BLOCK;
+
+        for (row = 0; row < product->rows; row++) {
+            for (col = 0; col < product->columns; col++) {
+                dst = product->out + (size_t)(row * product->columns + col) * product->count + block;
+                for (i = 0; i < size; i++)
+                    dst[i] = 0;
+
+                for (k = 0; k < product->inner; k++) {
+                    if (product->singleA) {
+                        a = product->a + row * product->inner + k;
+                        b = product->b + (size_t)(k * product->columns + col) * product->count + block;
+                        for (i = 0; i < size; i++)
+                            dst[i] += *a * b[i];
+
+                    } else if (product->singleB) {
+                        a = product->a + (size_t)(row * product->inner + k) * product->count + block;
+                        b = product->b + k * product->columns + col;
+                        for (i = 0; i < size; i++)
+                            dst[i] += a[i] * *b;
+
+                    } else {
+                        a = product->a + (size_t)(row * product->inner + k) * product->count + block;
+                        b = product->b + (size_t)(k * product->columns + col) * product->count + block;
+                        for (i = 0; i < size; i++)
+                            dst[i] += a[i] * b[i];
+                    }
+                }
+            }
+        }
+    }
+}
+
+
+PyObject *matrixBatchMul(PyObject *a, PyObject *b) {
+/*  Multiplies the matrices of two MatrixBatches pairwise, or each matrix of a MatrixBatch by a single Matrix.  The
+    work is split between threads, without holding the GIL.
+    Note that both arguments must be sanitized, as any Python object may be passed in either slot.
+
+    Inputs: a - Supposedly either a MatrixBatch, or a Matrix to multiply every matrix of b by on the left.
+            b - Supposedly either a MatrixBatch, or a Matrix to multiply every matrix of a by on the right.
+
+    Outputs: A new MatrixBatch of the products, NotImplemented if the operands cannot be multiplied, or NULL if an
+             exception occurred.
+*/
+
+    MatrixBatchProduct product;
+    MatrixBatch *result = NULL;
+    VECTOR_TYPE *packed = NULL;
+    Matrix *single;
+    unsigned int rowsA,
+                 columnsA,
+                 rowsB,
+                 columnsB;
+
+    product.singleA = Matrix_Check(a);
+    product.singleB = Matrix_Check(b);
+    if ((!product.singleA && !MatrixBatch_Check(a)) || (!product.singleB && !MatrixBatch_Check(b))) {
+        Py_INCREF(Py_NotImplemented);
+        return Py_NotImplemented;
+    }
+
+    rowsA = product.singleA ? ((Matrix *)a)->rows : ((MatrixBatch *)a)->rows;
+    columnsA = product.singleA ? ((Matrix *)a)->columns : ((MatrixBatch *)a)->columns;
+    rowsB = product.singleB ? ((Matrix *)b)->rows : ((MatrixBatch *)b)->rows;
+    columnsB = product.singleB ? ((Matrix *)b)->columns : ((MatrixBatch *)b)->columns;
+
+    if (columnsA != rowsB) {
+        PyErr_SetString(PyExc_ValueError, "A * B MatrixBatch multiplication requires A.columns = B.rows");
+        return NULL;
+    }
+
+    if (!product.singleA && !product.singleB && ((MatrixBatch *)a)->count != ((MatrixBatch *)b)->count) {
+        PyErr_Format(PyExc_ValueError, "Cannot multiply MatrixBatches of %zd and %zd matrices.",
+                     ((MatrixBatch *)a)->count, ((MatrixBatch *)b)->count);
+        return NULL;
+    }
+
+    product.count = product.singleA ? ((MatrixBatch *)b)->count : ((MatrixBatch *)a)->count;
+    product.rows = rowsA;
+    product.inner = columnsA;
+    product.columns = columnsB;
+
+    // Pack a single matrix row by row so that the kernel doesn't touch Python objects
+    if (product.singleA || product.singleB) {
+        single = (Matrix *)(product.singleA ? a : b);
+        if ((packed = PyMem_New(VECTOR_TYPE, (size_t)single->rows * single->columns + 1)) == NULL)
+            return PyErr_NoMemory();
+        _smallMatrixPack(single, packed);
+    }
+    product.a = product.singleA ? packed : ((MatrixBatch *)a)->data;
+    product.b = product.singleB ? packed : ((MatrixBatch *)b)->data;
+
+    if ((result = _matrixBatchNew(product.count, product.rows, product.columns)) != NULL) {
+        product.out = result->data;
+
+        Py_BEGIN_ALLOW_THREADS
+        // Batches may be empty, or hold empty matrices; so the work of each product may be 0
+        _parallelFor(_matrixBatchProductTask, &product, product.count,
+                     PARALLEL_MIN_CHUNK / ((Py_ssize_t)product.rows * product.inner * product.columns + 1) + 1);
+        Py_END_ALLOW_THREADS
+    }
+
+    PyMem_Free(packed);
+    return (PyObject *)result;
+}
+
+
+static VECTOR_TYPE _matrixBatchFactorLU(VECTOR_TYPE *lu, unsigned int n, unsigned int *pivots) {
+/*  Factors a square matrix in place into the product of a unit lower triangular matrix & an upper triangular matrix,
+    by gaussian elimination with partial pivoting.
+
+    Inputs: lu     - The matrix to factor, laid out row by row.  Overwritten with the multipliers of L below its
+                     diagonal, and U on and above it.
+            n      - The number of rows & columns of the matrix.
+            pivots - An array of n values to record the row swapped with each row as it was eliminated.
+
+    Outputs: The sign of the permutation applied to the rows, 1 or -1; or 0 if the matrix is singular, in which case the
+             factorization is left incomplete.
+*/
+
+    VECTOR_TYPE sign = 1,
+                multiplier,
+                temp;
+    unsigned int pivot,
+                 row,
+                 col;
+
+    for (col = 0; col < n; col++) {
+        pivot = col;
+        for (row = col + 1; row < n; row++)
+            if (fabs(lu[row * n + col]) > fabs(lu[pivot * n + col]))
+                pivot = row;
+
+        pivots[col] = pivot;
+        if (lu[pivot * n + col] == 0)
+            return 0;
+
+        if (pivot != col) {
+            for (row = 0; row < n; row++) {
+                temp = lu[pivot * n + row];
+                lu[pivot * n + row] = lu[col * n + row];
+                lu[col * n + row] = temp;
+            }
+            sign = -sign;
+        }
+
+        multiplier = 1 / lu[col * n + col];
+        for (row = col + 1; row < n; row++) {
+            temp = (lu[row * n + col] *= multiplier);
+            for (pivot = col + 1; pivot < n; pivot++)
+                lu[row * n + pivot] -= temp * lu[col * n + pivot];
+        }
+    }
+
+    return sign;
+}
+
+
+static void _matrixBatchSolveLU(VECTOR_TYPE *lu, unsigned int n, unsigned int *pivots, VECTOR_TYPE *x) {
+/*  Solves a system of equations in place, given the factorization of its matrix by _matrixBatchFactorLU.
+
+    Inputs: lu     - The factored matrix.
+            n      - The number of rows & columns of the matrix.
+            pivots - The rows swapped during the factorization.
+            x      - The n values of the right hand side of the system, overwritten with the solution.
+*/
+
+    VECTOR_TYPE temp;
+    unsigned int row,
+                 col;
+
+    for (row = 0; row < n; row++) {
+        temp = x[pivots[row]];
+        x[pivots[row]] = x[row];
+        x[row] = temp;
+    }
+
+    for (row = 1; row < n; row++)
+        for (col = 0; col < row; col++)
+            x[row] -= lu[row * n + col] * x[col];
+
+    for (row = n; row-- > 0;) {
+        for (col = row + 1; col < n; col++)
+            x[row] -= lu[row * n + col] * x[col];
+        x[row] /= lu[row * n + row];
+    }
+}
+
+
+static VECTOR_TYPE *_matrixBatchGather(MatrixBatchFactor *factor, Py_ssize_t i, unsigned int worker) {
+/*  Copies a matrix of a batch being factored into the scratch space of a worker, laid out row by row.
+
+    Inputs: factor - The MatrixBatchFactor being computed.
+            i      - The index of the matrix to copy.
+            worker - The index of the thread copying the matrix.
+
+    Outputs: The copy of the matrix.
+*/
+
+    VECTOR_TYPE *lu = factor->scratch + (size_t)worker * factor->n * (factor->n + 1);
+    unsigned int k;
+
+    for (k = 0; k < factor->n * factor->n; k++)
+        lu[k] = factor->in[(size_t)k * factor->count + i];
+
+    return lu;
+}
+
+
+static VECTOR_TYPE _matrixBatchDeterminantLU(MatrixBatchFactor *factor, Py_ssize_t i, unsigned int worker) {
+/*  Calculates the determinant of a matrix of a batch from its LU factorization.
+
+    Inputs: factor - The MatrixBatchFactor being computed.
+            i      - The index of the matrix.
+            worker - The index of the thread running the task.
+
+    Outputs: The determinant of the matrix.
+*/
+
+    unsigned int *pivots = factor->pivots + (size_t)worker * factor->n,
+                 k;
+    VECTOR_TYPE *lu = _matrixBatchGather(factor, i, worker),
+                determinant;
+
+    determinant = _matrixBatchFactorLU(lu, factor->n, pivots);
+    for (k = 0; k < factor->n; k++)
+        determinant *= lu[k * factor->n + k];
+
+    return determinant;
+}
+
+
+static unsigned char _matrixBatchInverseLU(MatrixBatchFactor *factor, Py_ssize_t i, unsigned int worker) {
+/*  Inverts a matrix of a batch from its LU factorization, writing the inverse into place among the inverses.
+
+    Inputs: factor - The MatrixBatchFactor being computed.
+            i      - The index of the matrix to invert.
+            worker - The index of the thread running the task.
+
+    Outputs: 1 if successful, or 0 if the matrix is singular.
+*/
+
+    unsigned int n = factor->n,
+                 *pivots = factor->pivots + (size_t)worker * n,
+                 row,
+                 col;
+    VECTOR_TYPE *lu = _matrixBatchGather(factor, i, worker),
+                *x = factor->scratch + (size_t)worker * n * (n + 1) + (size_t)n * n;
+
+    if (_matrixBatchFactorLU(lu, n, pivots) == 0)
+        return 0;
+
+    // Solve for each column of the inverse in turn
+    for (col = 0; col < n; col++) {
+        for (row = 0; row < n; row++)
+            x[row] = row == col;
+        _matrixBatchSolveLU(lu, n, pivots, x);
+        for (row = 0; row < n; row++)
+            factor->inverses[(size_t)(row * n + col) * factor->count + i] = x[row];
+    }
+
+    return 1;
+}
+
+
+static void _matrixBatchDeterminantTask(void *context, Py_ssize_t start, Py_ssize_t end, unsigned int worker) {
+/*  Calculates the determinants of a range of the matrices of a batch; in closed form for matrices of up to 4x4, and
+    otherwise from their LU factorizations.  Closed form determinants rejected by _smallDeterminantUsable are
+    recalculated from the LU factorization.
+
+    Inputs: context - The MatrixBatchFactor to compute.
+            start   - The index of the first matrix.
+            end     - The index after the last matrix.
+            worker  - The index of the thread running the task.
+*/
+
+    MatrixBatchFactor *factor = (MatrixBatchFactor *)context;
+    Py_ssize_t i;
+
+    switch (factor->n) {
+        case 1:
+            memcpy(factor->determinants + start, factor->in + start, sizeof(VECTOR_TYPE) * (end - start));
+            return;
+        case 2:
+            _smallDeterminant2(factor->in + start, factor->count, end - start, factor->determinants + start);
+            break;
+        case 3:
+            _smallDeterminant3(factor->in + start, factor->count, end - start, factor->determinants + start);
+            break;
+        case 4:
+            _smallDeterminant4(factor->in + start, factor->count, end - start, factor->determinants + start);
+            break;
+        default:
+            for (i = start; i < end; i++)
+                factor->determinants[i] = _matrixBatchDeterminantLU(factor, i, worker);
+            return;
+    }
+
+    for (i = start; i < end; i++)
+        if (!_smallDeterminantUsable(factor->in + i, factor->count, factor->n, factor->determinants[i]))
+            factor->determinants[i] = _matrixBatchDeterminantLU(factor, i, worker);
+}
+
+
+static void _matrixBatchInverseTask(void *context, Py_ssize_t start, Py_ssize_t end, unsigned int worker) {
+/*  Inverts a range of the matrices of a batch; in closed form for matrices of up to 4x4, MATRIX_BATCH_BLOCK matrices at
+    a time, and otherwise from their LU factorizations.  Matrices whose closed form inverses are rejected by
+    _smallInverseUsable are inverted from their LU factorizations as well.  Records the first matrix found to be
+    singular.
+
+    Inputs: context - The MatrixBatchFactor to compute.
+            start   - The index of the first matrix to invert.
+            end     - The index after the last matrix to invert.
+            worker  - The index of the thread running the task.
+*/
+
+    MatrixBatchFactor *factor = (MatrixBatchFactor *)context;
+    unsigned int n = factor->n;
+    VECTOR_TYPE determinants[MATRIX_BATCH_BLOCK];
+    unsigned char usable[MATRIX_BATCH_BLOCK];
+    Py_ssize_t block,
+               size,
+               i;
+
+    if (n >= 1 && n <= 4) {
+        for (block = start; block < end; block += size) {
+            size = end - block < MATRIX_BATCH_BLOCK ? end - block : MATRIX_BATCH_BLOCK;
+
+            switch (n) {
+                case 1:
+                    for (i = 0; i < size; i++) {
+                        determinants[i] = factor->in[block + i];
+                        factor->inverses[block + i] = 1 / determinants[i];
+                    }
+                    break;
+                case 2:
+                    _smallInverse2(factor->in + block, factor->inverses + block, factor->count, size, determinants);
+                    break;
+                case 3:
+                    _smallInverse3(factor->in + block, factor->inverses + block, factor->count, size, determinants);
+                    break;
+                default:
+                    _smallInverse4(factor->in + block, factor->inverses + block, factor->count, size, determinants);
+            }
+
+            if (n == 1)
+                for (i = 0; i < size; i++)
+                    usable[i] = determinants[i] != 0;
+            else
+                _smallInverseUsable(factor->in + block, factor->inverses + block, factor->count, size, n,
+                                    determinants, usable);
+
+            for (i = 0; i < size; i++) {
+                if (!usable[i] && (n == 1 || !_matrixBatchInverseLU(factor, block + i, worker))) {
+                    factor->singular[worker] = block + i;
+                    return;
+                }
+            }
+        }
+        return;
+    }
+
+    for (i = start; i < end; i++) {
+        if (!_matrixBatchInverseLU(factor, i, worker)) {
+            factor->singular[worker] = i;
+            return;
+        }
+    }
+}
+
+
+static void _matrixBatchSolveTask(void *context, Py_ssize_t start, Py_ssize_t end, unsigned int worker) {
+/*  Solves the systems of equations of a range of the matrices of a batch by LU factorization with partial pivoting.
+    Records the first matrix found to be singular.
+
+    Inputs: context - The MatrixBatchFactor to compute.
+            start   - The index of the first system to solve.
+            end     - The index after the last system to solve.
+            worker  - The index of the thread running the task.
+*/
+
+    MatrixBatchFactor *factor = (MatrixBatchFactor *)context;
+    unsigned int n = factor->n,
+                 *pivots = factor->pivots + (size_t)worker * n,
+                 row;
+    VECTOR_TYPE *x = factor->scratch + (size_t)worker * n * (n + 1) + (size_t)n * n,
+                *lu;
+    Py_ssize_t i;
+
+    for (i = start; i < end; i++) {
+        lu = _matrixBatchGather(factor, i, worker);
+        if (_matrixBatchFactorLU(lu, n, pivots) == 0) {
+            factor->singular[worker] = i;
+            return;
+        }
+
+        for (row = 0; row < n; row++)
+            x[row] = factor->singleRhs ? factor->rhs[row] : factor->rhs[(size_t)row * factor->count + i];
+        _matrixBatchSolveLU(lu, n, pivots, x);
+        for (row = 0; row < n; row++)
+            factor->solutions[(size_t)row * factor->count + i] = x[row];
+    }
+}
+
+
+static unsigned char _matrixBatchFactor(MatrixBatch *self, const char *name, ParallelTask task,
+                                        MatrixBatchFactor *factor) {
+/*  Runs a task over the square matrices of a batch, split between threads without holding the GIL.
+
+    Inputs: self   - The batch whose matrices the task is run over.
+            name   - The name of the method running the task, for error messages.
+            task   - The task to run.
+            factor - The MatrixBatchFactor to compute, whose outputs have been set; the rest is filled in here.
+
+    Outputs: 1 if successful, or 0 if an error occurred, including if one of the matrices was singular.
+*/
+
+    unsigned int workers = _parallelThreadCount(),
+                 i;
+
+    factor->in = self->data;
+    factor->n = self->rows;
+    factor->count = self->count;
+
+    if ((factor->scratch = PyMem_New(VECTOR_TYPE, (size_t)workers * factor->n * (factor->n + 1))) == NULL) {
+        PyErr_NoMemory();
+        return 0;
+    }
+    if ((factor->pivots = PyMem_New(unsigned int, (size_t)workers * factor->n)) == NULL) {
+        PyMem_Free(factor->scratch);
+        PyErr_NoMemory();
+        return 0;
+    }
+    for (i = 0; i < PARALLEL_MAX_THREADS; i++)
+        factor->singular[i] = -1;
+
+    Py_BEGIN_ALLOW_THREADS
+    _parallelFor(task, factor, self->count,
+                 PARALLEL_MIN_CHUNK / ((Py_ssize_t)factor->n * factor->n * factor->n + 1) + 1);
+    Py_END_ALLOW_THREADS
+
+    PyMem_Free(factor->scratch);
+    PyMem_Free(factor->pivots);
+
+    // Each worker processes a contiguous range of the matrices in order, so the first singular matrix is that of the
+    // first worker to find one
+    for (i = 0; i < PARALLEL_MAX_THREADS; i++) {
+        if (factor->singular[i] >= 0) {
+            PyErr_Format(PyExc_ValueError, "MatrixBatch.%s: matrix %zd of the batch is not invertible.", name,
+                         factor->singular[i]);
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+
+PyObject *matrixBatchDeterminant(MatrixBatch *self) {
+/*  Calculates the determinant of each matrix of a MatrixBatch.
+
+    Inputs: self - The batch of square matrices.
+
+    Outputs: A Vector of the determinants, or NULL if an error occurred.
+*/
+
+    MatrixBatchFactor factor;
+    Vector *result;
+
+    if (self->rows != self->columns) {
+        PyErr_SetString(PyExc_ValueError, "MatrixBatch.determinant must be run on a batch of square matrices.");
+        return NULL;
+    }
+    if (self->count > UINT_MAX) {
+        PyErr_Format(PyExc_ValueError, "Cannot return %zd determinants as a Vector.", self->count);
+        return NULL;
+    }
+
+    if ((result = _vectorNew((unsigned int)self->count)) == NULL)
+        return NULL;
+
+    factor.determinants = result->data;
+    if (!_matrixBatchFactor(self, "determinant", _matrixBatchDeterminantTask, &factor)) {
+        Py_DECREF(result);
+        return NULL;
+    }
+
+    return (PyObject *)result;
+}
+
+
+PyObject *matrixBatchInverse(MatrixBatch *self) {
+/*  Inverts each matrix of a MatrixBatch.
+
+    Inputs: self - The batch of square matrices.
+
+    Outputs: A new MatrixBatch of the inverses, or NULL if an error occurred, including if any matrix is singular.
+*/
+
+    MatrixBatchFactor factor;
+    MatrixBatch *result;
+
+    if (self->rows != self->columns) {
+        PyErr_SetString(PyExc_ValueError, "Cannot find inverse of non-square matrices.");
+        return NULL;
+    }
+
+    if ((result = _matrixBatchNew(self->count, self->rows, self->columns)) == NULL)
+        return NULL;
+
+    factor.inverses = result->data;
+    if (!_matrixBatchFactor(self, "inverse", _matrixBatchInverseTask, &factor)) {
+        Py_DECREF(result);
+        return NULL;
+    }
+
+    return (PyObject *)result;
+}
+
+
+PyObject *matrixBatchSolve(MatrixBatch *self, PyObject *rhs) {
+/*  Solves the system of equations Ax = b for each matrix A of a MatrixBatch, by LU factorization with partial pivoting.
+
+    Inputs: self - The batch of square matrices.
+            rhs  - The right hand side b of each system; either a VectorArray of one Vector for each matrix, or a single
+                   Vector used for every matrix.
+
+    Outputs: A new VectorArray of the solution x of each system, or NULL if an error occurred, including if any matrix
+             is singular.
+*/
+
+    MatrixBatchFactor factor;
+    VectorArray *result;
+    unsigned int dimensions;
+
+    if (self->rows != self->columns) {
+        PyErr_SetString(PyExc_ValueError, "MatrixBatch.solve must be run on a batch of square matrices.");
+        return NULL;
+    }
+
+    if (Vector_Check(rhs)) {
+        factor.singleRhs = 1;
+        factor.rhs = ((Vector *)rhs)->data;
+        dimensions = ((Vector *)rhs)->dimensions;
+
+    } else if (VectorArray_Check(rhs)) {
+        factor.singleRhs = 0;
+        factor.rhs = ((VectorArray *)rhs)->data;
+        dimensions = ((VectorArray *)rhs)->dimensions;
+
+        if (((VectorArray *)rhs)->count != self->count) {
+            PyErr_Format(PyExc_ValueError, "MatrixBatch.solve requires a Vector for each of the %zd matrices, not %zd.",
+                         self->count, ((VectorArray *)rhs)->count);
+            return NULL;
+        }
+
+    } else {
+        PyErr_Format(PyExc_TypeError, "MatrixBatch.solve requires a Vector or VectorArray, not: \"%.400s\"",
+                     Py_TYPE(rhs)->tp_name);
+        return NULL;
+    }
+
+    // Empty VectorArrays have no dimensions of their own
+    if (dimensions != self->rows && (factor.singleRhs || self->count)) {
+        PyErr_Format(PyExc_ValueError, "MatrixBatch.solve requires %u dimensional Vectors, not %u.", self->rows,
+                     dimensions);
+        return NULL;
+    }
+
+    if ((result = _vectorArrayNew(&VectorArrayType, self->count, self->rows)) == NULL)
+        return NULL;
+
+    factor.solutions = result->data;
+    if (!_matrixBatchFactor(self, "solve", _matrixBatchSolveTask, &factor)) {
+        Py_DECREF(result);
+        return NULL;
+    }
+
+    return (PyObject *)result;
+}
@@ -0,0 +1,471 @@
+/*
+ *  Copyright (C) 2016 Warren Spencer warrenspencer27@gmail.com
+
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/* Functions for reading and writing files in numpy's .npy format.
+   See: https://numpy.org/doc/stable/reference/generated/numpy.lib.format.html
+*/
+
+#define NPY_MAGIC "\x93NUMPY"
+#define NPY_MAGIC_LENGTH 6
+// Offset that the data section of files we write are aligned to; matches what numpy itself writes
+#define NPY_ALIGNMENT 64
+#define NPY_MAX_DIMENSIONS 2
+
+typedef struct {
+    unsigned int ndim;
+    unsigned int shape[NPY_MAX_DIMENSIONS];
+    unsigned char fortranOrder;
+    // Whether or not the data in the file is of the opposite byte order to this machine's
+    unsigned char byteSwapped;
+    // Offset from the start of the file at which the data section begins
+    long dataOffset;
+} NpyHeader;
+
+unsigned char _npyWriteHeader(FILE *, PyObject *, unsigned int, unsigned int *);
+unsigned char _npyWriteData(FILE *, PyObject *, VECTOR_TYPE *, size_t);
+unsigned char _npyReadHeader(FILE *, PyObject *, NpyHeader *);
+unsigned char _npyReadData(FILE *, PyObject *, NpyHeader *, VECTOR_TYPE *, size_t);
+PyObject *_npyMap(PyObject *, NpyHeader *, size_t, VECTOR_TYPE **);
+
+
+static unsigned char _npyLittleEndian(void) {
+/*  Determines whether or not this machine is little endian.
+
+    Outputs: 1 if this machine is little endian, otherwise 0.
+*/
+
+    const uint16_t probe = 1;
+
+    return *((const unsigned char *)&probe) == 1;
+}
+
+
+static unsigned char _npyIOError(FILE *f, PyObject *path) {
+/*  Sets an appropriate exception after a read or write on a file failed.
+
+    Inputs: f    - The file which the operation failed on.
+            path - The path that f was opened from.
+
+    Outputs: 0, so this can be returned directly by callers.
+*/
+
+    PyObject *filename;
+
+    if (ferror(f)) {
+        if ((filename = _pathFilenameObject(path)) != NULL) {
+            PyErr_SetFromErrnoWithFilenameObject(PyExc_IOError, filename);
+            Py_DECREF(filename);
+        }
+    } else {
+        PyErr_SetString(PyExc_ValueError, "Unexpected end of file; .npy file is truncated.");
+    }
+
+    return 0;
+}
+
+
+unsigned char _npyWriteHeader(FILE *f, PyObject *path, unsigned int ndim, unsigned int *shape) {
+/*  Writes an .npy header describing a C-ordered array of VECTOR_TYPEs.
+
+    Inputs: f     - The file to write the header to.
+            path  - The path that f was opened from.
+            ndim  - The number of dimensions in shape; either 1 or 2.
+            shape - The length of each dimension of the array.
+
+    Outputs: 1 if the header was successfully written, otherwise 0.
+*/
+
+    // Preamble (magic + version + header length), the header dictionary, and room to pad out to NPY_ALIGNMENT
+    char header[10 + 128 + NPY_ALIGNMENT];
+    int length;
+    size_t total;
+
+    if (ndim == 1)
+        length = sprintf(header + 10, "{'descr': '%s', 'fortran_order': False, 'shape': (%u,), }",
+                         _npyLittleEndian() ? "<f8" : ">f8", shape[0]);
+    else
+        length = sprintf(header + 10, "{'descr': '%s', 'fortran_order': False, 'shape': (%u, %u), }",
+                         _npyLittleEndian() ? "<f8" : ">f8", shape[0], shape[1]);
+
+    // Pad the header with spaces, terminated with a newline, so that the data which follows it is aligned
+    total = 10 + length + 1;
+    total += (NPY_ALIGNMENT - total % NPY_ALIGNMENT) % NPY_ALIGNMENT;
+    memset(header + 10 + length, ' ', total - 10 - length - 1);
+    header[total - 1] = '\n';
+
+    memcpy(header, NPY_MAGIC, NPY_MAGIC_LENGTH);
+    header[6] = 1;
+    header[7] = 0;
+    header[8] = (char)((total - 10) & 0xFF);
+    header[9] = (char)((total - 10) >> 8);
+
+    if (fwrite(header, 1, total, f) != total)
+        return _npyIOError(f, path);
+
+    return 1;
+}
+
+
+unsigned char _npyWriteData(FILE *f, PyObject *path, VECTOR_TYPE *data, size_t count) {
+/*  Writes a run of VECTOR_TYPEs to the data section of an .npy file.
+
+    Inputs: f     - The file to write the data to.
+            path  - The path that f was opened from.
+            data  - The values to write.
+            count - The number of values in data.
+
+    Outputs: 1 if the data was successfully written, otherwise 0.
+*/
+
+    size_t written;
+
+    Py_BEGIN_ALLOW_THREADS
+    written = fwrite(data, sizeof(VECTOR_TYPE), count, f);
+    Py_END_ALLOW_THREADS
+
+    if (written != count)
+        return _npyIOError(f, path);
+
+    return 1;
+}
+
+
+static const char *_npyFindKey(const char *header, const char *key) {
+/*  Finds the value associated with a key in an .npy header dictionary.
+
+    Inputs: header - The NUL terminated header dictionary.
+            key    - The quoted key to search for; ex: "'shape'".
+
+    Outputs: A pointer to the first non-whitespace character of the value, or NULL if the key could not be found.
+*/
+
+    const char *value;
+
+    if ((value = strstr(header, key)) == NULL)
+        return NULL;
+
+    value += strlen(key);
+    while (*value == ' ')
+        value++;
+    if (*value++ != ':')
+        return NULL;
+    while (*value == ' ')
+        value++;
+
+    return value;
+}
+
+
+static unsigned char _npyParseHeader(const char *header, NpyHeader *out) {
+/*  Parses the dictionary portion of an .npy header.
+
+    Inputs: header - The NUL terminated header dictionary.
+            out    - The NpyHeader to populate.
+
+    Outputs: 1 if the header was successfully parsed, otherwise 0 with an exception set.
+*/
+
+    const char *value;
+    char *end;
+    unsigned long long dimension;
+
+    // descr; we only support 8 byte floating point numbers, in either byte order
+    if ((value = _npyFindKey(header, "'descr'")) == NULL || (value[0] != '\'' && value[0] != '"'))
+        goto malformed;
+    if (strncmp(value + 1, "<f8", 3) == 0 && value[4] == value[0])
+        out->byteSwapped = !_npyLittleEndian();
+    else if (strncmp(value + 1, ">f8", 3) == 0 && value[4] == value[0])
+        out->byteSwapped = _npyLittleEndian();
+    else {
+        PyErr_SetString(PyExc_ValueError, "Unsupported .npy dtype; only float64 arrays can be loaded.");
+        return 0;
+    }
+
+    // fortran_order
+    if ((value = _npyFindKey(header, "'fortran_order'")) == NULL)
+        goto malformed;
+    if (strncmp(value, "True", 4) == 0)
+        out->fortranOrder = 1;
+    else if (strncmp(value, "False", 5) == 0)
+        out->fortranOrder = 0;
+    else
+        goto malformed;
+
+    // shape
+    if ((value = _npyFindKey(header, "'shape'")) == NULL || *value++ != '(')
+        goto malformed;
+
+    out->ndim = 0;
+    while (1) {
+        while (*value == ' ' || *value == ',')
+            value++;
+        if (*value == ')')
+            break;
+
+        if (out->ndim == NPY_MAX_DIMENSIONS) {
+            PyErr_SetString(PyExc_ValueError, "Unsupported .npy array; arrays can have at most 2 dimensions.");
+            return 0;
+        }
+
+        dimension = strtoull(value, &end, 10);
+        if (end == value)
+            goto malformed;
+        if (dimension > UINT_MAX) {
+            PyErr_SetString(PyExc_ValueError, "Unsupported .npy array; dimension is too large.");
+            return 0;
+        }
+
+        out->shape[out->ndim++] = (unsigned int)dimension;
+        value = end;
+    }
+
+    // Arrays without more than one row and column are laid out identically in either order
+    if (out->ndim < 2 || out->shape[0] <= 1 || out->shape[1] <= 1)
+        out->fortranOrder = 0;
+
+    return 1;
+
+malformed:
+    PyErr_SetString(PyExc_ValueError, "Malformed .npy header.");
+    return 0;
+}
+
+
+unsigned char _npyReadHeader(FILE *f, PyObject *path, NpyHeader *out) {
+/*  Reads and parses the header of an .npy file, leaving f positioned at the start of the data section.
+
+    Inputs: f    - The file to read the header from.
+            path - The path that f was opened from.
+            out  - The NpyHeader to populate.
+
+    Outputs: 1 if the header was successfully read, otherwise 0.
+*/
+
+    unsigned char preamble[12];
+    size_t preambleLength,
+           headerLength;
+    char *header;
+    unsigned char retval;
+
+    if (fread(preamble, 1, 10, f) != 10)
+        return _npyIOError(f, path);
+
+    if (memcmp(preamble, NPY_MAGIC, NPY_MAGIC_LENGTH) != 0) {
+        PyErr_SetString(PyExc_ValueError, "File is not in .npy format.");
+        return 0;
+    }
+
+    // Version 1.0 uses a 2 byte header length, while versions 2.0 and 3.0 use 4 bytes
+    if (preamble[6] == 1) {
+        preambleLength = 10;
+        headerLength = preamble[8] | (preamble[9] << 8);
+    } else if (preamble[6] == 2 || preamble[6] == 3) {
+        if (fread(preamble + 10, 1, 2, f) != 2)
+            return _npyIOError(f, path);
+
+        preambleLength = 12;
+        headerLength = (size_t)preamble[8] | ((size_t)preamble[9] << 8) |
+                       ((size_t)preamble[10] << 16) | ((size_t)preamble[11] << 24);
+    } else {
+        PyErr_Format(PyExc_ValueError, "Unsupported .npy format version: %d.%d", preamble[6], preamble[7]);
+        return 0;
+    }
+
+    if ((header = PyMem_Malloc(headerLength + 1)) == NULL) {
+        PyErr_NoMemory();
+        return 0;
+    }
+
+    if (fread(header, 1, headerLength, f) != headerLength) {
+        PyMem_Free(header);
+        return _npyIOError(f, path);
+    }
+    header[headerLength] = '\0';
+
+    retval = _npyParseHeader(header, out);
+    out->dataOffset = (long)(preambleLength + headerLength);
+
+    PyMem_Free(header);
+    return retval;
+}
+
+
+static void _npyByteSwap(VECTOR_TYPE *data, size_t count) {
+/*  Reverses the byte order of each value in an array.
+
+    Inputs: data  - The array of values to swap.
+            count - The number of values in data.
+*/
+
+    size_t i;
+    unsigned char *bytes,
+                  tmp;
+    unsigned int j;
+
+    for (i = 0; i < count; i++) {
+        bytes = (unsigned char *)(data + i);
+        for (j = 0; j < sizeof(VECTOR_TYPE) / 2; j++) {
+            tmp = bytes[j];
+            bytes[j] = bytes[sizeof(VECTOR_TYPE) - 1 - j];
+            bytes[sizeof(VECTOR_TYPE) - 1 - j] = tmp;
+        }
+    }
+}
+
+
+unsigned char _npyReadData(FILE *f, PyObject *path, NpyHeader *header, VECTOR_TYPE *data, size_t count) {
+/*  Reads a run of VECTOR_TYPEs from the data section of an .npy file, converting them to native byte order.
+
+    Inputs: f      - The file to read the data from.
+            path   - The path that f was opened from.
+            header - The parsed header of the file.
+            data   - The buffer to read the values into.
+            count  - The number of values to read.
+
+    Outputs: 1 if the data was successfully read, otherwise 0.
+*/
+
+    size_t read;
+
+    Py_BEGIN_ALLOW_THREADS
+    read = fread(data, sizeof(VECTOR_TYPE), count, f);
+    if (read == count && header->byteSwapped)
+        _npyByteSwap(data, count);
+    Py_END_ALLOW_THREADS
+
+    if (read != count)
+        return _npyIOError(f, path);
+
+    return 1;
+}
+
+
+#if PY_MAJOR_VERSION >= 3
+static PyObject *_npyCallMmap(PyObject *mmap, PyObject *fileno, PyObject *access) {
+/*  Calls mmap.mmap(fileno, 0, access=access).
+
+    Inputs: mmap    - The mmap module.
+            fileno  - The file descriptor to map.
+            access  - The access mode to map the file with.
+
+    Outputs: A new reference to the mmap object, or NULL if an error occurred.
+*/
+
+    PyObject *constructor,
+             *args,
+             *kwargs,
+             *map;
+
+    map = NULL;
+    if ((constructor = PyObject_GetAttrString(mmap, "mmap")) == NULL)
+        return NULL;
+
+    if ((args = Py_BuildValue("(Oi)", fileno, 0)) != NULL) {
+        if ((kwargs = Py_BuildValue("{sO}", "access", access)) != NULL) {
+            map = PyObject_Call(constructor, args, kwargs);
+            Py_DECREF(kwargs);
+        }
+        Py_DECREF(args);
+    }
+
+    Py_DECREF(constructor);
+    return map;
+}
+#endif
+
+
+PyObject *_npyMap(PyObject *path, NpyHeader *header, size_t count, VECTOR_TYPE **data) {
+/*  Maps the data section of an .npy file into memory, read only.
+
+    Inputs: path   - The path of the .npy file.
+            header - The parsed header of the file.
+            count  - The number of values expected in the data section.
+            data   - Will be set to point to the first value of the data section.
+
+    Outputs: A new reference to an object owning the mapping; the mapping remains valid for as long as it lives.
+             NULL if an error occurred.
+*/
+
+#if PY_MAJOR_VERSION >= 3
+    PyObject *io,
+             *mmap,
+             *file,
+             *fileno,
+             *access,
+             *map,
+             *view,
+             *tmp;
+    Py_buffer *buffer;
+
+    if (header->byteSwapped) {
+        PyErr_SetString(PyExc_ValueError, "Cannot memory map an .npy file of non-native byte order.");
+        return NULL;
+    }
+    if (header->dataOffset % sizeof(VECTOR_TYPE)) {
+        PyErr_SetString(PyExc_ValueError, "Cannot memory map an .npy file whose data section is not aligned.");
+        return NULL;
+    }
+
+    if ((io = PyImport_ImportModule("io")) == NULL)
+        return NULL;
+    file = PyObject_CallMethod(io, "open", "Os", path, "rb");
+    Py_DECREF(io);
+    if (file == NULL)
+        return NULL;
+
+    map = NULL;
+    if ((fileno = PyObject_CallMethod(file, "fileno", NULL)) != NULL) {
+        if ((mmap = PyImport_ImportModule("mmap")) != NULL) {
+            // mmap.mmap(fileno, 0, access=mmap.ACCESS_READ); access must be passed by keyword as the positional
+            // arguments following length differ between platforms
+            if ((access = PyObject_GetAttrString(mmap, "ACCESS_READ")) != NULL) {
+                map = _npyCallMmap(mmap, fileno, access);
+                Py_DECREF(access);
+            }
+            Py_DECREF(mmap);
+        }
+        Py_DECREF(fileno);
+    }
+
+    // The mapping remains valid after the file it was created from is closed
+    if ((tmp = PyObject_CallMethod(file, "close", NULL)) == NULL)
+        Py_CLEAR(map);
+    Py_XDECREF(tmp);
+    Py_DECREF(file);
+
+    if (map == NULL)
+        return NULL;
+
+    view = PyMemoryView_FromObject(map);
+    Py_DECREF(map);
+    if (view == NULL)
+        return NULL;
+
+    buffer = PyMemoryView_GET_BUFFER(view);
+    if ((size_t)buffer->len < (size_t)header->dataOffset + count * sizeof(VECTOR_TYPE)) {
+        Py_DECREF(view);
+        PyErr_SetString(PyExc_ValueError, "Unexpected end of file; .npy file is truncated.");
+        return NULL;
+    }
+
+    *data = (VECTOR_TYPE *)((char *)buffer->buf + header->dataOffset);
+    return view;
+#else
+    PyErr_SetString(PyExc_NotImplementedError, "Memory mapped loading requires Python 3.");
+    return NULL;
+#endif
+}
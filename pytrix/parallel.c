@@ -0,0 +1,135 @@
+/*
+ *  Copyright (C) 2016 Warren Spencer warrenspencer27@gmail.com
+
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/* A minimal parallel-for, used by batch operations to split large inputs between threads.  Uses pthreads, or native
+   threads on Windows.  Tasks are run without the GIL and so must not touch Python objects.
+*/
+
+unsigned int _parallelThreadCount(void);
+void _parallelFor(ParallelTask, void *, Py_ssize_t, Py_ssize_t);
+
+
+unsigned int _parallelThreadCount(void) {
+/*  Determines the number of threads to split work between; the number of online processors, up to
+    PARALLEL_MAX_THREADS.
+
+    Outputs: The number of threads to use; at least 1.
+*/
+
+    static unsigned int threads = 0;
+    long processors;
+
+    if (threads == 0) {
+#ifdef _WIN32
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+        processors = (long)info.dwNumberOfProcessors;
+#else
+        processors = sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+        if (processors < 1)
+            processors = 1;
+        threads = processors > PARALLEL_MAX_THREADS ? PARALLEL_MAX_THREADS : (unsigned int)processors;
+    }
+
+    return threads;
+}
+
+
+#ifdef _WIN32
+static DWORD WINAPI _parallelThreadMain(LPVOID arg) {
+#else
+static void *_parallelThreadMain(void *arg) {
+#endif
+/*  Entry point of the threads started by _parallelFor.
+
+    Inputs: arg - The ParallelChunk for the thread to process.
+*/
+
+    ParallelChunk *chunk = (ParallelChunk *)arg;
+
+    chunk->task(chunk->context, chunk->start, chunk->end, chunk->worker);
+    return 0;
+}
+
+
+void _parallelFor(ParallelTask task, void *context, Py_ssize_t count, Py_ssize_t minChunk) {
+/*  Runs a task over count items, split into contiguous chunks between up to _parallelThreadCount() threads, each
+    given at least minChunk items.  The calling thread processes the first chunk itself.  If a thread cannot be
+    started its chunk is run by the calling thread instead, so the task always completes.
+    Should be called without holding the GIL.
+
+    Inputs: task     - The function to run on each chunk.
+            context  - The context to pass to task.
+            count    - The number of items to process.
+            minChunk - The minimum number of items worth starting a thread for.
+*/
+
+    ParallelChunk chunks[PARALLEL_MAX_THREADS];
+#ifdef _WIN32
+    HANDLE threads[PARALLEL_MAX_THREADS];
+#else
+    pthread_t threads[PARALLEL_MAX_THREADS];
+#endif
+    unsigned char started[PARALLEL_MAX_THREADS];
+    unsigned int workers = _parallelThreadCount(),
+                 i;
+    Py_ssize_t size;
+
+    if (minChunk < 1)
+        minChunk = 1;
+    if (count / minChunk < (Py_ssize_t)workers)
+        workers = count / minChunk > 1 ? (unsigned int)(count / minChunk) : 1;
+
+    if (workers == 1) {
+        task(context, 0, count, 0);
+        return;
+    }
+
+    size = count / workers;
+    for (i = 0; i < workers; i++) {
+        chunks[i].task = task;
+        chunks[i].context = context;
+        chunks[i].start = i * size;
+        chunks[i].end = i == workers - 1 ? count : (i + 1) * size;
+        chunks[i].worker = i;
+    }
+
+    for (i = 1; i < workers; i++) {
+#ifdef _WIN32
+        threads[i] = CreateThread(NULL, 0, _parallelThreadMain, &chunks[i], 0, NULL);
+        started[i] = threads[i] != NULL;
+#else
+        started[i] = pthread_create(&threads[i], NULL, _parallelThreadMain, &chunks[i]) == 0;
+#endif
+    }
+
+    _parallelThreadMain(&chunks[0]);
+
+    for (i = 1; i < workers; i++) {
+        if (!started[i]) {
+            _parallelThreadMain(&chunks[i]);
+            continue;
+        }
+#ifdef _WIN32
+        WaitForSingleObject(threads[i], INFINITE);
+        CloseHandle(threads[i]);
+#else
+        pthread_join(threads[i], NULL);
+#endif
+    }
+}
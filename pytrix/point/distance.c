@@ -0,0 +1,291 @@
+/*
+ *  Copyright (C) 2016 Warren Spencer warrenspencer27@gmail.com
+
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+unsigned char _pointSetComponents(const char *name, PyObject *points, VECTOR_TYPE **data, Py_ssize_t *count,
+                                  unsigned int *dimensions, unsigned char *owned) {
+/*  Retrieves the coordinates of a set of points, stored component by component.  PointClouds are already stored this
+    way and are used in place; sequences of Points are copied.
+
+    Inputs: name       - The name of the function the points were passed to, for error messages.
+            points     - A PointCloud, or a sequence of Points which all have the same number of dimensions.
+            data       - Set to the coordinates of the points; component d of point i is data[d * count + i].
+            count      - Set to the number of points.
+            dimensions - Set to the number of dimensions of the points, or 0 if there are none.
+            owned      - Set to 1 if data was allocated, and must be released with PyMem_Free.
+
+    Outputs: 1 if successful, otherwise 0.
+*/
+
+    PyObject *sequence,
+             *item;
+    Point *p;
+    Py_ssize_t i;
+    unsigned int d;
+
+    *owned = 0;
+    if (PointCloud_Check(points)) {
+        *data = ((VectorArray *)points)->data;
+        *count = ((VectorArray *)points)->count;
+        *dimensions = *count ? ((VectorArray *)points)->dimensions : 0;
+        return 1;
+    }
+
+    if ((sequence = PySequence_Fast(points, "Expected a PointCloud or a sequence of Points.")) == NULL)
+        return 0;
+
+    *count = PySequence_Fast_GET_SIZE(sequence);
+    *dimensions = 0;
+    for (i = 0; i < *count; i++) {
+        item = PySequence_Fast_GET_ITEM(sequence, i);
+        if (!Point_Check(item)) {
+            PyErr_Format(PyExc_TypeError, "%.200s() requires Points, not: \"%.400s\"", name,
+                         Py_TYPE(item)->tp_name);
+            Py_DECREF(sequence);
+            return 0;
+        }
+        if (i == 0)
+            *dimensions = ((Point *)item)->dimensions;
+        else if (((Point *)item)->dimensions != *dimensions) {
+            PyErr_Format(PyExc_ValueError, "%.200s() requires Points of the same dimensions; point %zd has %u, not %u",
+                         name, i, ((Point *)item)->dimensions, *dimensions);
+            Py_DECREF(sequence);
+            return 0;
+        }
+    }
+
+    if ((*data = PyMem_Malloc(sizeof(VECTOR_TYPE) * ((size_t)*count * *dimensions + 1))) == NULL) {
+        Py_DECREF(sequence);
+        PyErr_NoMemory();
+        return 0;
+    }
+    *owned = 1;
+
+    for (i = 0; i < *count; i++) {
+        p = (Point *)PySequence_Fast_GET_ITEM(sequence, i);
+        for (d = 0; d < *dimensions; d++)
+            (*data)[(size_t)d * *count + i] = p->data[d];
+    }
+
+    Py_DECREF(sequence);
+    return 1;
+}
+
+
+static void _pairwiseDistancesTask(void *context, Py_ssize_t start, Py_ssize_t end, unsigned int worker) {
+/*  Computes the distances from a range of the first set of points to every point of the second set.  The second set
+    is processed PAIRWISE_DISTANCE_BLOCK points at a time, so that its block of coordinates stays in cache while it is
+    compared against each point of the range.  Euclidean & manhattan distances accumulate the differences of each
+    component as a run over contiguous memory; squared euclidean distances are instead computed as |a|^2 + |b|^2 - 2a.b,
+    so that each row of the block is a run of multiply-adds.
+
+    Inputs: context - The PairwiseDistances to compute.
+            start   - The index of the first point of the first set.
+            end     - The index after the last point of the first set.
+            worker  - The index of the thread running the task; unused.
+*/
+
+    PairwiseDistances *distances = (PairwiseDistances *)context;
+    Py_ssize_t block,
+               size,
+               i,
+               j;
+    unsigned int d;
+    VECTOR_TYPE *dst,
+                *src,
+                value;
+
+    for (block = 0; block < distances->countB; block += size) {
+        size = distances->countB - block < PAIRWISE_DISTANCE_BLOCK ? distances->countB - block :
+                                                                     PAIRWISE_DISTANCE_BLOCK;
+
+        for (i = start; i < end; i++) {
+            dst = distances->out + (size_t)i * distances->countB + block;
+
+            if (distances->metric == DISTANCE_MANHATTAN) {
+                memset(dst, 0, sizeof(VECTOR_TYPE) * size);
+                for (d = 0; d < distances->dimensions; d++) {
+                    value = distances->a[(size_t)d * distances->countA + i];
+                    src = distances->b + (size_t)d * distances->countB + block;
+                    for (j = 0; j < size; j++)
+                        dst[j] += fabs(value - src[j]);
+                }
+                continue;
+            }
+
+            // Differences are taken directly, as the expansion loses precision when the points are far from the origin
+            if (distances->metric == DISTANCE_EUCLIDEAN) {
+                memset(dst, 0, sizeof(VECTOR_TYPE) * size);
+                for (d = 0; d < distances->dimensions; d++) {
+                    value = distances->a[(size_t)d * distances->countA + i];
+                    src = distances->b + (size_t)d * distances->countB + block;
+                    for (j = 0; j < size; j++)
+                        dst[j] += (value - src[j]) * (value - src[j]);
+                }
+                for (j = 0; j < size; j++)
+                    dst[j] = sqrt(dst[j]);
+                continue;
+            }
+
+            value = distances->normsA[i];
+            src = distances->normsB + block;
+            for (j = 0; j < size; j++)
+                dst[j] = value + src[j];
+
+            for (d = 0; d < distances->dimensions; d++) {
+                value = -2 * distances->a[(size_t)d * distances->countA + i];
+                src = distances->b + (size_t)d * distances->countB + block;
+                for (j = 0; j < size; j++)
+                    dst[j] += value * src[j];
+            }
+
+            // Cancellation can leave the distance between (nearly) coincident points slightly negative
+            for (j = 0; j < size; j++)
+                dst[j] = dst[j] < 0 ? 0 : dst[j];
+        }
+    }
+}
+
+
+static void _pointSetNorms(VECTOR_TYPE *data, Py_ssize_t count, unsigned int dimensions, VECTOR_TYPE *norms) {
+/*  Computes the squared length of each point of a set of points.
+
+    Inputs: data       - The coordinates of the points, stored component by component.
+            count      - The number of points.
+            dimensions - The number of dimensions of the points.
+            norms      - The array to write the squared length of each point to.
+*/
+
+    VECTOR_TYPE *src;
+    Py_ssize_t i;
+    unsigned int d;
+
+    memset(norms, 0, sizeof(VECTOR_TYPE) * count);
+    for (d = 0; d < dimensions; d++) {
+        src = data + (size_t)d * count;
+        for (i = 0; i < count; i++)
+            norms[i] += src[i] * src[i];
+    }
+}
+
+
+PyObject *pairwiseDistancesFunction(PyObject *self, FASTCALL_KEYWORDS_PARAMETERS) {
+/*  Computes the distance between every point of one set of points and every point of another.  The work is split
+    between threads, without holding the GIL.
+
+    Inputs: self    - A pointer to the pytrix module.
+            args    - The two sets of points; each a PointCloud or a sequence of Points.  Optionally followed by metric;
+                      one of 'euclidean' (the default), 'sqeuclidean' or 'manhattan'.
+            nargs   - The number of positional arguments in args.
+            kwnames - The names of any keyword arguments passed.
+
+    Outputs: A Matrix whose value at [i, j] is the distance between point i of the first set and point j of the
+             second, or NULL if an error occurred.
+*/
+
+    FASTCALL_KEYWORDS_UNPACK_ARGS
+    PyObject *first,
+             *second,
+             *metricArg = NULL;
+    const char *metric = "euclidean";
+    PairwiseDistances distances;
+    Matrix *result = NULL;
+    VECTOR_TYPE *norms = NULL;
+    unsigned char ownedA = 0,
+                  ownedB = 0;
+    unsigned int dimensionsA,
+                 dimensionsB;
+    Py_ssize_t i,
+               minChunk;
+
+    if (!_parseOptionalArg("pairwise_distances", "metric", 2, args, nargs, kwnames, &metricArg))
+        return NULL;
+    if (metricArg != NULL && !PyArg_Parse(metricArg, "s:pairwise_distances", &metric))
+        return NULL;
+    first = args[0];
+    second = args[1];
+
+    if (strcmp(metric, "euclidean") == 0)
+        distances.metric = DISTANCE_EUCLIDEAN;
+    else if (strcmp(metric, "sqeuclidean") == 0)
+        distances.metric = DISTANCE_SQEUCLIDEAN;
+    else if (strcmp(metric, "manhattan") == 0)
+        distances.metric = DISTANCE_MANHATTAN;
+    else {
+        PyErr_Format(PyExc_ValueError, "Unknown metric: \"%.200s\"; expected 'euclidean', 'sqeuclidean' or "
+                     "'manhattan'.", metric);
+        return NULL;
+    }
+
+    if (!_pointSetComponents("pairwise_distances", first, &distances.a, &distances.countA, &dimensionsA, &ownedA))
+        return NULL;
+    if (!_pointSetComponents("pairwise_distances", second, &distances.b, &distances.countB, &dimensionsB, &ownedB))
+        goto cleanup;
+
+    if (dimensionsA != dimensionsB && dimensionsA != 0 && dimensionsB != 0) {
+        PyErr_Format(PyExc_ValueError, "pairwise_distances() requires Points of the same dimensions, not %u & %u",
+                     dimensionsA, dimensionsB);
+        goto cleanup;
+    }
+    distances.dimensions = dimensionsA;
+
+    if (distances.countA > UINT_MAX || distances.countB > UINT_MAX) {
+        PyErr_Format(PyExc_ValueError, "pairwise_distances() can compare sets of at most %u points.", UINT_MAX);
+        goto cleanup;
+    }
+
+    if ((result = _matrixNewContiguous((unsigned int)distances.countA, (unsigned int)distances.countB)) == NULL)
+        goto cleanup;
+    if (distances.countA == 0 || distances.countB == 0)
+        goto cleanup;
+    distances.out = Matrix_GetVector(result, 0)->data;
+
+    if (distances.metric == DISTANCE_SQEUCLIDEAN) {
+        if ((norms = PyMem_Malloc(sizeof(VECTOR_TYPE) * (distances.countA + distances.countB))) == NULL) {
+            Py_CLEAR(result);
+            PyErr_NoMemory();
+            goto cleanup;
+        }
+        distances.normsA = norms;
+        distances.normsB = norms + distances.countA;
+    }
+
+    // Each row of the result compares one point against the whole of the second set
+    minChunk = PARALLEL_MIN_CHUNK / (distances.countB * (distances.dimensions + 1)) + 1;
+
+    Py_BEGIN_ALLOW_THREADS
+    if (distances.metric == DISTANCE_SQEUCLIDEAN) {
+        _pointSetNorms(distances.a, distances.countA, distances.dimensions, distances.normsA);
+        _pointSetNorms(distances.b, distances.countB, distances.dimensions, distances.normsB);
+    }
+
+    _parallelFor(_pairwiseDistancesTask, &distances, distances.countA, minChunk);
+
+    // The distance from each point to itself is exactly 0, regardless of rounding in the expansion
+    if (first == second)
+        for (i = 0; i < distances.countA; i++)
+            distances.out[(size_t)i * distances.countB + i] = 0;
+    Py_END_ALLOW_THREADS
+
+cleanup:
+    if (ownedA)
+        PyMem_Free(distances.a);
+    if (ownedB)
+        PyMem_Free(distances.b);
+    PyMem_Free(norms);
+
+    return (PyObject *)result;
+}
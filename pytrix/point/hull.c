@@ -0,0 +1,616 @@
+/*
+ *  Copyright (C) 2016 Warren Spencer warrenspencer27@gmail.com
+
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+static int _hullPointCompare(const void *a, const void *b) {
+/*  Orders 2 dimensional points by x, then y, then by their index in the set they came from; for qsort.
+
+    Inputs: a, b - Pointers to the HullPoints to compare.
+
+    Outputs: A negative value if a comes before b, a positive value if it comes after, or 0 if they are the same.
+*/
+
+    const HullPoint *first = (const HullPoint *)a,
+                    *second = (const HullPoint *)b;
+
+    if (first->coordinates[0] != second->coordinates[0])
+        return first->coordinates[0] < second->coordinates[0] ? -1 : 1;
+    if (first->coordinates[1] != second->coordinates[1])
+        return first->coordinates[1] < second->coordinates[1] ? -1 : 1;
+    return (first->index > second->index) - (first->index < second->index);
+}
+
+
+static PyObject *_convexHull2D(VECTOR_TYPE *data, Py_ssize_t count) {
+/*  Computes the convex hull of a set of 2 dimensional points using Andrew's monotone chain algorithm.  The points are
+    sorted, then the lower & upper halves of the hull are each built in a single pass, discarding points which do not
+    make a counterclockwise turn.
+
+    Inputs: data  - The coordinates of the points; component d of point i is data[d * count + i].
+            count - The number of points, which must be at least 1.
+
+    Outputs: A list of the indices of the points on the hull, in counterclockwise order starting from the point with
+             the lowest x (then y) coordinate.  Points lying on an edge of the hull are excluded, as are all but the
+             first of any identical points.  NULL if an error occurred.
+*/
+
+    HullPoint *points,
+              **hull = NULL;
+    PyObject *result = NULL,
+             *index;
+    Py_ssize_t unique,
+               i,
+               k,
+               lower;
+
+    if ((points = PyMem_New(HullPoint, count)) == NULL)
+        return PyErr_NoMemory();
+
+    for (i = 0; i < count; i++) {
+        points[i].coordinates[0] = data[i];
+        points[i].coordinates[1] = data[count + i];
+        points[i].index = i;
+    }
+
+    qsort(points, count, sizeof(HullPoint), _hullPointCompare);
+    for (unique = 1, i = 1; i < count; i++)
+        if (points[i].coordinates[0] != points[unique - 1].coordinates[0] ||
+            points[i].coordinates[1] != points[unique - 1].coordinates[1])
+            points[unique++] = points[i];
+
+    if ((hull = PyMem_New(HullPoint *, unique * 2)) == NULL) {
+        PyErr_NoMemory();
+        goto cleanup;
+    }
+
+    // The lower hull from left to right, then the upper hull back again; the first point ends up at either end
+    for (k = 0, i = 0; i < unique; hull[k++] = &points[i++])
+        while (k >= 2 && _orient2d(hull[k - 2]->coordinates, hull[k - 1]->coordinates, points[i].coordinates) <= 0)
+            k--;
+
+    for (lower = k + 1, i = unique - 2; i >= 0; hull[k++] = &points[i--])
+        while (k >= lower && _orient2d(hull[k - 2]->coordinates, hull[k - 1]->coordinates, points[i].coordinates) <= 0)
+            k--;
+
+    k = unique > 1 ? k - 1 : 1;
+    if ((result = PyList_New(k)) == NULL)
+        goto cleanup;
+
+    for (i = 0; i < k; i++) {
+        if ((index = PyLong_FromSsize_t(hull[i]->index)) == NULL) {
+            Py_CLEAR(result);
+            goto cleanup;
+        }
+        PyList_SET_ITEM(result, i, index);
+    }
+
+cleanup:
+    PyMem_Free(points);
+    PyMem_Free(hull);
+
+    return result;
+}
+
+
+static unsigned char _hullFaceNew(HullFace **faces, Py_ssize_t *count, Py_ssize_t *capacity, Py_ssize_t a,
+                                  Py_ssize_t b, Py_ssize_t c) {
+/*  Appends a face to a 3 dimensional hull.  Its neighbours are left unset.
+
+    Inputs: faces    - The faces of the hull; reallocated if there is no room for another.
+            count    - The number of faces of the hull; incremented.
+            capacity - The number of faces there is room for in faces.
+            a, b, c  - The indices of the vertices of the face, counterclockwise when seen from outside the hull.
+
+    Outputs: 1 if successful, otherwise 0.
+*/
+
+    HullFace *face;
+
+    if (*count == *capacity) {
+        if ((face = PyMem_Realloc(*faces, sizeof(HullFace) * (size_t)(*capacity * 2 + 16))) == NULL) {
+            PyErr_NoMemory();
+            return 0;
+        }
+        *faces = face;
+        *capacity = *capacity * 2 + 16;
+    }
+
+    face = *faces + (*count)++;
+    face->vertices[0] = a;
+    face->vertices[1] = b;
+    face->vertices[2] = c;
+    face->neighbours[0] = face->neighbours[1] = face->neighbours[2] = -1;
+    face->conflicts = -1;
+    face->stamp = -1;
+    face->visible = 0;
+    face->alive = 1;
+
+    return 1;
+}
+
+
+static void _hullAssign(HullFace *faces, Py_ssize_t first, Py_ssize_t last, VECTOR_TYPE *points, Py_ssize_t *next,
+                        Py_ssize_t point) {
+/*  Adds a point to the conflicts of the first of a range of faces it lies outside of.  Points which lie outside of
+    none of them are inside the hull and are discarded.
+
+    Inputs: faces       - The faces of the hull.
+            first, last - The range of faces to consider.
+            points      - The coordinates of the points, 3 per point.
+            next        - The point following each point in the conflicts of its face.
+            point       - The index of the point to assign.
+*/
+
+    Py_ssize_t f;
+
+    for (f = first; f < last; f++) {
+        if (_orient3d(points + faces[f].vertices[0] * 3, points + faces[f].vertices[1] * 3,
+                      points + faces[f].vertices[2] * 3, points + point * 3) < 0) {
+            next[point] = faces[f].conflicts;
+            faces[f].conflicts = point;
+            return;
+        }
+    }
+}
+
+
+static int _hullPointOrder(VECTOR_TYPE *a, VECTOR_TYPE *b) {
+/*  Orders 3 dimensional points by x, then y, then z.
+
+    Inputs: a, b - The points to compare.
+
+    Outputs: A negative value if a comes before b, a positive value if it comes after, or 0 if they are the same.
+*/
+
+    unsigned int d;
+
+    for (d = 0; d < 3; d++)
+        if (a[d] != b[d])
+            return a[d] < b[d] ? -1 : 1;
+
+    return 0;
+}
+
+
+static int _hullEdgeCompare(const void *a, const void *b) {
+/*  Orders horizon edges by their starting vertex; for qsort & bsearch.
+
+    Inputs: a, b - Pointers to the HullEdges to compare.
+
+    Outputs: A negative value if a comes before b, a positive value if it comes after, or 0 if they start together.
+*/
+
+    Py_ssize_t first = ((const HullEdge *)a)->start,
+               second = ((const HullEdge *)b)->start;
+
+    return (first > second) - (first < second);
+}
+
+
+static int _hullTriangleCompare(const void *a, const void *b) {
+/*  Orders triangles, each given as 3 vertex indices, lexicographically; for qsort.
+
+    Inputs: a, b - Pointers to the triangles to compare.
+
+    Outputs: A negative value if a comes before b, a positive value if it comes after, or 0 if they are the same.
+*/
+
+    const Py_ssize_t *first = (const Py_ssize_t *)a,
+                     *second = (const Py_ssize_t *)b;
+    unsigned int i;
+
+    for (i = 0; i < 3; i++)
+        if (first[i] != second[i])
+            return first[i] < second[i] ? -1 : 1;
+
+    return 0;
+}
+
+
+static PyObject *_convexHull3D(VECTOR_TYPE *data, Py_ssize_t count) {
+/*  Computes the convex hull of a set of 3 dimensional points using quickhull.  Starting from a tetrahedron of extreme
+    points, each face keeps a list of the points outside of it; the farthest of these is repeatedly added to the hull
+    by removing every face it can see and joining it to the edges of the horizon left behind.  Points found to be
+    inside the hull are dropped as it grows, so most are only ever tested against a few faces.
+
+    Inputs: data  - The coordinates of the points; component d of point i is data[d * count + i].
+            count - The number of points, which must be at least 1.
+
+    Outputs: A sorted list of (i, j, k) tuples of the indices of the points at the corners of each triangle of the
+             hull's surface, counterclockwise when seen from outside the hull and starting from the smallest index.
+             Points lying on a face of the hull without being one of its corners are excluded.  NULL if an error
+             occurred.
+*/
+
+    VECTOR_TYPE *points = NULL,
+                *a,
+                *b,
+                *p,
+                u[3],
+                v[3],
+                best,
+                value;
+    HullFace *faces = NULL,
+             *face;
+    HullEdge *horizon = NULL,
+             *resized,
+             *found,
+             key;
+    Py_ssize_t *next = NULL,
+               *stack = NULL,
+               *triangles = NULL,
+               *grown,
+               simplex[4],
+               faceCount = 0,
+               faceCapacity = 0,
+               horizonCount,
+               horizonCapacity = 0,
+               stackCapacity = 0,
+               height,
+               stamp = 0,
+               pool,
+               first,
+               eye,
+               swap,
+               i,
+               j,
+               f,
+               g,
+               n;
+    unsigned int d,
+                 e;
+    PyObject *result = NULL,
+             *item;
+
+    if ((points = PyMem_New(VECTOR_TYPE, (size_t)count * 3)) == NULL || (next = PyMem_New(Py_ssize_t, count)) == NULL) {
+        PyErr_NoMemory();
+        goto cleanup;
+    }
+
+    for (i = 0; i < count; i++)
+        for (d = 0; d < 3; d++)
+            points[i * 3 + d] = data[(size_t)d * count + i];
+
+    // The initial tetrahedron: the first & last points in lexicographic order, the point farthest from the line
+    // through them, then the point farthest from the plane through all three
+    simplex[0] = simplex[1] = 0;
+    for (i = 1; i < count; i++) {
+        if (_hullPointOrder(points + i * 3, points + simplex[0] * 3) < 0)
+            simplex[0] = i;
+        if (_hullPointOrder(points + i * 3, points + simplex[1] * 3) > 0)
+            simplex[1] = i;
+    }
+
+    a = points + simplex[0] * 3;
+    b = points + simplex[1] * 3;
+    for (best = 0, simplex[2] = simplex[0], i = 0; i < count; i++) {
+        p = points + i * 3;
+        for (d = 0; d < 3; d++) {
+            u[d] = b[d] - a[d];
+            v[d] = p[d] - a[d];
+        }
+        value = (u[1] * v[2] - u[2] * v[1]) * (u[1] * v[2] - u[2] * v[1]) +
+                (u[2] * v[0] - u[0] * v[2]) * (u[2] * v[0] - u[0] * v[2]) +
+                (u[0] * v[1] - u[1] * v[0]) * (u[0] * v[1] - u[1] * v[0]);
+        if (value > best) {
+            best = value;
+            simplex[2] = i;
+        }
+    }
+
+    for (best = 0, simplex[3] = simplex[0], i = 0; i < count; i++) {
+        value = fabs(_orient3d(a, b, points + simplex[2] * 3, points + i * 3));
+        if (value > best) {
+            best = value;
+            simplex[3] = i;
+        }
+    }
+
+    if (best == 0) {
+        PyErr_SetString(PyExc_ValueError, "convex_hull() requires 3 dimensional Points which are not all coplanar");
+        goto cleanup;
+    }
+
+    // Face i of the tetrahedron omits vertex i, and is wound so that vertex lies below it
+    for (i = 0; i < 4; i++) {
+        if (!_hullFaceNew(&faces, &faceCount, &faceCapacity, simplex[i == 0], simplex[1 + (i <= 1)],
+                          simplex[2 + (i <= 2)]))
+            goto cleanup;
+        face = faces + i;
+        if (_orient3d(points + face->vertices[0] * 3, points + face->vertices[1] * 3, points + face->vertices[2] * 3,
+                      points + simplex[i] * 3) < 0) {
+            swap = face->vertices[1];
+            face->vertices[1] = face->vertices[2];
+            face->vertices[2] = swap;
+        }
+    }
+
+    for (f = 0; f < 4; f++)
+        for (e = 0; e < 3; e++)
+            for (g = 0; g < 4; g++)
+                for (d = 0; g != f && d < 3; d++)
+                    if (faces[g].vertices[d] == faces[f].vertices[(e + 1) % 3] &&
+                        faces[g].vertices[(d + 1) % 3] == faces[f].vertices[e])
+                        faces[f].neighbours[e] = g;
+
+    for (i = 0; i < count; i++)
+        if (i != simplex[0] && i != simplex[1] && i != simplex[2] && i != simplex[3])
+            _hullAssign(faces, 0, 4, points, next, i);
+
+    // New faces are appended, so a single pass reaches every face which ever has points outside of it
+    for (f = 0; f < faceCount; f++) {
+        if (!faces[f].alive || faces[f].conflicts == -1)
+            continue;
+
+        face = faces + f;
+        for (best = 0, eye = -1, i = face->conflicts; i != -1; i = next[i]) {
+            value = _orient3d(points + face->vertices[0] * 3, points + face->vertices[1] * 3,
+                              points + face->vertices[2] * 3, points + i * 3);
+            if (eye == -1 || value < best) {
+                best = value;
+                eye = i;
+            }
+        }
+
+        if (stackCapacity < faceCount) {
+            if ((grown = PyMem_Realloc(stack, sizeof(Py_ssize_t) * (size_t)faceCapacity)) == NULL) {
+                PyErr_NoMemory();
+                goto cleanup;
+            }
+            stack = grown;
+            stackCapacity = faceCapacity;
+        }
+
+        // Search outwards from the face for every face visible from the eye, pooling the points outside of them.  The
+        // edges between visible faces & those which aren't form the horizon
+        stamp++;
+        face->stamp = stamp;
+        face->visible = 1;
+        stack[0] = f;
+        height = 1;
+        horizonCount = 0;
+        pool = -1;
+        while (height) {
+            g = stack[--height];
+
+            for (i = faces[g].conflicts; i != -1; i = j) {
+                j = next[i];
+                if (i != eye) {
+                    next[i] = pool;
+                    pool = i;
+                }
+            }
+            faces[g].conflicts = -1;
+            faces[g].alive = 0;
+
+            for (e = 0; e < 3; e++) {
+                n = faces[g].neighbours[e];
+                if (faces[n].stamp != stamp) {
+                    faces[n].stamp = stamp;
+                    faces[n].visible = _orient3d(points + faces[n].vertices[0] * 3, points + faces[n].vertices[1] * 3,
+                                                 points + faces[n].vertices[2] * 3, points + eye * 3) < 0;
+                    if (faces[n].visible) {
+                        stack[height++] = n;
+                        continue;
+                    }
+                }
+
+                if (faces[n].visible)
+                    continue;
+
+                if (horizonCount == horizonCapacity) {
+                    if ((resized = PyMem_Realloc(horizon, sizeof(HullEdge) * (size_t)(horizonCapacity * 2 + 16))) ==
+                        NULL) {
+                        PyErr_NoMemory();
+                        goto cleanup;
+                    }
+                    horizon = resized;
+                    horizonCapacity = horizonCapacity * 2 + 16;
+                }
+                horizon[horizonCount].start = faces[g].vertices[e];
+                horizon[horizonCount].end = faces[g].vertices[(e + 1) % 3];
+                horizon[horizonCount].face = n;
+                for (d = 0; faces[n].neighbours[d] != g; d++);
+                horizon[horizonCount].edge = d;
+                horizonCount++;
+            }
+        }
+
+        // Join each edge of the horizon to the eye.  Its neighbours are the faces over the horizon edges ending at its
+        // start & starting at its end
+        first = faceCount;
+        for (i = 0; i < horizonCount; i++) {
+            if (!_hullFaceNew(&faces, &faceCount, &faceCapacity, horizon[i].start, horizon[i].end, eye))
+                goto cleanup;
+            horizon[i].created = faceCount - 1;
+            faces[faceCount - 1].neighbours[0] = horizon[i].face;
+            faces[horizon[i].face].neighbours[horizon[i].edge] = faceCount - 1;
+        }
+
+        qsort(horizon, horizonCount, sizeof(HullEdge), _hullEdgeCompare);
+        for (i = 0; i < horizonCount; i++) {
+            key.start = horizon[i].end;
+            if ((found = bsearch(&key, horizon, horizonCount, sizeof(HullEdge), _hullEdgeCompare)) == NULL) {
+                PyErr_SetString(PyExc_RuntimeError, "convex_hull() found a horizon which is not a closed loop");
+                goto cleanup;
+            }
+            faces[horizon[i].created].neighbours[1] = found->created;
+            faces[found->created].neighbours[2] = horizon[i].created;
+        }
+
+        for (i = pool; i != -1; i = j) {
+            j = next[i];
+            _hullAssign(faces, first, faceCount, points, next, i);
+        }
+    }
+
+    for (n = 0, f = 0; f < faceCount; f++)
+        n += faces[f].alive;
+
+    if ((triangles = PyMem_New(Py_ssize_t, (size_t)n * 3)) == NULL) {
+        PyErr_NoMemory();
+        goto cleanup;
+    }
+
+    // Rotating each triangle to start from its smallest index keeps its winding
+    for (i = 0, f = 0; f < faceCount; f++) {
+        if (!faces[f].alive)
+            continue;
+        face = faces + f;
+        e = face->vertices[0] < face->vertices[1] ? 0 : 1;
+        e = face->vertices[e] < face->vertices[2] ? e : 2;
+        for (d = 0; d < 3; d++)
+            triangles[i * 3 + d] = face->vertices[(e + d) % 3];
+        i++;
+    }
+
+    qsort(triangles, n, sizeof(Py_ssize_t) * 3, _hullTriangleCompare);
+    if ((result = PyList_New(n)) == NULL)
+        goto cleanup;
+
+    for (i = 0; i < n; i++) {
+        if ((item = Py_BuildValue("(nnn)", triangles[i * 3], triangles[i * 3 + 1], triangles[i * 3 + 2])) == NULL) {
+            Py_CLEAR(result);
+            goto cleanup;
+        }
+        PyList_SET_ITEM(result, i, item);
+    }
+
+cleanup:
+    PyMem_Free(points);
+    PyMem_Free(next);
+    PyMem_Free(faces);
+    PyMem_Free(horizon);
+    PyMem_Free(stack);
+    PyMem_Free(triangles);
+
+    return result;
+}
+
+
+PyObject *convexHullFunction(PyObject *self, FASTCALL_PARAMETERS) {
+/*  Computes the convex hull of a set of 2 or 3 dimensional points.  Orientation tests are exact, so that the hull is
+    correct even for points which are nearly collinear or coplanar.
+
+    Inputs: self  - A pointer to the pytrix module.
+            args  - A PointCloud or a sequence of Points.
+            nargs - The number of arguments in args.
+
+    Outputs: For 2 dimensional points, a list of the indices of the points on the hull in counterclockwise order.  For
+             3 dimensional points, a list of (i, j, k) tuples of the indices of the corners of each triangle of the
+             hull's surface, counterclockwise when seen from outside.  NULL if an error occurred.
+*/
+
+    FASTCALL_UNPACK_ARGS
+    VECTOR_TYPE *data;
+    Py_ssize_t count,
+               i;
+    unsigned int dimensions;
+    unsigned char owned;
+    PyObject *result = NULL;
+
+    if (!_assertArgCount("convex_hull", nargs, 1))
+        return NULL;
+
+    if (!_pointSetComponents("convex_hull", args[0], &data, &count, &dimensions, &owned))
+        return NULL;
+
+    for (i = 0; i < count * dimensions; i++) {
+        if (!Py_IS_FINITE(data[i])) {
+            PyErr_Format(PyExc_ValueError, "convex_hull() requires finite coordinates; point %zd is not", i % count);
+            goto cleanup;
+        }
+    }
+
+    if (count == 0)
+        result = PyList_New(0);
+    else if (dimensions == 2)
+        result = _convexHull2D(data, count);
+    else if (dimensions == 3)
+        result = _convexHull3D(data, count);
+    else
+        PyErr_Format(PyExc_ValueError, "convex_hull() requires 2 or 3 dimensional Points, not %u", dimensions);
+
+cleanup:
+    if (owned)
+        PyMem_Free(data);
+
+    return result;
+}
+
+
+PyObject *aabbFunction(PyObject *self, FASTCALL_PARAMETERS) {
+/*  Computes the axis aligned bounding box of a set of points.
+
+    Inputs: self  - A pointer to the pytrix module.
+            args  - A PointCloud or a non-empty sequence of Points.
+            nargs - The number of arguments in args.
+
+    Outputs: A (lower, upper) tuple of the Points at the minimum & maximum corners of the box.  NULL if an error
+             occurred.
+*/
+
+    FASTCALL_UNPACK_ARGS
+    VECTOR_TYPE *data,
+                *component,
+                low,
+                high;
+    Py_ssize_t count,
+               i;
+    unsigned int dimensions,
+                 d;
+    unsigned char owned;
+    Point *lower = NULL,
+          *upper = NULL;
+    PyObject *result = NULL;
+
+    if (!_assertArgCount("aabb", nargs, 1))
+        return NULL;
+
+    if (!_pointSetComponents("aabb", args[0], &data, &count, &dimensions, &owned))
+        return NULL;
+
+    if (count == 0) {
+        PyErr_SetString(PyExc_ValueError, "aabb() requires at least one Point");
+        goto cleanup;
+    }
+
+    if ((lower = _pointNew(dimensions)) == NULL || (upper = _pointNew(dimensions)) == NULL)
+        goto cleanup;
+
+    // Each component is stored contiguously, so its extremes are found in a single pass over it
+    for (d = 0; d < dimensions; d++) {
+        component = data + (size_t)d * count;
+        low = high = component[0];
+        for (i = 1; i < count; i++) {
+            low = component[i] < low ? component[i] : low;
+            high = component[i] > high ? component[i] : high;
+        }
+        Point_SetValue(lower, d, low);
+        Point_SetValue(upper, d, high);
+    }
+
+    result = Py_BuildValue("(OO)", lower, upper);
+
+cleanup:
+    Py_XDECREF(lower);
+    Py_XDECREF(upper);
+    if (owned)
+        PyMem_Free(data);
+
+    return result;
+}
@@ -0,0 +1,963 @@
+/*
+ *  Copyright (C) 2016 Warren Spencer warrenspencer27@gmail.com
+
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+static unsigned char _lineIntersection(VECTOR_TYPE *a1, VECTOR_TYPE *a2, VECTOR_TYPE *b1, VECTOR_TYPE *b2,
+                                       unsigned char segments, VECTOR_TYPE *out) {
+/*  Intersects two 2 dimensional lines or line segments.  The tests deciding whether segments meet are made on
+    products of the inputs rather than on quotients, so that segments which only touch at an endpoint are found.
+
+    Inputs: a1, a2   - Two points on the first line; or the endpoints of the first segment.
+            b1, b2   - Two points on the second line; or the endpoints of the second segment.
+            segments - 1 to intersect the segments between the points, 0 to intersect the lines through them.
+            out      - Set to the intersection point.  If the lines or segments overlap, set to the first point of the
+                       overlap from a1 towards a2.
+
+    Outputs: 1 if the lines or segments intersect, otherwise 0.
+*/
+
+    VECTOR_TYPE rx = a2[0] - a1[0],
+                ry = a2[1] - a1[1],
+                sx = b2[0] - b1[0],
+                sy = b2[1] - b1[1],
+                qx = b1[0] - a1[0],
+                qy = b1[1] - a1[1],
+                denominator = rx * sy - ry * sx,
+                t = qx * sy - qy * sx,
+                u = qx * ry - qy * rx,
+                length,
+                t0,
+                t1;
+
+    if (denominator != 0) {
+        if (segments) {
+            if (denominator < 0) {
+                denominator = -denominator;
+                t = -t;
+                u = -u;
+            }
+            if (t < 0 || t > denominator || u < 0 || u > denominator)
+                return 0;
+        }
+
+        t /= denominator;
+        out[0] = a1[0] + t * rx;
+        out[1] = a1[1] + t * ry;
+        return 1;
+    }
+
+    // Parallel lines only meet if they are the same line
+    if (u != 0 || (rx == 0 && ry == 0 && (qx * sy - qy * sx) != 0))
+        return 0;
+
+    length = rx * rx + ry * ry;
+    if (length == 0) {
+        // The first segment is a single point, which must lie within the second
+        length = sx * sx + sy * sy;
+        t = -(qx * sx + qy * sy);
+        if (segments && (length == 0 ? (qx != 0 || qy != 0) : (t < 0 || t > length)))
+            return 0;
+
+        out[0] = a1[0];
+        out[1] = a1[1];
+        return 1;
+    }
+
+    if (!segments) {
+        out[0] = a1[0];
+        out[1] = a1[1];
+        return 1;
+    }
+
+    // Collinear segments overlap where the second segment's extent along the first meets [0, 1]
+    t0 = (qx * rx + qy * ry) / length;
+    t1 = t0 + (sx * rx + sy * ry) / length;
+    if (t0 > t1) {
+        t = t0;
+        t0 = t1;
+        t1 = t;
+    }
+    if (t1 < 0 || t0 > 1)
+        return 0;
+
+    t = t0 > 0 ? t0 : 0;
+    out[0] = a1[0] + t * rx;
+    out[1] = a1[1] + t * ry;
+    return 1;
+}
+
+
+static PyObject *_intersectFunction(const char *name, unsigned char segments, PyObject *const *args, Py_ssize_t nargs) {
+/*  Implements intersect_lines & intersect_segments.
+
+    Inputs: name     - The name of the function, for error messages.
+            segments - 1 to intersect segments, 0 to intersect lines.
+            args     - The four 2 dimensional Points defining the lines or segments.
+            nargs    - The number of arguments in args.
+
+    Outputs: A new Point, None if there is no intersection, or NULL if an error occurred.
+*/
+
+    VECTOR_TYPE intersection[2];
+    Point *p;
+    Py_ssize_t i;
+
+    if (!_assertArgCount(name, nargs, 4))
+        return NULL;
+
+    for (i = 0; i < 4; i++) {
+        if (!Point_Check(args[i])) {
+            PyErr_Format(PyExc_TypeError, "%.200s() requires Points, not: \"%.400s\"", name,
+                         Py_TYPE(args[i])->tp_name);
+            return NULL;
+        }
+        if (((Point *)args[i])->dimensions != 2) {
+            PyErr_Format(PyExc_ValueError, "%.200s() requires 2 dimensional Points, not %u dimensional", name,
+                         ((Point *)args[i])->dimensions);
+            return NULL;
+        }
+    }
+
+    if (!_lineIntersection(((Point *)args[0])->data, ((Point *)args[1])->data, ((Point *)args[2])->data,
+                           ((Point *)args[3])->data, segments, intersection))
+        Py_RETURN_NONE;
+
+    if ((p = _pointNew(2)) == NULL)
+        return NULL;
+    p->data[0] = intersection[0];
+    p->data[1] = intersection[1];
+
+    return (PyObject *)p;
+}
+
+
+PyObject *intersectLinesFunction(PyObject *self, FASTCALL_PARAMETERS) {
+/*  Finds the intersection of two infinite 2 dimensional lines.
+
+    Inputs: self  - A pointer to the pytrix module.
+            args  - Two Points on the first line, followed by two Points on the second.
+            nargs - The number of arguments in args.
+
+    Outputs: A new Point; if the lines are the same line, the first of the given Points.  None if the lines are
+             parallel, or NULL if an error occurred.
+*/
+
+    FASTCALL_UNPACK_ARGS
+
+    return _intersectFunction("intersect_lines", 0, args, nargs);
+}
+
+
+PyObject *intersectSegmentsFunction(PyObject *self, FASTCALL_PARAMETERS) {
+/*  Finds the intersection of two 2 dimensional line segments.
+
+    Inputs: self  - A pointer to the pytrix module.
+            args  - The endpoints of the first segment, followed by the endpoints of the second.
+            nargs - The number of arguments in args.
+
+    Outputs: A new Point; if the segments overlap, the first point of the overlap from the first segment's first
+             endpoint.  None if the segments do not meet, or NULL if an error occurred.
+*/
+
+    FASTCALL_UNPACK_ARGS
+
+    return _intersectFunction("intersect_segments", 1, args, nargs);
+}
+
+
+static unsigned char _segmentsFromObject(PyObject *obj, VECTOR_TYPE **segments, Py_ssize_t *count) {
+/*  Copies the endpoints of a number of 2 dimensional segments into a single array.
+
+    Inputs: obj      - A sequence of pairs of Points, or a PointCloud holding the endpoints of each segment in turn.
+            segments - Set to a new array holding x1, y1, x2, y2 for each segment; must be released with PyMem_Free.
+            count    - Set to the number of segments.
+
+    Outputs: 1 if successful, otherwise 0.
+*/
+
+    PyObject *sequence,
+             *pair,
+             *item;
+    VectorArray *cloud;
+    Py_ssize_t i;
+    unsigned int endpoint;
+
+    if (PointCloud_Check(obj)) {
+        cloud = (VectorArray *)obj;
+        if (cloud->count % 2 || (cloud->count && cloud->dimensions != 2)) {
+            PyErr_SetString(PyExc_ValueError, "segment_intersections() requires a PointCloud of an even number of 2 "
+                            "dimensional points.");
+            return 0;
+        }
+
+        *count = cloud->count / 2;
+        if ((*segments = PyMem_New(VECTOR_TYPE, (size_t)*count * 4 + 1)) == NULL) {
+            PyErr_NoMemory();
+            return 0;
+        }
+        for (i = 0; i < cloud->count; i++) {
+            (*segments)[2 * i] = VectorArray_Component(cloud, 0)[i];
+            (*segments)[2 * i + 1] = VectorArray_Component(cloud, 1)[i];
+        }
+        return 1;
+    }
+
+    if ((sequence = PySequence_Fast(obj, "Expected a PointCloud or a sequence of pairs of Points.")) == NULL)
+        return 0;
+
+    *count = PySequence_Fast_GET_SIZE(sequence);
+    if ((*segments = PyMem_New(VECTOR_TYPE, (size_t)*count * 4 + 1)) == NULL) {
+        Py_DECREF(sequence);
+        PyErr_NoMemory();
+        return 0;
+    }
+
+    for (i = 0; i < *count; i++) {
+        pair = PySequence_Fast_GET_ITEM(sequence, i);
+        if (!PyTuple_Check(pair) && !PyList_Check(pair)) {
+            PyErr_Format(PyExc_TypeError, "segment_intersections() requires pairs of Points, not: \"%.400s\"",
+                         Py_TYPE(pair)->tp_name);
+            goto error;
+        }
+        if (PySequence_Fast_GET_SIZE(pair) != 2) {
+            PyErr_Format(PyExc_ValueError, "segment_intersections() requires pairs of Points; segment %zd has %zd", i,
+                         PySequence_Fast_GET_SIZE(pair));
+            goto error;
+        }
+
+        for (endpoint = 0; endpoint < 2; endpoint++) {
+            item = PySequence_Fast_GET_ITEM(pair, endpoint);
+            if (!Point_Check(item)) {
+                PyErr_Format(PyExc_TypeError, "segment_intersections() requires pairs of Points; segment %zd has "
+                             "\"%.400s\"", i, Py_TYPE(item)->tp_name);
+                goto error;
+            }
+            if (((Point *)item)->dimensions != 2) {
+                PyErr_Format(PyExc_ValueError, "segment_intersections() requires 2 dimensional Points; segment %zd "
+                             "has %u dimensional", i, ((Point *)item)->dimensions);
+                goto error;
+            }
+            (*segments)[4 * i + 2 * endpoint] = ((Point *)item)->data[0];
+            (*segments)[4 * i + 2 * endpoint + 1] = ((Point *)item)->data[1];
+        }
+    }
+
+    Py_DECREF(sequence);
+    return 1;
+
+error:
+    Py_DECREF(sequence);
+    PyMem_Free(*segments);
+    return 0;
+}
+
+
+static Py_ssize_t _segmentGridCell(SegmentGrid *grid, VECTOR_TYPE value, VECTOR_TYPE origin, Py_ssize_t cells) {
+/*  Finds the column or row of a SegmentGrid a coordinate falls in.
+
+    Inputs: grid   - The grid.
+            value  - The x or y coordinate.
+            origin - The lowest x or y coordinate of the grid.
+            cells  - The number of columns or rows in the grid.
+
+    Outputs: The column or row, clamped to the grid.
+*/
+
+    VECTOR_TYPE cell = floor((value - origin) / grid->cell);
+
+    return cell < 0 ? 0 : cell >= cells ? cells - 1 : (Py_ssize_t)cell;
+}
+
+
+static Py_ssize_t _segmentGridBucket(SegmentGrid *grid, Py_ssize_t column, Py_ssize_t row) {
+/*  Finds the bucket of a SegmentGrid holding the entries of a cell.
+
+    Inputs: grid   - The grid.
+            column - The column of the cell.
+            row    - The row of the cell.
+
+    Outputs: The bucket.
+*/
+
+    uint64_t hash = 14695981039346656037ULL;
+
+    hash = (hash ^ (uint64_t)column) * 1099511628211ULL;
+    hash = (hash ^ (uint64_t)row) * 1099511628211ULL;
+
+    // The number of buckets is a power of two, so mix the high bits into the low ones used to pick a bucket
+    hash ^= hash >> 32;
+    hash *= 0x9E3779B97F4A7C15ULL;
+    hash ^= hash >> 29;
+
+    return (Py_ssize_t)(hash & (uint64_t)(grid->buckets - 1));
+}
+
+
+static void _segmentGridPart(SegmentGrid *grid, Py_ssize_t i, Py_ssize_t column, VECTOR_TYPE *low, VECTOR_TYPE *high,
+                             Py_ssize_t *firstRow, Py_ssize_t *lastRow) {
+/*  Bounds the part of a segment within a column of a SegmentGrid, and finds the rows it crosses there.  The bounds are
+    widened by the grid's epsilon, so that a segment passing through the corner of a cell is placed in every cell
+    sharing the corner.
+
+    Inputs: grid     - The grid.
+            i        - The index of the segment.
+            column   - The column, which must be one of the columns the segment crosses.
+            low      - Set to the lowest x & y coordinates of the part of the segment.
+            high     - Set to the highest x & y coordinates of the part of the segment.
+            firstRow - Set to the first row the part crosses.
+            lastRow  - Set to the last row the part crosses.
+*/
+
+    VECTOR_TYPE *segment = grid->segments + (size_t)i * 4,
+                x1 = segment[0],
+                y1 = segment[1],
+                x2 = segment[2],
+                y2 = segment[3],
+                xa,
+                xb,
+                ya,
+                yb,
+                value;
+
+    if (x1 > x2) {
+        value = x1, x1 = x2, x2 = value;
+        value = y1, y1 = y2, y2 = value;
+    }
+
+    xa = grid->x + column * grid->cell;
+    xb = xa + grid->cell;
+    xa = xa < x1 ? x1 : xa > x2 ? x2 : xa;
+    xb = xb < x1 ? x1 : xb > x2 ? x2 : xb;
+
+    // Most segments lie within a single column, and are their own part
+    if (xa == x1 && xb == x2) {
+        ya = y1;
+        yb = y2;
+    } else {
+        ya = y1 + (y2 - y1) * ((xa - x1) / (x2 - x1));
+        yb = y1 + (y2 - y1) * ((xb - x1) / (x2 - x1));
+    }
+    if (ya > yb) {
+        value = ya, ya = yb, yb = value;
+    }
+
+    low[0] = xa - grid->epsilon;
+    low[1] = ya - grid->epsilon;
+    high[0] = xb + grid->epsilon;
+    high[1] = yb + grid->epsilon;
+    *firstRow = _segmentGridCell(grid, low[1], grid->y, grid->rows);
+    *lastRow = _segmentGridCell(grid, high[1], grid->y, grid->rows);
+}
+
+
+static void _segmentGridEntry(SegmentGrid *grid, Py_ssize_t i, Py_ssize_t column, Py_ssize_t row,
+                              const VECTOR_TYPE *low, const VECTOR_TYPE *high, SegmentGridEntry *entry) {
+/*  Describes the part of a segment within a cell of a SegmentGrid; that is, the part within the cell's column clipped
+    to the cell's row.
+
+    Inputs: grid   - The grid.
+            i      - The index of the segment.
+            column - The column of the cell.
+            row    - The row of the cell, which must be one of the rows the segment crosses in the column.
+            low    - The lowest x & y coordinates of the part of the segment within the column.
+            high   - The highest x & y coordinates of the part of the segment within the column.
+            entry  - Populated with the cell, the segment & the bounds of its part within the cell.
+*/
+
+    VECTOR_TYPE bottom = grid->y + row * grid->cell - grid->epsilon,
+                top = grid->y + (row + 1) * grid->cell + grid->epsilon;
+
+    entry->column = column;
+    entry->row = row;
+    entry->segment = i;
+    entry->low[0] = low[0];
+    entry->high[0] = high[0];
+    entry->low[1] = low[1] > bottom ? low[1] : bottom;
+    entry->high[1] = high[1] < top ? high[1] : top;
+}
+
+
+static Py_ssize_t _segmentGridPlace(SegmentGrid *grid, SegmentGridEntry *entries, Py_ssize_t i) {
+/*  Describes the parts of a segment within each cell of a SegmentGrid it crosses, unless it crosses more than
+    SEGMENT_GRID_MAX_CELLS cells.
+
+    Inputs: grid    - The grid.
+            entries - Populated with an entry for each cell the segment crosses; room for SEGMENT_GRID_MAX_CELLS.
+            i       - The index of the segment.
+
+    Outputs: The number of cells the segment crosses, or a number above SEGMENT_GRID_MAX_CELLS if it crosses more, in
+             which case the entries are incomplete.
+*/
+
+    VECTOR_TYPE *segment = grid->segments + (size_t)i * 4,
+                low[2],
+                high[2];
+    Py_ssize_t column,
+               lastColumn,
+               row,
+               lastRow,
+               cells = 0;
+
+    column = _segmentGridCell(grid, (segment[0] < segment[2] ? segment[0] : segment[2]) - grid->epsilon, grid->x,
+                              grid->columns);
+    lastColumn = _segmentGridCell(grid, (segment[0] < segment[2] ? segment[2] : segment[0]) + grid->epsilon, grid->x,
+                                  grid->columns);
+    if (lastColumn - column >= SEGMENT_GRID_MAX_CELLS)
+        return SEGMENT_GRID_MAX_CELLS + 1;
+
+    for (; column <= lastColumn; column++) {
+        _segmentGridPart(grid, i, column, low, high, &row, &lastRow);
+        if (cells + lastRow - row >= SEGMENT_GRID_MAX_CELLS)
+            return SEGMENT_GRID_MAX_CELLS + 1;
+
+        for (; row <= lastRow; row++)
+            _segmentGridEntry(grid, i, column, row, low, high, entries + cells++);
+    }
+
+    return cells;
+}
+
+
+static unsigned char _segmentGridOverlap(SegmentGridEntry *a, SegmentGridEntry *b) {
+/*  Determines whether the parts of two segments within a cell of a SegmentGrid have overlapping bounds.
+
+    Inputs: a - The entry of the first segment.
+            b - The entry of the second segment, in the same cell.
+
+    Outputs: 1 if the bounds overlap, otherwise 0.
+*/
+
+    return a->low[0] <= b->high[0] && b->low[0] <= a->high[0] && a->low[1] <= b->high[1] && b->low[1] <= a->high[1];
+}
+
+
+static unsigned char _segmentGridMetBefore(SegmentGrid *grid, Py_ssize_t i, Py_ssize_t j, Py_ssize_t column,
+                                           Py_ssize_t row) {
+/*  Determines whether the parts of two segments have overlapping bounds in a cell of a SegmentGrid before a given
+    cell, ordered by column & then row.  Each pair of intersecting segments is only reported from the first cell in
+    which their parts overlap, so that it is reported once however many cells the two share.
+
+    Inputs: grid   - The grid.
+            i      - The index of the first segment.
+            j      - The index of the second segment.
+            column - The column of the cell.
+            row    - The row of the cell.
+
+    Outputs: 1 if the segments' parts overlap in an earlier cell, otherwise 0.
+*/
+
+    VECTOR_TYPE *first = grid->segments + (size_t)i * 4,
+                *second = grid->segments + (size_t)j * 4,
+                lowA[2],
+                highA[2],
+                lowB[2],
+                highB[2];
+    SegmentGridEntry a,
+                     b;
+    Py_ssize_t current,
+               firstRowA,
+               lastRowA,
+               firstRowB,
+               lastRowB,
+               cell,
+               lastCell;
+
+    current = _segmentGridCell(grid, (first[0] < first[2] ? first[0] : first[2]) - grid->epsilon, grid->x,
+                               grid->columns);
+    cell = _segmentGridCell(grid, (second[0] < second[2] ? second[0] : second[2]) - grid->epsilon, grid->x,
+                            grid->columns);
+    current = current > cell ? current : cell;
+
+    for (; current <= column; current++) {
+        _segmentGridPart(grid, i, current, lowA, highA, &firstRowA, &lastRowA);
+        _segmentGridPart(grid, j, current, lowB, highB, &firstRowB, &lastRowB);
+
+        lastCell = lastRowA < lastRowB ? lastRowA : lastRowB;
+        if (current == column && lastCell >= row)
+            lastCell = row - 1;
+        for (cell = firstRowA > firstRowB ? firstRowA : firstRowB; cell <= lastCell; cell++) {
+            _segmentGridEntry(grid, i, current, cell, lowA, highA, &a);
+            _segmentGridEntry(grid, j, current, cell, lowB, highB, &b);
+            if (_segmentGridOverlap(&a, &b))
+                return 1;
+        }
+    }
+
+    return 0;
+}
+
+
+static VECTOR_TYPE _segmentExtentSelect(VECTOR_TYPE *extents, Py_ssize_t count, Py_ssize_t nth) {
+/*  Finds the value which would be at a position of an array of segment extents were it sorted, partially sorting the
+    array.
+
+    Inputs: extents - The extents.
+            count   - The number of extents.
+            nth     - The position to select the extent of.
+
+    Outputs: The extent.
+*/
+
+    Py_ssize_t left = 0,
+               right = count - 1,
+               middle,
+               i,
+               j;
+    VECTOR_TYPE pivot,
+                value;
+
+    #define SEGMENT_EXTENT_SWAP(a, b) (value = extents[a], extents[a] = extents[b], extents[b] = value)
+
+    while (right > left) {
+        // Order the first, middle & last extents, and partition around the median of the three
+        middle = left + (right - left) / 2;
+        if (extents[middle] < extents[left])
+            SEGMENT_EXTENT_SWAP(middle, left);
+        if (extents[right] < extents[left])
+            SEGMENT_EXTENT_SWAP(right, left);
+        if (extents[right] < extents[middle])
+            SEGMENT_EXTENT_SWAP(right, middle);
+        pivot = extents[middle];
+
+        i = left;
+        j = right;
+        while (i <= j) {
+            while (extents[i] < pivot)
+                i++;
+            while (extents[j] > pivot)
+                j--;
+            if (i <= j) {
+                SEGMENT_EXTENT_SWAP(i, j);
+                i++;
+                j--;
+            }
+        }
+
+        // Extents [left, j] are no greater than the pivot, and extents [i, right] no less
+        if (nth <= j)
+            right = j;
+        else if (nth >= i)
+            left = i;
+        else
+            break;
+    }
+
+    #undef SEGMENT_EXTENT_SWAP
+
+    return extents[nth];
+}
+
+
+static unsigned char _segmentGridInit(SegmentGrid *grid) {
+/*  Sizes a SegmentGrid to the segments it holds and places each segment in the cells it crosses.  Cells are sized to
+    the median segment, so that most segments cross few cells however far apart they are spread, and outlying segments
+    leave the cells of the rest unchanged.  Only cells holding a segment are stored, and segments crossing more than
+    SEGMENT_GRID_MAX_CELLS cells are left out of the grid altogether.
+
+    Inputs: grid - The grid, whose segments & count are set.
+
+    Outputs: 1 if successful, otherwise 0 with an error set.
+*/
+
+    VECTOR_TYPE *segment,
+                *extents,
+                lowX = grid->segments[0],
+                lowY = grid->segments[1],
+                highX = lowX,
+                highY = lowY,
+                magnitude = 0,
+                median,
+                dx,
+                dy,
+                span;
+    SegmentGridEntry *placed = NULL,
+                     *resized;
+    Py_ssize_t i,
+               cells,
+               capacity = 0,
+               total = 0;
+    unsigned int k;
+
+    if ((extents = PyMem_New(VECTOR_TYPE, grid->count)) == NULL) {
+        PyErr_NoMemory();
+        return 0;
+    }
+
+    for (i = 0; i < grid->count; i++) {
+        segment = grid->segments + (size_t)i * 4;
+        if (!Py_IS_FINITE(segment[0]) || !Py_IS_FINITE(segment[1]) || !Py_IS_FINITE(segment[2]) ||
+            !Py_IS_FINITE(segment[3])) {
+            PyErr_Format(PyExc_ValueError, "segment_intersections() requires finite coordinates; segment %zd is not",
+                         i);
+            PyMem_Free(extents);
+            return 0;
+        }
+
+        lowX = segment[0] < lowX ? segment[0] : lowX;
+        lowX = segment[2] < lowX ? segment[2] : lowX;
+        highX = segment[0] > highX ? segment[0] : highX;
+        highX = segment[2] > highX ? segment[2] : highX;
+        lowY = segment[1] < lowY ? segment[1] : lowY;
+        lowY = segment[3] < lowY ? segment[3] : lowY;
+        highY = segment[1] > highY ? segment[1] : highY;
+        highY = segment[3] > highY ? segment[3] : highY;
+        for (k = 0; k < 4; k++)
+            magnitude = fabs(segment[k]) > magnitude ? fabs(segment[k]) : magnitude;
+
+        dx = fabs(segment[2] - segment[0]);
+        dy = fabs(segment[3] - segment[1]);
+        extents[i] = dx > dy ? dx : dy;
+    }
+
+    median = _segmentExtentSelect(extents, grid->count, grid->count / 2);
+    PyMem_Free(extents);
+
+    span = highX - lowX > highY - lowY ? highX - lowX : highY - lowY;
+    grid->cell = median * SEGMENT_GRID_CELL;
+    // Most segments are single points, so share the area they cover between them; or the line they lie on
+    if (grid->cell == 0)
+        grid->cell = sqrt((highX - lowX) * (highY - lowY) / grid->count);
+    if (grid->cell == 0)
+        grid->cell = span / grid->count;
+    if (grid->cell < span / SEGMENT_GRID_MAX_SPAN)
+        grid->cell = span / SEGMENT_GRID_MAX_SPAN;
+    // Every segment is the same single point
+    if (grid->cell == 0)
+        grid->cell = 1;
+
+    // The positions computed along segments & the edges of cells are rounded relative to the magnitude of the
+    // coordinates
+    grid->epsilon = grid->cell * 1e-9 + magnitude * DBL_EPSILON * 16;
+    // Offset the cells by an irrational fraction of their size, so that the endpoints of segments with round
+    // coordinates, such as integers, do not fall on the corners of cells and place the segments in all four
+    grid->x = lowX - grid->cell * 0.381966011250105;
+    grid->y = lowY - grid->cell * 0.381966011250105;
+    grid->columns = (Py_ssize_t)((highX - grid->x) / grid->cell) + 1;
+    grid->rows = (Py_ssize_t)((highY - grid->y) / grid->cell) + 1;
+
+    if ((grid->spanning = PyMem_New(unsigned char, grid->count)) == NULL) {
+        PyErr_NoMemory();
+        return 0;
+    }
+
+    // Place each segment, growing the entries so that there is always room for those of another segment
+    for (i = 0; i < grid->count; i++) {
+        if (capacity - total < SEGMENT_GRID_MAX_CELLS) {
+            capacity = capacity * 2 + SEGMENT_GRID_MAX_CELLS;
+            if ((resized = PyMem_Realloc(placed, sizeof(SegmentGridEntry) * capacity)) == NULL) {
+                PyMem_Free(placed);
+                PyErr_NoMemory();
+                return 0;
+            }
+            placed = resized;
+        }
+
+        cells = _segmentGridPlace(grid, placed + total, i);
+        grid->spanning[i] = cells > SEGMENT_GRID_MAX_CELLS;
+        if (!grid->spanning[i])
+            total += cells;
+    }
+
+    for (grid->buckets = 1; grid->buckets < total; grid->buckets <<= 1);
+    grid->entryCount = total;
+    grid->entries = PyMem_New(SegmentGridEntry, total + 1);
+    grid->starts = PyMem_New(Py_ssize_t, grid->buckets + 1);
+    if (grid->entries == NULL || grid->starts == NULL) {
+        PyMem_Free(placed);
+        PyErr_NoMemory();
+        return 0;
+    }
+
+    // Group the entries into their buckets by counting the entries of each bucket
+    memset(grid->starts, 0, sizeof(Py_ssize_t) * (grid->buckets + 1));
+    for (i = 0; i < total; i++)
+        grid->starts[_segmentGridBucket(grid, placed[i].column, placed[i].row) + 1]++;
+    for (i = 0; i < grid->buckets; i++)
+        grid->starts[i + 1] += grid->starts[i];
+    for (i = 0; i < total; i++)
+        grid->entries[grid->starts[_segmentGridBucket(grid, placed[i].column, placed[i].row)]++] = placed[i];
+    for (i = grid->buckets; i > 0; i--)
+        grid->starts[i] = grid->starts[i - 1];
+    grid->starts[0] = 0;
+
+    PyMem_Free(placed);
+    return 1;
+}
+
+
+static int _segmentGridEntryCompare(const void *a, const void *b) {
+/*  Orders two SegmentGridEntries by their cells, by column & then row, for qsort.
+
+    Inputs: a - A pointer to the first entry.
+            b - A pointer to the second entry.
+
+    Outputs: A negative number, zero or a positive number if a comes before, with or after b.
+*/
+
+    const SegmentGridEntry *first = (const SegmentGridEntry *)a,
+                           *second = (const SegmentGridEntry *)b;
+
+    if (first->column != second->column)
+        return first->column < second->column ? -1 : 1;
+    return (first->row > second->row) - (first->row < second->row);
+}
+
+
+static int _segmentGridEntryCompareX(const void *a, const void *b) {
+/*  Orders two SegmentGridEntries of the same cell by the lowest x coordinate of their parts, for qsort.
+
+    Inputs: a - A pointer to the first entry.
+            b - A pointer to the second entry.
+
+    Outputs: A negative number, zero or a positive number if a comes before, with or after b.
+*/
+
+    const SegmentGridEntry *first = (const SegmentGridEntry *)a,
+                           *second = (const SegmentGridEntry *)b;
+
+    return (first->low[0] > second->low[0]) - (first->low[0] < second->low[0]);
+}
+
+
+static int _segmentGridEntryCompareY(const void *a, const void *b) {
+/*  Orders two SegmentGridEntries of the same cell by the lowest y coordinate of their parts, for qsort.
+
+    Inputs: a - A pointer to the first entry.
+            b - A pointer to the second entry.
+
+    Outputs: A negative number, zero or a positive number if a comes before, with or after b.
+*/
+
+    const SegmentGridEntry *first = (const SegmentGridEntry *)a,
+                           *second = (const SegmentGridEntry *)b;
+
+    return (first->low[1] > second->low[1]) - (first->low[1] < second->low[1]);
+}
+
+
+static int _segmentIntersectionCompare(const void *a, const void *b) {
+/*  Orders two SegmentIntersections by the indices of their segments, for qsort.
+
+    Inputs: a - A pointer to the first intersection.
+            b - A pointer to the second intersection.
+
+    Outputs: A negative number, zero or a positive number if a comes before, with or after b.
+*/
+
+    const SegmentIntersection *first = (const SegmentIntersection *)a,
+                              *second = (const SegmentIntersection *)b;
+
+    if (first->first != second->first)
+        return first->first < second->first ? -1 : 1;
+    return (first->second > second->second) - (first->second < second->second);
+}
+
+
+static unsigned char _segmentIntersectionAdd(SegmentIntersection **found, Py_ssize_t *count, Py_ssize_t *capacity,
+                                             Py_ssize_t i, Py_ssize_t j, VECTOR_TYPE *point) {
+/*  Records an intersection between two segments, growing the array of intersections as needed.
+
+    Inputs: found    - The array of intersections, which may be NULL if capacity is 0.
+            count    - The number of intersections in found; incremented.
+            capacity - The number of intersections found has room for.
+            i        - The index of the first segment.
+            j        - The index of the second segment.
+            point    - The intersection.
+
+    Outputs: 1 if successful, otherwise 0 with an error set.
+*/
+
+    SegmentIntersection *resized;
+
+    if (*count == *capacity) {
+        if ((resized = PyMem_Realloc(*found, sizeof(SegmentIntersection) * (*capacity * 2 + 16))) == NULL) {
+            PyErr_NoMemory();
+            return 0;
+        }
+        *found = resized;
+        *capacity = *capacity * 2 + 16;
+    }
+
+    (*found)[*count].first = i;
+    (*found)[*count].second = j;
+    (*found)[*count].x = point[0];
+    (*found)[*count].y = point[1];
+    (*count)++;
+    return 1;
+}
+
+
+PyObject *segmentIntersectionsFunction(PyObject *self, FASTCALL_PARAMETERS) {
+/*  Finds every intersection between a number of 2 dimensional line segments.  The segments are bucketed into a sparse
+    grid sized to them by _segmentGridInit.  Within each cell the parts of its segments are swept along whichever axis
+    they are narrower in, and only segments whose parts overlap are intersected; each pair being reported from the
+    first cell their parts overlap in.  Segments crossing too many cells to be placed in the grid are compared against
+    every other segment instead.
+
+    Beyond sorting, the work done grows with the number of segments & intersections for segments of similar lengths,
+    however unevenly they are spread; including long, closely spaced segments which never meet.  It grows with the
+    product of their numbers for the pairs of a few very long segments & many short ones, and for segments whose
+    parts overlap within cells without meeting, such as many nearly parallel segments crossing at shallow angles.
+
+    Inputs: self  - A pointer to the pytrix module.
+            args  - A sequence of pairs of Points, or a PointCloud holding the endpoints of each segment in turn.
+            nargs - The number of arguments in args.
+
+    Outputs: A list of (i, j, point) tuples for each pair of segments i < j which meet, ordered by i then j.  point is
+             the intersection, or the first point of the overlap of collinear segments as returned by
+             intersect_segments.  NULL if an error occurred.
+*/
+
+    FASTCALL_UNPACK_ARGS
+    SegmentGrid grid;
+    SegmentGridEntry *entries,
+                     *first,
+                     *second;
+    SegmentIntersection *found = NULL;
+    PyObject *result = NULL,
+             *item;
+    VECTOR_TYPE *a,
+                *b,
+                point[2],
+                widths,
+                heights;
+    Py_ssize_t bucket,
+               start,
+               last,
+               end,
+               m,
+               n,
+               i,
+               j,
+               count = 0,
+               capacity = 0;
+    unsigned int axis;
+    Point *p;
+
+    if (!_assertArgCount("segment_intersections", nargs, 1))
+        return NULL;
+
+    grid.entries = NULL;
+    grid.entryCount = 0;
+    grid.starts = NULL;
+    grid.buckets = 0;
+    grid.spanning = NULL;
+    if (!_segmentsFromObject(args[0], &grid.segments, &grid.count))
+        return NULL;
+
+    if (grid.count && !_segmentGridInit(&grid))
+        goto cleanup;
+
+    entries = grid.entries;
+    for (bucket = 0; bucket < grid.buckets; bucket++) {
+        // Cells sharing a bucket are rare, but their entries must be brought together
+        last = grid.starts[bucket + 1];
+        if (last - grid.starts[bucket] > 2)
+            qsort(entries + grid.starts[bucket], last - grid.starts[bucket], sizeof(SegmentGridEntry),
+                  _segmentGridEntryCompare);
+
+        for (start = grid.starts[bucket]; start < last; start = end) {
+            widths = heights = 0;
+            for (end = start; end < last && entries[end].column == entries[start].column &&
+                              entries[end].row == entries[start].row; end++) {
+                widths += entries[end].high[0] - entries[end].low[0];
+                heights += entries[end].high[1] - entries[end].low[1];
+            }
+
+            // Sweep the cell along the axis its segments' parts are narrower in, such as across parallel segments
+            axis = heights < widths;
+            if (end - start > 2)
+                qsort(entries + start, end - start, sizeof(SegmentGridEntry),
+                      axis ? _segmentGridEntryCompareY : _segmentGridEntryCompareX);
+
+            for (m = start; m < end; m++) {
+                first = entries + m;
+                for (n = m + 1; n < end && entries[n].low[axis] <= first->high[axis]; n++) {
+                    second = entries + n;
+                    if (!_segmentGridOverlap(first, second))
+                        continue;
+
+                    i = first->segment < second->segment ? first->segment : second->segment;
+                    j = first->segment < second->segment ? second->segment : first->segment;
+                    a = grid.segments + (size_t)i * 4;
+                    b = grid.segments + (size_t)j * 4;
+                    if (!_lineIntersection(a, a + 2, b, b + 2, 1, point) ||
+                        _segmentGridMetBefore(&grid, i, j, first->column, first->row))
+                        continue;
+
+                    if (!_segmentIntersectionAdd(&found, &count, &capacity, i, j, point))
+                        goto cleanup;
+                }
+            }
+        }
+    }
+
+    // Segments left out of the grid are compared against every other segment, and each other such segment once
+    for (i = 0; i < grid.count; i++) {
+        if (!grid.spanning[i])
+            continue;
+
+        for (j = 0; j < grid.count; j++) {
+            if (j == i || (grid.spanning[j] && j < i))
+                continue;
+
+            a = grid.segments + (size_t)(i < j ? i : j) * 4;
+            b = grid.segments + (size_t)(i < j ? j : i) * 4;
+
+            // Reject pairs whose bounding boxes are disjoint before intersecting them
+            if ((a[0] < b[0] && a[0] < b[2] && a[2] < b[0] && a[2] < b[2]) ||
+                (a[0] > b[0] && a[0] > b[2] && a[2] > b[0] && a[2] > b[2]) ||
+                (a[1] < b[1] && a[1] < b[3] && a[3] < b[1] && a[3] < b[3]) ||
+                (a[1] > b[1] && a[1] > b[3] && a[3] > b[1] && a[3] > b[3]) ||
+                !_lineIntersection(a, a + 2, b, b + 2, 1, point))
+                continue;
+
+            if (!_segmentIntersectionAdd(&found, &count, &capacity, i < j ? i : j, i < j ? j : i, point))
+                goto cleanup;
+        }
+    }
+
+    // qsort may not be given a NULL array
+    if (count > 1)
+        qsort(found, count, sizeof(SegmentIntersection), _segmentIntersectionCompare);
+
+    if ((result = PyList_New(count)) == NULL)
+        goto cleanup;
+
+    for (i = 0; i < count; i++) {
+        if ((p = _pointNew(2)) == NULL) {
+            Py_CLEAR(result);
+            goto cleanup;
+        }
+        p->data[0] = found[i].x;
+        p->data[1] = found[i].y;
+
+        if ((item = Py_BuildValue("(nnN)", found[i].first, found[i].second, p)) == NULL) {
+            Py_CLEAR(result);
+            goto cleanup;
+        }
+        PyList_SET_ITEM(result, i, item);
+    }
+
+cleanup:
+    PyMem_Free(grid.segments);
+    PyMem_Free(grid.entries);
+    PyMem_Free(grid.starts);
+    PyMem_Free(grid.spanning);
+    PyMem_Free(found);
+
+    return result;
+}
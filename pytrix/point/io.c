@@ -0,0 +1,93 @@
+/*
+ *  Copyright (C) 2016 Warren Spencer warrenspencer27@gmail.com
+
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+PyObject *pointFromBytes(PyObject *cls, PyObject *data) {
+/*  Creates a new point from a buffer of native doubles.
+
+    Inputs: cls  - The Point type.
+            data - An object supporting the buffer protocol.
+
+    Outputs: A new Point, or NULL if an error occurred.
+*/
+
+    Py_buffer view;
+    Point *p;
+
+    if (!_getVectorTypeBuffer(data, -1, &view))
+        return NULL;
+
+    if ((p = _pointNew((unsigned int)(view.len / sizeof(VECTOR_TYPE)))) != NULL)
+        memcpy(p->data, view.buf, view.len);
+
+    PyBuffer_Release(&view);
+    return (PyObject *)p;
+}
+
+
+PyObject *pointToBytes(Point *self) {
+/*  Returns the coordinates of this point as a bytes object of native doubles.
+
+    Inputs: self - The point to convert.
+
+    Outputs: A new bytes object, or NULL if an error occurred.
+*/
+
+    return PyBytes_FromStringAndSize((char *)self->data, (Py_ssize_t)self->dimensions * sizeof(VECTOR_TYPE));
+}
+
+
+PyObject *pointToTuple(Point *self) {
+/*  Converts this point to a tuple of floats.
+
+    Inputs: self - The point to convert.
+
+    Outputs: A new PyTuple, or NULL if an error occurred.
+*/
+
+    return _pointToTuple(self);
+}
+
+
+PyObject *pointReduceEx(Point *self, FASTCALL_PARAMETERS) {
+/*  Implements the pickle protocol for points.  The point data is emitted as a single bytes object, which is
+    transferred out-of-band when pickle protocol 5 or above is used.
+
+    Inputs: self  - The point being pickled.
+            args  - The pickle protocol being used.
+            nargs - The number of arguments in args.
+
+    Outputs: A tuple of (Point.frombytes, (data,)), or NULL if an error occurred.
+*/
+
+    FASTCALL_UNPACK_ARGS
+    PyObject *bytes,
+             *constructor;
+    long protocol;
+
+    if (!_assertArgCount("__reduce_ex__", nargs, 1) || !_parseLongArg(args[0], &protocol))
+        return NULL;
+
+    if ((bytes = _pickleBytes(pointToBytes(self), (int)protocol)) == NULL)
+        return NULL;
+
+    if ((constructor = PyObject_GetAttrString((PyObject *)&PointType, "frombytes")) == NULL) {
+        Py_DECREF(bytes);
+        return NULL;
+    }
+
+    return Py_BuildValue("(N(N))", constructor, bytes);
+}
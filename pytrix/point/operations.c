@@ -125,6 +125,14 @@ PyObject *pointRichCmp(PyObject *a, PyObject *b, int op) {
     if ((!_assertPoint(a)) || (!_assertPoint(b)))
         return NULL;
 
+    // If both hashes have already been computed and they differ, the points cannot be equal
+    if ((((Point *)a)->hash != -1 && ((Point *)b)->hash != -1) && ((Point *)a)->hash != ((Point *)b)->hash) {
+        if (op == Py_EQ)
+            Py_RETURN_FALSE;
+        if (op == Py_NE)
+            Py_RETURN_TRUE;
+    }
+
     switch (op) {
         case Py_EQ:
             if (_pointsEqual((Point *)a, (Point *)b))
@@ -143,6 +151,21 @@ PyObject *pointRichCmp(PyObject *a, PyObject *b, int op) {
 }
 
 
+Py_hash_t pointHash(Point *self) {
+/*  Hashes a point.  As points are immutable the hash is only computed once, and is cached on the point.
+
+    Inputs: self - The point to hash.
+
+    Outputs: A Py_hash_t of the components of self.
+*/
+
+    if (self->hash == -1)
+        self->hash = _finalizeHash(_hashVectorTypeArray(self->data, self->dimensions, (Py_uhash_t)self->dimensions));
+
+    return self->hash;
+}
+
+
 int pointTrue(Point *self) {
 /*  Determines if a point has a magnitude of 0 or not.
 
@@ -0,0 +1,210 @@
+/*
+ *  Copyright (C) 2016 Warren Spencer warrenspencer27@gmail.com
+
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/* Orientation predicates whose signs are always correct.  Each is first estimated in floating point, and only if the
+   estimate is too close to zero for its sign to be trusted is it recomputed exactly, as an expansion: a sum of
+   doubles which don't overlap, accumulated without rounding.
+*/
+
+static void _twoSum(VECTOR_TYPE a, VECTOR_TYPE b, VECTOR_TYPE *sum, VECTOR_TYPE *error) {
+/*  Adds two doubles exactly.
+
+    Inputs: a, b  - The doubles to add.
+            sum   - Set to a + b, rounded.
+            error - Set to the rounding error of sum, such that sum + error == a + b exactly.
+*/
+
+    VECTOR_TYPE x = a + b,
+                bVirtual = x - a,
+                aVirtual = x - bVirtual;
+
+    *sum = x;
+    *error = (a - aVirtual) + (b - bVirtual);
+}
+
+
+static void _twoProduct(VECTOR_TYPE a, VECTOR_TYPE b, VECTOR_TYPE *product, VECTOR_TYPE *error) {
+/*  Multiplies two doubles exactly, by splitting each into halves whose products can be computed without rounding.
+
+    Inputs: a, b    - The doubles to multiply.
+            product - Set to a * b, rounded.
+            error   - Set to the rounding error of product, such that product + error == a * b exactly.
+*/
+
+    VECTOR_TYPE x = a * b,
+                c = PREDICATE_SPLITTER * a,
+                aHigh = c - (c - a),
+                aLow = a - aHigh,
+                bHigh,
+                bLow;
+
+    c = PREDICATE_SPLITTER * b;
+    bHigh = c - (c - b);
+    bLow = b - bHigh;
+
+    *product = x;
+    *error = aLow * bLow - (((x - aHigh * bHigh) - aLow * bHigh) - aHigh * bLow);
+}
+
+
+static unsigned int _expansionGrow(VECTOR_TYPE *expansion, unsigned int length, VECTOR_TYPE value) {
+/*  Adds a double to an expansion, in place.  Components which become zero are dropped.
+
+    Inputs: expansion - The components of the expansion, from smallest to largest magnitude; must have room for one
+                        more component.
+            length    - The number of components in the expansion.
+            value     - The double to add.
+
+    Outputs: The number of components in the resulting expansion.
+*/
+
+    VECTOR_TYPE sum = value,
+                error;
+    unsigned int i,
+                 grown = 0;
+
+    for (i = 0; i < length; i++) {
+        _twoSum(sum, expansion[i], &sum, &error);
+        if (error != 0)
+            expansion[grown++] = error;
+    }
+
+    if (sum != 0 || grown == 0)
+        expansion[grown++] = sum;
+
+    return grown;
+}
+
+
+static unsigned int _expansionAddProduct(VECTOR_TYPE *expansion, unsigned int length, VECTOR_TYPE a, VECTOR_TYPE b,
+                                         VECTOR_TYPE c) {
+/*  Adds the exact product of two or three doubles to an expansion, in place.
+
+    Inputs: expansion - The components of the expansion, which must have room for four more components.
+            length    - The number of components in the expansion.
+            a, b, c   - The doubles to multiply; c may be 1 to multiply only a & b.
+
+    Outputs: The number of components in the resulting expansion.
+*/
+
+    VECTOR_TYPE high,
+                low,
+                product,
+                error;
+
+    _twoProduct(a, b, &high, &low);
+    if (c == 1) {
+        length = _expansionGrow(expansion, length, low);
+        return _expansionGrow(expansion, length, high);
+    }
+
+    _twoProduct(low, c, &product, &error);
+    length = _expansionGrow(expansion, length, error);
+    length = _expansionGrow(expansion, length, product);
+    _twoProduct(high, c, &product, &error);
+    length = _expansionGrow(expansion, length, error);
+    return _expansionGrow(expansion, length, product);
+}
+
+
+VECTOR_TYPE _orient2d(VECTOR_TYPE *a, VECTOR_TYPE *b, VECTOR_TYPE *c) {
+/*  Determines which side of the line through two 2 dimensional points a third lies on.
+
+    Inputs: a, b - Two points on the line.
+            c    - The point to test.
+
+    Outputs: A positive value if a, b & c are in counterclockwise order, a negative value if they are in clockwise
+             order, or 0 if they are collinear.  The value approximates twice the signed area of the triangle abc.
+*/
+
+    VECTOR_TYPE left = (a[0] - c[0]) * (b[1] - c[1]),
+                right = (a[1] - c[1]) * (b[0] - c[0]),
+                determinant = left - right,
+                expansion[13];
+    unsigned int length = 0;
+
+    if (fabs(determinant) > ORIENT2D_ERROR_BOUND * (fabs(left) + fabs(right)))
+        return determinant;
+
+    // ax.by - ay.bx + bx.cy - by.cx + cx.ay - cy.ax, computed exactly from the coordinates themselves
+    length = _expansionAddProduct(expansion, length, a[0], b[1], 1);
+    length = _expansionAddProduct(expansion, length, -a[1], b[0], 1);
+    length = _expansionAddProduct(expansion, length, b[0], c[1], 1);
+    length = _expansionAddProduct(expansion, length, -b[1], c[0], 1);
+    length = _expansionAddProduct(expansion, length, c[0], a[1], 1);
+    length = _expansionAddProduct(expansion, length, -c[1], a[0], 1);
+
+    // The largest component of an expansion has its sign
+    return expansion[length - 1];
+}
+
+
+static unsigned int _expansionAddDeterminant(VECTOR_TYPE *expansion, unsigned int length, VECTOR_TYPE *p,
+                                             VECTOR_TYPE *q, VECTOR_TYPE *r, VECTOR_TYPE sign) {
+/*  Adds the exact determinant of the 3x3 matrix whose rows are three points to an expansion, in place.
+
+    Inputs: expansion - The components of the expansion, which must have room for 24 more components.
+            length    - The number of components in the expansion.
+            p, q, r   - The rows of the matrix.
+            sign      - 1 to add the determinant, or -1 to subtract it.
+
+    Outputs: The number of components in the resulting expansion.
+*/
+
+    length = _expansionAddProduct(expansion, length, sign * p[0], q[1], r[2]);
+    length = _expansionAddProduct(expansion, length, -sign * p[0], q[2], r[1]);
+    length = _expansionAddProduct(expansion, length, -sign * p[1], q[0], r[2]);
+    length = _expansionAddProduct(expansion, length, sign * p[1], q[2], r[0]);
+    length = _expansionAddProduct(expansion, length, sign * p[2], q[0], r[1]);
+    return _expansionAddProduct(expansion, length, -sign * p[2], q[1], r[0]);
+}
+
+
+VECTOR_TYPE _orient3d(VECTOR_TYPE *a, VECTOR_TYPE *b, VECTOR_TYPE *c, VECTOR_TYPE *d) {
+/*  Determines which side of the plane through three 3 dimensional points a fourth lies on.
+
+    Inputs: a, b, c - Three points on the plane.
+            d       - The point to test.
+
+    Outputs: A positive value if d lies below the plane, where below is the side from which a, b & c appear clockwise;
+             a negative value if it lies above the plane, or 0 if the points are coplanar.  The value approximates six
+             times the signed volume of the tetrahedron abcd.
+*/
+
+    VECTOR_TYPE adx = a[0] - d[0], ady = a[1] - d[1], adz = a[2] - d[2],
+                bdx = b[0] - d[0], bdy = b[1] - d[1], bdz = b[2] - d[2],
+                cdx = c[0] - d[0], cdy = c[1] - d[1], cdz = c[2] - d[2],
+                determinant,
+                permanent,
+                expansion[97];
+    unsigned int length = 0;
+
+    determinant = adx * (bdy * cdz - bdz * cdy) + bdx * (cdy * adz - cdz * ady) + cdx * (ady * bdz - adz * bdy);
+    permanent = fabs(adx) * (fabs(bdy * cdz) + fabs(bdz * cdy)) + fabs(bdx) * (fabs(cdy * adz) + fabs(cdz * ady)) +
+                fabs(cdx) * (fabs(ady * bdz) + fabs(adz * bdy));
+
+    if (fabs(determinant) > ORIENT3D_ERROR_BOUND * permanent)
+        return determinant;
+
+    // The determinant of the 4x4 matrix whose rows are a, b, c & d each followed by a 1, expanded along its last column
+    length = _expansionAddDeterminant(expansion, length, b, c, d, -1);
+    length = _expansionAddDeterminant(expansion, length, a, c, d, 1);
+    length = _expansionAddDeterminant(expansion, length, a, b, d, -1);
+    length = _expansionAddDeterminant(expansion, length, a, b, c, 1);
+
+    return expansion[length - 1];
+}
@@ -0,0 +1,173 @@
+/*
+ *  Copyright (C) 2016 Warren Spencer warrenspencer27@gmail.com
+
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+static void _transformPointsTask(void *context, Py_ssize_t start, Py_ssize_t end, unsigned int worker) {
+/*  Applies a homogeneous transform to a range of points.  Each point is computed into the worker's scratch space
+    before being written out, so the output may overlap the input.
+
+    Inputs: context - The PointTransform to apply.
+            start   - The index of the first point to transform.
+            end     - The index after the last point to transform.
+            worker  - The index of the thread running the task.
+*/
+
+    PointTransform *transform = (PointTransform *)context;
+    unsigned int n = transform->dimensions,
+                 stride = n + 1,
+                 row,
+                 col;
+    VECTOR_TYPE *m = transform->matrix,
+                *scratch = transform->scratch + (size_t)worker * n,
+                *p,
+                *dst,
+                value,
+                w,
+                x,
+                y,
+                z;
+    Py_ssize_t i;
+
+    // Points in two and three dimensions are by far the most common, and are unrolled
+    if (n == 3 && !transform->projective) {
+        for (i = start; i < end; i++) {
+            p = transform->inputs[i];
+            x = p[0];
+            y = p[1];
+            z = p[2];
+            dst = transform->out + (size_t)i * 3;
+            dst[0] = m[0] * x + m[1] * y + m[2] * z + m[3];
+            dst[1] = m[4] * x + m[5] * y + m[6] * z + m[7];
+            dst[2] = m[8] * x + m[9] * y + m[10] * z + m[11];
+        }
+        return;
+    }
+
+    if (n == 2 && !transform->projective) {
+        for (i = start; i < end; i++) {
+            p = transform->inputs[i];
+            x = p[0];
+            y = p[1];
+            dst = transform->out + (size_t)i * 2;
+            dst[0] = m[0] * x + m[1] * y + m[2];
+            dst[1] = m[3] * x + m[4] * y + m[5];
+        }
+        return;
+    }
+
+    for (i = start; i < end; i++) {
+        p = transform->inputs[i];
+
+        for (row = 0; row < n; row++) {
+            value = m[row * stride + n];
+            for (col = 0; col < n; col++)
+                value += m[row * stride + col] * p[col];
+            scratch[row] = value;
+        }
+
+        if (transform->projective) {
+            w = m[n * stride + n];
+            for (col = 0; col < n; col++)
+                w += m[n * stride + col] * p[col];
+            for (row = 0; row < n; row++)
+                scratch[row] /= w;
+        }
+
+        memcpy(transform->out + (size_t)i * n, scratch, sizeof(VECTOR_TYPE) * n);
+    }
+}
+
+
+PyObject *transformPointsFunction(PyObject *self, FASTCALL_KEYWORDS_PARAMETERS) {
+/*  Applies an (n+1)x(n+1) homogeneous transform to a number of n dimensional points at once.  The work is split
+    between threads, without holding the GIL.
+
+    Inputs: self    - A pointer to the pytrix module.
+            args    - The transform Matrix, and either a sequence of Points, a PointCloud, or an object supporting the
+                      buffer protocol containing points of n native doubles laid out one after another; optionally
+                      followed by out, a writable buffer to write the results into.
+            nargs   - The number of positional arguments in args.
+            kwnames - The names of any keyword arguments passed.
+
+    Outputs: A PointCloud of the transformed points if given a PointCloud, otherwise a Matrix whose rows are the
+             transformed points, stored contiguously; or out if it was given.  NULL if an error occurred.
+*/
+
+    FASTCALL_KEYWORDS_UNPACK_ARGS
+    PyObject *outArg = Py_None;
+    BatchElements batch;
+    Matrix *m;
+    PointTransform transform;
+    unsigned int n,
+                 row,
+                 col;
+
+    if (!_parseOptionalArg("transform_points", "out", 2, args, nargs, kwnames, &outArg))
+        return NULL;
+
+    if (!_assertMatrix(args[0]))
+        return NULL;
+    m = (Matrix *)args[0];
+
+    if (m->rows != m->columns || m->rows < 2) {
+        PyErr_Format(PyExc_ValueError, "transform_points() requires an (n+1)x(n+1) homogeneous transform Matrix, not "
+                     "%ux%u", m->rows, m->columns);
+        return NULL;
+    }
+    n = m->rows - 1;
+
+    if (!_vectorArrayParseBatch(&batch, "transform_points()", args[1], outArg, &PointType, n, n))
+        return NULL;
+
+    // PointClouds are transformed component by component, straight from their own storage
+    if (batch.array != NULL) {
+        if (!_vectorArrayTransformInto(batch.array, m, batch.out != NULL ? batch.out :
+                                       ((VectorArray *)batch.result)->data, batch.out != NULL))
+            Py_CLEAR(batch.result);
+
+        _vectorArrayReleaseBatch(&batch);
+        return batch.result;
+    }
+
+    // The matrix is followed by the scratch space of each worker
+    if ((transform.matrix = PyMem_Malloc(sizeof(VECTOR_TYPE) * ((size_t)(n + 1) * (n + 1) +
+                                                                (size_t)PARALLEL_MAX_THREADS * n))) == NULL) {
+        Py_CLEAR(batch.result);
+        _vectorArrayReleaseBatch(&batch);
+        return PyErr_NoMemory();
+    }
+    transform.scratch = transform.matrix + (size_t)(n + 1) * (n + 1);
+    transform.dimensions = n;
+    transform.inputs = batch.inputs;
+    transform.out = batch.out;
+    transform.projective = Matrix_GetValue(m, n, n) != 1;
+    for (row = 0; row <= n; row++) {
+        for (col = 0; col <= n; col++) {
+            transform.matrix[row * (n + 1) + col] = Matrix_GetValue(m, row, col);
+            if (row == n && col != n && Matrix_GetValue(m, row, col) != 0)
+                transform.projective = 1;
+        }
+    }
+
+    Py_BEGIN_ALLOW_THREADS
+    _parallelFor(_transformPointsTask, &transform, batch.count, PARALLEL_MIN_CHUNK);
+    Py_END_ALLOW_THREADS
+
+    _vectorArrayReleaseBatch(&batch);
+    PyMem_Free(transform.matrix);
+
+    return batch.result;
+}
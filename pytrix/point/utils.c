@@ -36,6 +36,7 @@ Point *_pointNew(unsigned int dimensions) {
 
     newPoint->dimensions = dimensions;
     newPoint->data = data;
+    newPoint->hash = -1;
 
     return newPoint;
 }
@@ -134,25 +135,7 @@ PyObject *_pointToTuple(Point *self) {
     Outputs: A PyTuple corresponding to self if successful, else sets a PyError and returns NULL.
 */
 
-    PyObject *tuple;
-    unsigned int i;
-    PyObject *item;
-
-    if ((tuple = PyTuple_New(self->dimensions)) == NULL)
-        return NULL;
-
-    for (i = 0; i < self->dimensions; i++) {
-        item = PyNumber_FROM_VECTOR_TYPE(Point_GetValue(self, i));
-
-        if (item == NULL) {
-            Py_DECREF(tuple);
-            return NULL;
-        }
-
-        PyTuple_SET_ITEM(tuple, i, item);
-    }
-
-    return tuple;
+    return _vectorTypeArrayToTuple(self->data, self->dimensions);
 }
 
 
@@ -24,6 +24,13 @@ void initTypes(PyObject *module) {
  * Inputs: module - The module object we will attach the types to.
  */
 
+#ifdef HAVE_TYPE_VECTORCALL
+    // Construct our types through vectorcall, rather than tp_new & tp_init with a packed argument tuple
+    PointType.tp_vectorcall = pointVectorcall;
+    VectorType.tp_vectorcall = vectorVectorcall;
+    MatrixType.tp_vectorcall = matrixVectorcall;
+#endif
+
     if (PyType_Ready(&PointType) < 0)
         return;
     if (PyType_Ready(&PointIterType) < 0)
@@ -36,6 +43,26 @@ void initTypes(PyObject *module) {
         return;
     if (PyType_Ready(&MatrixIterType) < 0)
         return;
+    if (PyType_Ready(&SharedBufferType) < 0)
+        return;
+    if (PyType_Ready(&VectorBuilderType) < 0)
+        return;
+    if (PyType_Ready(&MatrixBuilderType) < 0)
+        return;
+    if (PyType_Ready(&LazyMatrixType) < 0)
+        return;
+    if (PyType_Ready(&VectorArrayType) < 0)
+        return;
+    if (PyType_Ready(&PointCloudType) < 0)
+        return;
+    if (PyType_Ready(&KDTreeType) < 0)
+        return;
+    if (PyType_Ready(&SpatialGridType) < 0)
+        return;
+    if (PyType_Ready(&QuaternionType) < 0)
+        return;
+    if (PyType_Ready(&MatrixBatchType) < 0)
+        return;
 
     Py_INCREF(&PointType);
     Py_INCREF(&PointIterType);
@@ -43,21 +70,85 @@ void initTypes(PyObject *module) {
     Py_INCREF(&VectorIterType);
     Py_INCREF(&MatrixType);
     Py_INCREF(&MatrixIterType);
+    Py_INCREF(&VectorBuilderType);
+    Py_INCREF(&MatrixBuilderType);
+    Py_INCREF(&LazyMatrixType);
+    Py_INCREF(&VectorArrayType);
+    Py_INCREF(&PointCloudType);
+    Py_INCREF(&KDTreeType);
+    Py_INCREF(&SpatialGridType);
+    Py_INCREF(&QuaternionType);
+    Py_INCREF(&MatrixBatchType);
     PyModule_AddObject(module, "Point", (PyObject *)&PointType);
     PyModule_AddObject(module, "Vector", (PyObject *)&VectorType);
     PyModule_AddObject(module, "Matrix", (PyObject *)&MatrixType);
+    PyModule_AddObject(module, "VectorBuilder", (PyObject *)&VectorBuilderType);
+    PyModule_AddObject(module, "MatrixBuilder", (PyObject *)&MatrixBuilderType);
+    PyModule_AddObject(module, "LazyMatrix", (PyObject *)&LazyMatrixType);
+    PyModule_AddObject(module, "VectorArray", (PyObject *)&VectorArrayType);
+    PyModule_AddObject(module, "PointCloud", (PyObject *)&PointCloudType);
+    PyModule_AddObject(module, "KDTree", (PyObject *)&KDTreeType);
+    PyModule_AddObject(module, "SpatialGrid", (PyObject *)&SpatialGridType);
+    PyModule_AddObject(module, "Quaternion", (PyObject *)&QuaternionType);
+    PyModule_AddObject(module, "MatrixBatch", (PyObject *)&MatrixBatchType);
 }
 
 
 static PyMethodDef pytrixMethods[] = {
-    {"identityMatrix", (PyCFunction)identityMatrix, METH_VARARGS,
+    {"identityMatrix", (PyCFunction)(void(*)(void))identityMatrix, METH_FASTCALL_COMPAT,
         PyDoc_STR("Convenience function for constructing identity matrices.")},
-    {"rotation2DMatrix", (PyCFunction)rotation2DMatrix, METH_VARARGS,
+    {"rotation2DMatrix", (PyCFunction)(void(*)(void))rotation2DMatrix, METH_FASTCALL_COMPAT,
         PyDoc_STR("Convenience function for constructing 2D rotation matrices.")},
-    {"rotation3DMatrix", (PyCFunction)rotation3DMatrix, METH_VARARGS,
+    {"rotation3DMatrix", (PyCFunction)(void(*)(void))rotation3DMatrix, METH_FASTCALL_COMPAT,
         PyDoc_STR("Convenience function for constructing 3D rotation matrices.")},
-    {"permutationMatrix", (PyCFunction)permutationMatrix, METH_VARARGS,
+    {"permutationMatrix", (PyCFunction)(void(*)(void))permutationMatrix, METH_FASTCALL_COMPAT,
         PyDoc_STR("Convenience function for constructing permutation matrices.")},
+    {"batch_inverse", (PyCFunction)(void(*)(void))batchInverseFunction, METH_FASTCALL_COMPAT,
+        PyDoc_STR("batch_inverse(matrices)\n\nInverts a sequence of square matrices of the same size, returning a "
+                  "list of their inverses.")},
+    {"add", (PyCFunction)(void(*)(void))addFunction, METH_FASTCALL_KEYWORDS_COMPAT,
+        PyDoc_STR("add(a, b, out=None)\n\nAdds two matrices or two vectors, writing the result into out if given.")},
+    {"sub", (PyCFunction)(void(*)(void))subFunction, METH_FASTCALL_KEYWORDS_COMPAT,
+        PyDoc_STR("sub(a, b, out=None)\n\nSubtracts b from a, writing the result into out if given.")},
+    {"scale", (PyCFunction)(void(*)(void))scaleFunction, METH_FASTCALL_KEYWORDS_COMPAT,
+        PyDoc_STR("scale(a, scalar, out=None)\n\nMultiplies a matrix or vector by a scalar, writing the result into "
+                  "out if given.")},
+    {"matmul", (PyCFunction)(void(*)(void))matmulFunction, METH_FASTCALL_KEYWORDS_COMPAT,
+        PyDoc_STR("matmul(a, b, out=None)\n\nMultiplies matrix a by matrix or vector b, writing the result into out "
+                  "if given.")},
+    {"linear_combination", (PyCFunction)(void(*)(void))linearCombinationFunction, METH_FASTCALL_KEYWORDS_COMPAT,
+        PyDoc_STR("linear_combination(coefficients, operands, out=None)\n\nComputes the sum of each coefficient "
+                  "multiplied by its matrix or vector, writing the result into out if given.")},
+    {"axpy", (PyCFunction)(void(*)(void))axpyFunction, METH_FASTCALL_KEYWORDS_COMPAT,
+        PyDoc_STR("axpy(alpha, x, y, out=None)\n\nComputes alpha * x + y, writing the result into out if given.")},
+    {"transform_points", (PyCFunction)(void(*)(void))transformPointsFunction, METH_FASTCALL_KEYWORDS_COMPAT,
+        PyDoc_STR("transform_points(matrix, points, out=None)\n\nApplies an (n+1)x(n+1) homogeneous transform to a "
+                  "sequence of n dimensional Points, or a buffer of packed points.")},
+    {"pairwise_distances", (PyCFunction)(void(*)(void))pairwiseDistancesFunction, METH_FASTCALL_KEYWORDS_COMPAT,
+        PyDoc_STR("pairwise_distances(a, b, metric='euclidean')\n\nComputes a Matrix of the distance between each "
+                  "point of a and each point of b.  metric is one of 'euclidean', 'sqeuclidean' or 'manhattan'.")},
+    {"intersect_lines", (PyCFunction)(void(*)(void))intersectLinesFunction, METH_FASTCALL_COMPAT,
+        PyDoc_STR("intersect_lines(a1, a2, b1, b2)\n\nReturns the Point where the line through a1 & a2 meets the line "
+                  "through b1 & b2, or None if they are parallel.")},
+    {"intersect_segments", (PyCFunction)(void(*)(void))intersectSegmentsFunction, METH_FASTCALL_COMPAT,
+        PyDoc_STR("intersect_segments(a1, a2, b1, b2)\n\nReturns the Point where the segment from a1 to a2 meets the "
+                  "segment from b1 to b2, or None if they do not meet.")},
+    {"segment_intersections", (PyCFunction)(void(*)(void))segmentIntersectionsFunction, METH_FASTCALL_COMPAT,
+        PyDoc_STR("segment_intersections(segments)\n\nFinds every pair of intersecting segments among a sequence of "
+                  "pairs of Points, returning a list of (i, j, point) tuples.")},
+    {"convex_hull", (PyCFunction)(void(*)(void))convexHullFunction, METH_FASTCALL_COMPAT,
+        PyDoc_STR("convex_hull(points)\n\nComputes the convex hull of 2 or 3 dimensional Points.  In 2 dimensions, "
+                  "returns the indices of its vertices in counterclockwise order; in 3, a list of (i, j, k) triangles "
+                  "wound counterclockwise when seen from outside.")},
+    {"aabb", (PyCFunction)(void(*)(void))aabbFunction, METH_FASTCALL_COMPAT,
+        PyDoc_STR("aabb(points)\n\nReturns the (lower, upper) corners of the axis aligned bounding box of a set of "
+                  "Points.")},
+    {"multi_dot", (PyCFunction)(void(*)(void))multiDotFunction, METH_FASTCALL_COMPAT,
+        PyDoc_STR("multi_dot(operands)\n\nMultiplies a sequence of matrices in the cheapest order.  The first and last "
+                  "operands may be Vectors.")},
+    {"lazy", (PyCFunction)(void(*)(void))lazyFunction, METH_FASTCALL_COMPAT,
+        PyDoc_STR("lazy(matrix)\n\nBegins a lazy expression; operators applied to the result build an expression "
+                  "which is only computed, in fused passes, by its evaluate() method.")},
     {NULL, NULL, 0, NULL}   /* sentinel */
 };
 
@@ -0,0 +1,204 @@
+/*
+ *  Copyright (C) 2016 Warren Spencer warrenspencer27@gmail.com
+
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+Quaternion *_quaternionNew(VECTOR_TYPE w, VECTOR_TYPE x, VECTOR_TYPE y, VECTOR_TYPE z) {
+/*  Creates a new Quaternion.
+
+    Inputs: w       - The scalar part of the quaternion.
+            x, y, z - The vector part of the quaternion.
+
+    Outputs: A new Quaternion, or NULL if an error occurred.
+*/
+
+    Quaternion *q;
+
+    if ((q = PyObject_New(Quaternion, &QuaternionType)) == NULL)
+        return NULL;
+
+    q->data[0] = w;
+    q->data[1] = x;
+    q->data[2] = y;
+    q->data[3] = z;
+
+    return q;
+}
+
+
+PyObject *quaternionNew(PyTypeObject *type, PyObject *args, PyObject *kwds) {
+/*  Creates a Quaternion from its components.
+
+    Inputs: type - The Quaternion type.
+            args - A tuple containing up to 4 PyNumbers; w, x, y & z.  w defaults to 1, and the others to 0, so that
+                   Quaternion() is the identity rotation.
+            kwds - Optionally contains w, x, y & z instead.
+
+    Outputs: A new Quaternion, or NULL if an error occurred.
+*/
+
+    static char *kwlist[] = {"w", "x", "y", "z", NULL};
+    VECTOR_TYPE w = 1,
+                x = 0,
+                y = 0,
+                z = 0;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|dddd:Quaternion", kwlist, &w, &x, &y, &z))
+        return NULL;
+
+    return (PyObject *)_quaternionNew(w, x, y, z);
+}
+
+
+void quaternionDeInit(Quaternion *self) {
+/*  Frees a Quaternion.
+
+    Inputs: self - The quaternion to free.
+*/
+
+    PyObject_Del(self);
+}
+
+
+PyObject *quaternionFromAxisAngle(PyObject *cls, FASTCALL_PARAMETERS) {
+/*  Creates a Quaternion rotating about an axis.
+
+    Inputs: cls   - The Quaternion type.
+            args  - The axis to rotate about as a 3 dimensional Vector of any non-zero length, followed by the radians
+                    to rotate counterclockwise about it, when looking back along the axis.
+            nargs - The number of arguments in args.
+
+    Outputs: A unit Quaternion, or NULL if an error occurred.
+*/
+
+    FASTCALL_UNPACK_ARGS
+    Vector *axis;
+    VECTOR_TYPE radians,
+                length,
+                factor;
+
+    if (!_assertArgCount("from_axis_angle", nargs, 2) || !_parseVectorTypeArg(args[1], &radians))
+        return NULL;
+
+    if (!Vector_Check(args[0]) || ((Vector *)args[0])->dimensions != 3) {
+        PyErr_SetString(PyExc_TypeError, "from_axis_angle() requires a 3 dimensional Vector axis.");
+        return NULL;
+    }
+    axis = (Vector *)args[0];
+
+    length = sqrt(Vector_GetValue(axis, 0) * Vector_GetValue(axis, 0) +
+                  Vector_GetValue(axis, 1) * Vector_GetValue(axis, 1) +
+                  Vector_GetValue(axis, 2) * Vector_GetValue(axis, 2));
+    if (length == 0) {
+        PyErr_SetString(PyExc_ValueError, "from_axis_angle() requires a non-zero axis.");
+        return NULL;
+    }
+
+    factor = sin(radians / 2) / length;
+    return (PyObject *)_quaternionNew(cos(radians / 2), Vector_GetValue(axis, 0) * factor,
+                                      Vector_GetValue(axis, 1) * factor, Vector_GetValue(axis, 2) * factor);
+}
+
+
+PyObject *quaternionFromEuler(PyObject *cls, FASTCALL_PARAMETERS) {
+/*  Creates a Quaternion performing the same rotation as rotation3DMatrix; rotating about the x, then the y, then the z
+    axis.
+
+    Inputs: cls   - The Quaternion type.
+            args  - Three PyNumbers for the x, y, and z rotation radians.
+            nargs - The number of arguments in args.
+
+    Outputs: A unit Quaternion, or NULL if an error occurred.
+*/
+
+    FASTCALL_UNPACK_ARGS
+    VECTOR_TYPE xRadians,
+                yRadians,
+                zRadians,
+                cx,
+                sx,
+                cy,
+                sy,
+                cz,
+                sz;
+
+    if (!_assertArgCount("from_euler", nargs, 3) || !_parseVectorTypeArg(args[0], &xRadians) ||
+        !_parseVectorTypeArg(args[1], &yRadians) || !_parseVectorTypeArg(args[2], &zRadians))
+        return NULL;
+
+    cx = cos(xRadians / 2);
+    sx = sin(xRadians / 2);
+    cy = cos(yRadians / 2);
+    sy = sin(yRadians / 2);
+    cz = cos(zRadians / 2);
+    sz = sin(zRadians / 2);
+
+    // The product of the rotations about z, y & x, expanded
+    return (PyObject *)_quaternionNew(cz * cy * cx + sz * sy * sx, cz * cy * sx - sz * sy * cx,
+                                      cz * sy * cx + sz * cy * sx, sz * cy * cx - cz * sy * sx);
+}
+
+
+PyObject *quaternionFromMatrix(PyObject *cls, PyObject *arg) {
+/*  Creates a Quaternion performing the same rotation as a rotation matrix.
+
+    Inputs: cls - The Quaternion type.
+            arg - A 3x3 rotation Matrix.
+
+    Outputs: A unit Quaternion, or NULL if an error occurred.
+*/
+
+    Matrix *m;
+    VECTOR_TYPE r[3][3],
+                trace,
+                s;
+    unsigned int row,
+                 col;
+
+    if (!_assertMatrix(arg))
+        return NULL;
+    m = (Matrix *)arg;
+
+    if (m->rows != 3 || m->columns != 3) {
+        PyErr_Format(PyExc_ValueError, "from_matrix() requires a 3x3 rotation Matrix, not %ux%u", m->rows, m->columns);
+        return NULL;
+    }
+
+    for (row = 0; row < 3; row++)
+        for (col = 0; col < 3; col++)
+            r[row][col] = Matrix_GetValue(m, row, col);
+
+    // Solve for the largest component first, from the diagonal, so that the others are divided by as much as possible
+    trace = r[0][0] + r[1][1] + r[2][2];
+    if (trace > 0) {
+        s = sqrt(trace + 1) * 2;
+        return (PyObject *)_quaternionNew(s / 4, (r[2][1] - r[1][2]) / s, (r[0][2] - r[2][0]) / s,
+                                          (r[1][0] - r[0][1]) / s);
+    }
+    if (r[0][0] > r[1][1] && r[0][0] > r[2][2]) {
+        s = sqrt(1 + r[0][0] - r[1][1] - r[2][2]) * 2;
+        return (PyObject *)_quaternionNew((r[2][1] - r[1][2]) / s, s / 4, (r[0][1] + r[1][0]) / s,
+                                          (r[0][2] + r[2][0]) / s);
+    }
+    if (r[1][1] > r[2][2]) {
+        s = sqrt(1 + r[1][1] - r[0][0] - r[2][2]) * 2;
+        return (PyObject *)_quaternionNew((r[0][2] - r[2][0]) / s, (r[0][1] + r[1][0]) / s, s / 4,
+                                          (r[1][2] + r[2][1]) / s);
+    }
+
+    s = sqrt(1 + r[2][2] - r[0][0] - r[1][1]) * 2;
+    return (PyObject *)_quaternionNew((r[1][0] - r[0][1]) / s, (r[0][2] + r[2][0]) / s, (r[1][2] + r[2][1]) / s,
+                                      s / 4);
+}
@@ -0,0 +1,473 @@
+/*
+ *  Copyright (C) 2016 Warren Spencer warrenspencer27@gmail.com
+
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+static void _quaternionMultiply(VECTOR_TYPE *a, VECTOR_TYPE *b, VECTOR_TYPE *out) {
+/*  Computes the Hamilton product of two quaternions; the rotation b followed by the rotation a.
+
+    Inputs: a, b - The components of the quaternions, w first.
+            out  - Set to the components of the product; must not be a or b.
+*/
+
+    out[0] = a[0] * b[0] - a[1] * b[1] - a[2] * b[2] - a[3] * b[3];
+    out[1] = a[0] * b[1] + a[1] * b[0] + a[2] * b[3] - a[3] * b[2];
+    out[2] = a[0] * b[2] - a[1] * b[3] + a[2] * b[0] + a[3] * b[1];
+    out[3] = a[0] * b[3] + a[1] * b[2] - a[2] * b[1] + a[3] * b[0];
+}
+
+
+static unsigned char _quaternionRotation(Quaternion *q, VECTOR_TYPE *out) {
+/*  Computes the 3x3 rotation matrix equivalent to a quaternion.  Quaternions which are not of unit length are treated
+    as the unit quaternion in the same direction.
+
+    Inputs: q   - The quaternion.
+            out - Set to the 9 values of the matrix, row by row.
+
+    Outputs: 1 if successful, otherwise 0 with a ValueError set if q is zero.
+*/
+
+    VECTOR_TYPE w = q->data[0],
+                x = q->data[1],
+                y = q->data[2],
+                z = q->data[3],
+                s = w * w + x * x + y * y + z * z;
+
+    if (s == 0) {
+        PyErr_SetString(PyExc_ValueError, "A zero Quaternion does not represent a rotation.");
+        return 0;
+    }
+    s = 2 / s;
+
+    out[0] = 1 - s * (y * y + z * z);
+    out[1] = s * (x * y - w * z);
+    out[2] = s * (x * z + w * y);
+    out[3] = s * (x * y + w * z);
+    out[4] = 1 - s * (x * x + z * z);
+    out[5] = s * (y * z - w * x);
+    out[6] = s * (x * z - w * y);
+    out[7] = s * (y * z + w * x);
+    out[8] = 1 - s * (x * x + y * y);
+
+    return 1;
+}
+
+
+static PyObject *_quaternionRotateOne(PyObject *item, VECTOR_TYPE *rotation) {
+/*  Rotates a single Vector or Point.
+
+    Inputs: item     - The 3 dimensional Vector or Point to rotate.
+            rotation - The rotation matrix to apply, row by row.
+
+    Outputs: A new Vector or Point of the same type as item, or NULL with an error set if item is not a 3 dimensional
+             Vector or Point.
+*/
+
+    VECTOR_TYPE *in,
+                *out;
+    PyObject *result;
+    unsigned int dimensions,
+                 row;
+
+    if (Vector_Check(item))
+        dimensions = ((Vector *)item)->dimensions;
+    else if (Point_Check(item))
+        dimensions = ((Point *)item)->dimensions;
+    else {
+        PyErr_Format(PyExc_TypeError, "rotate() requires Vectors or Points, not: \"%.400s\"", Py_TYPE(item)->tp_name);
+        return NULL;
+    }
+
+    if (dimensions != 3) {
+        PyErr_Format(PyExc_ValueError, "rotate() requires 3 dimensional Vectors or Points, not %u", dimensions);
+        return NULL;
+    }
+
+    if (Vector_Check(item)) {
+        if ((result = (PyObject *)_vectorNew(3)) == NULL)
+            return NULL;
+        in = ((Vector *)item)->data;
+        out = ((Vector *)result)->data;
+    } else {
+        if ((result = (PyObject *)_pointNew(3)) == NULL)
+            return NULL;
+        in = ((Point *)item)->data;
+        out = ((Point *)result)->data;
+    }
+
+    for (row = 0; row < 3; row++)
+        out[row] = rotation[row * 3] * in[0] + rotation[row * 3 + 1] * in[1] + rotation[row * 3 + 2] * in[2];
+
+    return result;
+}
+
+
+PyObject *quaternionStr(Quaternion *self) {
+/*  Constructs a human-readable Python String representing this quaternion.
+
+    Inputs: self - The quaternion for which the human readable format will be produced.
+
+    Outputs: A PyString of the (w, x, y, z) tuple of the quaternion's components.
+*/
+
+    PyObject *tuple,
+             *tupleRepr;
+
+    if ((tuple = quaternionToTuple(self)) == NULL)
+        return NULL;
+
+    tupleRepr = PyObject_Repr(tuple);
+    Py_DECREF(tuple);
+
+    return tupleRepr;
+}
+
+
+PyObject *quaternionToTuple(Quaternion *self) {
+/*  Returns the components of a quaternion.
+
+    Inputs: self - The quaternion.
+
+    Outputs: A (w, x, y, z) tuple of floats, or NULL if an error occurred.
+*/
+
+    return Py_BuildValue("(dddd)", self->data[0], self->data[1], self->data[2], self->data[3]);
+}
+
+
+PyObject *quaternionReduce(Quaternion *self) {
+/*  Helper for pickle.
+
+    Inputs: self - The quaternion being pickled.
+
+    Outputs: A tuple of the Quaternion type & the arguments to recreate self with.
+*/
+
+    return Py_BuildValue("(O(dddd))", (PyObject *)&QuaternionType, self->data[0], self->data[1], self->data[2],
+                         self->data[3]);
+}
+
+
+PyObject *quaternionRichCmp(PyObject *a, PyObject *b, int op) {
+/*  Performs (in)equality checking for quaternions.  Note that q & -q represent the same rotation, but are not equal.
+
+    Inputs: a  - The first object to compare.
+            b  - The second object to compare.
+            op - An operation code.  See https://docs.python.org/3/c-api/typeobj.html#c.PyTypeObject.tp_richcompare
+
+    Outputs: A PyTrue or PyFalse depending which op code was given and the values of a and b, or NotImplemented.
+*/
+
+    unsigned char equal;
+
+    if (!Quaternion_Check(a) || !Quaternion_Check(b) || (op != Py_EQ && op != Py_NE)) {
+        Py_INCREF(Py_NotImplemented);
+        return Py_NotImplemented;
+    }
+
+    equal = ((Quaternion *)a)->data[0] == ((Quaternion *)b)->data[0] &&
+            ((Quaternion *)a)->data[1] == ((Quaternion *)b)->data[1] &&
+            ((Quaternion *)a)->data[2] == ((Quaternion *)b)->data[2] &&
+            ((Quaternion *)a)->data[3] == ((Quaternion *)b)->data[3];
+
+    if (equal == (op == Py_EQ))
+        Py_RETURN_TRUE;
+    Py_RETURN_FALSE;
+}
+
+
+Py_hash_t quaternionHash(Quaternion *self) {
+/*  Hashes a quaternion.
+
+    Inputs: self - The quaternion to hash.
+
+    Outputs: A Py_hash_t of the components of self.
+*/
+
+    return _finalizeHash(_hashVectorTypeArray(self->data, 4, 4));
+}
+
+
+PyObject *quaternionMul(PyObject *a, PyObject *b) {
+/*  Composes two rotations; the rotation b followed by the rotation a.
+
+    Inputs: a - The first Quaternion.
+            b - The second Quaternion.
+
+    Outputs: A new Quaternion of the Hamilton product of a & b, or NotImplemented if either is not a Quaternion.
+*/
+
+    VECTOR_TYPE product[4];
+
+    if (!Quaternion_Check(a) || !Quaternion_Check(b)) {
+        Py_INCREF(Py_NotImplemented);
+        return Py_NotImplemented;
+    }
+
+    _quaternionMultiply(((Quaternion *)a)->data, ((Quaternion *)b)->data, product);
+    return (PyObject *)_quaternionNew(product[0], product[1], product[2], product[3]);
+}
+
+
+PyObject *quaternionNeg(Quaternion *self) {
+/*  Negates a quaternion; the result represents the same rotation.
+
+    Inputs: self - The quaternion to negate.
+
+    Outputs: A new Quaternion, or NULL if an error occurred.
+*/
+
+    return (PyObject *)_quaternionNew(-self->data[0], -self->data[1], -self->data[2], -self->data[3]);
+}
+
+
+PyObject *quaternionLength(Quaternion *self) {
+/*  Computes the length (norm) of a quaternion.
+
+    Inputs: self - The quaternion.
+
+    Outputs: A PyFloat of the length of self.
+*/
+
+    return PyFloat_FromDouble(sqrt(self->data[0] * self->data[0] + self->data[1] * self->data[1] +
+                                   self->data[2] * self->data[2] + self->data[3] * self->data[3]));
+}
+
+
+PyObject *quaternionNormalize(Quaternion *self) {
+/*  Scales a quaternion to unit length.
+
+    Inputs: self - The quaternion to normalize.
+
+    Outputs: A new unit Quaternion, or NULL with a ValueError set if self is zero.
+*/
+
+    VECTOR_TYPE length = sqrt(self->data[0] * self->data[0] + self->data[1] * self->data[1] +
+                              self->data[2] * self->data[2] + self->data[3] * self->data[3]);
+
+    if (length == 0) {
+        PyErr_SetString(PyExc_ValueError, "Cannot normalize a zero Quaternion.");
+        return NULL;
+    }
+
+    return (PyObject *)_quaternionNew(self->data[0] / length, self->data[1] / length, self->data[2] / length,
+                                      self->data[3] / length);
+}
+
+
+PyObject *quaternionConjugate(Quaternion *self) {
+/*  Conjugates a quaternion; for unit quaternions this is the inverse rotation.
+
+    Inputs: self - The quaternion to conjugate.
+
+    Outputs: A new Quaternion, or NULL if an error occurred.
+*/
+
+    return (PyObject *)_quaternionNew(self->data[0], -self->data[1], -self->data[2], -self->data[3]);
+}
+
+
+PyObject *quaternionInverse(Quaternion *self) {
+/*  Inverts a quaternion, such that self * self.inverse() is the identity.
+
+    Inputs: self - The quaternion to invert.
+
+    Outputs: A new Quaternion, or NULL with a ValueError set if self is zero.
+*/
+
+    VECTOR_TYPE norm = self->data[0] * self->data[0] + self->data[1] * self->data[1] +
+                       self->data[2] * self->data[2] + self->data[3] * self->data[3];
+
+    if (norm == 0) {
+        PyErr_SetString(PyExc_ValueError, "Cannot invert a zero Quaternion.");
+        return NULL;
+    }
+
+    return (PyObject *)_quaternionNew(self->data[0] / norm, -self->data[1] / norm, -self->data[2] / norm,
+                                      -self->data[3] / norm);
+}
+
+
+PyObject *quaternionSlerp(Quaternion *self, FASTCALL_PARAMETERS) {
+/*  Spherically interpolates between two rotations, at a constant angular velocity along the shorter arc between them.
+
+    Inputs: self  - The rotation at t = 0.
+            args  - The Quaternion of the rotation at t = 1, followed by t.
+            nargs - The number of arguments in args.
+
+    Outputs: A new unit Quaternion, or NULL if an error occurred.
+*/
+
+    FASTCALL_UNPACK_ARGS
+    VECTOR_TYPE a[4],
+                b[4],
+                t,
+                dot = 0,
+                lengthA = 0,
+                lengthB = 0,
+                theta,
+                factorA,
+                factorB,
+                length = 0;
+    unsigned int i;
+
+    if (!_assertArgCount("slerp", nargs, 2) || !_parseVectorTypeArg(args[1], &t))
+        return NULL;
+
+    if (!Quaternion_Check(args[0])) {
+        PyErr_Format(PyExc_TypeError, "slerp() requires a Quaternion, not: \"%.400s\"", Py_TYPE(args[0])->tp_name);
+        return NULL;
+    }
+
+    for (i = 0; i < 4; i++) {
+        lengthA += self->data[i] * self->data[i];
+        lengthB += ((Quaternion *)args[0])->data[i] * ((Quaternion *)args[0])->data[i];
+    }
+    if (lengthA == 0 || lengthB == 0) {
+        PyErr_SetString(PyExc_ValueError, "Cannot interpolate a zero Quaternion.");
+        return NULL;
+    }
+
+    lengthA = sqrt(lengthA);
+    lengthB = sqrt(lengthB);
+    for (i = 0; i < 4; i++) {
+        a[i] = self->data[i] / lengthA;
+        b[i] = ((Quaternion *)args[0])->data[i] / lengthB;
+        dot += a[i] * b[i];
+    }
+
+    // q & -q are the same rotation; take whichever is nearer to a, so as to follow the shorter arc
+    if (dot < 0) {
+        dot = -dot;
+        for (i = 0; i < 4; i++)
+            b[i] = -b[i];
+    }
+
+    // Nearly parallel rotations are interpolated linearly, as sin(theta) approaches 0
+    if (dot > 0.9995) {
+        factorA = 1 - t;
+        factorB = t;
+    } else {
+        theta = acos(dot);
+        factorA = sin((1 - t) * theta) / sin(theta);
+        factorB = sin(t * theta) / sin(theta);
+    }
+
+    for (i = 0; i < 4; i++) {
+        a[i] = factorA * a[i] + factorB * b[i];
+        length += a[i] * a[i];
+    }
+    length = sqrt(length);
+
+    return (PyObject *)_quaternionNew(a[0] / length, a[1] / length, a[2] / length, a[3] / length);
+}
+
+
+PyObject *quaternionToMatrix(Quaternion *self) {
+/*  Converts a quaternion to a rotation matrix.
+
+    Inputs: self - The quaternion.
+
+    Outputs: A new 3x3 rotation Matrix, or NULL if an error occurred.
+*/
+
+    VECTOR_TYPE rotation[9];
+    Matrix *m;
+    unsigned int row,
+                 col;
+
+    if (!_quaternionRotation(self, rotation) || (m = _matrixNew(3, 3)) == NULL)
+        return NULL;
+
+    for (row = 0; row < 3; row++)
+        for (col = 0; col < 3; col++)
+            Matrix_SetValue(m, row, col, rotation[row * 3 + col]);
+
+    return (PyObject *)m;
+}
+
+
+PyObject *quaternionRotate(Quaternion *self, PyObject *arg) {
+/*  Rotates Vectors or Points by a quaternion.  The quaternion is converted to a rotation matrix once, which is then
+    applied to each element; VectorArrays & PointClouds are rotated in parallel, without holding the GIL.
+
+    Inputs: self - The rotation.
+            arg  - A 3 dimensional Vector, Point, VectorArray or PointCloud, or a sequence of Vectors & Points.
+
+    Outputs: A new object of the same type as arg holding the rotated elements; a list for sequences.  NULL if an
+             error occurred.
+*/
+
+    VECTOR_TYPE rotation[9];
+    VectorArrayTransform transform;
+    VectorArray *array;
+    PyObject *sequence,
+             *result,
+             *item;
+    Py_ssize_t count,
+               i;
+
+    if (!_quaternionRotation(self, rotation))
+        return NULL;
+
+    if (Vector_Check(arg) || Point_Check(arg))
+        return _quaternionRotateOne(arg, rotation);
+
+    if (VectorArray_Check(arg) || PointCloud_Check(arg)) {
+        if (((VectorArray *)arg)->count && ((VectorArray *)arg)->dimensions != 3) {
+            PyErr_Format(PyExc_ValueError, "rotate() requires 3 dimensional Vectors or Points, not %u",
+                         ((VectorArray *)arg)->dimensions);
+            return NULL;
+        }
+
+        if ((array = _vectorArrayNew(Py_TYPE(arg), ((VectorArray *)arg)->count, 3)) == NULL)
+            return NULL;
+
+        // Points are rotated about the origin, so both are transformed linearly
+        transform.matrix = rotation;
+        transform.inDimensions = transform.outDimensions = 3;
+        transform.homogeneous = transform.projective = transform.interleaved = 0;
+        transform.in = ((VectorArray *)arg)->data;
+        transform.out = array->data;
+        transform.count = array->count;
+
+        Py_BEGIN_ALLOW_THREADS
+        _parallelFor(_vectorArrayTransformTask, &transform, array->count, PARALLEL_MIN_CHUNK);
+        Py_END_ALLOW_THREADS
+
+        return (PyObject *)array;
+    }
+
+    if ((sequence = PySequence_Fast(arg, "rotate() requires Vectors, Points, or a sequence of them.")) == NULL)
+        return NULL;
+
+    count = PySequence_Fast_GET_SIZE(sequence);
+    if ((result = PyList_New(count)) == NULL) {
+        Py_DECREF(sequence);
+        return NULL;
+    }
+
+    for (i = 0; i < count; i++) {
+        if ((item = _quaternionRotateOne(PySequence_Fast_GET_ITEM(sequence, i), rotation)) == NULL) {
+            Py_DECREF(sequence);
+            Py_DECREF(result);
+            return NULL;
+        }
+        PyList_SET_ITEM(result, i, item);
+    }
+
+    Py_DECREF(sequence);
+    return result;
+}
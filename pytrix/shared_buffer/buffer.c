@@ -0,0 +1,280 @@
+/*
+ *  Copyright (C) 2016 Warren Spencer warrenspencer27@gmail.com
+
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/* Shared memory segments are created through multiprocessing.shared_memory, so that they can be attached to by
+   pytrix and plain Python code alike.  Each segment begins with a small header describing the matrix it holds:
+
+     bytes 0 - 7:  SHARED_BUFFER_MAGIC
+     bytes 8 - 11: the number of rows, as a native unsigned int
+     bytes 12 - 15: the number of columns, as a native unsigned int
+     bytes 16 - 23: the id of the process which created the segment, as a native long long
+
+   followed by the matrix values, row by row, starting at SHARED_BUFFER_HEADER_SIZE.
+*/
+
+#define SHARED_BUFFER_MAGIC "PYTRIXSM"
+#define SHARED_BUFFER_HEADER_SIZE 64
+
+
+static PyObject *_sharedMemoryType(void) {
+/*  Imports multiprocessing.shared_memory.SharedMemory.
+
+    Outputs: A new reference to the SharedMemory type, or NULL if an error occurred.
+*/
+
+    PyObject *module,
+             *type;
+
+    if ((module = PyImport_ImportModule("multiprocessing.shared_memory")) == NULL)
+        return NULL;
+
+    type = PyObject_GetAttrString(module, "SharedMemory");
+    Py_DECREF(module);
+    return type;
+}
+
+
+static SharedBuffer *_sharedBufferWrap(PyObject *shm, unsigned char creator) {
+/*  Creates a SharedBuffer owning a SharedMemory instance.
+
+    Inputs: shm     - The SharedMemory instance.  A reference to it is stolen, and it is closed on failure.
+            creator - Whether or not the segment should be unlinked when the SharedBuffer is freed.
+
+    Outputs: A new SharedBuffer, or NULL if an error occurred.
+*/
+
+    SharedBuffer *self;
+    PyObject *buf;
+    Py_buffer view;
+
+    if ((self = PyObject_New(SharedBuffer, &SharedBufferType)) == NULL) {
+        Py_DECREF(shm);
+        return NULL;
+    }
+
+    self->shm = shm;
+    self->creator = creator;
+    self->data = NULL;
+
+    // The segment stays mapped until close() is called on it, so we can hold on to its address without holding an
+    // export on its buffer; which would otherwise prevent it from being closed
+    if ((buf = PyObject_GetAttrString(shm, "buf")) == NULL) {
+        SharedBuffer_dealloc(self);
+        return NULL;
+    }
+    if (PyObject_GetBuffer(buf, &view, PyBUF_SIMPLE) == -1) {
+        Py_DECREF(buf);
+        SharedBuffer_dealloc(self);
+        return NULL;
+    }
+
+    self->data = view.buf;
+    self->size = view.len;
+    PyBuffer_Release(&view);
+    Py_DECREF(buf);
+
+    return self;
+}
+
+
+static int _sharedBufferUntrack(SharedBuffer *self) {
+/*  Unregisters a SharedBuffer attached to a segment from this process's resource tracker, which would otherwise unlink
+    the segment when this process exits.  Only needed before Python 3.13, which lets attaching processes opt out of
+    tracking.  Segments created by this process are left registered, as the tracker holds a single registration for
+    each segment, which belongs to its creator.
+
+    Inputs: self - The SharedBuffer, whose header has been validated.
+
+    Outputs: 1 on success, or 0 if an error occurred.
+*/
+
+#ifndef MS_WINDOWS
+    PyObject *module,
+             *name,
+             *result;
+    long long pid;
+
+    memcpy(&pid, self->data + 16, sizeof(long long));
+    if (pid == (long long)getpid())
+        return 1;
+
+    if ((module = PyImport_ImportModule("multiprocessing.resource_tracker")) == NULL)
+        return 0;
+
+    // The tracker is given the segment's name as passed to shm_open, which is kept in _name
+    if ((name = PyObject_GetAttrString(self->shm, "_name")) == NULL) {
+        Py_DECREF(module);
+        return 0;
+    }
+
+    result = PyObject_CallMethod(module, "unregister", "Os", name, "shared_memory");
+    Py_DECREF(name);
+    Py_DECREF(module);
+    if (result == NULL)
+        return 0;
+    Py_DECREF(result);
+#endif
+
+    return 1;
+}
+
+
+SharedBuffer *_sharedBufferCreate(unsigned int rows, unsigned int columns) {
+/*  Creates a new shared memory segment large enough to hold a matrix of the given size, and writes its header.
+
+    Inputs: rows    - The number of rows in the matrix the segment will hold.
+            columns - The number of columns in the matrix the segment will hold.
+
+    Outputs: A new SharedBuffer, or NULL if an error occurred.
+*/
+
+    PyObject *type,
+             *shm;
+    SharedBuffer *self;
+    long long pid = 0;
+
+    if ((type = _sharedMemoryType()) == NULL)
+        return NULL;
+
+    shm = PyObject_CallFunction(type, "OOn", Py_None, Py_True,
+                                (Py_ssize_t)(SHARED_BUFFER_HEADER_SIZE + (size_t)rows * columns * sizeof(VECTOR_TYPE)));
+    Py_DECREF(type);
+    if (shm == NULL)
+        return NULL;
+
+    if ((self = _sharedBufferWrap(shm, 1)) == NULL)
+        return NULL;
+
+    memcpy(self->data, SHARED_BUFFER_MAGIC, 8);
+    memcpy(self->data + 8, &rows, sizeof(unsigned int));
+    memcpy(self->data + 12, &columns, sizeof(unsigned int));
+#ifndef MS_WINDOWS
+    pid = (long long)getpid();
+#endif
+    memcpy(self->data + 16, &pid, sizeof(long long));
+    self->rows = rows;
+    self->columns = columns;
+
+    return self;
+}
+
+
+SharedBuffer *_sharedBufferAttach(PyObject *name) {
+/*  Attaches to an existing shared memory segment created by _sharedBufferCreate.
+
+    Inputs: name - The name of the segment.
+
+    Outputs: A new SharedBuffer, or NULL if an error occurred.
+*/
+
+    PyObject *type,
+             *shm,
+             *args,
+             *kwargs;
+    SharedBuffer *self;
+    unsigned char untrack = 0;
+
+    if ((type = _sharedMemoryType()) == NULL)
+        return NULL;
+
+    if ((args = PyTuple_Pack(1, name)) == NULL) {
+        Py_DECREF(type);
+        return NULL;
+    }
+
+    // Segments we attach to are owned by the process which created them, so this process's resource tracker must not
+    // take ownership of them.  Python 3.13+ can be asked not to track them; before that they are unregistered instead
+    shm = NULL;
+    if ((kwargs = Py_BuildValue("{sO}", "track", Py_False)) != NULL) {
+        shm = PyObject_Call(type, args, kwargs);
+        Py_DECREF(kwargs);
+    }
+    if (shm == NULL && PyErr_ExceptionMatches(PyExc_TypeError)) {
+        PyErr_Clear();
+        shm = PyObject_Call(type, args, NULL);
+        untrack = 1;
+    }
+    Py_DECREF(args);
+    Py_DECREF(type);
+    if (shm == NULL)
+        return NULL;
+
+    if ((self = _sharedBufferWrap(shm, 0)) == NULL)
+        return NULL;
+
+    if (self->size < SHARED_BUFFER_HEADER_SIZE || memcmp(self->data, SHARED_BUFFER_MAGIC, 8) != 0) {
+        PyErr_SetString(PyExc_ValueError, "Shared memory segment was not created by Matrix.to_shared.");
+        Py_DECREF(self);
+        return NULL;
+    }
+
+    memcpy(&self->rows, self->data + 8, sizeof(unsigned int));
+    memcpy(&self->columns, self->data + 12, sizeof(unsigned int));
+
+    if (untrack && !_sharedBufferUntrack(self)) {
+        Py_DECREF(self);
+        return NULL;
+    }
+
+    if ((size_t)self->size < SHARED_BUFFER_HEADER_SIZE + (size_t)self->rows * self->columns * sizeof(VECTOR_TYPE)) {
+        PyErr_SetString(PyExc_ValueError, "Shared memory segment is too small for the matrix it describes.");
+        Py_DECREF(self);
+        return NULL;
+    }
+
+    return self;
+}
+
+
+PyObject *_sharedBufferName(SharedBuffer *self) {
+/*  Retrieves the name of the shared memory segment owned by a SharedBuffer.
+
+    Inputs: self - The SharedBuffer.
+
+    Outputs: A new reference to the name of the segment, or NULL if an error occurred.
+*/
+
+    return PyObject_GetAttrString(self->shm, "name");
+}
+
+
+void SharedBuffer_dealloc(SharedBuffer *self) {
+/*  Deallocates a SharedBuffer; unmapping its segment, and unlinking it if it was created by this process. */
+
+    PyObject *result,
+             *type,
+             *value,
+             *traceback;
+
+    // We may be freed while an exception is being raised; preserve it across the calls below
+    PyErr_Fetch(&type, &value, &traceback);
+
+    if ((result = PyObject_CallMethod(self->shm, "close", NULL)) == NULL)
+        PyErr_WriteUnraisable(self->shm);
+    Py_XDECREF(result);
+
+    if (self->creator) {
+        if ((result = PyObject_CallMethod(self->shm, "unlink", NULL)) == NULL)
+            PyErr_WriteUnraisable(self->shm);
+        Py_XDECREF(result);
+    }
+
+    PyErr_Restore(type, value, traceback);
+
+    Py_DECREF(self->shm);
+    PyObject_Del(self);
+}
@@ -0,0 +1,322 @@
+/*
+ *  Copyright (C) 2016 Warren Spencer warrenspencer27@gmail.com
+
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+static int64_t _spatialGridCoordinate(SpatialGrid *grid, VECTOR_TYPE value) {
+/*  Determines the integer coordinate of the cell of a SpatialGrid containing a coordinate.  Coordinates too large to
+    be represented share the outermost cells.
+
+    Inputs: grid  - The grid.
+            value - The coordinate; must be finite.
+
+    Outputs: The coordinate of the cell; within +/-2^61, so that the distance between two cells cannot overflow.
+*/
+
+    VECTOR_TYPE cell = floor(value / grid->cellSize);
+
+    if (cell < -2305843009213693952.0)
+        return -((int64_t)1 << 61);
+    if (cell > 2305843009213693952.0)
+        return (int64_t)1 << 61;
+
+    return (int64_t)cell;
+}
+
+
+static Py_ssize_t _spatialGridSlot(SpatialGrid *grid, int64_t *key) {
+/*  Finds the slot of a SpatialGrid's table holding a cell, or where it would be inserted.
+
+    Inputs: grid - The grid.
+            key  - The integer coordinates of the cell.
+
+    Outputs: The slot holding the cell if it is in the table, otherwise the first unused slot it probes.
+*/
+
+    uint64_t hash = 14695981039346656037ULL;
+    Py_ssize_t slot;
+    unsigned int d;
+
+    for (d = 0; d < grid->dimensions; d++)
+        hash = (hash ^ (uint64_t)key[d]) * 1099511628211ULL;
+
+    // The table size is a power of two, so mix the high bits into the low ones used to pick a slot
+    hash ^= hash >> 32;
+    hash *= 0x9E3779B97F4A7C15ULL;
+    hash ^= hash >> 29;
+
+    slot = (Py_ssize_t)(hash & (uint64_t)(grid->tableSize - 1));
+    while (grid->table[slot].used &&
+           memcmp(grid->keys + (size_t)slot * grid->dimensions, key, sizeof(int64_t) * grid->dimensions) != 0)
+        slot = (slot + 1) & (grid->tableSize - 1);
+
+    return slot;
+}
+
+
+static unsigned char _spatialGridRehash(SpatialGrid *grid, Py_ssize_t size) {
+/*  Moves the cells of a SpatialGrid into a new table, discarding those which have been emptied.
+
+    Inputs: grid - The grid.
+            size - The number of slots in the new table; a power of two at least twice the number of occupied cells.
+
+    Outputs: 1 if successful, otherwise 0 with a MemoryError set.
+*/
+
+    SpatialGridCell *table = grid->table,
+                    *cell;
+    int64_t *keys = grid->keys;
+    Py_ssize_t oldSize = grid->tableSize,
+               slot,
+               i,
+               j;
+
+    grid->table = PyMem_New(SpatialGridCell, size);
+    grid->keys = PyMem_New(int64_t, (size_t)size * grid->dimensions);
+    if (grid->table == NULL || grid->keys == NULL) {
+        PyMem_Free(grid->table);
+        PyMem_Free(grid->keys);
+        grid->table = table;
+        grid->keys = keys;
+        PyErr_NoMemory();
+        return 0;
+    }
+
+    memset(grid->table, 0, sizeof(SpatialGridCell) * (size_t)size);
+    grid->tableSize = size;
+    grid->tableUsed = 0;
+
+    for (i = 0; i < oldSize; i++) {
+        cell = table + i;
+        if (!cell->used)
+            continue;
+        if (cell->count == 0) {
+            PyMem_Free(cell->members);
+            continue;
+        }
+
+        slot = _spatialGridSlot(grid, keys + (size_t)i * grid->dimensions);
+        grid->table[slot] = *cell;
+        memcpy(grid->keys + (size_t)slot * grid->dimensions, keys + (size_t)i * grid->dimensions,
+               sizeof(int64_t) * grid->dimensions);
+        grid->tableUsed++;
+        for (j = 0; j < cell->count; j++)
+            grid->cells[cell->members[j]] = slot;
+    }
+
+    PyMem_Free(table);
+    PyMem_Free(keys);
+    return 1;
+}
+
+
+static Py_ssize_t _spatialGridCell(SpatialGrid *grid, int64_t *key) {
+/*  Finds a cell of a SpatialGrid, adding it to the table if it is not already there.  The table is rehashed whenever it
+    becomes half full, which also clears out cells points have since left.
+
+    Inputs: grid - The grid.
+            key  - The integer coordinates of the cell.
+
+    Outputs: The slot of the cell, or -1 with a MemoryError set.
+*/
+
+    Py_ssize_t slot = _spatialGridSlot(grid, key),
+               occupied = 0,
+               size,
+               i;
+    SpatialGridCell *cell;
+
+    if (grid->table[slot].used)
+        return slot;
+
+    if ((grid->tableUsed + 1) * 2 > grid->tableSize) {
+        for (i = 0; i < grid->tableSize; i++)
+            occupied += grid->table[i].count > 0;
+        for (size = grid->tableSize; (occupied + 1) * 4 > size; size *= 2);
+
+        if (!_spatialGridRehash(grid, size))
+            return -1;
+        slot = _spatialGridSlot(grid, key);
+    }
+
+    cell = grid->table + slot;
+    cell->used = 1;
+    cell->members = NULL;
+    cell->count = cell->capacity = 0;
+    memcpy(grid->keys + (size_t)slot * grid->dimensions, key, sizeof(int64_t) * grid->dimensions);
+    grid->tableUsed++;
+
+    return slot;
+}
+
+
+static unsigned char _spatialGridReserve(SpatialGrid *grid, Py_ssize_t id) {
+/*  Ensures a SpatialGrid has room to store a point under an id.
+
+    Inputs: grid - The grid.
+            id   - The id; must not be negative.
+
+    Outputs: 1 if successful, otherwise 0 with a MemoryError set.
+*/
+
+    Py_ssize_t capacity,
+               i;
+    VECTOR_TYPE *points;
+    Py_ssize_t *indices;
+
+    if (id < grid->capacity)
+        return 1;
+
+    capacity = grid->capacity * 2 > id + 1 ? grid->capacity * 2 : id + 1;
+    capacity = capacity > 16 ? capacity : 16;
+    if (capacity > PY_SSIZE_T_MAX / (Py_ssize_t)(sizeof(VECTOR_TYPE) * grid->dimensions)) {
+        PyErr_NoMemory();
+        return 0;
+    }
+
+    // Each array is replaced as soon as it is grown, so that a failure part way through leaves them all usable
+    if ((points = PyMem_Realloc(grid->points, sizeof(VECTOR_TYPE) * (size_t)capacity * grid->dimensions)) == NULL) {
+        PyErr_NoMemory();
+        return 0;
+    }
+    grid->points = points;
+
+    if ((indices = PyMem_Realloc(grid->positions, sizeof(Py_ssize_t) * (size_t)capacity)) == NULL) {
+        PyErr_NoMemory();
+        return 0;
+    }
+    grid->positions = indices;
+
+    if ((indices = PyMem_Realloc(grid->cells, sizeof(Py_ssize_t) * (size_t)capacity)) == NULL) {
+        PyErr_NoMemory();
+        return 0;
+    }
+    grid->cells = indices;
+
+    for (i = grid->capacity; i < capacity; i++)
+        grid->cells[i] = -1;
+    grid->capacity = capacity;
+
+    return 1;
+}
+
+
+PyObject *spatialGridNew(PyTypeObject *type, PyObject *args, PyObject *kwds) {
+/*  Creates an empty SpatialGrid.
+
+    Inputs: type - The SpatialGrid type.
+            args - A tuple containing the width of each cell of the grid along every axis, and the number of
+                   dimensions of the points it will hold.
+            kwds - Optionally contains cell_size & dim instead.
+
+    Outputs: A new SpatialGrid, or NULL if an error occurred.
+*/
+
+    static char *kwlist[] = {"cell_size", "dim", NULL};
+    SpatialGrid *self;
+    VECTOR_TYPE cellSize;
+    unsigned int dimensions;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "dI:SpatialGrid", kwlist, &cellSize, &dimensions))
+        return NULL;
+
+    if (!(cellSize > 0) || !Py_IS_FINITE(cellSize)) {
+        PyErr_SetString(PyExc_ValueError, "SpatialGrid() requires a positive, finite cell_size.");
+        return NULL;
+    }
+    if (dimensions == 0) {
+        PyErr_SetString(PyExc_ValueError, "SpatialGrid() requires points of at least one dimension.");
+        return NULL;
+    }
+
+    if ((self = PyObject_New(SpatialGrid, type)) == NULL)
+        return NULL;
+
+    self->cellSize = cellSize;
+    self->dimensions = dimensions;
+    self->count = self->capacity = 0;
+    self->points = NULL;
+    self->cells = self->positions = NULL;
+    self->tableSize = SPATIAL_GRID_MIN_TABLE;
+    self->tableUsed = 0;
+    self->table = PyMem_New(SpatialGridCell, SPATIAL_GRID_MIN_TABLE);
+    self->keys = PyMem_New(int64_t, (size_t)SPATIAL_GRID_MIN_TABLE * dimensions);
+    self->scratch = PyMem_New(int64_t, (size_t)dimensions * 3);
+
+    if (self->table != NULL)
+        memset(self->table, 0, sizeof(SpatialGridCell) * SPATIAL_GRID_MIN_TABLE);
+
+    if (self->table == NULL || self->keys == NULL || self->scratch == NULL) {
+        Py_DECREF(self);
+        return PyErr_NoMemory();
+    }
+
+    return (PyObject *)self;
+}
+
+
+void spatialGridDeInit(SpatialGrid *self) {
+/*  Frees a SpatialGrid.
+
+    Inputs: self - The grid to free.
+*/
+
+    Py_ssize_t i;
+
+    for (i = 0; self->table != NULL && i < self->tableSize; i++)
+        if (self->table[i].used)
+            PyMem_Free(self->table[i].members);
+
+    PyMem_Free(self->table);
+    PyMem_Free(self->keys);
+    PyMem_Free(self->scratch);
+    PyMem_Free(self->points);
+    PyMem_Free(self->cells);
+    PyMem_Free(self->positions);
+    PyObject_Del(self);
+}
+
+
+Py_ssize_t spatialGridLength(SpatialGrid *self) {
+/*  Returns the number of points in a SpatialGrid.
+
+    Inputs: self - The grid.
+
+    Outputs: The number of ids currently in self.
+*/
+
+    return self->count;
+}
+
+
+int spatialGridContains(SpatialGrid *self, PyObject *id) {
+/*  Determines whether a SpatialGrid holds a point under an id.
+
+    Inputs: self - The grid.
+            id   - The id to look for.
+
+    Outputs: 1 if id is an int naming a point in self, otherwise 0.
+*/
+
+    Py_ssize_t value;
+
+    if (!PyIndex_Check(id))
+        return 0;
+
+    if ((value = PyNumber_AsSsize_t(id, NULL)) == -1 && PyErr_Occurred())
+        return -1;
+
+    return value >= 0 && value < self->capacity && self->cells[value] != -1;
+}
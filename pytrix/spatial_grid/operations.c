@@ -0,0 +1,462 @@
+/*
+ *  Copyright (C) 2016 Warren Spencer warrenspencer27@gmail.com
+
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+static unsigned char _spatialGridParseId(const char *name, PyObject *arg, Py_ssize_t *id) {
+/*  Parses an id passed to a SpatialGrid.
+
+    Inputs: name - The name of the method the id was passed to, for error messages.
+            arg  - The object passed as the id.
+            id   - Set to the id.
+
+    Outputs: 1 if arg is a non-negative int, otherwise 0 with an error set.
+*/
+
+    long value;
+
+    if (!_parseLongArg(arg, &value))
+        return 0;
+
+    if (value < 0) {
+        PyErr_Format(PyExc_ValueError, "%.200s() requires non-negative ids, not %ld", name, value);
+        return 0;
+    }
+
+    *id = (Py_ssize_t)value;
+    return 1;
+}
+
+
+static VECTOR_TYPE *_spatialGridPoint(SpatialGrid *grid, const char *name, PyObject *point) {
+/*  Validates a Point passed to a SpatialGrid.
+
+    Inputs: grid  - The grid.
+            name  - The name of the method the Point was passed to, for error messages.
+            point - The object passed as the Point.
+
+    Outputs: The coordinates of the point, or NULL with an error set if it is not a finite Point of the grid's
+             dimensions.
+*/
+
+    unsigned int d;
+
+    if (!Point_Check(point)) {
+        PyErr_Format(PyExc_TypeError, "%.200s() requires a Point, not: \"%.400s\"", name, Py_TYPE(point)->tp_name);
+        return NULL;
+    }
+
+    if (((Point *)point)->dimensions != grid->dimensions) {
+        PyErr_Format(PyExc_ValueError, "%.200s() requires a Point of %u dimensions, not %u", name, grid->dimensions,
+                     ((Point *)point)->dimensions);
+        return NULL;
+    }
+
+    for (d = 0; d < grid->dimensions; d++) {
+        if (!Py_IS_FINITE(Point_GetValue(((Point *)point), d))) {
+            PyErr_Format(PyExc_ValueError, "%.200s() requires a Point with finite coordinates", name);
+            return NULL;
+        }
+    }
+
+    return ((Point *)point)->data;
+}
+
+
+static void _spatialGridDetach(SpatialGrid *grid, Py_ssize_t id) {
+/*  Removes a point from the cell of a SpatialGrid holding it, by moving the cell's last member into its place.
+
+    Inputs: grid - The grid.
+            id   - The id of the point; must be in the grid.
+*/
+
+    SpatialGridCell *cell = grid->table + grid->cells[id];
+    Py_ssize_t last = cell->members[--cell->count];
+
+    cell->members[grid->positions[id]] = last;
+    grid->positions[last] = grid->positions[id];
+    grid->cells[id] = -1;
+}
+
+
+static unsigned char _spatialGridPlace(SpatialGrid *grid, Py_ssize_t id, VECTOR_TYPE *point, Py_ssize_t stride) {
+/*  Stores a point in a SpatialGrid under an id, moving it if the id is already in use.  Points which stay within the
+    same cell only have their coordinates updated.
+
+    Inputs: grid   - The grid.
+            id     - The id to store the point under.
+            point  - The coordinates of the point; must be finite.
+            stride - The distance between successive coordinates of point.
+
+    Outputs: 1 if successful, otherwise 0 with a MemoryError set; the grid is unchanged.
+*/
+
+    int64_t *key = grid->scratch;
+    SpatialGridCell *cell;
+    Py_ssize_t *members,
+               slot;
+    unsigned int d;
+
+    if (!_spatialGridReserve(grid, id))
+        return 0;
+
+    for (d = 0; d < grid->dimensions; d++)
+        key[d] = _spatialGridCoordinate(grid, point[d * stride]);
+
+    slot = grid->cells[id];
+    if (slot == -1 ||
+        memcmp(grid->keys + (size_t)slot * grid->dimensions, key, sizeof(int64_t) * grid->dimensions) != 0) {
+        if ((slot = _spatialGridCell(grid, key)) == -1)
+            return 0;
+
+        cell = grid->table + slot;
+        if (cell->count == cell->capacity) {
+            if ((members = PyMem_Realloc(cell->members, sizeof(Py_ssize_t) * (size_t)(cell->capacity * 2 + 4))) ==
+                NULL) {
+                PyErr_NoMemory();
+                return 0;
+            }
+            cell->members = members;
+            cell->capacity = cell->capacity * 2 + 4;
+        }
+
+        if (grid->cells[id] == -1)
+            grid->count++;
+        else
+            _spatialGridDetach(grid, id);
+
+        grid->positions[id] = cell->count;
+        grid->cells[id] = slot;
+        cell->members[cell->count++] = id;
+    }
+
+    for (d = 0; d < grid->dimensions; d++)
+        SpatialGrid_GetPoint(grid, id)[d] = point[d * stride];
+
+    return 1;
+}
+
+
+static unsigned char _spatialGridVisit(SpatialGrid *grid, Py_ssize_t slot, VECTOR_TYPE *query, VECTOR_TYPE radius,
+                                       KDTreeMatches *matches) {
+/*  Matches the points of a cell of a SpatialGrid which lie within a distance of a query point.
+
+    Inputs: grid    - The grid.
+            slot    - The slot of the cell.
+            query   - The coordinates of the query point.
+            radius  - The squared distance to search within.
+            matches - The ids of the points matched so far.
+
+    Outputs: 1 if successful, otherwise 0 with a MemoryError set.
+*/
+
+    SpatialGridCell *cell = grid->table + slot;
+    VECTOR_TYPE *point,
+                distance,
+                difference;
+    Py_ssize_t i;
+    unsigned int d;
+
+    for (i = 0; i < cell->count; i++) {
+        point = SpatialGrid_GetPoint(grid, cell->members[i]);
+        for (distance = 0, d = 0; d < grid->dimensions; d++) {
+            difference = point[d] - query[d];
+            distance += difference * difference;
+        }
+
+        if (distance <= radius && !_kdTreeMatch(matches, cell->members[i]))
+            return 0;
+    }
+
+    return 1;
+}
+
+
+PyObject *spatialGridInsert(SpatialGrid *self, FASTCALL_PARAMETERS) {
+/*  Adds a point to a SpatialGrid.
+
+    Inputs: self  - The grid.
+            args  - The id to store the point under; a non-negative int not already in the grid, followed by the Point.
+            nargs - The number of arguments in args.
+
+    Outputs: None, or NULL if an error occurred.
+*/
+
+    FASTCALL_UNPACK_ARGS
+    VECTOR_TYPE *point;
+    Py_ssize_t id;
+
+    if (!_assertArgCount("insert", nargs, 2))
+        return NULL;
+
+    if (!_spatialGridParseId("insert", args[0], &id) || (point = _spatialGridPoint(self, "insert", args[1])) == NULL)
+        return NULL;
+
+    if (id < self->capacity && self->cells[id] != -1) {
+        PyErr_Format(PyExc_ValueError, "insert() id %zd is already in the grid; use move()", id);
+        return NULL;
+    }
+
+    if (!_spatialGridPlace(self, id, point, 1))
+        return NULL;
+
+    Py_RETURN_NONE;
+}
+
+
+PyObject *spatialGridMove(SpatialGrid *self, FASTCALL_PARAMETERS) {
+/*  Moves a point of a SpatialGrid.
+
+    Inputs: self  - The grid.
+            args  - The id of a point in the grid, followed by its new position as a Point.
+            nargs - The number of arguments in args.
+
+    Outputs: None, or NULL if an error occurred.
+*/
+
+    FASTCALL_UNPACK_ARGS
+    VECTOR_TYPE *point;
+    Py_ssize_t id;
+
+    if (!_assertArgCount("move", nargs, 2))
+        return NULL;
+
+    if (!_spatialGridParseId("move", args[0], &id) || (point = _spatialGridPoint(self, "move", args[1])) == NULL)
+        return NULL;
+
+    if (id >= self->capacity || self->cells[id] == -1) {
+        PyErr_SetObject(PyExc_KeyError, args[0]);
+        return NULL;
+    }
+
+    if (!_spatialGridPlace(self, id, point, 1))
+        return NULL;
+
+    Py_RETURN_NONE;
+}
+
+
+PyObject *spatialGridRemove(SpatialGrid *self, FASTCALL_PARAMETERS) {
+/*  Removes a point from a SpatialGrid.
+
+    Inputs: self  - The grid.
+            args  - The id of a point in the grid.
+            nargs - The number of arguments in args.
+
+    Outputs: None, or NULL if an error occurred.
+*/
+
+    FASTCALL_UNPACK_ARGS
+    Py_ssize_t id;
+
+    if (!_assertArgCount("remove", nargs, 1))
+        return NULL;
+
+    if (!_spatialGridParseId("remove", args[0], &id))
+        return NULL;
+
+    if (id >= self->capacity || self->cells[id] == -1) {
+        PyErr_SetObject(PyExc_KeyError, args[0]);
+        return NULL;
+    }
+
+    _spatialGridDetach(self, id);
+    self->count--;
+
+    Py_RETURN_NONE;
+}
+
+
+PyObject *spatialGridUpdate(SpatialGrid *self, FASTCALL_KEYWORDS_PARAMETERS) {
+/*  Stores a batch of points in a SpatialGrid, inserting those whose ids are not yet in the grid and moving the rest.
+    Every argument is validated before the grid is changed.
+
+    Inputs: self    - The grid.
+            args    - The positions of the points; a buffer of native doubles holding the coordinates of each point
+                      one after another, a PointCloud, or a sequence of Points.  Optionally followed by ids, a
+                      sequence of the id of each point; by default the points are given the ids 0, 1, 2...
+            nargs   - The number of positional arguments in args.
+            kwnames - The names of any keyword arguments passed.
+
+    Outputs: None, or NULL if an error occurred.
+*/
+
+    FASTCALL_KEYWORDS_UNPACK_ARGS
+    PyObject *idsArg = Py_None,
+             *sequence = NULL,
+             *result = NULL;
+    Py_buffer view;
+    VECTOR_TYPE *data;
+    Py_ssize_t *ids = NULL,
+               count,
+               pointStride,
+               componentStride,
+               i;
+    unsigned int dimensions;
+    unsigned char haveView = 0,
+                  owned = 0;
+
+    if (!_parseOptionalArg("update", "ids", 1, args, nargs, kwnames, &idsArg))
+        return NULL;
+
+    if (PyObject_CheckBuffer(args[0])) {
+        if (!_getVectorTypeBuffer(args[0], -1, &view))
+            return NULL;
+        haveView = 1;
+
+        data = (VECTOR_TYPE *)view.buf;
+        count = view.len / sizeof(VECTOR_TYPE);
+        if (count % self->dimensions != 0) {
+            PyErr_Format(PyExc_ValueError, "Buffer of %zd values does not hold a whole number of %u dimensional "
+                         "points.", count, self->dimensions);
+            goto cleanup;
+        }
+        count /= self->dimensions;
+        pointStride = self->dimensions;
+        componentStride = 1;
+
+    } else {
+        if (!_pointSetComponents("update", args[0], &data, &count, &dimensions, &owned))
+            return NULL;
+
+        if (count && dimensions != self->dimensions) {
+            PyErr_Format(PyExc_ValueError, "update() requires Points of %u dimensions, not %u", self->dimensions,
+                         dimensions);
+            goto cleanup;
+        }
+        pointStride = 1;
+        componentStride = count;
+    }
+
+    for (i = 0; i < count * self->dimensions; i++) {
+        if (!Py_IS_FINITE(data[i])) {
+            PyErr_SetString(PyExc_ValueError, "update() requires finite coordinates");
+            goto cleanup;
+        }
+    }
+
+    if (idsArg != Py_None) {
+        if ((sequence = PySequence_Fast(idsArg, "update() requires a sequence of ids.")) == NULL)
+            goto cleanup;
+
+        if (PySequence_Fast_GET_SIZE(sequence) != count) {
+            PyErr_Format(PyExc_ValueError, "update() was given %zd ids for %zd points",
+                         PySequence_Fast_GET_SIZE(sequence), count);
+            goto cleanup;
+        }
+
+        if ((ids = PyMem_New(Py_ssize_t, count + 1)) == NULL) {
+            PyErr_NoMemory();
+            goto cleanup;
+        }
+        for (i = 0; i < count; i++)
+            if (!_spatialGridParseId("update", PySequence_Fast_GET_ITEM(sequence, i), &ids[i]))
+                goto cleanup;
+    }
+
+    for (i = 0; i < count; i++)
+        if (!_spatialGridPlace(self, ids != NULL ? ids[i] : i, data + i * pointStride, componentStride))
+            goto cleanup;
+
+    result = Py_None;
+    Py_INCREF(result);
+
+cleanup:
+    if (haveView)
+        PyBuffer_Release(&view);
+    if (owned)
+        PyMem_Free(data);
+    Py_XDECREF(sequence);
+    PyMem_Free(ids);
+
+    return result;
+}
+
+
+PyObject *spatialGridQueryRadius(SpatialGrid *self, FASTCALL_PARAMETERS) {
+/*  Finds the points of a SpatialGrid within a distance of a query point.  Only the cells overlapping the bounding box
+    of the query's sphere are searched; or, if there are more of those than there are occupied cells, each occupied
+    cell is checked against the box instead.
+
+    Inputs: self  - The grid.
+            args  - The query Point, followed by the distance to search within.
+            nargs - The number of arguments in args.
+
+    Outputs: A list of the ids of the points no farther than the distance from the query point, in ascending order, or
+             NULL if an error occurred.
+*/
+
+    FASTCALL_UNPACK_ARGS
+    KDTreeMatches matches;
+    VECTOR_TYPE *query,
+                radius,
+                cells = 1;
+    int64_t *key = self->scratch,
+            *lower = self->scratch + self->dimensions,
+            *upper = self->scratch + self->dimensions * 2,
+            *cell;
+    Py_ssize_t slot;
+    unsigned int d;
+
+    if (!_assertArgCount("query_radius", nargs, 2))
+        return NULL;
+
+    if ((query = _spatialGridPoint(self, "query_radius", args[0])) == NULL || !_parseVectorTypeArg(args[1], &radius))
+        return NULL;
+
+    matches.indices = NULL;
+    matches.count = matches.capacity = 0;
+    if (!(radius >= 0) || self->count == 0)
+        return _kdTreeMatchesToList(&matches);
+
+    for (d = 0; d < self->dimensions; d++) {
+        lower[d] = _spatialGridCoordinate(self, query[d] - radius);
+        upper[d] = _spatialGridCoordinate(self, query[d] + radius);
+        cells *= (VECTOR_TYPE)upper[d] - (VECTOR_TYPE)lower[d] + 1;
+    }
+
+    if (cells > self->tableUsed) {
+        for (slot = 0; slot < self->tableSize; slot++) {
+            if (!self->table[slot].used || self->table[slot].count == 0)
+                continue;
+
+            cell = self->keys + (size_t)slot * self->dimensions;
+            for (d = 0; d < self->dimensions && cell[d] >= lower[d] && cell[d] <= upper[d]; d++);
+            if (d == self->dimensions && !_spatialGridVisit(self, slot, query, radius * radius, &matches))
+                goto error;
+        }
+
+    } else {
+        // Step through each cell of the box in turn, like an odometer
+        memcpy(key, lower, sizeof(int64_t) * self->dimensions);
+        while (1) {
+            slot = _spatialGridSlot(self, key);
+            if (self->table[slot].used && !_spatialGridVisit(self, slot, query, radius * radius, &matches))
+                goto error;
+
+            for (d = 0; d < self->dimensions && key[d] == upper[d]; d++)
+                key[d] = lower[d];
+            if (d == self->dimensions)
+                break;
+            key[d]++;
+        }
+    }
+
+    return _kdTreeMatchesToList(&matches);
+
+error:
+    PyMem_Free(matches.indices);
+    return NULL;
+}
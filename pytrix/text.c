@@ -0,0 +1,433 @@
+/*
+ *  Copyright (C) 2016 Warren Spencer warrenspencer27@gmail.com
+
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/* Functions for parsing and formatting delimited text containing VECTOR_TYPEs. */
+
+// Number of bytes read from a file at a time while parsing it
+#define TEXT_CHUNK_SIZE (1 << 20)
+// Longest string produced by PyOS_double_to_string when formatting a double using repr's format
+#define TEXT_MAX_DOUBLE_LENGTH 32
+// Values with mantissas no larger than this, and exponents no larger in magnitude than TEXT_MAX_EXACT_POW10 can be
+// computed exactly using a single floating point multiplication or division
+#define TEXT_MAX_EXACT_MANTISSA (1ULL << 53)
+#define TEXT_MAX_EXACT_POW10 22
+
+typedef struct {
+    // The character separating values on a line; or '\0' if values are separated by runs of whitespace
+    char delimiter;
+    // A bytes object accumulating the parsed values, row by row
+    PyObject *values;
+    size_t count;
+    size_t capacity;
+    unsigned int rows;
+    unsigned int columns;
+    // The number of the line currently being parsed; for error messages
+    size_t line;
+} TextParser;
+
+unsigned char _textParserInit(TextParser *, char);
+void _textParserFree(TextParser *);
+Py_ssize_t _textParse(TextParser *, const char *, size_t, unsigned char);
+unsigned char _textParseFile(TextParser *, PyObject *);
+char *_formatVectorTypeArray(char *, VECTOR_TYPE *, unsigned int, const char *, size_t);
+
+
+unsigned char _textParserInit(TextParser *parser, char delimiter) {
+/*  Initializes a TextParser.
+
+    Inputs: parser    - The parser to initialize.
+            delimiter - The character separating values on a line, or '\0' to separate them by whitespace.
+
+    Outputs: 1 if the parser was successfully initialized, otherwise 0.
+*/
+
+    parser->delimiter = delimiter;
+    parser->count = 0;
+    parser->capacity = 1024;
+    parser->rows = 0;
+    parser->columns = 0;
+    parser->line = 0;
+
+    if ((parser->values = PyBytes_FromStringAndSize(NULL, parser->capacity * sizeof(VECTOR_TYPE))) == NULL)
+        return 0;
+
+    return 1;
+}
+
+
+void _textParserFree(TextParser *parser) {
+/*  Releases the resources held by a TextParser.
+
+    Inputs: parser - The parser to free.
+*/
+
+    Py_CLEAR(parser->values);
+}
+
+
+static unsigned char _textIsSpace(TextParser *parser, char c) {
+/*  Determines whether a character is insignificant whitespace surrounding a value.
+
+    Inputs: parser - The parser; whitespace characters used as delimiters are significant.
+            c      - The character to test.
+
+    Outputs: 1 if c is whitespace, otherwise 0.
+*/
+
+    return (c == ' ' || c == '\t' || c == '\r') && c != parser->delimiter;
+}
+
+
+static unsigned char _textFastParseDouble(const char *s, const char *end, VECTOR_TYPE *out) {
+/*  Parses a decimal floating point number without any intermediate allocations, for the common case of numbers
+    having at most 19 significant digits and which can be computed exactly (Clinger's fast path).
+
+    Inputs: s   - The first character of the number.
+            end - One past the last character of the number.
+            out - Set to the parsed value.
+
+    Outputs: 1 if the number was parsed, or 0 if it must be parsed by the slower, general purpose parser.
+*/
+
+    static const double powers[TEXT_MAX_EXACT_POW10 + 1] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+    uint64_t mantissa = 0;
+    int exponent = 0,
+        exponentValue = 0,
+        digits = 0;
+    unsigned char negative = 0,
+                  exponentNegative = 0,
+                  sawDigit = 0;
+    double value;
+
+    if (s < end && (*s == '-' || *s == '+'))
+        negative = (*s++ == '-');
+
+    for (; s < end && *s >= '0' && *s <= '9'; s++) {
+        if (digits == 19)
+            return 0;
+        mantissa = mantissa * 10 + (*s - '0');
+        digits += (mantissa != 0);
+        sawDigit = 1;
+    }
+
+    if (s < end && *s == '.') {
+        for (s++; s < end && *s >= '0' && *s <= '9'; s++) {
+            if (digits == 19)
+                return 0;
+            mantissa = mantissa * 10 + (*s - '0');
+            digits += (mantissa != 0);
+            exponent--;
+            sawDigit = 1;
+        }
+    }
+
+    if (!sawDigit)
+        return 0;
+
+    if (s < end && (*s == 'e' || *s == 'E')) {
+        s++;
+        if (s < end && (*s == '-' || *s == '+'))
+            exponentNegative = (*s++ == '-');
+        if (s == end || *s < '0' || *s > '9')
+            return 0;
+
+        for (; s < end && *s >= '0' && *s <= '9'; s++)
+            if (exponentValue < 10000)
+                exponentValue = exponentValue * 10 + (*s - '0');
+
+        exponent += exponentNegative ? -exponentValue : exponentValue;
+    }
+
+    if (s != end || mantissa > TEXT_MAX_EXACT_MANTISSA)
+        return 0;
+
+    value = (double)mantissa;
+    if (mantissa != 0) {
+        if (exponent < -TEXT_MAX_EXACT_POW10 || exponent > TEXT_MAX_EXACT_POW10)
+            return 0;
+
+        if (exponent < 0)
+            value /= powers[-exponent];
+        else
+            value *= powers[exponent];
+    }
+
+    *out = negative ? -value : value;
+    return 1;
+}
+
+
+static unsigned char _textParseValue(TextParser *parser, const char *s, const char *end) {
+/*  Parses a single value and appends it to the values parsed so far.
+
+    Inputs: parser - The parser.
+            s      - The first character of the value.
+            end    - One past the last character of the value.
+
+    Outputs: 1 if the value was parsed, otherwise 0.
+*/
+
+    char small[64],
+         *buffer;
+    VECTOR_TYPE value;
+    size_t length = end - s;
+
+    if (length == 0) {
+        PyErr_Format(PyExc_ValueError, "Empty value on line %zu.", parser->line);
+        return 0;
+    }
+
+    if (!_textFastParseDouble(s, end, &value)) {
+        // Fall back to Python's own parser, which handles every other case; including inf and nan
+        if (length < sizeof(small)) {
+            buffer = small;
+        } else if ((buffer = PyMem_Malloc(length + 1)) == NULL) {
+            PyErr_NoMemory();
+            return 0;
+        }
+
+        memcpy(buffer, s, length);
+        buffer[length] = '\0';
+
+        value = PyOS_string_to_double(buffer, NULL, NULL);
+        if (value == -1.0 && PyErr_Occurred()) {
+            PyErr_Clear();
+            PyErr_Format(PyExc_ValueError, "Could not convert '%.64s' to a float on line %zu.", buffer, parser->line);
+        }
+
+        if (buffer != small)
+            PyMem_Free(buffer);
+        if (PyErr_Occurred())
+            return 0;
+    }
+
+    if (parser->count == parser->capacity) {
+        parser->capacity *= 2;
+        if (_PyBytes_Resize(&parser->values, parser->capacity * sizeof(VECTOR_TYPE)) == -1)
+            return 0;
+    }
+
+    ((VECTOR_TYPE *)PyBytes_AS_STRING(parser->values))[parser->count++] = value;
+    return 1;
+}
+
+
+static unsigned char _textParseLine(TextParser *parser, const char *s, const char *end) {
+/*  Parses a line of values into a row.  Blank lines are ignored.
+
+    Inputs: parser - The parser.
+            s      - The first character of the line.
+            end    - One past the last character of the line, excluding its newline.
+
+    Outputs: 1 if the line was parsed, otherwise 0.
+*/
+
+    const char *valueEnd,
+               *next;
+    unsigned int columns = 0;
+
+    parser->line++;
+
+    while (s < end && _textIsSpace(parser, *s))
+        s++;
+    while (end > s && _textIsSpace(parser, end[-1]))
+        end--;
+
+    if (s == end)
+        return 1;
+
+    while (1) {
+        if (parser->delimiter) {
+            if ((next = memchr(s, parser->delimiter, end - s)) == NULL)
+                next = end;
+            valueEnd = next;
+            while (valueEnd > s && _textIsSpace(parser, valueEnd[-1]))
+                valueEnd--;
+        } else {
+            for (next = s; next < end && !_textIsSpace(parser, *next); next++);
+            valueEnd = next;
+        }
+
+        if (!_textParseValue(parser, s, valueEnd))
+            return 0;
+        columns++;
+
+        if (next == end)
+            break;
+
+        for (s = next + 1; s < end && _textIsSpace(parser, *s); s++);
+        if (parser->delimiter && s == end) {
+            PyErr_Format(PyExc_ValueError, "Empty value on line %zu.", parser->line);
+            return 0;
+        }
+    }
+
+    if (parser->rows == 0) {
+        parser->columns = columns;
+    } else if (columns != parser->columns) {
+        PyErr_Format(PyExc_ValueError, "Line %zu has %u values; expected %u.", parser->line, columns,
+                     parser->columns);
+        return 0;
+    }
+
+    if (parser->rows == UINT_MAX) {
+        PyErr_SetString(PyExc_ValueError, "Too many rows.");
+        return 0;
+    }
+
+    parser->rows++;
+    return 1;
+}
+
+
+Py_ssize_t _textParse(TextParser *parser, const char *data, size_t length, unsigned char final) {
+/*  Parses each complete line in a block of text.
+
+    Inputs: parser - The parser.
+            data   - The text to parse.
+            length - The number of bytes in data.
+            final  - Whether or not this is the last block of text; if so, a trailing line without a newline is
+                     parsed as well.
+
+    Outputs: The number of bytes of data consumed; any remaining bytes form an incomplete line which should be passed
+             again along with the next block.  -1 if an error occurred.
+*/
+
+    const char *newline;
+    size_t position = 0;
+
+    while ((newline = memchr(data + position, '\n', length - position)) != NULL) {
+        if (!_textParseLine(parser, data + position, newline))
+            return -1;
+
+        position = newline - data + 1;
+    }
+
+    if (final && position < length) {
+        if (!_textParseLine(parser, data + position, data + length))
+            return -1;
+
+        position = length;
+    }
+
+    return (Py_ssize_t)position;
+}
+
+
+unsigned char _textParseFile(TextParser *parser, PyObject *path) {
+/*  Parses a file, streaming it in TEXT_CHUNK_SIZE blocks.
+
+    Inputs: parser - The parser.
+            path   - The path of the file to parse.
+
+    Outputs: 1 if the file was parsed, otherwise 0.
+*/
+
+    FILE *f;
+    char *buffer,
+         *grown;
+    size_t capacity = TEXT_CHUNK_SIZE,
+           filled = 0,
+           read;
+    Py_ssize_t consumed;
+    unsigned char final = 0;
+
+    if ((f = _openPath(path, "rb")) == NULL)
+        return 0;
+
+    if ((buffer = PyMem_Malloc(capacity)) == NULL) {
+        fclose(f);
+        PyErr_NoMemory();
+        return 0;
+    }
+
+    do {
+        // If a single line fills the entire buffer, grow it so that the rest of the line can be read
+        if (filled == capacity) {
+            if ((grown = PyMem_Realloc(buffer, capacity * 2)) == NULL) {
+                PyErr_NoMemory();
+                break;
+            }
+
+            buffer = grown;
+            capacity *= 2;
+        }
+
+        Py_BEGIN_ALLOW_THREADS
+        read = fread(buffer + filled, 1, capacity - filled, f);
+        Py_END_ALLOW_THREADS
+
+        if (read == 0 && ferror(f)) {
+            PyErr_SetFromErrno(PyExc_IOError);
+            break;
+        }
+
+        filled += read;
+        final = (read == 0);
+
+        if ((consumed = _textParse(parser, buffer, filled, final)) == -1)
+            break;
+
+        memmove(buffer, buffer + consumed, filled - consumed);
+        filled -= consumed;
+    } while (!final);
+
+    PyMem_Free(buffer);
+    fclose(f);
+
+    return !PyErr_Occurred();
+}
+
+
+char *_formatVectorTypeArray(char *dst, VECTOR_TYPE *values, unsigned int count, const char *separator,
+                             size_t separatorLength) {
+/*  Formats an array of VECTOR_TYPEs as text, in the same format as Python's repr of a float.
+
+    Inputs: dst             - The buffer to write to.  Must have room for
+                              count * (TEXT_MAX_DOUBLE_LENGTH + separatorLength) bytes.
+            values          - The values to format.
+            count           - The number of values in values.
+            separator       - The string to write between each value.
+            separatorLength - The length of separator.
+
+    Outputs: A pointer to one past the last byte written, or NULL if an error occurred.
+*/
+
+    unsigned int i;
+    char *formatted;
+    size_t length;
+
+    for (i = 0; i < count; i++) {
+        if (i) {
+            memcpy(dst, separator, separatorLength);
+            dst += separatorLength;
+        }
+
+        if ((formatted = PyOS_double_to_string(values[i], 'r', 0, Py_DTSF_ADD_DOT_0, NULL)) == NULL)
+            return NULL;
+
+        length = strlen(formatted);
+        memcpy(dst, formatted, length);
+        dst += length;
+        PyMem_Free(formatted);
+    }
+
+    return dst;
+}
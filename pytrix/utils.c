@@ -17,24 +17,179 @@
 
 VECTOR_TYPE PyNumber_AS_VECTOR_TYPE(PyObject *);
 PyObject *PyNumber_FROM_VECTOR_TYPE(VECTOR_TYPE);
+PyObject *_vectorTypeArrayToList(VECTOR_TYPE *, unsigned int);
+PyObject *_vectorTypeArrayToTuple(VECTOR_TYPE *, unsigned int);
+Py_ssize_t _vectorTypeArrayFromObjects(VECTOR_TYPE *, PyObject *const *, Py_ssize_t);
+void _vectorTypeArrayLinearCombination(VECTOR_TYPE *, VECTOR_TYPE *, VECTOR_TYPE **, Py_ssize_t, unsigned int);
+Py_uhash_t _hashVectorTypeArray(VECTOR_TYPE *, unsigned int, Py_uhash_t);
+Py_hash_t _finalizeHash(Py_uhash_t);
+unsigned char _getVectorTypeBuffer(PyObject *, Py_ssize_t, Py_buffer *);
+PyObject *_vectorTypeBufferOwner(Py_buffer *);
+PyObject *_pickleBytes(PyObject *, int);
+PyObject *_pathFilenameObject(PyObject *);
+FILE *_openPath(PyObject *, const char *);
+unsigned char _assertArgCount(const char *, Py_ssize_t, Py_ssize_t);
+unsigned char _parseLongArg(PyObject *, long *);
+unsigned char _parseVectorTypeArg(PyObject *, VECTOR_TYPE *);
+unsigned char _parseOptionalArg(const char *, const char *, Py_ssize_t, PyObject *const *, Py_ssize_t, PyObject *,
+                                PyObject **);
 
 
 VECTOR_TYPE PyNumber_AS_VECTOR_TYPE(PyObject *n) {
-/*  Converts a PyObject containing any type of number to a VECTOR_TYPE.
+/*  Converts a PyObject containing any type of number to a VECTOR_TYPE.  Floats, ints & bools are converted directly,
+    without creating an intermediate float object.
 
     Inputs: n - The PyObject to convert.
 
-    Outputs: A VECTOR_TYPE.
+    Outputs: A VECTOR_TYPE.  If an error occurred -1 is returned, and PyErr_Occurred() will be set.
 */
 
-    PyObject *pyFloat;
-    VECTOR_TYPE retval;
+    if (PyFloat_CheckExact(n))
+        return PyFloat_AS_DOUBLE(n);
 
-    pyFloat = PyNumber_Float(n);
-    retval = PyFloat_AS_DOUBLE(pyFloat);
-    Py_DECREF(pyFloat);
+#if PY_MAJOR_VERSION < 3
+    if (PyInt_CheckExact(n))
+        return (VECTOR_TYPE)PyInt_AS_LONG(n);
+#endif
 
-    return retval;
+    if (PyLong_CheckExact(n))
+        return PyLong_AsDouble(n);
+
+    if (PyBool_Check(n))
+        return n == Py_True;
+
+    return PyFloat_AsDouble(n);
+}
+
+
+PyObject *_vectorTypeArrayToList(VECTOR_TYPE *values, unsigned int count) {
+/*  Constructs a PyList of floats from an array of VECTOR_TYPEs.
+
+    Inputs: values - The array to convert.
+            count  - The number of values in the array.
+
+    Outputs: A new PyList, or NULL if an error occurred.
+*/
+
+    PyObject *list,
+             *item;
+    unsigned int i;
+
+    if ((list = PyList_New(count)) == NULL)
+        return NULL;
+
+    for (i = 0; i < count; i++) {
+        if ((item = PyFloat_FromDouble(values[i])) == NULL) {
+            Py_DECREF(list);
+            return NULL;
+        }
+        PyList_SET_ITEM(list, i, item);
+    }
+
+    return list;
+}
+
+
+PyObject *_vectorTypeArrayToTuple(VECTOR_TYPE *values, unsigned int count) {
+/*  Constructs a PyTuple of floats from an array of VECTOR_TYPEs.
+
+    Inputs: values - The array to convert.
+            count  - The number of values in the array.
+
+    Outputs: A new PyTuple, or NULL if an error occurred.
+*/
+
+    PyObject *tuple,
+             *item;
+    unsigned int i;
+
+    if ((tuple = PyTuple_New(count)) == NULL)
+        return NULL;
+
+    for (i = 0; i < count; i++) {
+        if ((item = PyFloat_FromDouble(values[i])) == NULL) {
+            Py_DECREF(tuple);
+            return NULL;
+        }
+        PyTuple_SET_ITEM(tuple, i, item);
+    }
+
+    return tuple;
+}
+
+
+Py_ssize_t _vectorTypeArrayFromObjects(VECTOR_TYPE *dst, PyObject *const *items, Py_ssize_t count) {
+/*  Converts an array of PyObjects containing numbers into an array of VECTOR_TYPEs.
+
+    Inputs: dst   - The array to write the converted values to; must have room for count values.
+            items - The PyObjects to convert.
+            count - The number of objects in items.
+
+    Outputs: -1 if every object was converted, otherwise the index of the first object which could not be converted.
+             If that object is not a number no exception is set, so that the caller can raise one describing where the
+             object came from; if it is a number which failed to convert, the conversion's exception is set.
+*/
+
+    Py_ssize_t i;
+    PyObject *item;
+    VECTOR_TYPE value;
+
+    for (i = 0; i < count; i++) {
+        item = items[i];
+
+        // Handle the common case of floats inline; everything else goes through the general conversion
+        if (PyFloat_CheckExact(item)) {
+            dst[i] = PyFloat_AS_DOUBLE(item);
+            continue;
+        }
+
+        if (!PyNumber_Check(item))
+            return i;
+
+        value = PyNumber_AS_VECTOR_TYPE(item);
+        if (value == -1 && PyErr_Occurred())
+            return i;
+        dst[i] = value;
+    }
+
+    return -1;
+}
+
+
+void _vectorTypeArrayLinearCombination(VECTOR_TYPE *dst, VECTOR_TYPE *coefficients, VECTOR_TYPE **sources,
+                                       Py_ssize_t count, unsigned int length) {
+/*  Computes the sum of coefficients[i] * sources[i] into dst.  The result is accumulated LINEAR_COMBINATION_BLOCK
+    values at a time in a buffer which stays in cache, and copied into dst once each block is complete; dst is only
+    written once, and may be one of the sources.
+
+    Inputs: dst          - The array to write the result to.
+            coefficients - The factor to multiply each source by.
+            sources      - The arrays to combine, each of length values.
+            count        - The number of sources.
+            length       - The number of values in dst and each source.
+*/
+
+    VECTOR_TYPE block[LINEAR_COMBINATION_BLOCK],
+                coefficient,
+                *src;
+    unsigned int start,
+                 size,
+                 i;
+    Py_ssize_t s;
+
+    for (start = 0; start < length; start += size) {
+        size = length - start < LINEAR_COMBINATION_BLOCK ? length - start : LINEAR_COMBINATION_BLOCK;
+
+        memset(block, 0, sizeof(VECTOR_TYPE) * size);
+        for (s = 0; s < count; s++) {
+            coefficient = coefficients[s];
+            src = sources[s] + start;
+            for (i = 0; i < size; i++)
+                block[i] += coefficient * src[i];
+        }
+
+        memcpy(dst + start, block, sizeof(VECTOR_TYPE) * size);
+    }
 }
 
 
@@ -48,3 +203,323 @@ PyObject *PyNumber_FROM_VECTOR_TYPE(VECTOR_TYPE v) {
 
     return PyFloat_FromDouble(v);
 }
+
+
+// Multiplicative constants used by the hashing functions below; taken from the 64 bit primes used by xxHash.
+#define HASH_PRIME_1 0x9E3779B185EBCA87ULL
+#define HASH_PRIME_2 0xC2B2AE3D27D4EB4FULL
+#define HASH_ROTATE(x, r) (((x) << (r)) | ((x) >> (64 - (r))))
+
+Py_uhash_t _hashVectorTypeArray(VECTOR_TYPE *data, unsigned int length, Py_uhash_t seed) {
+/*  Hashes an array of VECTOR_TYPEs.  The array is consumed 4 values at a time into 4 independent lanes so that the
+    multiplications in each lane can be pipelined (or vectorized) by the compiler, the lanes are then folded together.
+
+    Inputs: data   - The array of values to hash.
+            length - The number of values in data.
+            seed   - A value to seed the hash with; used to chain the hashes of multiple arrays together.
+
+    Outputs: The (unfinalized) hash of the array.  See _finalizeHash.
+*/
+
+    uint64_t lanes[4],
+             word,
+             hash;
+    VECTOR_TYPE value;
+    unsigned int i,
+                 lane;
+
+    lanes[0] = (uint64_t)seed + HASH_PRIME_1 + HASH_PRIME_2;
+    lanes[1] = (uint64_t)seed + HASH_PRIME_2;
+    lanes[2] = (uint64_t)seed;
+    lanes[3] = (uint64_t)seed - HASH_PRIME_1;
+
+    for (i = 0; i < length; i += 4) {
+        for (lane = 0; lane < 4 && i + lane < length; lane++) {
+            // -0.0 compares equal to 0.0, so it must hash equal to it as well
+            value = (data[i + lane] == 0) ? 0 : data[i + lane];
+            memcpy(&word, &value, sizeof(word));
+
+            lanes[lane] += word * HASH_PRIME_2;
+            lanes[lane] = HASH_ROTATE(lanes[lane], 31) * HASH_PRIME_1;
+        }
+    }
+
+    hash = HASH_ROTATE(lanes[0], 1) + HASH_ROTATE(lanes[1], 7) + HASH_ROTATE(lanes[2], 12) + HASH_ROTATE(lanes[3], 18);
+    hash ^= (uint64_t)length;
+    hash ^= hash >> 33;
+    hash *= HASH_PRIME_2;
+    hash ^= hash >> 29;
+
+    return (Py_uhash_t)(hash ^ (hash >> 32));
+}
+
+
+Py_hash_t _finalizeHash(Py_uhash_t hash) {
+/*  Converts a hash produced by _hashVectorTypeArray into a value which can be returned from a tp_hash function.
+
+    Inputs: hash - The hash to finalize.
+
+    Outputs: A Py_hash_t which is guaranteed not to be -1, which Python reserves to signal errors.
+*/
+
+    if ((Py_hash_t)hash == -1)
+        return -2;
+
+    return (Py_hash_t)hash;
+}
+
+
+unsigned char _getVectorTypeBuffer(PyObject *obj, Py_ssize_t count, Py_buffer *view) {
+/*  Acquires a contiguous buffer from an object which should contain a given number of native VECTOR_TYPEs.
+
+    Inputs: obj   - The object exporting the buffer; ex: bytes, bytearray, memoryview or pickle.PickleBuffer.
+            count - The number of VECTOR_TYPEs the buffer is expected to contain, or -1 to accept any whole number of
+                    VECTOR_TYPEs.
+            view  - The Py_buffer to populate.  Must be released with PyBuffer_Release on success.
+
+    Outputs: 1 if the buffer was acquired, otherwise 0.
+*/
+
+    if (PyObject_GetBuffer(obj, view, PyBUF_C_CONTIGUOUS) == -1)
+        return 0;
+
+    if (count == -1) {
+        if (view->len % sizeof(VECTOR_TYPE) == 0 && view->len / (Py_ssize_t)sizeof(VECTOR_TYPE) <= UINT_MAX)
+            return 1;
+
+        PyErr_Format(PyExc_ValueError, "Buffer of %zd bytes does not contain a whole number of values.", view->len);
+        PyBuffer_Release(view);
+        return 0;
+    }
+
+    if (view->len != count * (Py_ssize_t)sizeof(VECTOR_TYPE)) {
+        PyErr_Format(PyExc_ValueError, "Expected a buffer of %zd bytes, got %zd bytes.",
+                     count * (Py_ssize_t)sizeof(VECTOR_TYPE), view->len);
+        PyBuffer_Release(view);
+        return 0;
+    }
+
+    return 1;
+}
+
+
+PyObject *_vectorTypeBufferOwner(Py_buffer *view) {
+/*  Determines whether the data in a buffer acquired by _getVectorTypeBuffer can be referenced directly rather than
+    copied; which is only the case if the object ultimately exporting it is immutable, and the data is suitably
+    aligned.
+
+    Inputs: view - The acquired buffer.
+
+    Outputs: A borrowed reference to the object owning the data if it can be referenced directly, otherwise NULL.
+*/
+
+    if (view->obj != NULL && PyBytes_CheckExact(view->obj) && ((uintptr_t)view->buf % sizeof(VECTOR_TYPE)) == 0)
+        return view->obj;
+
+    return NULL;
+}
+
+
+PyObject *_pickleBytes(PyObject *bytes, int protocol) {
+/*  Prepares a bytes object to be used as an argument returned from __reduce_ex__.  For pickle protocols 5 and above
+    the bytes are wrapped in a PickleBuffer so that they can be transferred out-of-band.
+
+    Inputs: bytes    - The bytes object to prepare.  A reference to it is stolen.
+            protocol - The pickle protocol being used.
+
+    Outputs: A new reference to the object to pickle, or NULL if an error occurred.
+*/
+
+#if PY_VERSION_HEX >= 0x03080000
+    PyObject *buffer;
+
+    if (bytes != NULL && protocol >= 5) {
+        buffer = PyPickleBuffer_FromObject(bytes);
+        Py_DECREF(bytes);
+        return buffer;
+    }
+#endif
+
+    return bytes;
+}
+
+
+PyObject *_pathFilenameObject(PyObject *path) {
+/*  Converts a path into an object suitable for use as the filename of an exception.
+
+    Inputs: path - The path object passed to us.
+
+    Outputs: A new reference to a filename object, or NULL if an error occurred.
+*/
+
+#if PY_VERSION_HEX >= 0x03060000
+    return PyOS_FSPath(path);
+#else
+    Py_INCREF(path);
+    return path;
+#endif
+}
+
+
+FILE *_openPath(PyObject *path, const char *mode) {
+/*  Opens a file given a Python path object.
+
+    Inputs: path - A str, bytes or os.PathLike object containing the path to open.
+            mode - The mode to pass to fopen.
+
+    Outputs: An open FILE *, or NULL if an error occurred.
+*/
+
+    FILE *f;
+    PyObject *filename;
+    char *cPath;
+
+#if PY_MAJOR_VERSION >= 3
+    PyObject *bytesPath;
+
+    if (!PyUnicode_FSConverter(path, &bytesPath))
+        return NULL;
+
+    cPath = PyBytes_AS_STRING(bytesPath);
+#else
+    if ((cPath = PyString_AsString(path)) == NULL)
+        return NULL;
+#endif
+
+    Py_BEGIN_ALLOW_THREADS
+    f = fopen(cPath, mode);
+    Py_END_ALLOW_THREADS
+
+#if PY_MAJOR_VERSION >= 3
+    Py_DECREF(bytesPath);
+#endif
+
+    if (f == NULL) {
+        if ((filename = _pathFilenameObject(path)) != NULL) {
+            PyErr_SetFromErrnoWithFilenameObject(PyExc_IOError, filename);
+            Py_DECREF(filename);
+        }
+    }
+
+    return f;
+}
+
+
+unsigned char _assertArgCount(const char *name, Py_ssize_t nargs, Py_ssize_t expected) {
+/*  Asserts that a function taking positional arguments was passed the expected number of them.
+
+    Inputs: name     - The name of the function, for the error message.
+            nargs    - The number of arguments passed.
+            expected - The number of arguments expected.
+
+    Outputs: 1 if the correct number of arguments were passed, otherwise 0 with a TypeError set.
+*/
+
+    if (nargs == expected)
+        return 1;
+
+    PyErr_Format(PyExc_TypeError, "%.200s() takes exactly %zd argument%s (%zd given)", name, expected,
+                 expected == 1 ? "" : "s", nargs);
+    return 0;
+}
+
+
+unsigned char _parseLongArg(PyObject *arg, long *out) {
+/*  Converts an integer argument to a long, with the same semantics as PyArg_ParseTuple's "l" format.
+
+    Inputs: arg - The argument to convert.
+            out - Set to the converted value.
+
+    Outputs: 1 if the argument was converted, otherwise 0.
+*/
+
+    if (PyFloat_Check(arg)) {
+        PyErr_SetString(PyExc_TypeError, "integer argument expected, got float");
+        return 0;
+    }
+
+    *out = PyLong_AsLong(arg);
+    return !(*out == -1 && PyErr_Occurred());
+}
+
+
+unsigned char _parseVectorTypeArg(PyObject *arg, VECTOR_TYPE *out) {
+/*  Converts a numeric argument to a VECTOR_TYPE, with the same semantics as PyArg_ParseTuple's "d" format.
+
+    Inputs: arg - The argument to convert.
+            out - Set to the converted value.
+
+    Outputs: 1 if the argument was converted, otherwise 0.
+*/
+
+    *out = PyNumber_AS_VECTOR_TYPE(arg);
+    return !(*out == -1.0 && PyErr_Occurred());
+}
+
+
+unsigned char _parseOptionalArg(const char *name, const char *keyword, Py_ssize_t position, PyObject *const *args,
+                                Py_ssize_t nargs, PyObject *kwnames, PyObject **value) {
+/*  Parses the arguments of a function called with METH_FASTCALL_KEYWORDS_COMPAT, which takes `position` required
+    positional arguments followed by a single optional argument that may be passed either positionally or by keyword.
+
+    Inputs: name     - The name of the function, for error messages.
+            keyword  - The name of the optional argument.
+            position - The index of the optional argument; i.e. the number of required arguments.
+            args     - The arguments passed to the function.
+            nargs    - The number of positional arguments in args.
+            kwnames  - The keyword names passed to the function (or on older Pythons, the keyword argument dictionary).
+            value    - Set to a borrowed reference to the optional argument if it was given, otherwise untouched.
+
+    Outputs: 1 if successful, otherwise 0 with a TypeError set.
+*/
+
+    PyObject *kwname;
+#if PY_VERSION_HEX < 0x03070000
+    PyObject *kwvalue;
+#endif
+    Py_ssize_t i = 0;
+    unsigned char matched;
+
+    if (nargs < position || nargs > position + 1) {
+        PyErr_Format(PyExc_TypeError, "%.200s() takes %zd or %zd arguments (%zd given)", name, position, position + 1,
+                     nargs);
+        return 0;
+    }
+
+    if (nargs > position)
+        *value = args[position];
+
+    if (kwnames == NULL)
+        return 1;
+
+#if PY_VERSION_HEX >= 0x03070000
+    for (i = 0; i < PyTuple_GET_SIZE(kwnames); i++) {
+        kwname = PyTuple_GET_ITEM(kwnames, i);
+        matched = PyUnicode_CompareWithASCIIString(kwname, keyword) == 0;
+#else
+    while (PyDict_Next(kwnames, &i, &kwname, &kwvalue)) {
+    #if PY_MAJOR_VERSION >= 3
+        matched = PyUnicode_Check(kwname) && PyUnicode_CompareWithASCIIString(kwname, keyword) == 0;
+    #else
+        matched = PyString_Check(kwname) && strcmp(PyString_AS_STRING(kwname), keyword) == 0;
+    #endif
+#endif
+
+        if (!matched) {
+            PyErr_Format(PyExc_TypeError, "%.200s() got an unexpected keyword argument", name);
+            return 0;
+        }
+        if (nargs > position) {
+            PyErr_Format(PyExc_TypeError, "%.200s() got multiple values for argument '%s'", name, keyword);
+            return 0;
+        }
+
+#if PY_VERSION_HEX >= 0x03070000
+        *value = args[nargs + i];
+#else
+        *value = kwvalue;
+#endif
+    }
+
+    return 1;
+}
@@ -0,0 +1,343 @@
+/*
+ *  Copyright (C) 2016 Warren Spencer warrenspencer27@gmail.com
+
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+PyObject *vectorBuilderNew(PyTypeObject *type, PyObject *args, PyObject *kwds) {
+/*  Creates a new vector builder, either with all components 0 or from a copy of an existing vector.
+
+    Inputs: type - The VectorBuilder type.
+            args - A tuple containing either the number of dimensions of the vector to build, or a Vector to copy.
+            kwds - A dictionary of keyword arguments, which must be empty.
+
+    Outputs: A new VectorBuilder, or NULL if an error occurred.
+*/
+
+    VectorBuilder *self;
+    Vector *v;
+    long dimensions;
+
+    if (kwds != NULL && PyDict_Size(kwds) != 0) {
+        PyErr_SetString(PyExc_TypeError, "VectorBuilder() takes no keyword arguments");
+        return NULL;
+    }
+
+    if (PyTuple_GET_SIZE(args) != 1) {
+        PyErr_SetString(PyExc_TypeError, "VectorBuilder takes either a Vector to copy, or a number of dimensions.");
+        return NULL;
+    }
+
+    if (Vector_Check(PyTuple_GET_ITEM(args, 0))) {
+        if ((v = _vectorCopy((Vector *)PyTuple_GET_ITEM(args, 0))) == NULL)
+            return NULL;
+
+    } else {
+        if (!_parseLongArg(PyTuple_GET_ITEM(args, 0), &dimensions))
+            return NULL;
+
+        if (dimensions < 0 || dimensions > UINT_MAX) {
+            PyErr_Format(PyExc_ValueError, "Invalid Vector dimensions: %ld", dimensions);
+            return NULL;
+        }
+
+        if ((v = _vectorNew((unsigned int)dimensions)) == NULL)
+            return NULL;
+        memset(v->data, '\x00', sizeof(VECTOR_TYPE) * v->dimensions);
+    }
+
+    if ((self = (VectorBuilder *)type->tp_alloc(type, 0)) == NULL) {
+        Py_DECREF(v);
+        return NULL;
+    }
+
+    v->isMutable = 1;
+    self->vector = v;
+
+    return (PyObject *)self;
+}
+
+
+void vectorBuilderDeInit(VectorBuilder *self) {
+    /* De-allocates a vector builder. */
+
+    Py_XDECREF(self->vector);
+    Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+
+static Vector *_vectorBuilderVector(VectorBuilder *self) {
+/*  Returns the vector being built by a builder.
+
+    Inputs: self - The builder.
+
+    Outputs: A borrowed reference to the builder's vector, or NULL with a ValueError set if it has been frozen.
+*/
+
+    if (self->vector == NULL)
+        PyErr_SetString(PyExc_ValueError, "VectorBuilder has already been frozen.");
+
+    return self->vector;
+}
+
+
+static Vector *_vectorBuilderOperand(PyObject *operand) {
+/*  Returns the vector held by the operand of an in-place operation.
+
+    Inputs: operand - Either a Vector or a VectorBuilder.
+
+    Outputs: A borrowed reference to the operand's vector.  NULL if operand is neither, or if an error occurred (in
+             which case a PyError is set).
+*/
+
+    if (Vector_Check(operand))
+        return (Vector *)operand;
+    if (VectorBuilder_Check(operand))
+        return _vectorBuilderVector((VectorBuilder *)operand);
+
+    return NULL;
+}
+
+
+Py_ssize_t vectorBuilderLength(VectorBuilder *self) {
+/*  Returns the number of dimensions of the vector being built.
+
+    Inputs: self - The builder.
+
+    Outputs: The number of dimensions, or -1 if the builder has been frozen.
+*/
+
+    Vector *v;
+
+    if ((v = _vectorBuilderVector(self)) == NULL)
+        return -1;
+
+    return (Py_ssize_t)v->dimensions;
+}
+
+
+PyObject *vectorBuilderItem(VectorBuilder *self, Py_ssize_t i) {
+/*  Returns a single component of the vector being built.
+
+    Inputs: self - The builder.
+            i    - The index of the component.
+
+    Outputs: A PyFloat, or NULL if an error occurred.
+*/
+
+    Vector *v;
+
+    if ((v = _vectorBuilderVector(self)) == NULL)
+        return NULL;
+
+    if (i < 0 || i >= v->dimensions) {
+        PyErr_Format(PyExc_IndexError, "Cannot return item in index %zd of VectorBuilder with %u dimensions.", i,
+                     v->dimensions);
+        return NULL;
+    }
+
+    return PyNumber_FROM_VECTOR_TYPE(Vector_GetValue(v, i));
+}
+
+
+int vectorBuilderAssItem(VectorBuilder *self, Py_ssize_t i, PyObject *value) {
+/*  Sets a single component of the vector being built.
+
+    Inputs: self  - The builder.
+            i     - The index of the component.
+            value - The number to set, or NULL if the component is being deleted.
+
+    Outputs: 0 if successful, else -1.
+*/
+
+    Vector *v;
+    VECTOR_TYPE component;
+
+    if (value == NULL) {
+        PyErr_SetString(PyExc_TypeError, "VectorBuilder components cannot be deleted.");
+        return -1;
+    }
+
+    if ((v = _vectorBuilderVector(self)) == NULL || !_parseVectorTypeArg(value, &component))
+        return -1;
+
+    if (i < 0 || i >= v->dimensions) {
+        PyErr_Format(PyExc_IndexError, "Cannot set item in index %zd of VectorBuilder with %u dimensions.", i,
+                     v->dimensions);
+        return -1;
+    }
+
+    Vector_SetValue(v, i, component);
+    return 0;
+}
+
+
+PyObject *vectorBuilderInplaceAdd(VectorBuilder *self, PyObject *other) {
+/*  Adds a vector to the vector being built, in place.
+
+    Inputs: self  - The builder.
+            other - A Vector or VectorBuilder to add.
+
+    Outputs: self, or NULL if an error occurred.
+*/
+
+    Vector *v,
+           *o;
+
+    if ((v = _vectorBuilderVector(self)) == NULL)
+        return NULL;
+
+    if ((o = _vectorBuilderOperand(other)) == NULL) {
+        if (PyErr_Occurred())
+            return NULL;
+        Py_INCREF(Py_NotImplemented);
+        return Py_NotImplemented;
+    }
+
+    if (!_assertVectorDimensionsEqual(v, o))
+        return NULL;
+
+    _inplaceVectorAdd(v, o, v);
+
+    Py_INCREF(self);
+    return (PyObject *)self;
+}
+
+
+PyObject *vectorBuilderInplaceSub(VectorBuilder *self, PyObject *other) {
+/*  Subtracts a vector from the vector being built, in place.
+
+    Inputs: self  - The builder.
+            other - A Vector or VectorBuilder to subtract.
+
+    Outputs: self, or NULL if an error occurred.
+*/
+
+    Vector *v,
+           *o;
+
+    if ((v = _vectorBuilderVector(self)) == NULL)
+        return NULL;
+
+    if ((o = _vectorBuilderOperand(other)) == NULL) {
+        if (PyErr_Occurred())
+            return NULL;
+        Py_INCREF(Py_NotImplemented);
+        return Py_NotImplemented;
+    }
+
+    if (!_assertVectorDimensionsEqual(v, o))
+        return NULL;
+
+    _inplaceVectorSub(v, o, v);
+
+    Py_INCREF(self);
+    return (PyObject *)self;
+}
+
+
+PyObject *vectorBuilderInplaceMul(VectorBuilder *self, PyObject *other) {
+/*  Multiplies the vector being built by either a scalar, or a square matrix (as with Vector * Matrix), in place.
+
+    Inputs: self  - The builder.
+            other - A scalar, or a Matrix or MatrixBuilder with as many rows & columns as the vector has dimensions.
+
+    Outputs: self, or NULL if an error occurred.
+*/
+
+    Vector *v;
+    Matrix *m;
+    VECTOR_TYPE scalar;
+
+    if ((v = _vectorBuilderVector(self)) == NULL)
+        return NULL;
+
+    if ((m = _matrixBuilderOperand(other)) != NULL) {
+        if (!_inplaceVectorMatrixMul(m, v, v))
+            return NULL;
+
+    } else if (PyErr_Occurred()) {
+        return NULL;
+
+    } else if (PyNumber_Check(other)) {
+        if ((scalar = PyNumber_AS_VECTOR_TYPE(other)) == -1 && PyErr_Occurred())
+            return NULL;
+        _inplaceVectorMul(v, scalar, v);
+
+    } else {
+        Py_INCREF(Py_NotImplemented);
+        return Py_NotImplemented;
+    }
+
+    Py_INCREF(self);
+    return (PyObject *)self;
+}
+
+
+PyObject *vectorBuilderFreeze(VectorBuilder *self) {
+/*  Ends the building of a vector, handing its data to an immutable Vector without copying it.  The builder cannot be
+    used afterwards.
+
+    Inputs: self - The builder.
+
+    Outputs: The built Vector, or NULL if the builder has already been frozen.
+*/
+
+    Vector *v;
+
+    if ((v = _vectorBuilderVector(self)) == NULL)
+        return NULL;
+
+    // Our reference to the vector is passed to the caller
+    self->vector = NULL;
+    v->isMutable = 0;
+    v->hash = -1;
+
+    return (PyObject *)v;
+}
+
+
+PyObject *vectorBuilderDimensions(VectorBuilder *self, void *closure) {
+/*  Returns the number of dimensions of the vector being built.
+
+    Inputs: self    - The builder.
+            closure - Unused.
+
+    Outputs: A PyLong, or NULL if the builder has been frozen.
+*/
+
+    Vector *v;
+
+    if ((v = _vectorBuilderVector(self)) == NULL)
+        return NULL;
+
+    return PyLong_FromUnsignedLong(v->dimensions);
+}
+
+
+PyObject *vectorBuilderStr(VectorBuilder *self) {
+/*  Returns a string representation of the vector being built.
+
+    Inputs: self - The builder.
+
+    Outputs: A PyString, or NULL if an error occurred.
+*/
+
+    Vector *v;
+
+    if ((v = _vectorBuilderVector(self)) == NULL)
+        return NULL;
+
+    return vectorStr(v);
+}
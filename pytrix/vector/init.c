@@ -16,68 +16,159 @@
  */
 
 
-static int vectorInit(Vector *self, PyObject *args) {
-/*  Initializes a vector from a sequence.
+static int _vectorInitFromArray(Vector *self, PyObject *const *args, Py_ssize_t nargs) {
+/*  Initializes a vector from either a single sequence of values, or a series of values.
 
-    Inputs: self - The Vector being initialized.
-            args - A packed version of the arguments passed to the initializer.
+    Inputs: self  - The Vector being initialized.
+            args  - The arguments passed to the initializer.
+            nargs - The number of arguments in args.
 
     Outputs: 0 If successful, else -1
 */
 
-    unsigned int i;
-    PyObject *iterable = NULL,
-             *item = NULL;
+    PyObject *const *values;
+    Py_ssize_t count,
+               failed;
 
     // We expect either args to contain either a single list of values, or a series of values.
     // Assert that args isn't empty
-    if (PySequence_Length(args) == 0) {
+    if (nargs == 0) {
         PyErr_SetString(PyExc_TypeError,
                         "Vector.__init__ takes either an iterable of values or an unpacked sequence of values.");
         return -1;
     }
 
     // Check the first value of args.  If it's an iterable, assert that args contains exactly one item
-    if ((item = PySequence_GetItem(args, 0)) == NULL)
-        return -1;
-    if (Compatible_Input_Sequence_Check(item)) {
-        if (PySequence_Length(args) != 1) {
+    if (Compatible_Input_Sequence_Check(args[0])) {
+        if (nargs != 1) {
             PyErr_SetString(PyExc_TypeError,
                             "Vector.__init__ takes either an iterable of values or an unpacked sequence of values.");
             return -1;
         }
-        iterable = item;
+        values = PySequence_Fast_ITEMS(args[0]);
+        count = PySequence_Fast_GET_SIZE(args[0]);
 
     // Otherwise, assume that we were given an unpacked sequence of values to initialize from
     } else {
-        iterable = args;
+        values = args;
+        count = nargs;
     }
 
     // If we have already been initialized, free the memory reserved in our data variable before it is reinitialized
-    if (self->data != NULL)
-        PyMem_Free(self->data);
+    _vectorFreeData(self);
 
-    self->dimensions = PySequence_Fast_GET_SIZE(iterable);
-    if ((self->data = PyMem_New(VECTOR_TYPE, self->dimensions)) == NULL)
+    self->hash = -1;
+    self->dimensions = (unsigned int)count;
+    if ((self->data = PyMem_New(VECTOR_TYPE, self->dimensions)) == NULL) {
+        PyErr_NoMemory();
         return -1;
+    }
 
-    // Initialize self->data from the given iterable
-    for (i = 0; i < self->dimensions; i++) {
-        item = PySequence_Fast_GET_ITEM(iterable, i);
-        if (!PyNumber_Check(item)) {
-            PyErr_Format(PyExc_TypeError, "Non-numeric object in iterable slot %d", i);
-            return -1;
-        }
-        Vector_SetValue(self, i, PyNumber_AS_VECTOR_TYPE(item));
+    // Initialize self->data from the given values
+    if ((failed = _vectorTypeArrayFromObjects(self->data, values, count)) != -1) {
+        if (!PyErr_Occurred())
+            PyErr_Format(PyExc_TypeError, "Non-numeric object in iterable slot %zd", failed);
+        return -1;
     }
 
     return 0;
 }
 
 
+static int vectorInit(Vector *self, PyObject *args, PyObject *kwds) {
+/*  Initializes a vector from a sequence.
+
+    Inputs: self - The Vector being initialized.
+            args - A packed version of the arguments passed to the initializer.
+            kwds - A dictionary of keyword arguments passed to the initializer, which must be empty.
+
+    Outputs: 0 If successful, else -1
+*/
+
+    if (kwds != NULL && PyDict_Size(kwds) != 0) {
+        PyErr_SetString(PyExc_TypeError, "Vector() takes no keyword arguments");
+        return -1;
+    }
+
+    return _vectorInitFromArray(self, &PyTuple_GET_ITEM(args, 0), PyTuple_GET_SIZE(args));
+}
+
+
+#ifdef HAVE_TYPE_VECTORCALL
+PyObject *vectorVectorcall(PyObject *type, PyObject *const *args, size_t nargsf, PyObject *kwnames) {
+/*  Constructs a vector without packing its arguments into a tuple.
+
+    Inputs: type    - The Vector type.
+            args    - The arguments passed to the constructor.
+            nargsf  - The number of arguments in args, possibly with PY_VECTORCALL_ARGUMENTS_OFFSET set.
+            kwnames - The names of any keyword arguments passed.
+
+    Outputs: A new Vector, or NULL if an error occurred.
+*/
+
+    PyObject *self;
+
+    if (kwnames != NULL && PyTuple_GET_SIZE(kwnames) != 0) {
+        PyErr_SetString(PyExc_TypeError, "Vector() takes no keyword arguments");
+        return NULL;
+    }
+
+    if ((self = PyType_GenericNew((PyTypeObject *)type, NULL, NULL)) == NULL)
+        return NULL;
+
+    if (_vectorInitFromArray((Vector *)self, args, PyVectorcall_NARGS(nargsf)) == -1) {
+        Py_DECREF(self);
+        return NULL;
+    }
+
+    return self;
+}
+#endif
+
+
+PyObject *vectorZeros(PyObject *cls, FASTCALL_KEYWORDS_PARAMETERS) {
+/*  Creates a new vector whose components are all 0.
+
+    Inputs: cls     - The Vector type.
+            args    - The number of dimensions of the vector, followed by the optional mutable flag.
+            nargs   - The number of positional arguments in args.
+            kwnames - The names of any keyword arguments passed.
+
+    Outputs: A new Vector, or NULL if an error occurred.  If mutable is True, the vector may be used as the out
+             argument of pytrix's arithmetic functions.
+*/
+
+    FASTCALL_KEYWORDS_UNPACK_ARGS
+    PyObject *mutableArg = Py_False;
+    long dimensions;
+    int isMutable;
+    Vector *v;
+
+    if (!_parseOptionalArg("zeros", "mutable", 1, args, nargs, kwnames, &mutableArg) ||
+        !_parseLongArg(args[0], &dimensions))
+        return NULL;
+
+    if (dimensions < 0 || dimensions > UINT_MAX) {
+        PyErr_Format(PyExc_ValueError, "Invalid Vector dimensions: %ld", dimensions);
+        return NULL;
+    }
+
+    if ((isMutable = PyObject_IsTrue(mutableArg)) == -1)
+        return NULL;
+
+    if ((v = _vectorNew((unsigned int)dimensions)) == NULL)
+        return NULL;
+
+    memset(v->data, '\x00', sizeof(VECTOR_TYPE) * v->dimensions);
+    v->isMutable = (char)isMutable;
+
+    return (PyObject *)v;
+}
+
+
 static void vectorDeInit(Vector *self) {
     /* De-allocates a vector. */
 
-    PyMem_Free(self->data);
+    _vectorFreeData(self);
     PyObject_Del(self);
 }
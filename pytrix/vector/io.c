@@ -0,0 +1,187 @@
+/*
+ *  Copyright (C) 2016 Warren Spencer warrenspencer27@gmail.com
+
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+PyObject *vectorSave(Vector *self, PyObject *path) {
+/*  Writes this vector to a file in numpy's .npy format.
+
+    Inputs: self - The vector to save.
+            path - The path of the file to write to.
+
+    Outputs: None, or NULL if an error occurred.
+*/
+
+    FILE *f;
+
+    if ((f = _openPath(path, "wb")) == NULL)
+        return NULL;
+
+    if (!_npyWriteHeader(f, path, 1, &self->dimensions) || !_npyWriteData(f, path, self->data, self->dimensions)) {
+        fclose(f);
+        return NULL;
+    }
+
+    if (fclose(f) != 0)
+        return PyErr_SetFromErrno(PyExc_IOError);
+
+    Py_RETURN_NONE;
+}
+
+
+PyObject *vectorLoad(PyObject *cls, PyObject *args, PyObject *kwargs) {
+/*  Creates a new vector from a 1 dimensional float64 array stored in numpy's .npy format.
+
+    Inputs: cls    - The Vector type.
+            args   - A tuple containing the path of the file to load.
+            kwargs - Optionally contains mmap; if True the vector will reference the file's pages directly, rather than
+                     reading them into memory.
+
+    Outputs: A new Vector, or NULL if an error occurred.
+*/
+
+    static char *kwlist[] = {"path", "mmap", NULL};
+    PyObject *path,
+             *map,
+             *mmap = Py_False;
+    NpyHeader header;
+    VECTOR_TYPE *data;
+    FILE *f;
+    Vector *v;
+    int useMmap;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|O:load", kwlist, &path, &mmap))
+        return NULL;
+
+    if ((useMmap = PyObject_IsTrue(mmap)) == -1)
+        return NULL;
+
+    if ((f = _openPath(path, "rb")) == NULL)
+        return NULL;
+
+    if (!_npyReadHeader(f, path, &header)) {
+        fclose(f);
+        return NULL;
+    }
+
+    if (header.ndim != 1) {
+        fclose(f);
+        PyErr_Format(PyExc_ValueError, "Vectors can only be loaded from 1 dimensional arrays, not %u.", header.ndim);
+        return NULL;
+    }
+
+    if (useMmap) {
+        fclose(f);
+        if ((map = _npyMap(path, &header, header.shape[0], &data)) == NULL)
+            return NULL;
+
+        v = _vectorNewView(header.shape[0], data, map);
+        Py_DECREF(map);
+        return (PyObject *)v;
+    }
+
+    if ((v = _vectorNew(header.shape[0])) != NULL) {
+        if (!_npyReadData(f, path, &header, v->data, v->dimensions))
+            Py_CLEAR(v);
+    }
+
+    fclose(f);
+    return (PyObject *)v;
+}
+
+
+PyObject *vectorFromBytes(PyObject *cls, PyObject *data) {
+/*  Creates a new vector from a buffer of native doubles.
+
+    Inputs: cls  - The Vector type.
+            data - An object supporting the buffer protocol.
+
+    Outputs: A new Vector, or NULL if an error occurred.
+*/
+
+    PyObject *owner;
+    Py_buffer view;
+    unsigned int dimensions;
+    Vector *v;
+
+    if (!_getVectorTypeBuffer(data, -1, &view))
+        return NULL;
+    dimensions = (unsigned int)(view.len / sizeof(VECTOR_TYPE));
+
+    // Immutable buffers (such as those produced when unpickling) can be referenced directly rather than copied
+    if ((owner = _vectorTypeBufferOwner(&view)) != NULL) {
+        v = _vectorNewView(dimensions, (VECTOR_TYPE *)view.buf, owner);
+    } else if ((v = _vectorNew(dimensions)) != NULL) {
+        memcpy(v->data, view.buf, view.len);
+    }
+
+    PyBuffer_Release(&view);
+    return (PyObject *)v;
+}
+
+
+PyObject *vectorToBytes(Vector *self) {
+/*  Returns the data of this vector as a bytes object of native doubles.
+
+    Inputs: self - The vector to convert.
+
+    Outputs: A new bytes object, or NULL if an error occurred.
+*/
+
+    return PyBytes_FromStringAndSize((char *)self->data, (Py_ssize_t)self->dimensions * sizeof(VECTOR_TYPE));
+}
+
+
+PyObject *vectorToList(Vector *self) {
+/*  Converts this vector to a list of floats.
+
+    Inputs: self - The vector to convert.
+
+    Outputs: A new PyList, or NULL if an error occurred.
+*/
+
+    return _vectorTypeArrayToList(self->data, self->dimensions);
+}
+
+
+PyObject *vectorReduceEx(Vector *self, FASTCALL_PARAMETERS) {
+/*  Implements the pickle protocol for vectors.  The vector data is emitted as a single bytes object, which is
+    transferred out-of-band when pickle protocol 5 or above is used.
+
+    Inputs: self  - The vector being pickled.
+            args  - The pickle protocol being used.
+            nargs - The number of arguments in args.
+
+    Outputs: A tuple of (Vector.frombytes, (data,)), or NULL if an error occurred.
+*/
+
+    FASTCALL_UNPACK_ARGS
+    PyObject *bytes,
+             *constructor;
+    long protocol;
+
+    if (!_assertArgCount("__reduce_ex__", nargs, 1) || !_parseLongArg(args[0], &protocol))
+        return NULL;
+
+    if ((bytes = _pickleBytes(vectorToBytes(self), (int)protocol)) == NULL)
+        return NULL;
+
+    if ((constructor = PyObject_GetAttrString((PyObject *)&VectorType, "frombytes")) == NULL) {
+        Py_DECREF(bytes);
+        return NULL;
+    }
+
+    return Py_BuildValue("(N(N))", constructor, bytes);
+}
@@ -260,7 +260,7 @@ PyObject *vectorMul(PyObject *a, PyObject *b) {
         return Py_NotImplemented;
     }
 
-    if (PyErr_Occurred() != NULL)
+    if (multiplier == -1 && PyErr_Occurred() != NULL)
         return NULL;
 
     return (PyObject *)_vectorMul(v, multiplier);
@@ -292,7 +292,7 @@ PyObject *vectorDiv(PyObject *a, PyObject *b) {
 
     divider = PyNumber_AS_VECTOR_TYPE(b);
 
-    if (PyErr_Occurred() != NULL)
+    if (divider == -1 && PyErr_Occurred() != NULL)
         return NULL;
 
     return (PyObject *)_vectorDiv((Vector *)a, divider);
@@ -352,6 +352,14 @@ PyObject *vectorRichCmp(PyObject *a, PyObject *b, int op) {
     if ((!_assertVector(a)) || (!_assertVector(b)))
         return NULL;
 
+    // If both hashes have already been computed and they differ, the vectors cannot be equal
+    if ((((Vector *)a)->hash != -1 && ((Vector *)b)->hash != -1) && ((Vector *)a)->hash != ((Vector *)b)->hash) {
+        if (op == Py_EQ)
+            Py_RETURN_FALSE;
+        if (op == Py_NE)
+            Py_RETURN_TRUE;
+    }
+
     switch (op) {
         case Py_EQ:
             if (_vectorsEqual((Vector *)a, (Vector *)b))
@@ -370,6 +378,26 @@ PyObject *vectorRichCmp(PyObject *a, PyObject *b, int op) {
 }
 
 
+Py_hash_t vectorHash(Vector *self) {
+/*  Hashes a vector.  As vectors are immutable the hash is only computed once, and is cached on the vector.
+
+    Inputs: self - The vector to hash.
+
+    Outputs: A Py_hash_t of the components of self.
+*/
+
+    if (self->isMutable) {
+        PyErr_SetString(PyExc_TypeError, "unhashable type: mutable Vector");
+        return -1;
+    }
+
+    if (self->hash == -1)
+        self->hash = _finalizeHash(_hashVectorTypeArray(self->data, self->dimensions, (Py_uhash_t)self->dimensions));
+
+    return self->hash;
+}
+
+
 int vectorTrue(Vector *self) {
 /*  Determines if a vector has a magnitude of 0 or not.
 
@@ -36,11 +36,56 @@ Vector *_vectorNew(unsigned int dimensions) {
 
     newVector->dimensions = dimensions;
     newVector->data = data;
+    newVector->hash = -1;
+    newVector->base = NULL;
+    newVector->isMutable = 0;
 
     return newVector;
 }
 
 
+Vector *_vectorNewView(unsigned int dimensions, VECTOR_TYPE *data, PyObject *base) {
+/*  Creates a new vector object whose data is borrowed from another object rather than allocated for it.
+
+    Inputs: dimensions - The number of dimensions to create the new vector object with.
+            data       - A pointer to the first of `dimensions` values the vector should use as its data.
+            base       - The object which owns data.  A reference to it is held for the lifetime of the vector.
+
+    Outputs: A pointer to a Vector object, or NULL if an error occurred.
+*/
+
+    Vector *newVector;
+
+    if ((newVector = PyObject_New(Vector, &VectorType)) == NULL)
+        return NULL;
+
+    Py_INCREF(base);
+    newVector->dimensions = dimensions;
+    newVector->data = data;
+    newVector->hash = -1;
+    newVector->base = base;
+    newVector->isMutable = 0;
+
+    return newVector;
+}
+
+
+void _vectorFreeData(Vector *v) {
+/*  Releases the data referenced by a vector; either by freeing it, or by releasing the object which owns it.
+
+    Inputs: v - The vector whose data should be released.
+*/
+
+    if (v->base != NULL) {
+        Py_CLEAR(v->base);
+    } else if (v->data != NULL) {
+        PyMem_Free(v->data);
+    }
+
+    v->data = NULL;
+}
+
+
 void _vectorCopyData(Vector *in, Vector *out) {
 /*  Copies the data from in to out.
     Assumes that in.dimensions == out.dimensions.
@@ -116,25 +161,7 @@ PyObject *_vectorToTuple(Vector *self) {
     Outputs: A PyTuple corresponding to self if successful, else sets a PyError and returns NULL.
 */
 
-    PyObject *tuple;
-    unsigned int i;
-    PyObject *item;
-
-    if ((tuple = PyTuple_New(self->dimensions)) == NULL)
-        return NULL;
-
-    for (i = 0; i < self->dimensions; i++) {
-        item = PyNumber_FROM_VECTOR_TYPE(Vector_GetValue(self, i));
-
-        if (item == NULL) {
-            Py_DECREF(tuple);
-            return NULL;
-        }
-
-        PyTuple_SET_ITEM(tuple, i, item);
-    }
-
-    return tuple;
+    return _vectorTypeArrayToTuple(self->data, self->dimensions);
 }
 
 
@@ -174,6 +201,54 @@ VECTOR_TYPE _vectorLength(Vector *self) {
 }
 
 
+void _inplaceVectorAdd(Vector *a, Vector *b, Vector *out) {
+/*  Adds the components of two vectors together, writing the result into out.
+    Assumes that a, b & out have the same number of dimensions; out may safely be one of a, b.
+
+    Inputs: a   - The first vector to add.
+            b   - The second vector to add.
+            out - The vector to write a + b into.
+*/
+
+    unsigned int i;
+
+    for (i = 0; i < out->dimensions; i++)
+        Vector_SetValue(out, i, Vector_GetValue(a, i) + Vector_GetValue(b, i));
+}
+
+
+void _inplaceVectorSub(Vector *a, Vector *b, Vector *out) {
+/*  Subtracts the components of one vector from another, writing the result into out.
+    Assumes that a, b & out have the same number of dimensions; out may safely be one of a, b.
+
+    Inputs: a   - The vector to subtract from.
+            b   - The vector to subtract from a.
+            out - The vector to write a - b into.
+*/
+
+    unsigned int i;
+
+    for (i = 0; i < out->dimensions; i++)
+        Vector_SetValue(out, i, Vector_GetValue(a, i) - Vector_GetValue(b, i));
+}
+
+
+void _inplaceVectorMul(Vector *self, VECTOR_TYPE multiplier, Vector *out) {
+/*  Multiplies the components of a vector by a scalar, writing the result into out.
+    Assumes that self & out have the same number of dimensions; out may safely be self.
+
+    Inputs: self       - The vector to be multiplied by multiplier.
+            multiplier - The scalar to multiply self by.
+            out        - The vector to write self * multiplier into.
+*/
+
+    unsigned int i;
+
+    for (i = 0; i < out->dimensions; i++)
+        Vector_SetValue(out, i, Vector_GetValue(self, i) * multiplier);
+}
+
+
 Vector *_vectorAdd(Vector *a, Vector *b) {
 /*  Adds the components of two vectors together to construct a third vector.
 
@@ -184,7 +259,6 @@ Vector *_vectorAdd(Vector *a, Vector *b) {
 */
 
     Vector *sum;
-    unsigned int i;
 
     if (!_assertVectorDimensionsEqual(a, b))
         return NULL;
@@ -192,8 +266,7 @@ Vector *_vectorAdd(Vector *a, Vector *b) {
     if ((sum = _vectorNew(a->dimensions)) == NULL)
         return NULL;
 
-    for (i = 0; i < sum->dimensions; i++)
-        Vector_SetValue(sum, i, Vector_GetValue(a, i) + Vector_GetValue(b, i));
+    _inplaceVectorAdd(a, b, sum);
 
     return sum;
 }
@@ -209,7 +282,6 @@ Vector *_vectorSub(Vector *a, Vector *b) {
 */
 
     Vector *difference;
-    unsigned int i;
 
     if (!_assertVectorDimensionsEqual(a, b))
         return NULL;
@@ -217,8 +289,7 @@ Vector *_vectorSub(Vector *a, Vector *b) {
     if ((difference = _vectorNew(a->dimensions)) == NULL)
         return NULL;
 
-    for (i = 0; i < difference->dimensions; i++)
-        Vector_SetValue(difference, i, Vector_GetValue(a, i) - Vector_GetValue(b, i));
+    _inplaceVectorSub(a, b, difference);
 
     return difference;
 }
@@ -234,13 +305,11 @@ Vector *_vectorMul(Vector *self, VECTOR_TYPE multiplier) {
 */
 
     Vector *product;
-    unsigned int i;
 
     if ((product = _vectorNew(self->dimensions)) == NULL)
         return NULL;
 
-    for (i = 0; i < self->dimensions; i++)
-        Vector_SetValue(product, i, Vector_GetValue(self, i) * multiplier);
+    _inplaceVectorMul(self, multiplier, product);
 
     return product;
 }
@@ -0,0 +1,174 @@
+/*
+ *  Copyright (C) 2016 Warren Spencer warrenspencer27@gmail.com
+
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+PyObject *vectorArrayNew(PyTypeObject *type, PyObject *args, PyObject *kwds) {
+/*  Creates a new VectorArray from a sequence of Vectors, or a new PointCloud from a sequence of Points.
+
+    Inputs: type - Either VectorArrayType or PointCloudType.
+            args - A tuple containing a single sequence of elements, all of the same number of dimensions.
+            kwds - A dictionary of keyword arguments, which must be empty.
+
+    Outputs: A new VectorArray or PointCloud, or NULL if an error occurred.
+*/
+
+    PyObject *sequence,
+             *item;
+    PyTypeObject *elementType = type == &PointCloudType ? &PointType : &VectorType;
+    VectorArray *self;
+    VECTOR_TYPE *data;
+    Py_ssize_t count,
+               i;
+    unsigned int dimensions = 0,
+                 d;
+
+    if (kwds != NULL && PyDict_Size(kwds) != 0) {
+        PyErr_Format(PyExc_TypeError, "%s() takes no keyword arguments", type->tp_name);
+        return NULL;
+    }
+
+    if (PyTuple_GET_SIZE(args) != 1) {
+        PyErr_Format(PyExc_TypeError, "%s() takes a single sequence of %ss", type->tp_name,
+                     _vectorArrayElementName(type));
+        return NULL;
+    }
+
+    if ((sequence = PySequence_Fast(PyTuple_GET_ITEM(args, 0), "Expected a sequence of elements")) == NULL)
+        return NULL;
+    count = PySequence_Fast_GET_SIZE(sequence);
+
+    for (i = 0; i < count; i++) {
+        item = PySequence_Fast_GET_ITEM(sequence, i);
+        if (Py_TYPE(item) != elementType) {
+            PyErr_Format(PyExc_TypeError, "%s() requires %ss, not: \"%.400s\"", type->tp_name,
+                         _vectorArrayElementName(type), Py_TYPE(item)->tp_name);
+            Py_DECREF(sequence);
+            return NULL;
+        }
+
+        // Points & Vectors share the same layout for their dimensions & data
+        d = elementType == &PointType ? ((Point *)item)->dimensions : ((Vector *)item)->dimensions;
+        if (i == 0) {
+            dimensions = d;
+        } else if (d != dimensions) {
+            PyErr_Format(PyExc_ValueError, "%s() requires %ss of the same dimensions; element %zd has %u, not %u",
+                         type->tp_name, _vectorArrayElementName(type), i, d, dimensions);
+            Py_DECREF(sequence);
+            return NULL;
+        }
+    }
+
+    if ((self = _vectorArrayNew(type, count, dimensions)) == NULL) {
+        Py_DECREF(sequence);
+        return NULL;
+    }
+
+    for (i = 0; i < count; i++) {
+        item = PySequence_Fast_GET_ITEM(sequence, i);
+        data = elementType == &PointType ? ((Point *)item)->data : ((Vector *)item)->data;
+        for (d = 0; d < dimensions; d++)
+            VectorArray_Component(self, d)[i] = data[d];
+    }
+
+    Py_DECREF(sequence);
+    return (PyObject *)self;
+}
+
+
+void vectorArrayDeInit(VectorArray *self) {
+    /* De-allocates a VectorArray or PointCloud. */
+
+    PyMem_Free(self->data);
+    PyObject_Del(self);
+}
+
+
+PyObject *vectorArrayFromBytes(PyObject *cls, FASTCALL_PARAMETERS) {
+/*  Creates a new VectorArray or PointCloud from a buffer of elements of native doubles, laid out one after another.
+
+    Inputs: cls   - Either the VectorArray or the PointCloud type.
+            args  - An object supporting the buffer protocol, and the number of dimensions of each element.
+            nargs - The number of arguments in args.
+
+    Outputs: A new VectorArray or PointCloud, or NULL if an error occurred.
+*/
+
+    FASTCALL_UNPACK_ARGS
+    Py_buffer view;
+    VectorArray *self = NULL;
+    VECTOR_TYPE *src;
+    Py_ssize_t count,
+               i;
+    long dimensions;
+    unsigned int d;
+
+    if (!_assertArgCount("frombytes", nargs, 2) || !_parseLongArg(args[1], &dimensions))
+        return NULL;
+
+    if (dimensions < 1 || dimensions > UINT_MAX) {
+        PyErr_Format(PyExc_ValueError, "Invalid number of dimensions: %ld", dimensions);
+        return NULL;
+    }
+
+    if (!_getVectorTypeBuffer(args[0], -1, &view))
+        return NULL;
+
+    count = view.len / sizeof(VECTOR_TYPE);
+    if (count % dimensions != 0) {
+        PyErr_Format(PyExc_ValueError, "Buffer of %zd values does not hold a whole number of %ld dimensional elements.",
+                     count, dimensions);
+        PyBuffer_Release(&view);
+        return NULL;
+    }
+    count /= dimensions;
+
+    if ((self = _vectorArrayNew((PyTypeObject *)cls, count, (unsigned int)dimensions)) != NULL) {
+        src = (VECTOR_TYPE *)view.buf;
+        for (i = 0; i < count; i++)
+            for (d = 0; d < self->dimensions; d++)
+                memcpy(VectorArray_Component(self, d) + i, src++, sizeof(VECTOR_TYPE));
+    }
+
+    PyBuffer_Release(&view);
+    return (PyObject *)self;
+}
+
+
+PyObject *vectorArrayToBytes(VectorArray *self) {
+/*  Returns the elements of a VectorArray or PointCloud as a bytes object of native doubles, laid out one element after
+    another; the layout accepted by frombytes, Matrix.apply & transform_points.
+
+    Inputs: self - The array to convert.
+
+    Outputs: A new bytes object, or NULL if an error occurred.
+*/
+
+    PyObject *bytes;
+    VECTOR_TYPE *dst;
+    Py_ssize_t i;
+    unsigned int d;
+
+    if ((bytes = PyBytes_FromStringAndSize(NULL, (Py_ssize_t)(self->count * self->dimensions * sizeof(VECTOR_TYPE))))
+        == NULL)
+        return NULL;
+
+    dst = (VECTOR_TYPE *)PyBytes_AS_STRING(bytes);
+    for (i = 0; i < self->count; i++)
+        for (d = 0; d < self->dimensions; d++)
+            memcpy(dst++, VectorArray_Component(self, d) + i, sizeof(VECTOR_TYPE));
+
+    return bytes;
+}
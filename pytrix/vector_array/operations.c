@@ -0,0 +1,347 @@
+/*
+ *  Copyright (C) 2016 Warren Spencer warrenspencer27@gmail.com
+
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+Py_ssize_t vectorArrayLength(VectorArray *self) {
+/*  Returns the number of elements in a VectorArray or PointCloud.
+
+    Inputs: self - The array.
+
+    Outputs: The number of elements in self.
+*/
+
+    return self->count;
+}
+
+
+PyObject *vectorArrayItem(VectorArray *self, Py_ssize_t i) {
+/*  Returns the ith element of a VectorArray or PointCloud.
+
+    Inputs: self - The array.
+            i    - The index of the element to return.
+
+    Outputs: A new Vector, or Point for PointClouds, or NULL if an error occurred.
+*/
+
+    if (i < 0 || i >= self->count) {
+        PyErr_Format(PyExc_IndexError, "Cannot return element %zd of a %s with %zd elements.", i,
+                     Py_TYPE(self)->tp_name, self->count);
+        return NULL;
+    }
+
+    return _vectorArrayElement(self, i);
+}
+
+
+static PyObject *_vectorArrayAddOrSub(PyObject *a, PyObject *b, VECTOR_TYPE sign) {
+/*  Adds or subtracts two operands, at least one of which is a VectorArray or PointCloud, element by element.  The
+    other operand may be an array of the same size, or a single Vector or Point applied to every element.  As with
+    Points & Vectors, adding vectors to points or subtracting them from points gives points, subtracting points from
+    points gives vectors, and combining vectors gives vectors.
+
+    Inputs: a    - Supposedly the first operand.
+            b    - Supposedly the second operand.
+            sign - 1 to compute a + b, -1 to compute a - b.
+
+    Outputs: A new VectorArray or PointCloud, NotImplemented if the operands cannot be combined, or NULL if an error
+             occurred.
+*/
+
+    VectorArrayOperand left,
+                       right;
+    VectorArray *result;
+    PyTypeObject *type;
+    Py_ssize_t count;
+
+    if (!_vectorArrayOperand(a, &left) || !_vectorArrayOperand(b, &right) || (left.count == -1 && right.count == -1)) {
+        Py_INCREF(Py_NotImplemented);
+        return Py_NotImplemented;
+    }
+
+    if (left.isPoint && right.isPoint) {
+        if (sign > 0) {
+            Py_INCREF(Py_NotImplemented);
+            return Py_NotImplemented;
+        }
+        type = &VectorArrayType;
+    } else if (right.isPoint) {
+        if (sign < 0) {
+            Py_INCREF(Py_NotImplemented);
+            return Py_NotImplemented;
+        }
+        type = &PointCloudType;
+    } else {
+        type = left.isPoint ? &PointCloudType : &VectorArrayType;
+    }
+
+    if (left.dimensions != right.dimensions) {
+        PyErr_Format(PyExc_ValueError, "Operands must have the same number of dimensions, not %u & %u",
+                     left.dimensions, right.dimensions);
+        return NULL;
+    }
+
+    if (left.count != -1 && right.count != -1 && left.count != right.count) {
+        PyErr_Format(PyExc_ValueError, "Operands must have the same number of elements, not %zd & %zd", left.count,
+                     right.count);
+        return NULL;
+    }
+
+    count = left.count == -1 ? right.count : left.count;
+    if ((result = _vectorArrayNew(type, count, left.dimensions)) == NULL)
+        return NULL;
+
+    _vectorArrayCombine(&left, &right, sign, result->data, count);
+    return (PyObject *)result;
+}
+
+
+PyObject *vectorArrayAdd(PyObject *a, PyObject *b) {
+/*  Adds two operands, at least one of which is a VectorArray or PointCloud, element by element.
+    Note that both arguments must be sanitized, as any Python object may be passed in either slot.
+
+    Inputs: a - Supposedly the first operand to add.
+            b - Supposedly the second operand to add.
+
+    Outputs: A new VectorArray or PointCloud constructed by performing a + b, or NULL if an exception occurred.
+*/
+
+    return _vectorArrayAddOrSub(a, b, 1);
+}
+
+
+PyObject *vectorArraySub(PyObject *a, PyObject *b) {
+/*  Subtracts two operands, at least one of which is a VectorArray or PointCloud, element by element.
+    Note that both arguments must be sanitized, as any Python object may be passed in either slot.
+
+    Inputs: a - Supposedly the operand to subtract from.
+            b - Supposedly the operand to subtract.
+
+    Outputs: A new VectorArray or PointCloud constructed by performing a - b, or NULL if an exception occurred.
+*/
+
+    return _vectorArrayAddOrSub(a, b, -1);
+}
+
+
+PyObject *vectorArrayMul(PyObject *a, PyObject *b) {
+/*  Multiplies each element of a VectorArray or PointCloud by a scalar.
+    Note that both arguments must be sanitized, as any Python object may be passed in either slot.
+
+    Inputs: a - Supposedly either the array or the scalar to multiply it by.
+            b - Supposedly either the array or the scalar to multiply it by.
+
+    Outputs: A new VectorArray or PointCloud, NotImplemented if neither operand is a scalar, or NULL if an exception
+             occurred.
+*/
+
+    VectorArray *self,
+                *result;
+    VECTOR_TYPE scalar,
+                *src,
+                *dst;
+    Py_ssize_t i,
+               size;
+
+    if (PyNumber_Check(a)) {
+        self = (VectorArray *)b;
+        scalar = PyNumber_AS_VECTOR_TYPE(a);
+    } else if (PyNumber_Check(b)) {
+        self = (VectorArray *)a;
+        scalar = PyNumber_AS_VECTOR_TYPE(b);
+    } else {
+        Py_INCREF(Py_NotImplemented);
+        return Py_NotImplemented;
+    }
+
+    if (scalar == -1 && PyErr_Occurred())
+        return NULL;
+
+    if ((result = _vectorArrayNew(Py_TYPE(self), self->count, self->dimensions)) == NULL)
+        return NULL;
+
+    src = self->data;
+    dst = result->data;
+    size = self->count * self->dimensions;
+    for (i = 0; i < size; i++)
+        dst[i] = src[i] * scalar;
+
+    return (PyObject *)result;
+}
+
+
+PyObject *vectorArrayNeg(VectorArray *self) {
+/*  Negates each element of a VectorArray or PointCloud.
+
+    Inputs: self - The array to negate.
+
+    Outputs: A new array of the same type as self, or NULL if an error occurred.
+*/
+
+    VectorArray *result;
+    Py_ssize_t i,
+               size = self->count * self->dimensions;
+
+    if ((result = _vectorArrayNew(Py_TYPE(self), self->count, self->dimensions)) == NULL)
+        return NULL;
+
+    for (i = 0; i < size; i++)
+        result->data[i] = -self->data[i];
+
+    return (PyObject *)result;
+}
+
+
+PyObject *vectorArrayRichCmp(PyObject *a, PyObject *b, int op) {
+/*  Compares two VectorArrays or PointClouds for equality.
+
+    Inputs: a  - The first array to compare.
+            b  - The object to compare it with.
+            op - The comparison operation; only Py_EQ & Py_NE are supported.
+
+    Outputs: A PyBoolean, or NotImplemented if the comparison is not supported.
+*/
+
+    VectorArray *left = (VectorArray *)a,
+                *right = (VectorArray *)b;
+    Py_ssize_t i,
+               size;
+    unsigned char equal;
+
+    if ((op != Py_EQ && op != Py_NE) || Py_TYPE(a) != Py_TYPE(b)) {
+        Py_INCREF(Py_NotImplemented);
+        return Py_NotImplemented;
+    }
+
+    equal = left->count == right->count && left->dimensions == right->dimensions;
+    size = left->count * left->dimensions;
+    for (i = 0; equal && i < size; i++)
+        equal = left->data[i] == right->data[i];
+
+    if (equal == (op == Py_EQ))
+        Py_RETURN_TRUE;
+    Py_RETURN_FALSE;
+}
+
+
+PyObject *vectorArrayCentroid(VectorArray *self) {
+/*  Computes the mean of the elements of a VectorArray or PointCloud.
+
+    Inputs: self - The array.
+
+    Outputs: A new Vector, or Point for PointClouds, or NULL if an error occurred.
+*/
+
+    PyObject *centroid;
+    VECTOR_TYPE *data,
+                *src,
+                sum;
+    Py_ssize_t i;
+    unsigned int d;
+
+    if (self->count == 0) {
+        PyErr_Format(PyExc_ValueError, "Cannot take the centroid of an empty %s.", Py_TYPE(self)->tp_name);
+        return NULL;
+    }
+
+    if (PointCloud_Check(self)) {
+        if ((centroid = (PyObject *)_pointNew(self->dimensions)) == NULL)
+            return NULL;
+        data = ((Point *)centroid)->data;
+    } else {
+        if ((centroid = (PyObject *)_vectorNew(self->dimensions)) == NULL)
+            return NULL;
+        data = ((Vector *)centroid)->data;
+    }
+
+    for (d = 0; d < self->dimensions; d++) {
+        src = VectorArray_Component(self, d);
+        sum = 0;
+        for (i = 0; i < self->count; i++)
+            sum += src[i];
+        data[d] = sum / self->count;
+    }
+
+    return centroid;
+}
+
+
+PyObject *vectorArrayBounds(VectorArray *self) {
+/*  Computes the axis aligned bounding box of the elements of a VectorArray or PointCloud.
+
+    Inputs: self - The array.
+
+    Outputs: A tuple of the minimum & maximum of each component, as Vectors, or Points for PointClouds.  NULL if an
+             error occurred.
+*/
+
+    PyObject *lower,
+             *upper;
+    VECTOR_TYPE *src,
+                low,
+                high;
+    Py_ssize_t i;
+    unsigned int d;
+
+    if (self->count == 0) {
+        PyErr_Format(PyExc_ValueError, "Cannot take the bounds of an empty %s.", Py_TYPE(self)->tp_name);
+        return NULL;
+    }
+
+    if ((lower = _vectorArrayElement(self, 0)) == NULL)
+        return NULL;
+    if ((upper = _vectorArrayElement(self, 0)) == NULL) {
+        Py_DECREF(lower);
+        return NULL;
+    }
+
+    for (d = 0; d < self->dimensions; d++) {
+        src = VectorArray_Component(self, d);
+        low = high = src[0];
+        for (i = 1; i < self->count; i++) {
+            low = src[i] < low ? src[i] : low;
+            high = src[i] > high ? src[i] : high;
+        }
+
+        // Points & Vectors share the same layout for their data
+        if (PointCloud_Check(self)) {
+            ((Point *)lower)->data[d] = low;
+            ((Point *)upper)->data[d] = high;
+        } else {
+            ((Vector *)lower)->data[d] = low;
+            ((Vector *)upper)->data[d] = high;
+        }
+    }
+
+    return Py_BuildValue("(NN)", lower, upper);
+}
+
+
+PyObject *vectorArrayTransformMethod(VectorArray *self, PyObject *m) {
+/*  Applies a matrix to each element of a VectorArray or PointCloud.
+
+    Inputs: self - The array to transform.
+            m    - The Matrix to multiply each vector by, or the (n+1)x(n+1) homogeneous transform to apply to each
+                   point.
+
+    Outputs: A new array of the same type as self, or NULL if an error occurred.
+*/
+
+    if (!_assertMatrix(m))
+        return NULL;
+
+    return (PyObject *)_vectorArrayTransform(self, (Matrix *)m);
+}
+
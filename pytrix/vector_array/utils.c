@@ -0,0 +1,466 @@
+/*
+ *  Copyright (C) 2016 Warren Spencer warrenspencer27@gmail.com
+
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+VectorArray *_vectorArrayNew(PyTypeObject *type, Py_ssize_t count, unsigned int dimensions) {
+/*  Creates a new, uninitialized VectorArray or PointCloud.
+
+    Inputs: type       - Either VectorArrayType or PointCloudType.
+            count      - The number of elements in the new array.
+            dimensions - The number of dimensions of each element.
+
+    Outputs: A pointer to the new array, or NULL if an error occurred.
+*/
+
+    VectorArray *newArray;
+    VECTOR_TYPE *data;
+
+    if ((data = PyMem_New(VECTOR_TYPE, (size_t)count * dimensions + 1)) == NULL)
+        return (VectorArray *)PyErr_NoMemory();
+
+    if ((newArray = PyObject_New(VectorArray, type)) == NULL) {
+        PyMem_Free(data);
+        return NULL;
+    }
+
+    newArray->count = count;
+    newArray->dimensions = dimensions;
+    newArray->data = data;
+
+    return newArray;
+}
+
+
+const char *_vectorArrayElementName(PyTypeObject *type) {
+/*  Returns the name of the type of element held by a VectorArray or PointCloud, for error messages.
+
+    Inputs: type - Either VectorArrayType or PointCloudType.
+
+    Outputs: Either "Vector" or "Point".
+*/
+
+    return type == &PointCloudType ? "Point" : "Vector";
+}
+
+
+PyObject *_vectorArrayElement(VectorArray *self, Py_ssize_t i) {
+/*  Gathers an element of a VectorArray or PointCloud into a new Vector or Point.  Does no bounds checking.
+
+    Inputs: self - The array.
+            i    - The index of the element to gather.
+
+    Outputs: A new Vector, or a Point if self is a PointCloud; or NULL if an error occurred.
+*/
+
+    VECTOR_TYPE *data;
+    PyObject *element;
+    unsigned int d;
+
+    if (PointCloud_Check(self)) {
+        if ((element = (PyObject *)_pointNew(self->dimensions)) == NULL)
+            return NULL;
+        data = ((Point *)element)->data;
+    } else {
+        if ((element = (PyObject *)_vectorNew(self->dimensions)) == NULL)
+            return NULL;
+        data = ((Vector *)element)->data;
+    }
+
+    for (d = 0; d < self->dimensions; d++)
+        data[d] = VectorArray_Component(self, d)[i];
+
+    return element;
+}
+
+
+unsigned char _vectorArrayOperand(PyObject *obj, VectorArrayOperand *operand) {
+/*  Describes an operand of an arithmetic operation on VectorArrays / PointClouds.
+
+    Inputs: obj     - The operand.
+            operand - Populated with a description of obj.
+
+    Outputs: 1 if obj is a VectorArray, PointCloud, Vector or Point, otherwise 0.
+*/
+
+    if (VectorArray_Check(obj) || PointCloud_Check(obj)) {
+        operand->data = ((VectorArray *)obj)->data;
+        operand->count = ((VectorArray *)obj)->count;
+        operand->dimensions = ((VectorArray *)obj)->dimensions;
+        operand->isPoint = PointCloud_Check(obj);
+    } else if (Vector_Check(obj)) {
+        operand->data = ((Vector *)obj)->data;
+        operand->count = -1;
+        operand->dimensions = ((Vector *)obj)->dimensions;
+        operand->isPoint = 0;
+    } else if (Point_Check(obj)) {
+        operand->data = ((Point *)obj)->data;
+        operand->count = -1;
+        operand->dimensions = ((Point *)obj)->dimensions;
+        operand->isPoint = 1;
+    } else {
+        return 0;
+    }
+
+    return 1;
+}
+
+
+void _vectorArrayCombine(VectorArrayOperand *a, VectorArrayOperand *b, VECTOR_TYPE sign, VECTOR_TYPE *out,
+                         Py_ssize_t count) {
+/*  Computes a + sign * b component by component, where either operand may be a single element applied to every
+    element of the other.  Each component is processed as a contiguous run of values.
+
+    Inputs: a     - The first operand.
+            b     - The second operand.
+            sign  - Either 1 or -1.
+            out   - The data of the array to write the result into.
+            count - The number of elements in the result.
+*/
+
+    unsigned int d;
+    Py_ssize_t i;
+    VECTOR_TYPE *dst,
+                *srcA,
+                *srcB,
+                value;
+
+    for (d = 0; d < a->dimensions; d++) {
+        dst = out + (size_t)d * count;
+
+        if (a->count == -1) {
+            value = a->data[d];
+            srcB = b->data + (size_t)d * count;
+            for (i = 0; i < count; i++)
+                dst[i] = value + sign * srcB[i];
+
+        } else if (b->count == -1) {
+            value = sign * b->data[d];
+            srcA = a->data + (size_t)d * count;
+            for (i = 0; i < count; i++)
+                dst[i] = srcA[i] + value;
+
+        } else {
+            srcA = a->data + (size_t)d * count;
+            srcB = b->data + (size_t)d * count;
+            for (i = 0; i < count; i++)
+                dst[i] = srcA[i] + sign * srcB[i];
+        }
+    }
+}
+
+
+static void _vectorArrayTransformTask(void *context, Py_ssize_t start, Py_ssize_t end, unsigned int worker) {
+/*  Applies a matrix to a range of the elements of an array, VECTOR_ARRAY_BLOCK elements at a time.  For each block,
+    every output component is accumulated as a scaled sum of contiguous runs of the input components.
+
+    Inputs: context - The VectorArrayTransform to apply.
+            start   - The index of the first element to transform.
+            end     - The index after the last element to transform.
+            worker  - The index of the thread running the task; unused.
+*/
+
+    VectorArrayTransform *transform = (VectorArrayTransform *)context;
+    unsigned int stride = transform->inDimensions + transform->homogeneous,
+                 n = transform->inDimensions,
+                 row,
+                 col;
+    Py_ssize_t block,
+               size,
+               i;
+    VECTOR_TYPE w[VECTOR_ARRAY_BLOCK],
+                values[VECTOR_ARRAY_BLOCK],
+                *dst,
+                *src,
+                factor;
+
+    for (block = start; block < end; block += size) {
+        size = end - block < VECTOR_ARRAY_BLOCK ? end - block : VECTOR_ARRAY_BLOCK;
+
+        if (transform->projective) {
+            for (i = 0; i < size; i++)
+                w[i] = transform->matrix[n * stride + n];
+            for (col = 0; col < n; col++) {
+                factor = transform->matrix[n * stride + col];
+                src = transform->in + (size_t)col * transform->count + block;
+                for (i = 0; i < size; i++)
+                    w[i] += factor * src[i];
+            }
+        }
+
+        for (row = 0; row < transform->outDimensions; row++) {
+            // Interleaved results are accumulated in a block of their own, then scattered into place
+            dst = transform->interleaved ? values : transform->out + (size_t)row * transform->count + block;
+
+            factor = transform->homogeneous ? transform->matrix[row * stride + n] : 0;
+            for (i = 0; i < size; i++)
+                dst[i] = factor;
+
+            for (col = 0; col < n; col++) {
+                factor = transform->matrix[row * stride + col];
+                src = transform->in + (size_t)col * transform->count + block;
+                for (i = 0; i < size; i++)
+                    dst[i] += factor * src[i];
+            }
+
+            if (transform->projective)
+                for (i = 0; i < size; i++)
+                    dst[i] /= w[i];
+
+            if (transform->interleaved)
+                for (i = 0; i < size; i++)
+                    transform->out[(size_t)(block + i) * transform->outDimensions + row] = values[i];
+        }
+    }
+}
+
+
+unsigned char _vectorArrayTransformInto(VectorArray *self, Matrix *m, VECTOR_TYPE *out, unsigned char interleaved) {
+/*  Applies a matrix to each element of a VectorArray or PointCloud, writing the results into an existing array.
+    Vectors are multiplied by the matrix, while points are transformed by it as an (n+1)x(n+1) homogeneous transform.
+    The dimensions of the matrix must already have been checked.  The work is split between threads, without holding
+    the GIL.
+
+    Inputs: self        - The array to transform.
+            m           - The matrix to apply.
+            out         - Where to write the transformed elements.  Must not overlap the data of self.
+            interleaved - Whether to write the components of each element one after another, rather than laid out as
+                          the data of an array.
+
+    Outputs: 1 if successful, otherwise 0.
+*/
+
+    VectorArrayTransform transform;
+    unsigned int row,
+                 col;
+
+    transform.homogeneous = PointCloud_Check(self);
+    transform.inDimensions = self->dimensions;
+    transform.outDimensions = transform.homogeneous ? self->dimensions : m->rows;
+
+    if ((transform.matrix = PyMem_New(VECTOR_TYPE, (size_t)m->rows * m->columns + 1)) == NULL) {
+        PyErr_NoMemory();
+        return 0;
+    }
+
+    transform.projective = 0;
+    for (row = 0; row < m->rows; row++) {
+        for (col = 0; col < m->columns; col++) {
+            transform.matrix[row * m->columns + col] = Matrix_GetValue(m, row, col);
+            if (transform.homogeneous && row == self->dimensions &&
+                Matrix_GetValue(m, row, col) != (col == self->dimensions ? 1 : 0))
+                transform.projective = 1;
+        }
+    }
+
+    transform.in = self->data;
+    transform.out = out;
+    transform.count = self->count;
+    transform.interleaved = interleaved;
+
+    Py_BEGIN_ALLOW_THREADS
+    _parallelFor(_vectorArrayTransformTask, &transform, self->count, PARALLEL_MIN_CHUNK);
+    Py_END_ALLOW_THREADS
+
+    PyMem_Free(transform.matrix);
+    return 1;
+}
+
+
+VectorArray *_vectorArrayTransform(VectorArray *self, Matrix *m) {
+/*  Applies a matrix to each element of a VectorArray or PointCloud.  Vectors are multiplied by the matrix, while
+    points are transformed by it as an (n+1)x(n+1) homogeneous transform.
+
+    Inputs: self - The array to transform.
+            m    - The matrix to apply.
+
+    Outputs: A new array of the same type as self holding the transformed elements, or NULL if an error occurred.
+*/
+
+    VectorArray *result;
+
+    if (PointCloud_Check(self)) {
+        if (m->rows != self->dimensions + 1 || m->columns != self->dimensions + 1) {
+            PyErr_Format(PyExc_ValueError, "Transforming %u dimensional Points requires a %ux%u homogeneous transform "
+                         "Matrix, not %ux%u", self->dimensions, self->dimensions + 1, self->dimensions + 1, m->rows,
+                         m->columns);
+            return NULL;
+        }
+
+    } else if (m->columns != self->dimensions) {
+        PyErr_SetString(PyExc_ValueError, "Matrix * Vector multiplication must have M.cols = V.dimensions");
+        return NULL;
+    }
+
+    if ((result = _vectorArrayNew(Py_TYPE(self), self->count, PointCloud_Check(self) ? self->dimensions : m->rows))
+        == NULL)
+        return NULL;
+
+    if (!_vectorArrayTransformInto(self, m, result->data, 0))
+        Py_CLEAR(result);
+
+    return result;
+}
+
+
+unsigned char _vectorArrayParseBatch(BatchElements *batch, const char *name, PyObject *elements, PyObject *outArg,
+                                     PyTypeObject *elementType, unsigned int inDimensions, unsigned int outDimensions) {
+/*  Gathers the elements given to a batched operation, and prepares where its results are to be written.  Elements
+    may be given as a sequence of Points or Vectors, as an object supporting the buffer protocol containing elements
+    of native doubles laid out one after another, or as a PointCloud or VectorArray, whose data is read in place.
+
+    Results are written either into out, which must be a writable buffer of exactly the size of the results, each
+    element's components laid out one after another; into a new array of the same type as an array of elements; or
+    otherwise into a new Matrix whose rows are stored contiguously.
+
+    Inputs: batch         - Populated with the elements & results.  Must be released with _vectorArrayReleaseBatch
+                            on success.
+            name          - The name of the operation, for error messages.
+            elements      - The elements to gather.
+            outArg        - The buffer to write the results into, or Py_None.
+            elementType   - Either PointType or VectorType.
+            inDimensions  - The number of dimensions each element must have.
+            outDimensions - The number of dimensions of each result.
+
+    Outputs: 1 if successful, otherwise 0.
+*/
+
+    PyTypeObject *arrayType = elementType == &PointType ? &PointCloudType : &VectorArrayType;
+    const char *elementName = _vectorArrayElementName(arrayType);
+    PyObject *item;
+    Py_ssize_t i;
+    unsigned int dimensions;
+
+    batch->inputs = NULL;
+    batch->array = NULL;
+    batch->sequence = NULL;
+    batch->haveView = 0;
+    batch->result = NULL;
+    batch->out = NULL;
+    batch->haveOutView = 0;
+
+    if (Py_TYPE(elements) == arrayType) {
+        batch->array = (VectorArray *)elements;
+        batch->count = batch->array->count;
+        // Empty arrays have no dimensions of their own, and are accepted by any operation
+        if (batch->count && batch->array->dimensions != inDimensions) {
+            PyErr_Format(PyExc_ValueError, "%s requires %ss of %u dimensions, not %u", name, elementName,
+                         inDimensions, batch->array->dimensions);
+            goto error;
+        }
+
+    } else if (PyObject_CheckBuffer(elements)) {
+        if (!_getVectorTypeBuffer(elements, -1, &batch->view))
+            goto error;
+        batch->haveView = 1;
+
+        batch->count = batch->view.len / sizeof(VECTOR_TYPE);
+        if (inDimensions == 0 || batch->count % inDimensions != 0) {
+            PyErr_Format(PyExc_ValueError, "Buffer of %zd values does not hold a whole number of %u dimensional "
+                         "%ss.", batch->count, inDimensions, elementName);
+            goto error;
+        }
+        batch->count /= inDimensions;
+
+        if ((batch->inputs = PyMem_New(VECTOR_TYPE *, batch->count + 1)) == NULL) {
+            PyErr_NoMemory();
+            goto error;
+        }
+        for (i = 0; i < batch->count; i++)
+            batch->inputs[i] = (VECTOR_TYPE *)batch->view.buf + (size_t)i * inDimensions;
+
+    } else {
+        // Take a tuple of the elements so that they are kept alive while the GIL is released
+        if ((batch->sequence = PySequence_Tuple(elements)) == NULL)
+            goto error;
+
+        batch->count = PyTuple_GET_SIZE(batch->sequence);
+        if ((batch->inputs = PyMem_New(VECTOR_TYPE *, batch->count + 1)) == NULL) {
+            PyErr_NoMemory();
+            goto error;
+        }
+
+        for (i = 0; i < batch->count; i++) {
+            item = PyTuple_GET_ITEM(batch->sequence, i);
+            if (Py_TYPE(item) != elementType) {
+                PyErr_Format(PyExc_TypeError, "%s requires %ss, not: \"%.400s\"", name, elementName,
+                             Py_TYPE(item)->tp_name);
+                goto error;
+            }
+
+            dimensions = elementType == &PointType ? ((Point *)item)->dimensions : ((Vector *)item)->dimensions;
+            if (dimensions != inDimensions) {
+                PyErr_Format(PyExc_ValueError, "%s requires %ss of %u dimensions; %s %zd has %u", name, elementName,
+                             inDimensions, elementName, i, dimensions);
+                goto error;
+            }
+            batch->inputs[i] = elementType == &PointType ? ((Point *)item)->data : ((Vector *)item)->data;
+        }
+    }
+
+    if (outArg != Py_None) {
+        if (PyObject_GetBuffer(outArg, &batch->outView, PyBUF_C_CONTIGUOUS | PyBUF_WRITABLE) == -1)
+            goto error;
+        batch->haveOutView = 1;
+
+        if (batch->outView.len != batch->count * outDimensions * (Py_ssize_t)sizeof(VECTOR_TYPE)) {
+            PyErr_Format(PyExc_ValueError, "%s out buffer must be %zd bytes, not %zd bytes.", name,
+                         batch->count * outDimensions * (Py_ssize_t)sizeof(VECTOR_TYPE), batch->outView.len);
+            goto error;
+        }
+        batch->out = (VECTOR_TYPE *)batch->outView.buf;
+        Py_INCREF(outArg);
+        batch->result = outArg;
+
+    } else if (batch->array != NULL) {
+        if ((batch->result = (PyObject *)_vectorArrayNew(arrayType, batch->count, outDimensions)) == NULL)
+            goto error;
+
+    } else {
+        if (batch->count > UINT_MAX) {
+            PyErr_Format(PyExc_ValueError, "%s can transform at most %u %ss at once.", name, UINT_MAX, elementName);
+            goto error;
+        }
+        if ((batch->result = (PyObject *)_matrixNewContiguous((unsigned int)batch->count, outDimensions)) == NULL)
+            goto error;
+        batch->out = batch->count ? Matrix_GetVector(((Matrix *)batch->result), 0)->data : NULL;
+    }
+
+    return 1;
+
+error:
+    _vectorArrayReleaseBatch(batch);
+    return 0;
+}
+
+
+void _vectorArrayReleaseBatch(BatchElements *batch) {
+/*  Releases the elements gathered for a batched operation.  The reference held to its result is not released.
+
+    Inputs: batch - The batch to release.
+*/
+
+    if (batch->haveView)
+        PyBuffer_Release(&batch->view);
+    if (batch->haveOutView)
+        PyBuffer_Release(&batch->outView);
+    Py_XDECREF(batch->sequence);
+    PyMem_Free(batch->inputs);
+
+    batch->haveView = 0;
+    batch->haveOutView = 0;
+    batch->sequence = NULL;
+    batch->inputs = NULL;
+}
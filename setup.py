@@ -5,6 +5,9 @@ DEBUG_COMPILE_ARGS = None
 VERSION = "0.0.3"
 NAME = "pytrix"
 
+# Batch operations split large inputs between threads
+LIBRARIES = [] if os.name == "nt" else ['pthread']
+
 if "DEBUG" in os.environ:
     DEBUG_COMPILE_ARGS = ['-O0', '-g', '-g3', '-pedantic', '-Wall', '-Wextra', '-Wmissing-prototypes',
                           '-Wstrict-prototypes', '-Wold-style-definition']
@@ -27,6 +30,7 @@ distutils.core.setup(
             NAME,
             sources = ['{0}/{0}.c'.format(NAME)],
             include_dirs = [NAME],
+            libraries = LIBRARIES,
             extra_compile_args=DEBUG_COMPILE_ARGS
         )
      ]
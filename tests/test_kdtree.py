@@ -0,0 +1,72 @@
+# Project imports
+import pytrix
+import tests
+
+class TestKDTree(tests.PytrixTestCase):
+
+    def setUp(self):
+        # A grid with many equally distant points, so that ties have to be broken consistently
+        self.points = [pytrix.Point(x, y) for x in range(10) for y in range(10)]
+        self.tree = pytrix.KDTree(self.points)
+
+    def _nearest(self, query, k):
+        distances = sorted(((p - query).length(), i) for i, p in enumerate(self.points))
+        return [i for _, i in distances[:k]]
+
+
+    def testKDTreeInit(self):
+        self.assertEqual((len(self.tree), self.tree.dimensions), (100, 2))
+        self.assertEqual(len(pytrix.KDTree(pytrix.PointCloud(self.points))), 100)
+        self.assertEqual(len(pytrix.KDTree([])), 0)
+
+        self.assertRaises(TypeError, pytrix.KDTree)
+        self.assertRaises(TypeError, pytrix.KDTree, 1)
+        self.assertRaises(TypeError, pytrix.KDTree, [pytrix.Vector(1, 2)])
+        self.assertRaises(ValueError, pytrix.KDTree, [pytrix.Point(1, 2), pytrix.Point(1)])
+        self.assertRaises(ValueError, pytrix.KDTree, [pytrix.Point([])])
+
+    def testKDTreeQuery(self):
+        for query in (pytrix.Point(4.5, 4.5), pytrix.Point(0, 0), pytrix.Point(-3, 12), pytrix.Point(7.2, 3)):
+            for k in (1, 4, 9, 100):
+                neighbours = self.tree.query(query, k)
+                self.assertEqual([i for _, i in neighbours], self._nearest(query, k))
+                for distance, i in neighbours:
+                    self.assertAlmostEqual(distance, (self.points[i] - query).length())
+
+        self.assertEqual(self.tree.query(pytrix.Point(3, 4)), [(0, 34)])
+        self.assertEqual(len(self.tree.query(pytrix.Point(3, 4), k=1000)), 100)
+        self.assertEqual(pytrix.KDTree([]).query(pytrix.Point(1, 2)), [])
+
+        self.assertRaises(ValueError, self.tree.query, pytrix.Point(1, 2, 3))
+        self.assertRaises(ValueError, self.tree.query, pytrix.Point(1, 2), 0)
+        self.assertRaises(TypeError, self.tree.query, pytrix.Vector(1, 2))
+        self.assertRaises(TypeError, self.tree.query, pytrix.Point(1, 2), k=None)
+
+    def testKDTreeQueryBatch(self):
+        queries = [pytrix.Point(x / 3.0, 9 - x / 2.0) for x in range(20)]
+        expected = [self.tree.query(q, 5) for q in queries]
+        self.assertEqual(self.tree.query_batch(queries, 5), expected)
+        self.assertEqual(self.tree.query_batch(pytrix.PointCloud(queries), k=5), expected)
+        self.assertEqual(self.tree.query_batch([]), [])
+
+        self.assertRaises(ValueError, self.tree.query_batch, [pytrix.Point(1)])
+        self.assertRaises(TypeError, self.tree.query_batch, pytrix.Point(1, 2))
+
+    def testKDTreeQueryRadius(self):
+        query = pytrix.Point(4.5, 5)
+        for radius in (0, 0.5, 1.2, 3, 20):
+            expected = [i for i, p in enumerate(self.points) if (p - query).length() <= radius]
+            self.assertEqual(self.tree.query_radius(query, radius), expected)
+        self.assertEqual(self.tree.query_radius(pytrix.Point(2, 2), 0), [22])
+        self.assertEqual(self.tree.query_radius(pytrix.Point(2, 2), -1), [])
+
+        self.assertRaises(TypeError, self.tree.query_radius, query)
+        self.assertRaises(TypeError, self.tree.query_radius, query, None)
+
+    def testKDTreeQueryBox(self):
+        self.assertEqual(self.tree.query_box(pytrix.Point(1, 2), pytrix.Point(2.5, 3)), [12, 13, 22, 23])
+        self.assertEqual(self.tree.query_box(pytrix.Point(-1, -1), pytrix.Point(20, 20)), list(range(100)))
+        self.assertEqual(self.tree.query_box(pytrix.Point(3, 3), pytrix.Point(2, 2)), [])
+
+        self.assertRaises(ValueError, self.tree.query_box, pytrix.Point(1), pytrix.Point(2))
+        self.assertRaises(TypeError, self.tree.query_box, pytrix.Point(1, 2))
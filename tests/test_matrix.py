@@ -1,3 +1,11 @@
+# Standard imports
+import os, pickle, struct, subprocess, sys, tempfile, unittest
+
+try:
+    from multiprocessing import shared_memory
+except ImportError:
+    shared_memory = None
+
 # Project imports
 import pytrix
 import tests
@@ -28,6 +36,15 @@ class TestMatrix(tests.PytrixTestCase):
             for j in range(m1.columns):
                 self.assertAlmostEqual(m1[i][j], m2[i][j], delta=.0001)
 
+    def _assertScaledInverse(self, inverse, scales):
+        for i in range(inverse.rows):
+            for j in range(inverse.columns):
+                self.assertAlmostEqual(inverse[i][j], 1 / scales[i] if i == j else 0, delta=1e-12 / scales[i])
+
+    def _scaledMatrices(self):
+        # Diagonal matrices whose closed form determinants & adjugates underflow or overflow
+        return [[scale] * size for size in (2, 3, 4) for scale in (1e-200, 1e200)] + [[1e-200, 1e200, 1, 1e-100]]
+
     def testMatrixRowsColumns(self):
         self.assertEqual(self.e1.rows, 0)
         self.assertEqual(self.e1.columns, 0)
@@ -62,6 +79,7 @@ class TestMatrix(tests.PytrixTestCase):
         self.assertRaises(TypeError, pytrix.Matrix, [1, 2, 3], [[1, 2, 3]])
         self.assertRaises(TypeError, pytrix.Matrix, pytrix.Point([1, 2, 3]))
         self.assertRaises(TypeError, pytrix.Matrix, pytrix.Vector([1, 2, 3]))
+        self.assertRaises(TypeError, pytrix.Matrix, [1, 2], rows=1)
 
     def testMatrixCopy(self):
         self.assertEqual(self.m1, self.m1.copy())
@@ -70,6 +88,21 @@ class TestMatrix(tests.PytrixTestCase):
         self.assertNotEqual(id(self.m1), id(self.m1.copy()))
         self.assertNotEqual(id(self.e1), id(self.e1.copy()))
 
+    def testMatrixHash(self):
+        self.assertEqual(hash(self.m1), hash(self.m1.copy()))
+        self.assertEqual(hash(self.e1), hash(pytrix.Matrix([])))
+        self.assertNotEqual(hash(self.m1), hash(self.m2))
+        self.assertNotEqual(hash(self.zero2), hash(self.zero3))
+        self.assertNotEqual(hash(pytrix.Matrix([1, 2, 3, 4])), hash(pytrix.Matrix([1, 2], [3, 4])))
+        self.assertEqual(len(set([self.m1, self.m1.copy(), self.m2, self.zero1, self.zero2, self.zero3])), 5)
+        self.assertEqual({self.m1: 1}[pytrix.Matrix([[1, 2, 3], [4, 5, 6], [7, 8, 9]])], 1)
+
+        # Equality must still hold between matrices which have both been hashed
+        hash(self.m1)
+        hash(self.m2)
+        self.assertNotEqual(self.m1, self.m2)
+        self.assertEqual(self.m1, self.m1.copy())
+
     def testMatrixAdd(self):
         # Test typical matrix additions
         self._assertMatrixEqual(self.m1 + self.m2, [10, 10, 10], [10, 10, 10], [10, 10, 10])
@@ -302,6 +335,8 @@ class TestMatrix(tests.PytrixTestCase):
         self.assertRaises(TypeError, self.m1.permute, 0, "5")
         self.assertRaises(TypeError, self.m1.permute, 0, [])
         self.assertRaises(TypeError, self.m1.permute, 0, pytrix.Point(1, 2, 3))
+        self.assertRaises(TypeError, self.m1.permute, 0)
+        self.assertRaises(TypeError, self.m1.permute, 0, 1, 2)
 
         self.assertEqual(self.zero1, self.zero1.permute(0, 0))
         self.assertEqual(self.m1, self.m1.permute(0, 0))
@@ -392,6 +427,41 @@ class TestMatrix(tests.PytrixTestCase):
         self.assertRaises(ValueError, pytrix.Matrix([[1], [2], [3], [4]]).determinant)
         self.assertRaises(ValueError, pytrix.Matrix([[0, 2, -6, -2, 4], [0, -1, 3, 3, 2], [0, -1, 3, 7, 10]]).determinant)
 
+    def testMatrixExact(self):
+        matrices = [
+            (self.e1, 1, 0),
+            (self.m1, 0, 2),
+            (self.zero1, 0, 0),
+            ([[2]], 2, 1),
+            ([[2, 0], [7, 0]], 0, 1),
+            ([[0, 0, 0], [1, 0, 0], [0, 0, 0]], 0, 1),
+            ([[2, -1, 3], [4, 2, 1], [-6, -1, 2]], 48, 3),
+            ([[1, 4, 2, 3], [1, 2, 1, 0], [2, 6, 3, 1], [0, 0, 1, 4]], -4, 4),
+            ([[0, 1, 0, 0, 0], [0, 0, 1, 0, 0], [0, 0, 0, 1, 0], [0, 0, 0, 0, 1], [1, 0, 0, 0, 0]], 1, 5),
+            # Too close to singular for floating point elimination
+            ([[2 ** 52 + 1, 2 ** 52], [2 ** 52, 2 ** 52 - 1]], -1, 2),
+            ([[2 ** 52, 2 ** 52 - 1], [2 ** 52 - 1, 2 ** 52 - 2]], -1, 2),
+            # Products overflowing 64 bit integers, and values too large for them
+            ([[2 ** 40, 1, 0], [1, 2 ** 40, 1], [0, 1, 2 ** 40]], 2 ** 120 - 2 ** 41, 3),
+            ([[0, 2 ** 70, 0], [2 ** 70, 0, 0], [0, 0, 3]], -3 * 2 ** 140, 3),
+        ]
+
+        for m, determinant, rank in matrices:
+            if not isinstance(m, pytrix.Matrix):
+                m = pytrix.Matrix(m)
+
+            self.assertEqual(m.det_exact(), determinant)
+            self.assertEqual(m.rank_exact(), rank)
+
+        self.assertEqual(pytrix.Matrix([[1, 2, 0, 2], [3, 6, -1, 8], [1, 2, 1, 0]]).rank_exact(), 2)
+        self.assertEqual(pytrix.Matrix([[0, 2, -6, -2, 4], [0, -1, 3, 3, 2], [0, -1, 3, 7, 10]]).rank_exact(), 2)
+        self.assertEqual(pytrix.Matrix([[2 ** 60, 2 ** 61], [2 ** 61 - 2 ** 8, 2 ** 62 - 2 ** 10]]).rank_exact(), 2)
+
+        self.assertRaises(ValueError, pytrix.Matrix([[1, 2, 3, 4], [5, 6, 7, 8]]).det_exact)
+        self.assertRaises(ValueError, pytrix.Matrix([[1, 2], [3, 4.5]]).det_exact)
+        self.assertRaises(ValueError, pytrix.Matrix([[1, 2], [3, 4.5]]).rank_exact)
+        self.assertRaises(ValueError, pytrix.Matrix([[1, 2], [3, float('inf')]]).rank_exact)
+
     def testMatrixInverse(self):
         matrices = [
             self.e1,
@@ -400,6 +470,7 @@ class TestMatrix(tests.PytrixTestCase):
             [[1, 1, 1], [2, 2, 5], [4, 6, 8]],
             [[2, -1, 3], [4, 2, 1], [ -6, -1, 2]],
             [[1, 4, 2, 3], [1, 2, 1, 0], [2, 6, 3, 1], [0, 0, 1, 4]],
+            [[0, 2, 0, 0], [3, 0, 0, 0], [0, 0, 0, 5], [0, 0, 7, 0]],
         ]
 
         for m in matrices:
@@ -407,6 +478,7 @@ class TestMatrix(tests.PytrixTestCase):
                 m = pytrix.Matrix(m)
             i = m.inverse()
             self._assertMatrixEqualWithDelta(i.inverse(), m)
+            self._assertMatrixEqualWithDelta(i * m, pytrix.identityMatrix(m.rows))
 
         self.assertRaises(ValueError, self.zero1.inverse)
         self.assertRaises(ValueError, self.zero2.inverse)
@@ -454,6 +526,41 @@ class TestMatrix(tests.PytrixTestCase):
                 m = pytrix.Matrix(m)
             self.assertFalse(m.isInvertible())
 
+    def testMatrixScaledInverse(self):
+        for scales in self._scaledMatrices():
+            m = pytrix.Matrix([[scale if row == col else 0 for col, scale in enumerate(scales)]
+                               for row in range(len(scales))])
+            determinant = 1
+            for scale in scales:
+                determinant *= scale
+            self.assertTrue(m.isInvertible())
+            self.assertEqual(m.determinant(), determinant)
+            self._assertScaledInverse(m.inverse(), scales)
+            self._assertScaledInverse(pytrix.batch_inverse([m, m])[1], scales)
+
+    def testMatrixBatchInverse(self):
+        matrices = [
+            pytrix.Matrix([[2, -1, 3], [4, 2, 1], [ -6, -1, 2]]),
+            pytrix.Matrix([[1, 1, 1], [2, 3, 5], [4, 6, 8]]),
+            pytrix.identityMatrix(3),
+        ]
+        inverses = pytrix.batch_inverse(matrices)
+        self.assertEqual(len(inverses), 3)
+        for m, i in zip(matrices, inverses):
+            self._assertMatrixEqualWithDelta(i, m.inverse())
+
+        for size in (1, 2, 4, 5):
+            m = pytrix.identityMatrix(size) * 2
+            self._assertMatrixEqualWithDelta(pytrix.batch_inverse([m, m])[1], m.inverse())
+        self.assertEqual(pytrix.batch_inverse([]), [])
+        self.assertEqual(pytrix.batch_inverse(()), [])
+
+        self.assertRaises(TypeError, pytrix.batch_inverse, 1)
+        self.assertRaises(TypeError, pytrix.batch_inverse, [self.m1, 1])
+        self.assertRaises(ValueError, pytrix.batch_inverse, [pytrix.identityMatrix(3), self.m1])
+        self.assertRaises(ValueError, pytrix.batch_inverse, [pytrix.identityMatrix(3), pytrix.identityMatrix(4)])
+        self.assertRaises(ValueError, pytrix.batch_inverse, [pytrix.Matrix([[1, 2, 3], [4, 5, 6]])])
+
     def testMatrixFactorLU(self):
         matrices = [
             self.e1,
@@ -634,3 +741,420 @@ class TestMatrix(tests.PytrixTestCase):
             self.assertEqual(nm, sm2)
             self.assertEqual(sm2, sm4)
             self.assertEqual(sm4, sm8)
+
+    def testMatrixSaveLoad(self):
+        directory = tempfile.mkdtemp()
+        path = os.path.join(directory, 'm.npy')
+
+        try:
+            for m in (self.e1, self.zero1, self.m1, pytrix.Matrix([[1.5, -2, 3], [4, 5, 6e100]])):
+                m.save(path)
+                with open(path, 'rb') as f:
+                    header = f.read(10)
+                self.assertEqual(header[:6], b'\x93NUMPY')
+                self.assertEqual((10 + struct.unpack('<H', header[8:10])[0]) % 64, 0)
+
+                self.assertEqual(pytrix.Matrix.load(path), m)
+                mapped = pytrix.Matrix.load(path, mmap=True)
+                self.assertEqual(mapped, m)
+
+                # Rows of a memory mapped matrix must keep the mapping alive after the matrix itself is gone
+                if m.rows:
+                    row = mapped[0]
+                    del mapped
+                    self.assertEqual(row, m[0])
+
+            # Fortran ordered and big endian files, as numpy could produce them
+            with open(path, 'wb') as f:
+                header = "{'descr': '>f8', 'fortran_order': True, 'shape': (2, 3), }".ljust(117) + '\n'
+                f.write(b'\x93NUMPY\x01\x00' + struct.pack('<H', len(header)) + header.encode('ascii'))
+                f.write(struct.pack('>6d', 1, 4, 2, 5, 3, 6))
+            self._assertMatrixEqual(pytrix.Matrix.load(path), [1, 2, 3], [4, 5, 6])
+            self.assertRaises(ValueError, pytrix.Matrix.load, path, mmap=True)
+
+            pytrix.Vector([1, 2, 3]).save(path)
+            self.assertRaises(ValueError, pytrix.Matrix.load, path)
+            with open(path, 'wb') as f:
+                f.write(b'not an npy file')
+            self.assertRaises(ValueError, pytrix.Matrix.load, path)
+            self.m1.save(path)
+            with open(path, 'r+b') as f:
+                f.truncate(100)
+            self.assertRaises(ValueError, pytrix.Matrix.load, path)
+            self.assertRaises(ValueError, pytrix.Matrix.load, path, mmap=True)
+            self.assertRaises(IOError, pytrix.Matrix.load, os.path.join(directory, 'missing.npy'))
+        finally:
+            if os.path.exists(path):
+                os.remove(path)
+            os.rmdir(directory)
+
+    def testMatrixPickle(self):
+        for protocol in range(pickle.HIGHEST_PROTOCOL + 1):
+            for m in (self.e1, self.zero1, self.m1, pytrix.Matrix([[1.5, -2, 3], [4, 5, 6e100]])):
+                unpickled = pickle.loads(pickle.dumps(m, protocol))
+                self.assertTrue(isinstance(unpickled, pytrix.Matrix))
+                self.assertEqual(unpickled, m)
+
+        if pickle.HIGHEST_PROTOCOL >= 5:
+            buffers = []
+            data = pickle.dumps(self.m1, 5, buffer_callback=buffers.append)
+            self.assertEqual(len(buffers), 1)
+            self.assertEqual(pickle.loads(data, buffers=buffers), self.m1)
+
+    def testMatrixFromBytes(self):
+        data = self.m1.__reduce_ex__(2)[1][0]
+        self.assertEqual(pytrix.Matrix.frombytes(data, 3, 3), self.m1)
+        self._assertMatrixEqual(pytrix.Matrix.frombytes(data, 1, 9), [1, 2, 3, 4, 5, 6, 7, 8, 9])
+
+        # Mutable buffers must be copied
+        mutable = bytearray(data)
+        m = pytrix.Matrix.frombytes(mutable, 3, 3)
+        mutable[:] = bytes(len(mutable))
+        self.assertEqual(m, self.m1)
+
+        self.assertRaises(ValueError, pytrix.Matrix.frombytes, data, 2, 2)
+        self.assertRaises(TypeError, pytrix.Matrix.frombytes, [1, 2, 3], 1, 3)
+
+    def testMatrixOut(self):
+        out = pytrix.Matrix.zeros(3, 3, mutable=True)
+        self.assertTrue(out.mutable)
+        self.assertFalse(self.m1.mutable)
+        self.assertRaises(TypeError, hash, out)
+
+        self.assertTrue(pytrix.add(self.m1, self.m2, out=out) is out)
+        self.assertEqual(out.copy(), self.m1 + self.m2)
+        self.assertTrue(pytrix.sub(out, self.m2, out) is out)
+        self.assertEqual(out.copy(), self.m1)
+        pytrix.scale(out, 2, out=out)
+        self.assertEqual(out.copy(), self.m1 * 2)
+        pytrix.matmul(self.m1, self.m2, out=out)
+        self.assertEqual(out.copy(), self.m1 * self.m2)
+        pytrix.matmul(out, out, out=out)
+        self.assertEqual(out.copy(), (self.m1 * self.m2) * (self.m1 * self.m2))
+
+        v = pytrix.Vector.zeros(3, mutable=True)
+        pytrix.add(v, pytrix.Vector(1, 2, 3), out=v)
+        pytrix.matmul(self.m1, v, out=v)
+        self.assertEqual(v.copy(), self.m1 * pytrix.Vector(1, 2, 3))
+
+        self.assertEqual(pytrix.add(self.m1, self.m2), self.m1 + self.m2)
+        self.assertEqual(pytrix.matmul(self.m1, self.m2), self.m1 * self.m2)
+        self.assertRaises(TypeError, pytrix.add, self.m1, self.m2, out=self.zero3)
+        self.assertRaises(TypeError, pytrix.add, self.m1, self.m2, out=v)
+        self.assertRaises(TypeError, pytrix.add, self.m1, self.m2, out, out=out)
+        self.assertRaises(TypeError, pytrix.add, self.m1, self.m2, into=out)
+        self.assertRaises(TypeError, pytrix.add, self.m1, v)
+        self.assertRaises(ValueError, pytrix.add, self.m1, self.m2, out=pytrix.Matrix.zeros(2, 2, mutable=True))
+        self.assertRaises(ValueError, pytrix.matmul, self.m1, pytrix.Vector(1, 2), out=v)
+
+    def testMatrixBuilder(self):
+        b = pytrix.MatrixBuilder(self.m1)
+        self.assertEqual((b.rows, b.columns), (3, 3))
+        self.assertRaises(TypeError, hash, b)
+        b += self.m2
+        b -= self.m1
+        b *= 2
+        self.assertEqual(b[0, 0], 18)
+        b[0, 0] = 1
+        b *= pytrix.identityMatrix(3)
+        b.swap_rows(0, 2)
+        b.scale_row(0, 0.5)
+        b.add_row(1, 0, 1)
+        b.add_row(2, 0, -2)
+
+        m = b.freeze()
+        self.assertTrue(isinstance(m, pytrix.Matrix))
+        self.assertFalse(m.mutable)
+        self._assertMatrixEqual(m, [3, 2, 1], [15, 12, 9], [-5, 12, 12])
+        self.assertEqual(hash(m), hash(m.copy()))
+        self.assertRaises(ValueError, b.freeze)
+        self.assertRaises(ValueError, b.swap_rows, 0, 1)
+
+        b = pytrix.MatrixBuilder(2, 3)
+        self._assertMatrixEqual(b.freeze(), [0, 0, 0], [0, 0, 0])
+        b = pytrix.MatrixBuilder(2, 3)
+        self.assertRaises(IndexError, lambda: b[2, 0])
+        self.assertRaises(IndexError, b.swap_rows, 0, 2)
+        self.assertRaises(TypeError, lambda: b[0])
+        with self.assertRaises(ValueError):
+            b += self.m1
+        with self.assertRaises(ValueError):
+            b *= self.zero2
+        with self.assertRaises(TypeError):
+            b += 1
+        self.assertRaises(TypeError, pytrix.MatrixBuilder)
+        self.assertRaises(TypeError, pytrix.MatrixBuilder, self.p)
+
+    def testMatrixApply(self):
+        vectors = [pytrix.Vector(1, 0, 0), pytrix.Vector(0, 1, 0), pytrix.Vector(1, 2, 3)]
+        result = self.m1.apply(vectors)
+        self.assertEqual((result.rows, result.columns), (3, 3))
+        self.assertEqual(list(result), [self.m1 * v for v in vectors])
+        self.assertEqual(result.tobytes(), b''.join((self.m1 * v).tobytes() for v in vectors))
+
+        packed = b''.join(v.tobytes() for v in vectors)
+        self.assertEqual(self.m1.apply(packed), result)
+        self.assertEqual(pytrix.Matrix([[1, 2, 3]]).apply(packed), pytrix.Matrix([[1], [2], [14]]))
+        self.assertEqual(self.m1.apply([]).rows, 0)
+
+        out = bytearray(len(packed))
+        self.assertTrue(self.m1.apply(packed, out=out) is out)
+        self.assertEqual(bytes(out), result.tobytes())
+        inplace = bytearray(packed)
+        self.m1.apply(inplace, out=inplace)
+        self.assertEqual(inplace, out)
+
+        # VectorArrays are read in place, and give a VectorArray of the products
+        array = self.m1.apply(pytrix.VectorArray(vectors))
+        self.assertTrue(isinstance(array, pytrix.VectorArray))
+        self.assertEqual(list(array), list(result))
+        self.assertEqual(pytrix.Matrix([[1, 2, 3]]).apply(pytrix.VectorArray(vectors)).dimensions, 1)
+        out = bytearray(len(packed))
+        self.assertTrue(self.m1.apply(pytrix.VectorArray(vectors), out=out) is out)
+        self.assertEqual(bytes(out), result.tobytes())
+        empty = pytrix.Matrix([[1, 2, 3]]).apply(pytrix.VectorArray([]))
+        self.assertEqual((len(empty), empty.dimensions), (0, 1))
+
+        self.assertRaises(ValueError, self.m1.apply, [pytrix.Vector(1, 2)])
+        self.assertRaises(ValueError, self.m1.apply, pytrix.VectorArray([pytrix.Vector(1, 2)]))
+        self.assertRaises(TypeError, self.m1.apply, [self.p])
+        self.assertRaises(ValueError, self.m1.apply, packed[:-8])
+        self.assertRaises(ValueError, self.m1.apply, packed, out=bytearray(8))
+        self.assertRaises(BufferError, self.m1.apply, packed, out=packed)
+
+    def testMatrixLinearCombination(self):
+        self.assertEqual(pytrix.linear_combination([1, 2, -1], [self.m1, self.m2, self.m1]), self.m2 * 2)
+        self.assertEqual(pytrix.axpy(-1, self.m1, self.m2), self.m2 - self.m1)
+        self.assertRaises(TypeError, pytrix.linear_combination, [1, 1], [self.m1, pytrix.Vector(1, 2, 3)])
+
+    def testMatrixMultiDot(self):
+        wide = pytrix.Matrix([[1, 2, 3]])
+        tall = pytrix.Matrix([[1], [2], [3]])
+        self.assertEqual(pytrix.multi_dot([tall, wide, self.m1, tall]), tall * wide * self.m1 * tall)
+        self.assertEqual(pytrix.multi_dot((self.m1, self.m2, self.m1)), self.m1 * self.m2 * self.m1)
+        self.assertEqual(pytrix.multi_dot([self.m1, self.m2, pytrix.Vector(1, 0, 1)]),
+                         self.m1 * (self.m2 * pytrix.Vector(1, 0, 1)))
+        self.assertEqual(pytrix.multi_dot([pytrix.Vector(1, 0, 0), self.m1]), pytrix.Vector(1, 2, 3))
+        self.assertEqual(pytrix.multi_dot([pytrix.Vector(1, 0, 0), self.m1, pytrix.Vector(0, 1, 0)]), 2)
+
+        self.assertRaises(ValueError, pytrix.multi_dot, [self.m1])
+        self.assertRaises(ValueError, pytrix.multi_dot, [self.m1, self.zero2])
+        self.assertRaises(TypeError, pytrix.multi_dot, [self.m1, pytrix.Vector(1, 2, 3), self.m1])
+        self.assertRaises(TypeError, pytrix.multi_dot, [self.m1, self.p])
+        self.assertRaises(TypeError, pytrix.multi_dot, self.m1)
+
+    def testMatrixLazy(self):
+        expr = pytrix.lazy(self.m1) * 2 + self.m2 - self.m1
+        self.assertTrue(isinstance(expr, pytrix.LazyMatrix))
+        self.assertEqual((expr.rows, expr.columns), (3, 3))
+        self.assertEqual(expr.evaluate(), self.m1 * 2 + self.m2 - self.m1)
+        self.assertEqual((-pytrix.lazy(self.m1)).evaluate(), -self.m1)
+        self.assertEqual((pytrix.lazy(self.m1) * self.m2).evaluate(), self.m1 * self.m2)
+        self.assertEqual((2 * pytrix.lazy(self.m1) * self.m2 + 3 * pytrix.lazy(self.m2)).evaluate(),
+                         (self.m1 * self.m2) * 2 + self.m2 * 3)
+        self.assertEqual((self.m1 * (pytrix.lazy(self.m2) - self.m1) * 0.5).evaluate(),
+                         (self.m1 * (self.m2 - self.m1)) * 0.5)
+        self.assertTrue(pytrix.lazy(self.m1).evaluate() is self.m1)
+
+        self.assertRaises(TypeError, pytrix.lazy, self.p)
+        self.assertRaises(TypeError, pytrix.lazy)
+        self.assertRaises(ValueError, lambda: pytrix.lazy(self.m1) + self.zero2)
+        self.assertRaises(ValueError, lambda: pytrix.lazy(self.m1) * self.zero2)
+        self.assertRaises(TypeError, lambda: pytrix.lazy(self.m1) + pytrix.Vector(1, 2, 3))
+
+        # Deep expressions must neither exhaust the C stack when evaluated nor when freed
+        expr = pytrix.lazy(self.zero1)
+        for i in range(200000):
+            expr = expr + self.zero1 if i % 2 else pytrix.Matrix([[1]]) - expr
+        self.assertEqual(expr.evaluate(), pytrix.Matrix([[0]]))
+        del expr
+
+        expr = pytrix.lazy(self.zero1)
+        for i in range(200000):
+            expr = expr * self.zero1
+        self.assertRaises(RuntimeError, expr.evaluate)
+        del expr
+
+    def testMatrixToList(self):
+        self.assertEqual(self.m1.tolist(), [[1, 2, 3], [4, 5, 6], [7, 8, 9]])
+        self.assertEqual(self.e1.tolist(), [])
+        self.assertTrue(all(isinstance(x, float) for row in self.m1.tolist() for x in row))
+        self.assertEqual(pytrix.Matrix.frombytes(self.m1.tobytes(), 3, 3), self.m1)
+        self.assertEqual(self.m1.tobytes(), struct.pack('9d', *range(1, 10)))
+
+    @unittest.skipIf(shared_memory is None, "multiprocessing.shared_memory is unavailable")
+    def testMatrixShared(self):
+        self.assertIsNone(self.m1.shared_name)
+
+        shared = self.m1.to_shared()
+        name = shared.shared_name
+        self.assertEqual(shared, self.m1)
+        self.assertIsNotNone(name)
+
+        attached = pytrix.Matrix.from_shared(name)
+        self.assertEqual(attached, self.m1)
+        self.assertEqual(attached.shared_name, name)
+
+        # Shared matrices are pickled by name
+        self.assertEqual(pickle.loads(pickle.dumps(shared)), self.m1)
+        self.assertTrue(len(pickle.dumps(shared)) < len(pickle.dumps(self.m1)))
+
+        # Segments can be attached to by plain Python code
+        segment = shared_memory.SharedMemory(name)
+        self.assertEqual(struct.unpack_from('9d', segment.buf, 64), tuple(float(i) for i in range(1, 10)))
+        segment.close()
+
+        # Operations on shared matrices produce ordinary ones
+        self.assertIsNone((shared + shared).shared_name)
+
+        # Processes attaching to a segment must not unlink it when they exit; stopping the attaching process's resource
+        # tracker waits for it to clean up anything registered with it
+        script = ("import sys; sys.path.insert(0, %r); import pytrix; assert pytrix.Matrix.from_shared(%r)[2][2] == 9; "
+                  "from multiprocessing import resource_tracker; "
+                  "getattr(resource_tracker._resource_tracker, '_stop', lambda: None)()")
+        path = os.path.dirname(os.path.abspath(pytrix.__file__))
+        subprocess.check_call([sys.executable, "-c", script % (path, name)])
+        self.assertEqual(pytrix.Matrix.from_shared(name), self.m1)
+
+        # Once the creating matrix has been freed, the segment is unlinked
+        del shared
+        self.assertEqual(attached, self.m1)
+        del attached
+        self.assertRaises(OSError, pytrix.Matrix.from_shared, name)
+
+        segment = shared_memory.SharedMemory(create=True, size=128)
+        try:
+            self.assertRaises(ValueError, pytrix.Matrix.from_shared, segment.name)
+        finally:
+            segment.close()
+            segment.unlink()
+
+    def testMatrixStr(self):
+        self.assertEqual(str(self.e1), '')
+        self.assertEqual(str(self.m1), '[1.0, 2.0, 3.0]\n[4.0, 5.0, 6.0]\n[7.0, 8.0, 9.0]')
+        self.assertEqual(str(pytrix.Matrix([[-0.5, 1e22, float('inf')]])), '[-0.5, 1e+22, inf]')
+
+    def testMatrixFromText(self):
+        self._assertMatrixEqual(pytrix.Matrix.from_text(b'1 2 3\n4 5 6\n'), [1, 2, 3], [4, 5, 6])
+        self._assertMatrixEqual(pytrix.Matrix.from_text(b' 1\t 2 \r\n\n-3e2   .5'), [1, 2], [-300, .5])
+        self._assertMatrixEqual(pytrix.Matrix.from_text(b'1;2\n3;4', delimiter=';'), [1, 2], [3, 4])
+        self._assertMatrixEqual(pytrix.Matrix.from_csv(b'1, 2\r\n3 ,4\r\n'), [1, 2], [3, 4])
+        self._assertMatrixEqual(pytrix.Matrix.from_csv(bytearray(b'1\t2'), delimiter='\t'), [1, 2])
+        self.assertEqual(pytrix.Matrix.from_text(b'').rows, 0)
+
+        # Values which can't be parsed exactly by the fast path must still be correctly rounded
+        values = ['0.1', '1e-300', '123456789012345678901234567890', '2.2250738585072014e-308', '9007199254740993',
+                  '-0', '1e23', 'inf', '-Infinity']
+        m = pytrix.Matrix.from_csv(','.join(values).encode('ascii'))
+        for i, value in enumerate(values):
+            self.assertEqual(struct.pack('d', m[0][i]), struct.pack('d', float(value)))
+
+        self.assertRaises(ValueError, pytrix.Matrix.from_csv, b'1,2\n3')
+        self.assertRaises(ValueError, pytrix.Matrix.from_csv, b'1,,2')
+        self.assertRaises(ValueError, pytrix.Matrix.from_csv, b'1,2,')
+        self.assertRaises(ValueError, pytrix.Matrix.from_csv, b'1,a')
+        self.assertRaises(ValueError, pytrix.Matrix.from_text, b'1 2', delimiter='ab')
+        for delimiter in '\r\n.+-eE09':
+            self.assertRaises(ValueError, pytrix.Matrix.from_text, b'1e2e3', delimiter=delimiter)
+        self.assertRaises(IOError, pytrix.Matrix.from_text, os.path.join(tempfile.gettempdir(), 'pytrix-missing.txt'))
+
+    def testMatrixToText(self):
+        m = pytrix.Matrix([[1.5, -2, 1e-7], [4, 5, 6e100]])
+        self.assertEqual(m.to_text(), '1.5 -2.0 1e-07\n4.0 5.0 6e+100\n')
+        self.assertEqual(m.to_text(delimiter=', '), '1.5, -2.0, 1e-07\n4.0, 5.0, 6e+100\n')
+        self.assertEqual(self.e1.to_text(), '')
+        self.assertEqual(pytrix.Matrix.from_text(m.to_text().encode('ascii')), m)
+
+        # Round trip through a file large enough to be parsed in several chunks
+        big = pytrix.Matrix([[(row * 1000 + column) / 7.0 for column in range(100)] for row in range(1000)])
+        fd, path = tempfile.mkstemp()
+        os.close(fd)
+        try:
+            big.to_text(path, delimiter=',')
+            self.assertEqual(pytrix.Matrix.from_csv(path), big)
+        finally:
+            os.remove(path)
+
+    def testMatrixBatch(self):
+        a = pytrix.Matrix([[1, 2], [3, 4], [5, 6]])
+        b = pytrix.Matrix([[0, -1], [2, 0.5], [1, 1]])
+        batch = pytrix.MatrixBatch([a, b])
+        self.assertEqual((len(batch), batch.rows, batch.columns), (2, 3, 2))
+        self.assertTrue(isinstance(batch[0], pytrix.Matrix))
+        self.assertEqual((batch[0], batch[1]), (a, b))
+        self.assertEqual(batch.tobytes(), a.tobytes() + b.tobytes())
+        self.assertEqual(pytrix.MatrixBatch.frombytes(batch.tobytes(), 3, 2)[1], b)
+        self.assertEqual(len(pytrix.MatrixBatch([])), 0)
+
+        square = pytrix.Matrix([[1, 2], [-1, 3]])
+        product = batch * pytrix.MatrixBatch([square, square.transpose()])
+        self.assertEqual((product[0], product[1]), (a * square, b * square.transpose()))
+        self.assertEqual((batch * square)[1], b * square)
+        left = pytrix.Matrix([[1, 0, 2]])
+        self.assertEqual((left * batch)[1], left * b)
+
+        # Products over enough matrices to be computed in several blocks
+        many = pytrix.MatrixBatch([square * i for i in range(1000)])
+        self.assertEqual((many * many)[999], (square * 999) * (square * 999))
+
+        self.assertRaises(IndexError, lambda: batch[2])
+        self.assertRaises(TypeError, pytrix.MatrixBatch, [a, 1])
+        self.assertRaises(ValueError, pytrix.MatrixBatch, [a, square])
+        self.assertRaises(ValueError, pytrix.MatrixBatch.frombytes, b'\x00' * 40, 3, 2)
+        self.assertRaises(ValueError, lambda: batch * batch)
+        self.assertRaises(ValueError, lambda: batch * pytrix.MatrixBatch([square]))
+        self.assertRaises(ValueError, lambda: square * batch)
+        self.assertRaises(TypeError, lambda: batch * 2)
+        self.assertRaises(TypeError, lambda: batch * pytrix.Vector(1, 2))
+
+    def testMatrixBatchFactor(self):
+        for size in range(1, 8):
+            matrices = [pytrix.Matrix([[(row * 7 + col * 3 + i) % 5 + (row == col) * (size + i)
+                                        for col in range(size)] for row in range(size)]) for i in range(40)]
+            batch = pytrix.MatrixBatch(matrices)
+            determinants = batch.determinant()
+            inverses = batch.inverse()
+            rhs = pytrix.VectorArray([pytrix.Vector([row + i for row in range(size)]) for i in range(40)])
+            solutions = batch.solve(rhs)
+            shared = batch.solve(pytrix.Vector(list(range(size))))
+            for i, m in enumerate(matrices):
+                self.assertAlmostEqual(determinants[i], m.determinant(), delta=abs(m.determinant()) * 1e-9)
+                self._assertMatrixEqualWithDelta(inverses[i], m.inverse())
+                for row, value in enumerate(m * solutions[i]):
+                    self.assertAlmostEqual(value, row + i)
+                for row, value in enumerate(m * shared[i]):
+                    self.assertAlmostEqual(value, row)
+
+        # Solving requires pivoting
+        batch = pytrix.MatrixBatch([pytrix.Matrix([[0, 0, 1, 0, 0], [1, 0, 0, 0, 0], [0, 0, 0, 0, 2], [0, 3, 0, 0, 0],
+                                                   [0, 0, 0, 4, 0]])])
+        self.assertEqual(list(batch.solve(pytrix.Vector(1, 2, 4, 6, 8))[0]), [2, 2, 1, 2, 2])
+        self.assertEqual(list(batch.determinant()), [24])
+
+        for scales in self._scaledMatrices():
+            m = pytrix.Matrix([[scale if row == col else 0 for col, scale in enumerate(scales)]
+                               for row in range(len(scales))])
+            batch = pytrix.MatrixBatch([pytrix.identityMatrix(len(scales)), m])
+            self.assertEqual(batch.determinant()[1], m.determinant())
+            self._assertScaledInverse(batch.inverse()[1], scales)
+
+        # Empty batches, and batches of empty matrices
+        for batch in (pytrix.MatrixBatch([]), pytrix.MatrixBatch.frombytes(b'', 3, 3)):
+            self.assertEqual(list(batch.determinant()), [])
+            self.assertEqual(len(batch.inverse()), 0)
+            self.assertEqual(len(batch.solve(pytrix.VectorArray([]))), 0)
+            self.assertEqual(len(batch * batch), 0)
+        empty = pytrix.MatrixBatch([self.e1, self.e1])
+        self.assertEqual(list(empty.determinant()), [1, 1])
+        self.assertEqual(len(empty.inverse()), 2)
+        self.assertEqual(len(empty * empty), 2)
+
+        singular = pytrix.MatrixBatch([pytrix.identityMatrix(3), self.m1, self.zero3])
+        self.assertEqual(list(singular.determinant()), [1, 0, 0])
+        self.assertRaises(ValueError, singular.inverse)
+        self.assertRaises(ValueError, singular.solve, pytrix.Vector(1, 2, 3))
+        self.assertRaises(ValueError, pytrix.MatrixBatch([pytrix.Matrix([[1, 2, 3], [4, 5, 6]])]).inverse)
+        self.assertRaises(ValueError, pytrix.MatrixBatch([pytrix.Matrix([[1, 2, 3], [4, 5, 6]])]).determinant)
+        self.assertRaises(ValueError, singular.solve, pytrix.Vector(1, 2))
+        self.assertRaises(ValueError, singular.solve, pytrix.VectorArray([pytrix.Vector(1, 2, 3)]))
+        self.assertRaises(TypeError, singular.solve, pytrix.Point(1, 2, 3))
@@ -59,6 +59,15 @@ class TestMatrixConstructors(tests.PytrixTestCase):
         r = pytrix.rotation3DMatrix(math.pi, 0, 0)
         self.assertAlmostEqual((r * v).angleBetween(v), math.pi, delta=.01)
 
+        # Rotations are applied about x, then y, then z
+        x, y, z = 0.3, -1.2, 2.5
+        product = (pytrix.rotation3DMatrix(0, 0, z) * pytrix.rotation3DMatrix(0, y, 0) *
+                   pytrix.rotation3DMatrix(x, 0, 0))
+        r = pytrix.rotation3DMatrix(x, y, z)
+        for row in range(3):
+            for col in range(3):
+                self.assertAlmostEqual(r[row][col], product[row][col], places=12)
+
         matrices = [
             pytrix.Vector(2, 0, 0),
             pytrix.Vector(2, 2, 0),
@@ -100,3 +109,4 @@ class TestMatrixConstructors(tests.PytrixTestCase):
         self.assertRaises(ValueError, pytrix.permutationMatrix, -1, 2, 3)
         self.assertRaises(TypeError, pytrix.permutationMatrix, 0, [], 3)
         self.assertRaises(TypeError, pytrix.permutationMatrix, 0, 2, "3")
+        self.assertRaises(ValueError, pytrix.permutationMatrix, 3, 0, 3)
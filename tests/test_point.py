@@ -1,5 +1,5 @@
 # Standard imports
-import math
+import math, pickle
 
 # Project imports
 import pytrix
@@ -100,6 +100,14 @@ class TestPoint(tests.PytrixTestCase):
         self.assertEqual(self.p2.dimensions, 2)
         self.assertEqual(self.p3.dimensions, 3)
 
+    def testPointHash(self):
+        self.assertEqual(hash(self.p3), hash(self.p3.copy()))
+        self.assertEqual(hash(self.p0), hash(pytrix.Point([])))
+        self.assertEqual(hash(pytrix.Point(0.0)), hash(pytrix.Point(-0.0)))
+        self.assertNotEqual(hash(self.p2), hash(self.p3))
+        self.assertEqual(len(set([self.p1, self.p1.copy(), self.p2, self.p3])), 3)
+        self.assertEqual({self.p3: 1}[pytrix.Point(1, 2, 3)], 1)
+
     def testPointCopy(self):
         self.assertEqual(self.p0, self.p0.copy())
         self.assertEqual(self.p1, self.p1.copy())
@@ -119,3 +127,235 @@ class TestPoint(tests.PytrixTestCase):
         self.assertRaises(IndexError, self.p1.__getitem__, -1)
         self.assertRaises(IndexError, self.p0.__getitem__, 0)
         self.assertRaises(TypeError, self.v1.__getitem__, self.p3)
+
+    def testPointPickle(self):
+        for protocol in range(pickle.HIGHEST_PROTOCOL + 1):
+            for p in (self.p0, self.p1, pytrix.Point([1.5, -2, 6e100])):
+                unpickled = pickle.loads(pickle.dumps(p, protocol))
+                self.assertTrue(isinstance(unpickled, pytrix.Point))
+                self.assertEqual(unpickled, p)
+
+        if pickle.HIGHEST_PROTOCOL >= 5:
+            buffers = []
+            data = pickle.dumps(self.p1, 5, buffer_callback=buffers.append)
+            self.assertEqual(len(buffers), 1)
+            self.assertEqual(pickle.loads(data, buffers=buffers), self.p1)
+
+        self.assertRaises(ValueError, pytrix.Point.frombytes, b'123')
+
+    def testPointToTuple(self):
+        self.assertEqual(self.p1.totuple(), tuple(self.p1))
+        self.assertEqual(pytrix.Point.frombytes(self.p1.tobytes()), self.p1)
+
+    def testTransformPoints(self):
+        translate = pytrix.Matrix([1, 0, 0, 1], [0, 1, 0, 2], [0, 0, 1, 3], [0, 0, 0, 1])
+        result = pytrix.transform_points(translate, [self.p3, pytrix.Point(0, 0, 0)])
+        self.assertEqual(list(map(list, result)), [[2, 4, 6], [1, 2, 3]])
+
+        # Non-affine transforms divide through by w
+        perspective = pytrix.Matrix([2, 0, 0], [0, 2, 0], [0, 1, 1])
+        self.assertEqual(list(pytrix.transform_points(perspective, [pytrix.Point(2, 3)])[0]), [1, 1.5])
+
+        scale = pytrix.Matrix([2, 0, 0, 0, 0], [0, 2, 0, 0, 0], [0, 0, 2, 0, 0], [0, 0, 0, 2, 0], [0, 0, 0, 0, 1])
+        self.assertEqual(list(pytrix.transform_points(scale, [pytrix.Point(1, 2, 3, 4)])[0]), [2, 4, 6, 8])
+
+        packed = self.p3.tobytes() + self.p3.tobytes()
+        self.assertEqual(pytrix.transform_points(translate, packed).tobytes(), result.row(0).tobytes() * 2)
+        out = bytearray(packed)
+        self.assertTrue(pytrix.transform_points(translate, out, out=out) is out)
+        self.assertEqual(bytes(out), result.row(0).tobytes() * 2)
+
+        # PointClouds are read in place, and give a PointCloud of the transformed points
+        cloud = pytrix.transform_points(translate, pytrix.PointCloud([self.p3, pytrix.Point(0, 0, 0)]))
+        self.assertTrue(isinstance(cloud, pytrix.PointCloud))
+        self.assertEqual(list(map(list, cloud)), [[2, 4, 6], [1, 2, 3]])
+        self.assertEqual(list(pytrix.transform_points(perspective, pytrix.PointCloud([pytrix.Point(2, 3)]))[0]),
+                         [1, 1.5])
+        out = bytearray(len(packed))
+        pytrix.transform_points(translate, pytrix.PointCloud([self.p3, self.p3]), out=out)
+        self.assertEqual(bytes(out), result.row(0).tobytes() * 2)
+        empty = pytrix.transform_points(translate, pytrix.PointCloud([]))
+        self.assertEqual((len(empty), empty.dimensions), (0, 3))
+
+        self.assertRaises(ValueError, pytrix.transform_points, pytrix.Matrix([1, 2]), [self.p1])
+        self.assertRaises(ValueError, pytrix.transform_points, translate, pytrix.PointCloud([self.p2]))
+        self.assertRaises(ValueError, pytrix.transform_points, translate, [self.p2])
+        self.assertRaises(TypeError, pytrix.transform_points, translate, [self.v3])
+        self.assertRaises(ValueError, pytrix.transform_points, translate, self.p2.tobytes())
+        self.assertRaises(ValueError, pytrix.transform_points, translate, packed, out=bytearray(8))
+
+    def testPointCloud(self):
+        cloud = pytrix.PointCloud([self.p3, pytrix.Point(3, 0, -1), pytrix.Point(-1, 4, 1)])
+        self.assertEqual((len(cloud), cloud.dimensions), (3, 3))
+        self.assertEqual(cloud[1], pytrix.Point(3, 0, -1))
+        self.assertTrue(isinstance(cloud[0], pytrix.Point))
+        self.assertEqual(cloud.centroid(), pytrix.Point(1, 2, 1))
+        self.assertEqual(cloud.bounds(), (pytrix.Point(-1, 0, -1), pytrix.Point(3, 4, 3)))
+        self.assertEqual(pytrix.PointCloud.frombytes(cloud.tobytes(), 3), cloud)
+        self.assertEqual(cloud.tobytes(), b''.join(p.tobytes() for p in (cloud[0], cloud[1], cloud[2])))
+        self.assertRaises(TypeError, hash, cloud)
+
+        moved = cloud + self.v3
+        self.assertTrue(isinstance(moved, pytrix.PointCloud))
+        self.assertEqual(moved[2], pytrix.Point(-1, 4, 1) + self.v3)
+        self.assertEqual(self.v3 + cloud, moved)
+        self.assertEqual(cloud - self.v3 + self.v3, cloud)
+        self.assertEqual(list((moved - cloud)[1]), list(self.v3))
+        self.assertTrue(isinstance(moved - cloud, pytrix.VectorArray))
+        self.assertEqual(list((self.p3 - cloud)[0]), [0, 0, 0])
+        self.assertEqual((cloud * 2)[1], pytrix.Point(6, 0, -2))
+        self.assertEqual(-cloud, cloud * -1)
+
+        translate = pytrix.Matrix([1, 0, 0, 1], [0, 1, 0, 2], [0, 0, 1, 3], [0, 0, 0, 1])
+        self.assertEqual(cloud.transform(translate), moved)
+
+        self.assertRaises(TypeError, lambda: cloud + cloud)
+        self.assertRaises(ValueError, lambda: cloud + self.v2)
+        self.assertRaises(ValueError, lambda: cloud - pytrix.PointCloud([self.p3]))
+        self.assertRaises(ValueError, cloud.transform, pytrix.identityMatrix(3))
+        self.assertRaises(IndexError, lambda: cloud[3])
+        self.assertRaises(TypeError, pytrix.PointCloud, [self.p3, self.v3])
+        self.assertRaises(ValueError, pytrix.PointCloud, [self.p3, self.p2])
+        self.assertRaises(ValueError, pytrix.PointCloud.frombytes, self.p2.tobytes(), 3)
+        self.assertRaises(ValueError, pytrix.PointCloud([]).centroid)
+
+    def testPairwiseDistances(self):
+        points = [pytrix.Point(0, 0), pytrix.Point(3, 4), pytrix.Point(-1, 1)]
+        others = [pytrix.Point(3, 0), pytrix.Point(0, 0)]
+
+        distances = pytrix.pairwise_distances(points, others)
+        self.assertEqual((distances.rows, distances.columns), (3, 2))
+        for i, p in enumerate(points):
+            for j, q in enumerate(others):
+                self.assertAlmostEqual(distances[i][j], (p - q).length())
+        self.assertEqual(list(pytrix.pairwise_distances(points, others, metric='sqeuclidean')[1]), [16, 25])
+        self.assertEqual(list(pytrix.pairwise_distances(points, others, metric='manhattan')[2]), [5, 2])
+
+        cloud = pytrix.PointCloud(points)
+        self.assertEqual(pytrix.pairwise_distances(cloud, others), distances)
+        self.assertEqual([pytrix.pairwise_distances(cloud, cloud)[i][i] for i in range(3)], [0, 0, 0])
+        self.assertEqual(pytrix.pairwise_distances([], others).rows, 0)
+
+        # Euclidean distances between points far from the origin keep their precision
+        far = [pytrix.Point(1e8 + 0.125, 1e8), pytrix.Point(1e8, 1e8)]
+        self.assertEqual(list(pytrix.pairwise_distances(far, far)[0]), [0, 0.125])
+        near = pytrix.PointCloud([pytrix.Point(1e3 + 0.3, -1e3, 1e3), pytrix.Point(1e3 + 0.3, -1e3 + 1e-3, 1e3)])
+        self.assertEqual(list(pytrix.pairwise_distances(near, pytrix.PointCloud(list(near)))[0]),
+                         [0, (near[0] - near[1]).length()])
+
+        self.assertRaises(ValueError, pytrix.pairwise_distances, points, [self.p3])
+        self.assertRaises(ValueError, pytrix.pairwise_distances, points, others, metric='cosine')
+        self.assertRaises(TypeError, pytrix.pairwise_distances, points, [self.v2])
+        self.assertRaises(TypeError, pytrix.pairwise_distances, points, 1)
+
+    def testIntersectSegments(self):
+        P = pytrix.Point
+        self.assertEqual(pytrix.intersect_segments(P(0, 0), P(2, 2), P(0, 2), P(2, 0)), P(1, 1))
+        self.assertEqual(pytrix.intersect_segments(P(0, 0), P(1, 0), P(1, 0), P(1, 5)), P(1, 0))
+        self.assertEqual(pytrix.intersect_segments(P(3, 0), P(0, 0), P(1, 0), P(2, 0)), P(2, 0))
+        self.assertEqual(pytrix.intersect_segments(P(1, 1), P(1, 1), P(0, 0), P(2, 2)), P(1, 1))
+        self.assertEqual(pytrix.intersect_segments(P(0, 0), P(1, 0), P(2, -1), P(2, 1)), None)
+        self.assertEqual(pytrix.intersect_segments(P(0, 0), P(1, 0), P(2, 0), P(3, 0)), None)
+        self.assertEqual(pytrix.intersect_segments(P(0, 0), P(1, 1), P(0, 1), P(1, 2)), None)
+
+        self.assertEqual(pytrix.intersect_lines(P(0, 0), P(1, 0), P(2, -1), P(2, 1)), P(2, 0))
+        self.assertEqual(pytrix.intersect_lines(P(0, 0), P(1, 1), P(0, 1), P(1, 2)), None)
+
+        self.assertRaises(TypeError, pytrix.intersect_segments, P(0, 0), P(1, 1), P(0, 1))
+        self.assertRaises(TypeError, pytrix.intersect_segments, P(0, 0), P(1, 1), P(0, 1), self.v2)
+        self.assertRaises(ValueError, pytrix.intersect_lines, P(0, 0), P(1, 1), P(0, 1), self.p3)
+
+    def testSegmentIntersections(self):
+        P = pytrix.Point
+        segments = [(P(x, y), P(x + dx, y + dy)) for x, y, dx, dy in
+                    ((0, 0, 4, 4), (0, 4, 4, -4), (2, 0, 0, 5), (5, 5, 1, 1), (6, 6, 2, 0), (1, 1, 2, 2), (9, 9, 1, 0))]
+        expected = []
+        for i in range(len(segments)):
+            for j in range(i + 1, len(segments)):
+                point = pytrix.intersect_segments(segments[i][0], segments[i][1], segments[j][0], segments[j][1])
+                if point is not None:
+                    expected.append((i, j, point))
+
+        self.assertEqual(len(expected), 7)
+        self.assertEqual(pytrix.segment_intersections(segments), expected)
+        self.assertEqual(pytrix.segment_intersections(pytrix.PointCloud([p for s in segments for p in s])), expected)
+        self.assertEqual(pytrix.segment_intersections([]), [])
+        self.assertEqual(pytrix.segment_intersections([(P(1, 1), P(1, 1))] * 3),
+                         [(0, 1, P(1, 1)), (0, 2, P(1, 1)), (1, 2, P(1, 1))])
+
+        # Short segments on a lattice with a far away one & long ones crossing many cells, long parallel segments, and
+        # segments along the lines of an integer grid which overlap & meet at their ends
+        layouts = ([(P(x, y), P(x + 1, y + 0.5)) for x in range(0, 30, 2) for y in range(0, 30, 2)] +
+                   [(P(1e6, 1e6), P(1e6 + 1, 1e6)), (P(-50, 1.25), P(80, 1.25)), (P(-50, -50), P(80, 80))],
+                   [(P(0, i), P(1000, i + 0.5)) for i in range(100)] + [(P(500, -1), P(500, 101))],
+                   [(P(x, y), P(x + 2, y)) for x in range(6) for y in range(6)] +
+                   [(P(x, y), P(x, y + 1)) for x in range(6) for y in range(6)])
+        for segments in layouts:
+            expected = []
+            for i in range(len(segments)):
+                for j in range(i + 1, len(segments)):
+                    point = pytrix.intersect_segments(segments[i][0], segments[i][1], segments[j][0], segments[j][1])
+                    if point is not None:
+                        expected.append((i, j, point))
+
+            self.assertEqual(pytrix.segment_intersections(segments), expected)
+
+        self.assertRaises(TypeError, pytrix.segment_intersections, 1)
+        self.assertRaises(TypeError, pytrix.segment_intersections, [(P(1, 2), self.v2)])
+        self.assertRaises(ValueError, pytrix.segment_intersections, [(P(1, 2),)])
+        self.assertRaises(ValueError, pytrix.segment_intersections, [(P(1, 2), self.p3)])
+        self.assertRaises(ValueError, pytrix.segment_intersections, [(P(1, 2), P(float('inf'), 2))])
+        self.assertRaises(ValueError, pytrix.segment_intersections, pytrix.PointCloud([self.p2]))
+
+    def testConvexHull(self):
+        P = pytrix.Point
+        square = [P(x, y) for x, y in ((1, 1), (0, 0), (2, 0), (1, 0), (2, 2), (0, 2), (1, 1), (2, 0), (0.5, 1.5))]
+        self.assertEqual(pytrix.convex_hull(square), [1, 2, 4, 5])
+        self.assertEqual(pytrix.convex_hull(pytrix.PointCloud(square)), [1, 2, 4, 5])
+        self.assertEqual(pytrix.convex_hull([P(3, 3), P(1, 1), P(2, 2), P(1, 1)]), [1, 0])
+        self.assertEqual(pytrix.convex_hull([P(3, 3)]), [0])
+        self.assertEqual(pytrix.convex_hull([]), [])
+
+        # Points a few units in the last place from a line through them are still classified exactly
+        nearly = [P(0.5 + i * 2 ** -52, 0.5 + j * 2 ** -52) for i in range(8) for j in range(8)]
+        nearly += [P(12, 12), P(24, 24)]
+        hull = pytrix.convex_hull(nearly)
+        self.assertEqual(hull[0], 0)
+        self.assertIn(65, hull)
+        self.assertNotIn(64, hull)
+
+        cube = [P(x, y, z) for x in range(3) for y in range(3) for z in range(3)]
+        hull = pytrix.convex_hull(cube)
+        corners = set(v for triangle in hull for v in triangle)
+        self.assertEqual(len(hull), 12)
+        self.assertEqual(corners, set(i for i, p in enumerate(cube) if all(c in (0, 2) for c in p)))
+        self.assertEqual(hull, sorted(hull))
+        edges = set()
+        for i, j, k in hull:
+            self.assertEqual(i, min(i, j, k))
+            edges.update(((i, j), (j, k), (k, i)))
+            # Faces are counterclockwise seen from outside, so their normals point away from the centre
+            a, b, c = cube[i], cube[j], cube[k]
+            u, v = [b[d] - a[d] for d in range(3)], [c[d] - a[d] for d in range(3)]
+            normal = (u[1] * v[2] - u[2] * v[1], u[2] * v[0] - u[0] * v[2], u[0] * v[1] - u[1] * v[0])
+            self.assertGreater(sum(normal[d] * (a[d] - 1) for d in range(3)), 0)
+        self.assertEqual(len(edges), 36)
+        self.assertTrue(all((j, i) in edges for i, j in edges))
+
+        self.assertRaises(TypeError, pytrix.convex_hull, 1)
+        self.assertRaises(TypeError, pytrix.convex_hull, [self.v2])
+        self.assertRaises(ValueError, pytrix.convex_hull, [self.p2, self.p3])
+        self.assertRaises(ValueError, pytrix.convex_hull, [P(1, 2, 3, 4)])
+        self.assertRaises(ValueError, pytrix.convex_hull, [P(x, y, 0) for x in range(3) for y in range(3)])
+        self.assertRaises(ValueError, pytrix.convex_hull, [P(float('nan'), 1)])
+
+    def testAabb(self):
+        P = pytrix.Point
+        points = [P(1, 5, 2), P(-1, 7, 0), P(0, 6, 3)]
+        self.assertEqual(pytrix.aabb(points), (P(-1, 5, 0), P(1, 7, 3)))
+        self.assertEqual(pytrix.aabb(pytrix.PointCloud(points)), (P(-1, 5, 0), P(1, 7, 3)))
+        self.assertEqual(pytrix.aabb([self.p2]), (self.p2, self.p2))
+
+        self.assertRaises(TypeError, pytrix.aabb, 1)
+        self.assertRaises(ValueError, pytrix.aabb, [])
+        self.assertRaises(ValueError, pytrix.aabb, [self.p2, self.p3])
@@ -0,0 +1,120 @@
+# Standard imports
+import math
+import pickle
+
+# Project imports
+import pytrix
+import tests
+
+class TestQuaternion(tests.PytrixTestCase):
+
+    def setUp(self):
+        self.q1 = pytrix.Quaternion.from_euler(0.3, -1.2, 2.5)
+        self.q2 = pytrix.Quaternion.from_axis_angle(pytrix.Vector(1, 2, 3), 0.8)
+
+    def _assertClose(self, a, b, places=12):
+        a, b = tuple(a), tuple(b)
+        self.assertEqual(len(a), len(b))
+        for x, y in zip(a, b):
+            self.assertAlmostEqual(x, y, places=places)
+
+    def _assertMatrixClose(self, a, b):
+        for row in range(3):
+            self._assertClose(a[row], b[row])
+
+
+    def testQuaternionInit(self):
+        q = pytrix.Quaternion(1, 2, 3, 4)
+        self.assertEqual((q.w, q.x, q.y, q.z), (1, 2, 3, 4))
+        self.assertEqual(q.totuple(), (1, 2, 3, 4))
+        self.assertEqual(pytrix.Quaternion().totuple(), (1, 0, 0, 0))
+        self.assertEqual(pytrix.Quaternion(z=2).totuple(), (1, 0, 0, 2))
+        self.assertEqual(str(q), '(1.0, 2.0, 3.0, 4.0)')
+        self.assertEqual(q, pytrix.Quaternion(1, 2, 3, 4))
+        self.assertNotEqual(q, -q)
+        self.assertEqual(hash(q), hash(pytrix.Quaternion(1, 2, 3, 4)))
+        self.assertEqual(pickle.loads(pickle.dumps(q)), q)
+
+        self.assertRaises(TypeError, pytrix.Quaternion, 'a')
+        self.assertRaises(TypeError, pytrix.Quaternion, 1, 2, 3, 4, 5)
+
+    def testQuaternionConversions(self):
+        x, y, z = 0.3, -1.2, 2.5
+        self._assertMatrixClose(self.q1.to_matrix(), pytrix.rotation3DMatrix(x, y, z))
+        self._assertMatrixClose(pytrix.Quaternion.from_matrix(self.q1.to_matrix()).to_matrix(), self.q1.to_matrix())
+        self.assertAlmostEqual(self.q1.length(), 1, places=12)
+
+        # Each branch of from_matrix, chosen by the largest diagonal element
+        for axis in (pytrix.Vector(1, 0, 0), pytrix.Vector(0, 1, 0), pytrix.Vector(0, 0, 1), pytrix.Vector(1, 1, 1)):
+            for radians in (0.5, 3):
+                q = pytrix.Quaternion.from_axis_angle(axis, radians)
+                self._assertMatrixClose(pytrix.Quaternion.from_matrix(q.to_matrix()).to_matrix(), q.to_matrix())
+
+        q = pytrix.Quaternion.from_axis_angle(pytrix.Vector(0, 0, 2), math.pi / 2)
+        self._assertClose(q.totuple(), (math.sqrt(0.5), 0, 0, math.sqrt(0.5)))
+        self._assertMatrixClose(pytrix.Quaternion(2, 0, 0, 0).to_matrix(), pytrix.identityMatrix(3))
+
+        self.assertRaises(TypeError, pytrix.Quaternion.from_axis_angle, pytrix.Vector(1, 0), 1)
+        self.assertRaises(ValueError, pytrix.Quaternion.from_axis_angle, pytrix.Vector(0, 0, 0), 1)
+        self.assertRaises(TypeError, pytrix.Quaternion.from_euler, 1, 2)
+        self.assertRaises(TypeError, pytrix.Quaternion.from_matrix, pytrix.Vector(1, 2, 3))
+        self.assertRaises(ValueError, pytrix.Quaternion.from_matrix, pytrix.identityMatrix(4))
+        self.assertRaises(ValueError, pytrix.Quaternion(0, 0, 0, 0).to_matrix)
+
+    def testQuaternionArithmetic(self):
+        self._assertMatrixClose((self.q1 * self.q2).to_matrix(), self.q1.to_matrix() * self.q2.to_matrix())
+        self._assertClose((self.q1 * self.q1.conjugate()).totuple(), (1, 0, 0, 0))
+        self._assertClose((pytrix.Quaternion(1, 2, 3, 4) * pytrix.Quaternion(1, 2, 3, 4).inverse()).totuple(),
+                          (1, 0, 0, 0))
+        self._assertClose(pytrix.Quaternion(0, 3, 0, 4).normalize().totuple(), (0, 0.6, 0, 0.8))
+        self.assertEqual(pytrix.Quaternion(0, 3, 0, 4).length(), 5)
+        self.assertEqual((-pytrix.Quaternion(1, 2, 3, 4)).totuple(), (-1, -2, -3, -4))
+
+        self.assertRaises(TypeError, lambda: self.q1 * 2)
+        self.assertRaises(TypeError, lambda: self.q1 * pytrix.Vector(1, 2, 3))
+        self.assertRaises(ValueError, pytrix.Quaternion(0, 0, 0, 0).inverse)
+        self.assertRaises(ValueError, pytrix.Quaternion(0, 0, 0, 0).normalize)
+
+    def testQuaternionSlerp(self):
+        self._assertClose(self.q1.slerp(self.q2, 0).totuple(), self.q1.totuple())
+        self._assertClose(self.q1.slerp(self.q2, 1).totuple(), self.q2.totuple())
+        self._assertClose(self.q1.slerp(-self.q2, 1).totuple(), self.q2.totuple())
+
+        z = pytrix.Vector(0, 0, 1)
+        start = pytrix.Quaternion()
+        end = pytrix.Quaternion.from_axis_angle(z, 2)
+        for t in (0.25, 0.5, 0.9):
+            self._assertClose(start.slerp(end, t).totuple(), pytrix.Quaternion.from_axis_angle(z, 2 * t).totuple())
+        self._assertClose(start.slerp(start, 0.5).totuple(), start.totuple())
+
+        self.assertRaises(TypeError, self.q1.slerp, 1, 0.5)
+        self.assertRaises(ValueError, self.q1.slerp, pytrix.Quaternion(0, 0, 0, 0), 0.5)
+
+    def testQuaternionRotate(self):
+        m = self.q1.to_matrix()
+        v = pytrix.Vector(1, -2, 0.5)
+        rotated = self.q1.rotate(v)
+        self.assertTrue(isinstance(rotated, pytrix.Vector))
+        self._assertClose(rotated, m * v)
+
+        p = pytrix.Point(1, -2, 0.5)
+        self.assertTrue(isinstance(self.q1.rotate(p), pytrix.Point))
+        self._assertClose(self.q1.rotate(p), m * v)
+
+        items = [v, p, pytrix.Vector(0, 0, 0)]
+        self.assertEqual(self.q1.rotate(items), [self.q1.rotate(item) for item in items])
+        self.assertEqual(self.q1.rotate([]), [])
+
+        cloud = self.q1.rotate(pytrix.PointCloud([p, pytrix.Point(2, -4, 1), -p]))
+        self.assertTrue(isinstance(cloud, pytrix.PointCloud))
+        self._assertClose(cloud[2], self.q1.rotate(-p))
+        array = self.q1.rotate(pytrix.VectorArray([v, v * 2]))
+        self.assertTrue(isinstance(array, pytrix.VectorArray))
+        self._assertClose(array[1], self.q1.rotate(v * 2))
+        self.assertEqual(len(self.q1.rotate(pytrix.PointCloud([]))), 0)
+
+        self.assertRaises(TypeError, self.q1.rotate, 1)
+        self.assertRaises(TypeError, self.q1.rotate, [v, 1])
+        self.assertRaises(ValueError, self.q1.rotate, pytrix.Vector(1, 2))
+        self.assertRaises(ValueError, self.q1.rotate, pytrix.PointCloud([pytrix.Point(1, 2)]))
+        self.assertRaises(ValueError, pytrix.Quaternion(0, 0, 0, 0).rotate, v)
@@ -0,0 +1,86 @@
+# Standard imports
+import struct
+
+# Project imports
+import pytrix
+import tests
+
+class TestSpatialGrid(tests.PytrixTestCase):
+
+    def setUp(self):
+        self.grid = pytrix.SpatialGrid(1.5, 2)
+        self.positions = {}
+        for i, (x, y) in enumerate((x, y) for x in range(-4, 5) for y in range(-4, 5)):
+            self.grid.insert(i * 2, pytrix.Point(x, y))
+            self.positions[i * 2] = (x, y)
+
+    def _within(self, query, radius):
+        return sorted(i for i, (x, y) in self.positions.items()
+                      if (x - query[0]) ** 2 + (y - query[1]) ** 2 <= radius ** 2)
+
+
+    def testSpatialGridInit(self):
+        self.assertEqual((len(self.grid), self.grid.dimensions, self.grid.cell_size), (81, 2, 1.5))
+        self.assertEqual(len(pytrix.SpatialGrid(cell_size=2, dim=3)), 0)
+        self.assertIn(0, self.grid)
+        self.assertNotIn(1, self.grid)
+        self.assertNotIn(1000, self.grid)
+        self.assertNotIn('a', self.grid)
+
+        self.assertRaises(TypeError, pytrix.SpatialGrid)
+        self.assertRaises(TypeError, pytrix.SpatialGrid, 1)
+        self.assertRaises(ValueError, pytrix.SpatialGrid, 0, 2)
+        self.assertRaises(ValueError, pytrix.SpatialGrid, float('inf'), 2)
+        self.assertRaises(ValueError, pytrix.SpatialGrid, 1, 0)
+
+    def testSpatialGridModify(self):
+        self.grid.move(0, pytrix.Point(10, 10))
+        self.grid.move(2, pytrix.Point(-3.9, -3.1))
+        self.grid.remove(4)
+        self.grid.insert(1, pytrix.Point(0.5, 0.5))
+        self.positions.update({0: (10, 10), 2: (-3.9, -3.1), 1: (0.5, 0.5)})
+        del self.positions[4]
+
+        self.assertEqual(len(self.grid), 81)
+        self.assertNotIn(4, self.grid)
+        for query in ((0, 0), (10, 10), (-4, -3), (2.2, -1.7)):
+            for radius in (0, 1, 2.5, 100):
+                self.assertEqual(self.grid.query_radius(pytrix.Point(*query), radius), self._within(query, radius))
+
+        self.assertRaises(ValueError, self.grid.insert, 0, pytrix.Point(1, 1))
+        self.assertRaises(ValueError, self.grid.insert, -1, pytrix.Point(1, 1))
+        self.assertRaises(ValueError, self.grid.insert, 3, pytrix.Point(1, 1, 1))
+        self.assertRaises(ValueError, self.grid.insert, 3, pytrix.Point(float('nan'), 1))
+        self.assertRaises(TypeError, self.grid.insert, 3, pytrix.Vector(1, 1))
+        self.assertRaises(KeyError, self.grid.move, 4, pytrix.Point(1, 1))
+        self.assertRaises(KeyError, self.grid.remove, 4)
+
+    def testSpatialGridUpdate(self):
+        coordinates = [c for i in sorted(self.positions) for c in (self.positions[i][0] * 0.5, 7)]
+        self.grid.update(struct.pack('%dd' % len(coordinates), *coordinates), ids=sorted(self.positions))
+        self.grid.update([pytrix.Point(1, 1), pytrix.Point(2, 2)], [1000, 0])
+        self.grid.update(pytrix.PointCloud([pytrix.Point(3, 3)]))
+        self.positions = dict((i, (self.positions[i][0] * 0.5, 7)) for i in self.positions)
+        self.positions.update({1000: (1, 1), 0: (3, 3)})
+
+        self.assertEqual(len(self.grid), 82)
+        for query in ((0, 7), (2, 2), (-1.2, 6.1)):
+            for radius in (0.5, 1, 3):
+                self.assertEqual(self.grid.query_radius(pytrix.Point(*query), radius), self._within(query, radius))
+
+        self.assertRaises(ValueError, self.grid.update, struct.pack('3d', 1, 2, 3))
+        self.assertRaises(ValueError, self.grid.update, [pytrix.Point(1, 2)], [1, 2])
+        self.assertRaises(ValueError, self.grid.update, [pytrix.Point(1, 2)], [-1])
+        self.assertRaises(ValueError, self.grid.update, [pytrix.Point(1, 2, 3)])
+        self.assertRaises(ValueError, self.grid.update, bytearray(struct.pack('2d', 1, float('inf'))))
+        self.assertEqual(self.grid.query_radius(pytrix.Point(1, 2), 0), [])
+
+    def testSpatialGridQueryRadius(self):
+        self.assertEqual(self.grid.query_radius(pytrix.Point(0, 0), 1), [62, 78, 80, 82, 98])
+        self.assertEqual(self.grid.query_radius(pytrix.Point(0, 0), -1), [])
+        self.assertEqual(len(self.grid.query_radius(pytrix.Point(0, 0), float('inf'))), 81)
+        self.assertEqual(pytrix.SpatialGrid(1, 2).query_radius(pytrix.Point(0, 0), 1), [])
+
+        self.assertRaises(TypeError, self.grid.query_radius, pytrix.Point(0, 0))
+        self.assertRaises(TypeError, self.grid.query_radius, pytrix.Vector(0, 0), 1)
+        self.assertRaises(ValueError, self.grid.query_radius, pytrix.Point(0, 0, 0), 1)
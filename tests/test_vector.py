@@ -1,5 +1,5 @@
 # Standard imports
-import math
+import math, os, pickle, tempfile
 
 # Project imports
 import pytrix
@@ -29,6 +29,11 @@ class TestVector(tests.PytrixTestCase):
         self.assertEqual(len(list(pytrix.Vector([1, 2, 3]))), 3)
         self.assertEqual(len(list(pytrix.Vector(1, 2, 3))), 3)
         self.assertEqual(list(pytrix.Vector(1, 2, 3, 4, 5, 6)), [1, 2, 3, 4, 5, 6])
+        self.assertEqual(list(pytrix.Vector([True, False, 2, 2.5])), [1, 0, 2, 2.5])
+        self.assertRaises(TypeError, pytrix.Vector, [1, 2j])
+        self.assertRaises(OverflowError, pytrix.Vector, [1, 10 ** 400])
+        self.assertRaises(TypeError, pytrix.Matrix, [[1, 2], [3, 4j]])
+        self.assertRaises(TypeError, lambda: pytrix.Vector(1, 2) * 1j)
 
 
     def testVectorAdd(self):
@@ -147,6 +152,22 @@ class TestVector(tests.PytrixTestCase):
         self.assertEqual(self.v1.dimensions, 10)
         self.assertEqual(self.v2.dimensions, 10)
 
+    def testVectorHash(self):
+        self.assertEqual(hash(self.v1), hash(self.v1.copy()))
+        self.assertEqual(hash(self.e1), hash(pytrix.Vector([])))
+        self.assertEqual(hash(pytrix.Vector([0.0])), hash(pytrix.Vector([-0.0])))
+        self.assertNotEqual(hash(self.v1), hash(self.v2))
+        self.assertNotEqual(hash(self.zero1), hash(self.zero2))
+        self.assertEqual(len(set([self.v1, self.v1.copy(), self.v2, self.zero0, self.zero1, self.zero2])), 5)
+        self.assertEqual({self.v1: 1}[pytrix.Vector([1, 2, 3, 4, 5, 6, 7, 8, 9, 0])], 1)
+
+        # Equality must still hold between vectors which have both been hashed
+        v = pytrix.Vector([1, 2, 3])
+        hash(v)
+        hash(self.v1)
+        self.assertNotEqual(v, self.v1)
+        self.assertEqual(self.v1, self.v1.copy())
+
     def testVectorCopy(self):
         self.assertEqual(self.v1, self.v1.copy())
         self.assertEqual(self.v2, self.v2.copy())
@@ -279,3 +300,104 @@ class TestVector(tests.PytrixTestCase):
         self.assertRaises(IndexError, self.v1.__getitem__, 11)
         self.assertRaises(IndexError, self.e1.__getitem__, 0)
         self.assertRaises(TypeError, self.v1.__getitem__, self.p3)
+
+    def testVectorSaveLoad(self):
+        directory = tempfile.mkdtemp()
+        path = os.path.join(directory, 'v.npy')
+
+        try:
+            for v in (self.e1, self.zero2, self.v1, pytrix.Vector([1.5, -2, 6e100])):
+                v.save(path)
+                self.assertEqual(pytrix.Vector.load(path), v)
+                self.assertEqual(pytrix.Vector.load(path, mmap=True), v)
+
+            pytrix.Matrix([[1, 2], [3, 4]]).save(path)
+            self.assertRaises(ValueError, pytrix.Vector.load, path)
+            self.assertRaises(IOError, pytrix.Vector.load, os.path.join(directory, 'missing.npy'))
+        finally:
+            if os.path.exists(path):
+                os.remove(path)
+            os.rmdir(directory)
+
+    def testVectorPickle(self):
+        for protocol in range(pickle.HIGHEST_PROTOCOL + 1):
+            for v in (self.e1, self.zero2, self.v1, pytrix.Vector([1.5, -2, 6e100])):
+                unpickled = pickle.loads(pickle.dumps(v, protocol))
+                self.assertTrue(isinstance(unpickled, pytrix.Vector))
+                self.assertEqual(unpickled, v)
+
+        self.assertEqual(pytrix.Vector.frombytes(bytearray(self.v1.__reduce_ex__(2)[1][0])), self.v1)
+        self.assertRaises(ValueError, pytrix.Vector.frombytes, b'123')
+
+    def testVectorToList(self):
+        self.assertEqual(self.v1.tolist(), list(self.v1))
+        self.assertEqual(self.e1.tolist(), [])
+        self.assertEqual(pytrix.Vector.frombytes(self.v1.tobytes()), self.v1)
+
+    def testVectorBuilder(self):
+        b = pytrix.VectorBuilder(pytrix.Vector(1, 2, 3))
+        self.assertEqual((len(b), b.dimensions), (3, 3))
+        self.assertRaises(TypeError, hash, b)
+        b += pytrix.Vector(1, 1, 1)
+        b -= pytrix.Vector(0, 0, 1)
+        b *= 2
+        b[2] = 1
+        self.assertEqual(b[1], 6)
+        b *= pytrix.permutationMatrix(3, 0, 2)
+
+        v = b.freeze()
+        self.assertTrue(isinstance(v, pytrix.Vector))
+        self.assertFalse(v.mutable)
+        self.assertEqual(list(v), [1, 6, 4])
+        self.assertRaises(ValueError, b.freeze)
+        self.assertRaises(ValueError, len, b)
+
+        b = pytrix.VectorBuilder(2)
+        self.assertEqual(list(b.freeze()), [0, 0])
+        b = pytrix.VectorBuilder(2)
+        self.assertRaises(IndexError, lambda: b[2])
+        with self.assertRaises(ValueError):
+            b += self.zero2
+        with self.assertRaises(ValueError):
+            b *= pytrix.identityMatrix(3)
+        self.assertRaises(TypeError, pytrix.VectorBuilder, self.p2)
+
+    def testVectorLinearCombination(self):
+        self.assertEqual(pytrix.linear_combination([2, -1], [self.v1, self.v2]), self.v1 * 2 - self.v2)
+        self.assertEqual(pytrix.linear_combination((0.5,), (self.v1,)), self.v1 * 0.5)
+        self.assertEqual(pytrix.axpy(3, self.v1, self.v2), self.v1 * 3 + self.v2)
+
+        out = pytrix.Vector.zeros(10, mutable=True)
+        self.assertTrue(pytrix.axpy(1, self.v1, out, out=out) is out)
+        self.assertTrue(pytrix.axpy(2, out, out, out=out) is out)
+        self.assertEqual(out.copy(), self.v1 * 3)
+
+        self.assertRaises(ValueError, pytrix.linear_combination, [1], [self.v1, self.v2])
+        self.assertRaises(ValueError, pytrix.linear_combination, [], [])
+        self.assertRaises(ValueError, pytrix.linear_combination, [1, 1], [self.v1, self.zero2])
+        self.assertRaises(TypeError, pytrix.linear_combination, [1, None], [self.v1, self.v2])
+        self.assertRaises(TypeError, pytrix.linear_combination, [1, 1], [self.v1, self.p1])
+        self.assertRaises(TypeError, pytrix.axpy, 1, self.v1, self.v2, out=self.v2)
+
+    def testVectorArray(self):
+        array = pytrix.VectorArray([self.v1, self.v2])
+        self.assertEqual((len(array), array.dimensions), (2, 10))
+        self.assertTrue(isinstance(array[0], pytrix.Vector))
+        self.assertEqual(array[1], self.v2)
+        self.assertEqual((array + self.v1)[1], self.v1 + self.v2)
+        self.assertEqual((array - array)[0], pytrix.Vector.zeros(10))
+        self.assertEqual((0.5 * array)[0], self.v1 * 0.5)
+        self.assertEqual((-array)[1], -self.v2)
+        self.assertEqual(array.centroid(), (self.v1 + self.v2) * 0.5)
+        self.assertEqual(array.bounds()[1], pytrix.Vector([1, 9, 8, 7, 6, 6, 7, 8, 9, 1]))
+        self.assertEqual(pytrix.VectorArray.frombytes(array.tobytes(), 10), array)
+
+        rotate = pytrix.Matrix([0, -1], [1, 0])
+        vectors = pytrix.VectorArray([pytrix.Vector(1, 0), pytrix.Vector(2, 3)])
+        self.assertEqual(list(vectors.transform(rotate)[1]), [-3, 2])
+        self.assertEqual(list(vectors.transform(pytrix.Matrix([1, 1]))[1]), [5])
+
+        self.assertRaises(ValueError, vectors.transform, pytrix.identityMatrix(3))
+        self.assertRaises(ValueError, lambda: array + vectors)
+        self.assertRaises(TypeError, lambda: array + 1)
+        self.assertRaises(TypeError, pytrix.VectorArray, [self.p2])